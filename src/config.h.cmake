@@ -40,6 +40,9 @@
 /* Define if IEEE 32bit float optimizations are enabled. */
 #cmakedefine CONFIG_FLOAT32 @CONFIG_FLOAT32@
 
+/* Define if memory-mapped audio file reads are enabled. */
+#cmakedefine CONFIG_MMAP @CONFIG_MMAP@
+
 /* Define if round is available. */
 #cmakedefine CONFIG_ROUND @CONFIG_ROUND@
 
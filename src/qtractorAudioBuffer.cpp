@@ -22,18 +22,26 @@
 #include "qtractorAbout.h"
 #include "qtractorAudioBuffer.h"
 #include "qtractorAudioPeak.h"
+#include "qtractorAudioKernel.h"
 
 #include "qtractorTimeStretcher.h"
 
 #include "qtractorSession.h"
 #include "qtractorAudioEngine.h"
 
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDateTime>
+
 #include <cmath>
 
 
 // Glitch, click, pop-free ramp length (in frames).
 #define QTRACTOR_RAMP_LENGTH	32
 
+// Failed preload cache items retry period (in msecs).
+#define QTRACTOR_CACHE_RETRY	10000
+
 
 //----------------------------------------------------------------------
 // class qtractorAudioBufferThread -- Ring-cache manager thread.
@@ -51,6 +59,8 @@ qtractorAudioBufferThread::qtractorAudioBufferThread (
 	m_iSyncRead   = 0;
 	m_iSyncWrite  = 0;
 
+	m_pSyncPending = new SyncPending [m_iSyncSize];
+
 	m_bRunState = false;
 }
 
@@ -63,6 +73,7 @@ qtractorAudioBufferThread::~qtractorAudioBufferThread (void)
 		sync();
 	} while (!wait(100));
 
+	delete [] m_pSyncPending;
 	delete [] m_ppSyncItems;
 }
 
@@ -159,16 +170,42 @@ void qtractorAudioBufferThread::run (void)
 // Thread run executive.
 void qtractorAudioBufferThread::process (void)
 {
+	unsigned int i, j, n = 0;
+
+	// Gather all distinct pending items,
+	// sorted by urgency (insertion sort)...
 	unsigned int r = m_iSyncRead;
 	unsigned int w = m_iSyncWrite;
 
 	while (r != w) {
-		m_ppSyncItems[r]->sync();
+		qtractorAudioBuffer *pAudioBuffer = m_ppSyncItems[r];
+		for (i = 0; i < n; ++i) {
+			if (m_pSyncPending[i].buffer == pAudioBuffer)
+				break;
+		}
+		if (i >= n) {
+			const unsigned int ahead = pAudioBuffer->syncUrgency();
+			for (j = n++; j > 0 && m_pSyncPending[j - 1].ahead > ahead; --j)
+				m_pSyncPending[j] = m_pSyncPending[j - 1];
+			m_pSyncPending[j].buffer = pAudioBuffer;
+			m_pSyncPending[j].ahead  = ahead;
+		}
 		++r &= m_iSyncMask;
 		w = m_iSyncWrite;
 	}
 
 	m_iSyncRead = r;
+
+	// Most urgent first, just enough to get off the hook...
+	for (i = j = 0; i < n; ++i) {
+		qtractorAudioBuffer *pAudioBuffer = m_pSyncPending[i].buffer;
+		if (pAudioBuffer->syncPartial())
+			m_pSyncPending[j++].buffer = pAudioBuffer;
+	}
+
+	// Then the remaining read-ahead, still by urgency...
+	for (i = 0; i < j; ++i)
+		m_pSyncPending[i].buffer->syncAhead();
 }
 
 
@@ -185,14 +222,571 @@ void qtractorAudioBufferThread::checkSyncSize ( unsigned int iSyncSize )
 		qtractorAudioBuffer **ppOldSyncItems = m_ppSyncItems;
 		::memcpy(ppNewSyncItems, ppOldSyncItems,
 			m_iSyncSize * sizeof(qtractorAudioBuffer *));
+		SyncPending *pOldSyncPending = m_pSyncPending;
 		m_iSyncSize = iNewSyncSize;
 		m_iSyncMask = (iNewSyncSize - 1);
 		m_ppSyncItems = ppNewSyncItems;
+		m_pSyncPending = new SyncPending [iNewSyncSize];
+		delete [] pOldSyncPending;
 		delete [] ppOldSyncItems;
 	}
 }
 
 
+//----------------------------------------------------------------------
+// class qtractorAudioBufferCacheThread -- Preload cache loader thread.
+//
+
+class qtractorAudioBufferCacheThread : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioBufferCacheThread(qtractorAudioBufferCache *pCache)
+		: QThread(), m_pCache(pCache), m_bRunState(false) {}
+
+	// Thread run state accessors.
+	void setRunState(bool bRunState)
+	{
+		QMutexLocker locker(&m_mutex);
+		m_bRunState = bRunState;
+	}
+
+	bool runState() const
+		{ return m_bRunState; }
+
+	// Wake from executive wait condition.
+	void sync()
+	{
+		QMutexLocker locker(&m_mutex);
+		m_cond.wakeAll();
+	}
+
+protected:
+
+	// The main thread executive.
+	void run()
+	{
+		m_mutex.lock();
+		m_bRunState = true;
+		while (m_bRunState) {
+			m_mutex.unlock();
+			while (m_bRunState && m_pCache->load())
+				;
+			m_mutex.lock();
+			if (m_bRunState)
+				m_cond.wait(&m_mutex);
+		}
+		m_mutex.unlock();
+	}
+
+private:
+
+	// The owner cache.
+	qtractorAudioBufferCache *m_pCache;
+
+	// Whether the thread is logically running.
+	volatile bool m_bRunState;
+
+	// Thread synchronization objects.
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioBufferCache -- Whole-file (preload) cache.
+//
+
+// The local preload cache singleton.
+static qtractorAudioBufferCache g_audioBufferCache;
+
+qtractorAudioBufferCache *qtractorAudioBufferCache::getInstance (void)
+{
+	return &g_audioBufferCache;
+}
+
+
+// Constructor.
+qtractorAudioBufferCache::qtractorAudioBufferCache (void)
+	: m_pThread(nullptr), m_iSize(0), m_iBudget(0), m_iSerial(0),
+		m_bEnabled(false)
+{
+}
+
+
+// Destructor.
+qtractorAudioBufferCache::~qtractorAudioBufferCache (void)
+{
+	stopThread();
+
+	QMutexLocker locker(&m_mutex);
+
+	QHash<QString, Item *>::ConstIterator iter = m_items.constBegin();
+	const QHash<QString, Item *>::ConstIterator& iter_end = m_items.constEnd();
+	for ( ; iter != iter_end; ++iter) {
+		Item *pItem = iter.value();
+		if (pItem->buffer) {
+			for (unsigned short i = 0; i < pItem->channels; ++i)
+				delete [] pItem->buffer[i];
+			delete [] pItem->buffer;
+		}
+		delete pItem;
+	}
+
+	m_items.clear();
+	m_lru.clear();
+	m_pending.clear();
+}
+
+
+// Preload mode enablement.
+void qtractorAudioBufferCache::setEnabled ( bool bEnabled )
+{
+	m_bEnabled = bEnabled;
+
+	if (m_bEnabled)
+		return;
+
+	// Stop loading and forget the pending...
+	stopThread();
+
+	QMutexLocker locker(&m_mutex);
+
+	while (!m_pending.isEmpty())
+		remove(m_pending.takeFirst());
+}
+
+bool qtractorAudioBufferCache::isEnabled (void) const
+{
+	return m_bEnabled;
+}
+
+
+// Memory budget (in bytes).
+void qtractorAudioBufferCache::setBudget ( unsigned long iBudget )
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_iBudget = iBudget;
+
+	evict(0);
+
+	// Failed ones may fit now, so retry them...
+	QHash<QString, Item *>::ConstIterator iter = m_items.constBegin();
+	const QHash<QString, Item *>::ConstIterator& iter_end = m_items.constEnd();
+	for ( ; iter != iter_end; ++iter) {
+		Item *pItem = iter.value();
+		if (pItem->retry > 0)
+			pItem->retry = 1;
+	}
+}
+
+unsigned long qtractorAudioBufferCache::budget (void) const
+{
+	return m_iBudget;
+}
+
+
+// Current memory usage (in bytes).
+unsigned long qtractorAudioBufferCache::size (void) const
+{
+	return m_iSize;
+}
+
+
+// Number of items done loading, so far.
+unsigned int qtractorAudioBufferCache::serial (void) const
+{
+	return m_iSerial;
+}
+
+
+// Shared item key (file modification and size aware).
+QString qtractorAudioBufferCache::itemKey ( const QString& sFilename,
+	unsigned short iChannels, unsigned int iSampleRate )
+{
+	const QFileInfo info(sFilename);
+	return sFilename
+		+ '_' + QString::number(info.lastModified().toMSecsSinceEpoch())
+		+ '_' + QString::number(info.size())
+		+ '_' + QString::number(iChannels)
+		+ '_' + QString::number(iSampleRate);
+}
+
+
+// Shared item factory methods (non RT-safe).
+qtractorAudioBufferCache::Item *qtractorAudioBufferCache::acquire (
+	const QString& sFilename, unsigned short iChannels,
+	unsigned int iSampleRate )
+{
+	if (!m_bEnabled)
+		return nullptr;
+
+	const QString& sKey = itemKey(sFilename, iChannels, iSampleRate);
+
+	QMutexLocker locker(&m_mutex);
+
+	// Already there? Not while still loading; failed ones
+	// are only queued for loading again, once due...
+	Item *pItem = m_items.value(sKey, nullptr);
+	if (pItem) {
+		if (pItem->ready) {
+			if (pItem->refs++ == 0)
+				m_lru.removeAll(pItem);
+			return pItem;
+		}
+		if (pItem->retry < 1
+			|| pItem->retry > QDateTime::currentMSecsSinceEpoch())
+			return nullptr;
+	} else {
+		pItem = new Item;
+		pItem->key        = sKey;
+		pItem->filename   = sFilename;
+		pItem->sampleRate = iSampleRate;
+		pItem->channels   = iChannels;
+		pItem->frames     = 0;
+		pItem->buffer     = nullptr;
+		pItem->size       = 0;
+		pItem->refs       = 0;
+		pItem->ready      = false;
+		m_items.insert(sKey, pItem);
+	}
+
+	// Queue it for background loading...
+	pItem->retry = 0;
+	m_pending.append(pItem);
+
+	if (m_pThread == nullptr) {
+		m_pThread = new qtractorAudioBufferCacheThread(this);
+		m_pThread->start(QThread::LowPriority);
+	}
+
+	m_pThread->sync();
+
+	return nullptr;
+}
+
+
+void qtractorAudioBufferCache::release ( Item *pItem )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (--pItem->refs > 0)
+		return;
+
+	if (pItem->ready && m_bEnabled) {
+		m_lru.append(pItem);
+		evict(0);
+	} else {
+		remove(pItem);
+	}
+}
+
+
+// Free all unreferenced (and failed) items.
+void qtractorAudioBufferCache::cleanup (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	while (!m_lru.isEmpty())
+		remove(m_lru.takeFirst());
+
+	QList<Item *> failed;
+	QHash<QString, Item *>::ConstIterator iter = m_items.constBegin();
+	const QHash<QString, Item *>::ConstIterator& iter_end = m_items.constEnd();
+	for ( ; iter != iter_end; ++iter) {
+		Item *pItem = iter.value();
+		if (pItem->retry > 0)
+			failed.append(pItem);
+	}
+
+	while (!failed.isEmpty())
+		remove(failed.takeFirst());
+}
+
+
+// Background loader executive (loader thread).
+bool qtractorAudioBufferCache::load (void)
+{
+	m_mutex.lock();
+
+	if (m_pending.isEmpty()) {
+		m_mutex.unlock();
+		return false;
+	}
+
+	// Pending items are only ever removed from here...
+	Item *pItem = m_pending.first();
+
+	m_mutex.unlock();
+
+	qtractorAudioBuffer *pDecoder
+		= new qtractorAudioBuffer(nullptr, pItem->channels);
+	pDecoder->m_bCacheDecode = true;
+
+	// Session sample-rate may have changed meanwhile...
+	qtractorSession *pSession = qtractorSession::getInstance();
+	bool bReady = (pSession && pSession->sampleRate() == pItem->sampleRate
+		&& pDecoder->open(pItem->filename));
+	if (bReady) {
+		// Make room for it, if we're allowed to...
+		const unsigned long iSize = pDecoder->frames()
+			* pDecoder->channels() * sizeof(float);
+		m_mutex.lock();
+		evict(iSize);
+		bReady = (m_iSize + iSize <= m_iBudget);
+		if (bReady) {
+			pItem->size = iSize; // reserved.
+			m_iSize += iSize;
+		}
+		m_mutex.unlock();
+		// Decode the whole thing...
+		if (bReady)
+			bReady = decode(pItem, pDecoder);
+	}
+
+	delete pDecoder;
+
+	// Adjust to the actual memory usage...
+	QMutexLocker locker(&m_mutex);
+
+	const unsigned long iNewSize = (bReady
+		? pItem->frames * pItem->channels * sizeof(float) : 0);
+	m_iSize -= pItem->size;
+	m_iSize += iNewSize;
+	pItem->size  = iNewSize;
+	pItem->ready = bReady;
+
+	m_pending.removeAll(pItem);
+
+	// Unreferenced for now, unless failed,
+	// which get another chance a while later...
+	if (bReady) {
+		m_lru.append(pItem);
+		evict(0);
+	} else {
+		pItem->retry = QDateTime::currentMSecsSinceEpoch()
+			+ QTRACTOR_CACHE_RETRY;
+	}
+
+	// Let the waiting ones know...
+	++m_iSerial;
+
+	return !m_pending.isEmpty();
+}
+
+
+// Whole-file decoder.
+bool qtractorAudioBufferCache::decode (
+	Item *pItem, qtractorAudioBuffer *pDecoder )
+{
+	// Read it all, integrally...
+	pDecoder->initSync();
+
+	if (!pDecoder->m_bIntegral)
+		return false;
+
+	const unsigned long iFrames = pDecoder->m_iFileLength;
+	if (iFrames < 1)
+		return false;
+
+	qtractorRingBuffer<float> *pRingBuffer = pDecoder->m_pRingBuffer;
+	const unsigned short iBuffers = pRingBuffer->channels();
+	if (iBuffers < 1)
+		return false;
+
+	// Trim to exact size, one channel at a time,
+	// freeing the decoder ones as soon as possible...
+	float **ppRingBuffer = pRingBuffer->buffer();
+	float **ppBuffer = new float * [iBuffers];
+	for (unsigned short i = 0; i < iBuffers; ++i) {
+		ppBuffer[i] = new float [iFrames];
+		::memcpy(ppBuffer[i], ppRingBuffer[i], iFrames * sizeof(float));
+		delete [] ppRingBuffer[i];
+		ppRingBuffer[i] = nullptr;
+	}
+
+	pItem->channels = iBuffers;
+	pItem->frames = iFrames;
+	pItem->buffer = ppBuffer;
+
+	return true;
+}
+
+
+// Free least recently used items,
+// until there's room for some more (locked).
+void qtractorAudioBufferCache::evict ( unsigned long iSize )
+{
+	while (m_iSize + iSize > m_iBudget && !m_lru.isEmpty())
+		remove(m_lru.takeFirst());
+}
+
+
+// Item destroyer (locked).
+void qtractorAudioBufferCache::remove ( Item *pItem )
+{
+	m_items.remove(pItem->key);
+	m_lru.removeAll(pItem);
+
+	m_iSize -= pItem->size;
+
+	if (pItem->buffer) {
+		for (unsigned short i = 0; i < pItem->channels; ++i)
+			delete [] pItem->buffer[i];
+		delete [] pItem->buffer;
+	}
+
+	delete pItem;
+}
+
+
+// Background loader thread termination.
+void qtractorAudioBufferCache::stopThread (void)
+{
+	if (m_pThread == nullptr)
+		return;
+
+	if (m_pThread->isRunning()) do {
+		m_pThread->setRunState(false);
+		m_pThread->sync();
+	} while (!m_pThread->wait(100));
+
+	delete m_pThread;
+	m_pThread = nullptr;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioBufferStats -- Read-ahead (disk latency) statistics.
+//
+
+// The local read-ahead statistics singleton.
+static qtractorAudioBufferStats g_audioBufferStats;
+
+qtractorAudioBufferStats *qtractorAudioBufferStats::getInstance (void)
+{
+	return &g_audioBufferStats;
+}
+
+
+// Merge statistics of a just closed file (non RT-safe).
+void qtractorAudioBufferStats::update (
+	const QString& sFilename, const Item& item )
+{
+	if (item.reads < 1 || item.frames < 1)
+		return;
+
+	QMutexLocker locker(&m_mutex);
+
+	merge(m_items[sFilename], item);
+	merge(m_items[sourceKey(sFilename)], item);
+}
+
+
+// Best known statistics for a file, falling back
+// to the ones of its storage/format source (non RT-safe).
+bool qtractorAudioBufferStats::lookup (
+	const QString& sFilename, Item& item ) const
+{
+	QMutexLocker locker(&m_mutex);
+
+	QHash<QString, Item>::ConstIterator iter = m_items.constFind(sFilename);
+	if (iter == m_items.constEnd())
+		iter = m_items.constFind(sourceKey(sFilename));
+	if (iter == m_items.constEnd())
+		return false;
+
+	item = iter.value();
+	return true;
+}
+
+
+// Forget it all.
+void qtractorAudioBufferStats::clear (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_items.clear();
+}
+
+
+// Average and peak block read latency (in msecs).
+float qtractorAudioBufferStats::latency ( const Item& item )
+{
+	return (item.reads > 0 ? 1e-6f * float(item.nsecs) / float(item.reads) : 0.0f);
+}
+
+float qtractorAudioBufferStats::peakLatency ( const Item& item )
+{
+	return 1e-6f * float(item.peak);
+}
+
+
+// Read/decode time relative to real-time (0.0 = idle, 1.0 = full).
+float qtractorAudioBufferStats::load (
+	const Item& item, unsigned int iSampleRate )
+{
+	if (item.frames < 1)
+		return 0.0f;
+
+	return 1e-9f * float(item.nsecs) * float(iSampleRate) / float(item.frames);
+}
+
+
+// Read-ahead (ring-buffer) size estimate (in frames).
+unsigned int qtractorAudioBufferStats::readAheadSize (
+	const Item& item, unsigned int iSampleRate )
+{
+	// Default, when nothing is known yet...
+	if (item.reads < 1)
+		return (iSampleRate << 2);
+
+	// Peak latency (in frames) with enough room for
+	// the sync thread to serve plenty other buffers...
+	float fSize = 32e-9f * float(item.peak) * float(iSampleRate);
+
+	// Slow decoders (eg. compressed formats) get even more slack...
+	float fLoad = load(item, iSampleRate);
+	if (fLoad > 0.75f)
+		fLoad = 0.75f;
+	fSize /= (1.0f - fLoad);
+
+	// Fast sources still get a couple of seconds...
+	const float fMinSize = float(iSampleRate << 1);
+	const float fMaxSize = float(iSampleRate << 3);
+	if (fSize < fMinSize)
+		fSize = fMinSize;
+	else
+	if (fSize > fMaxSize)
+		fSize = fMaxSize;
+
+	return (unsigned int) fSize;
+}
+
+
+// Storage/format source key (directory and file suffix).
+QString qtractorAudioBufferStats::sourceKey ( const QString& sFilename )
+{
+	const QFileInfo info(sFilename);
+	return info.absolutePath() + "/*." + info.suffix().toLower();
+}
+
+
+// Accumulate statistics, decaying the old peak.
+void qtractorAudioBufferStats::merge ( Item& item, const Item& other )
+{
+	item.reads  += other.reads;
+	item.frames += other.frames;
+	item.nsecs  += other.nsecs;
+
+	item.peak -= (item.peak >> 2);
+	if (item.peak < other.peak)
+		item.peak = other.peak;
+}
+
+
 //----------------------------------------------------------------------
 // class qtractorAudioBuffer -- Ring buffer/cache method implementation.
 //
@@ -212,6 +806,8 @@ qtractorAudioBuffer::qtractorAudioBuffer (
 	m_iThreshold     = 0;
 	m_iBufferSize    = 0;
 
+	m_iSampleRate    = 0;
+
 	m_syncFlags      = 0;
 
 	m_iReadOffset    = 0;
@@ -263,6 +859,17 @@ qtractorAudioBuffer::qtractorAudioBuffer (
 	m_bWsolaTimeStretch = g_bDefaultWsolaTimeStretch;
 	m_bWsolaQuickSeek   = g_bDefaultWsolaQuickSeek;
 
+	// Whole-file (preload) cache stuff.
+	m_bCacheDecode = false;
+	m_pCacheItem   = nullptr;
+
+	m_bCacheWait   = false;
+	m_iCacheSerial = 0;
+
+	ATOMIC_SET(&m_cacheSwap, 0);
+	m_pCacheRingBuffer = nullptr;
+	m_iCacheLength = 0;
+
 }
 
 // Default destructor.
@@ -369,13 +976,28 @@ bool qtractorAudioBuffer::open ( const QString& sFilename, int iMode )
 			m_iOffset = 0;
 	}
 
+	// Read-ahead size, pre-sized from past latency measurements
+	// of this same file or any other from the same source...
+	unsigned int iReadAhead = (iSampleRate << 2);
+	if ((iMode & qtractorAudioFile::Read) && !m_bCacheDecode) {
+		qtractorAudioBufferStats::Item stats;
+		if (qtractorAudioBufferStats::getInstance()->lookup(sFilename, stats))
+			iReadAhead = qtractorAudioBufferStats::readAheadSize(stats, iSampleRate);
+	}
+
+	m_iSampleRate = iSampleRate;
+	m_readStats = qtractorAudioBufferStats::Item();
+
 	// Allocate ring-buffer now.
 	unsigned int iBufferSize = m_iLength;
 	if (iBufferSize == 0)
 		iBufferSize = (iSampleRate >> 1);
 	else
-	if (iBufferSize > (iSampleRate << 2))
-		iBufferSize = (iSampleRate << 2);
+	if (iBufferSize > iReadAhead && !m_bCacheDecode)
+		iBufferSize = iReadAhead;
+	else
+	if (m_bCacheDecode) // Whole-file decoder, with some slack...
+		iBufferSize += (iSampleRate >> 1);
 
 	m_pRingBuffer = new qtractorRingBuffer<float> (iBuffers, iBufferSize);
 	m_iThreshold  = (m_pRingBuffer->bufferSize() >> 2);
@@ -451,6 +1073,9 @@ bool qtractorAudioBuffer::open ( const QString& sFilename, int iMode )
 	for ( ; i < iBuffers; ++i)
 		m_pfGains[i] = 1.0f;
 
+	// Keep it around for the whole-file (preload) cache...
+	m_sFilename = sFilename;
+
 	// Make it sync-managed...
 	if (m_pSyncThread)
 		m_pSyncThread->sync(this);
@@ -508,12 +1133,29 @@ void qtractorAudioBuffer::close (void)
 		m_ppBuffer = nullptr;
 	}
 
+	// Drop any late cache attachment (swapped in or out).
+	if (m_pCacheRingBuffer) {
+		delete m_pCacheRingBuffer;
+		m_pCacheRingBuffer = nullptr;
+	}
+
+	ATOMIC_SET(&m_cacheSwap, 0);
+
 	if (m_pRingBuffer) {
 		deleteIOBuffers();
 		delete m_pRingBuffer;
 		m_pRingBuffer = nullptr;
 	}
 
+	// Release any shared (preload) cache item.
+	releaseCache();
+
+	// Keep read-ahead statistics for the next time around...
+	if ((m_pFile->mode() & qtractorAudioFile::Read) && !m_bCacheDecode) {
+		qtractorAudioBufferStats::getInstance()->update(
+			m_sFilename, m_readStats);
+	}
+
 	// Finally delete what we still own.
 	if (m_pFile) {
 		delete m_pFile;
@@ -965,6 +1607,13 @@ void qtractorAudioBuffer::initSync (void)
 	m_fNextGain = 0.0f;
 	m_iRampGain = (m_iOffset == 0 ? 0 : 1);
 
+	// Served from the whole-file (preload) cache?
+	if (initCache()) {
+		setSyncFlag(InitSync);
+		setSyncFlag(CloseSync, false);
+		return;
+	}
+
 	// Set to initial offset...
 	m_iSeekOffset = m_iOffset;
 
@@ -1001,12 +1650,57 @@ void qtractorAudioBuffer::initSync (void)
 
 // Base-mode sync executive.
 void qtractorAudioBuffer::sync (void)
+{
+	syncFrames(0);
+}
+
+
+// Prioritized sync executives: partial read-ahead first...
+bool qtractorAudioBuffer::syncPartial (void)
+{
+	return syncFrames(m_iThreshold);
+}
+
+// ...and the remaining read-ahead, later.
+void qtractorAudioBuffer::syncAhead (void)
+{
+	if (m_pFile && (m_pFile->mode() & qtractorAudioFile::Read))
+		readSync();
+}
+
+
+// Sync urgency: frames still available ahead of
+// the real-time thread, until under/overrun.
+unsigned int qtractorAudioBuffer::syncUrgency (void) const
+{
+	if (m_pFile == nullptr || m_pRingBuffer == nullptr)
+		return 0;
+
+	// Initializing, closing or seeking is always urgent...
+	if (!isSyncFlag(InitSync) || isSyncFlag(CloseSync)
+		|| ATOMIC_GET(&m_seekPending))
+		return 0;
+
+	// Recording: room left until overrun...
+	if (m_pFile->mode() & qtractorAudioFile::Write)
+		return m_pRingBuffer->writable();
+
+	// Playback: frames left until underrun...
+	return m_pRingBuffer->readable();
+}
+
+
+// Base-mode sync executive (optionally limited read-ahead);
+// returns whether there's still more to read-ahead.
+bool qtractorAudioBuffer::syncFrames ( unsigned int iMaxFrames )
 {
 	if (m_pFile == nullptr)
-		return;
+		return false;
 
 	if (!isSyncFlag(WaitSync))
-		return;
+		return false;
+
+	bool bAhead = false;
 
 	if (!isSyncFlag(InitSync)) {
 		initSync();
@@ -1015,15 +1709,18 @@ void qtractorAudioBuffer::sync (void)
 		setSyncFlag(WaitSync, false);
 		const int mode = m_pFile->mode();
 		if (mode & qtractorAudioFile::Read)
-			readSync();
+			bAhead = readSync(iMaxFrames);
 		else
 		if (mode & qtractorAudioFile::Write)
 			writeSync();
 		if (isSyncFlag(CloseSync)) {
 			m_pFile->close();
 			setSyncFlag(CloseSync, false);
+			bAhead = false;
 		}
 	}
+
+	return bAhead;
 }
 
 
@@ -1034,6 +1731,10 @@ bool qtractorAudioBuffer::inSync (
 	if (!isSyncFlag(InitSync))
 		return false;
 
+	// Late whole-file (preload) cache attachment?
+	if (m_cacheSwap.loadAcquire() == 1)
+		swapCache();
+
 	if (isSyncFlag(ReadSync))
 		return true;
 
@@ -1060,20 +1761,37 @@ void qtractorAudioBuffer::syncExport (void)
 }
 
 
-// Read-mode sync executive.
-void qtractorAudioBuffer::readSync (void)
+// Read-mode sync executive (optionally limited read-ahead);
+// returns whether there's still more to read-ahead.
+bool qtractorAudioBuffer::readSync ( unsigned int iMaxFrames )
 {
 	if (m_pRingBuffer == nullptr)
-		return;
+		return false;
 
 	if (isSyncFlag(CloseSync))
-		return;
+		return false;
+
+	// Served from the whole-file (preload) cache?
+	if (m_pCacheItem) {
+		// Free the swapped out streaming ring-buffer, if any...
+		if (m_cacheSwap.loadAcquire() == 2) {
+			deleteIOBuffers();
+			delete m_pCacheRingBuffer;
+			m_pCacheRingBuffer = nullptr;
+			ATOMIC_SET(&m_cacheSwap, 0);
+		}
+		return false;
+	}
+
+	// Whole-file (preload) cache item got ready meanwhile?
+	if (m_bCacheWait && attachCache())
+		return false;
 
 	// Check whether we have some hard-seek pending...
 	if (ATOMIC_TAZ(&m_seekPending)) {
 		// Do it...
 		if (!seekSync(m_iSeekOffset))
-			return;
+			return false;
 		// Refill the whole buffer....
 		m_pRingBuffer->reset();
 		// Override with new intended offset...
@@ -1081,9 +1799,16 @@ void qtractorAudioBuffer::readSync (void)
 		m_iReadOffset  = m_iSeekOffset;
 	}
 
-	const unsigned int ws = m_pRingBuffer->writable();
+	unsigned int ws = m_pRingBuffer->writable();
 	if (ws == 0)
-		return;
+		return false;
+
+	// Limited read-ahead, if so asked...
+	bool bAhead = false;
+	if (iMaxFrames > 0 && ws > iMaxFrames) {
+		ws = iMaxFrames;
+		bAhead = true;
+	}
 
 	unsigned int nahead = ws;
 	unsigned int ntotal = 0;
@@ -1111,8 +1836,23 @@ void qtractorAudioBuffer::readSync (void)
 		// Read the block in...
 		// (assume end-of-file)
 		int nread = -1;
-		if (nahead > 0)
-			nread = readBuffer(nahead);
+		if (nahead > 0) {
+			// Measure latency, once past the initial read-ahead...
+			if (isSyncFlag(InitSync)) {
+				QElapsedTimer timer;
+				timer.start();
+				nread = readBuffer(nahead);
+				if (nread > 0) {
+					const unsigned long long nsecs = timer.nsecsElapsed();
+					++m_readStats.reads;
+					m_readStats.frames += nread;
+					m_readStats.nsecs  += nsecs;
+					if (m_readStats.peak < nsecs)
+						m_readStats.peak = nsecs;
+				}
+			}
+			else nread = readBuffer(nahead);
+		}
 		if (nread > 0) {
 			// Another block was read in...
 			m_iWriteOffset += nread;
@@ -1135,6 +1875,13 @@ void qtractorAudioBuffer::readSync (void)
 			}
 		}
 	}
+
+	// Slow sources should refill earlier...
+	if (ntotal > 0 && isSyncFlag(InitSync))
+		updateThreshold();
+
+	// Still more to read-ahead, later?
+	return (bAhead && ntotal >= ws && !ATOMIC_GET(&m_seekPending));
 }
 
 
@@ -1375,7 +2122,7 @@ int qtractorAudioBuffer::readMixFrames (
 
 	const unsigned short iBuffers = m_pRingBuffer->channels();
 
-	unsigned short i, j; int n;
+	unsigned short i, j;
 	float fGainIter, fGainStep1, fGainStep2;
 	float *pFrames, *pBuffer;
 
@@ -1386,12 +2133,11 @@ int qtractorAudioBuffer::readMixFrames (
 		const int n0 = (m_iRampGain < 0 ? nread - nramp : nramp);
 		const int n1 = (m_iRampGain < 0 ? n0 : 0);
 		const int n2 = (m_iRampGain < 0 ? nread : n0);
+		fGainIter = (m_iRampGain < 0 ? 1.0f : 0.0f);
 		fGainStep1 = float(m_iRampGain) / float(nramp);
 		for (i = 0; i < iBuffers; ++i) {
-			fGainIter = (m_iRampGain < 0 ? 1.0f : 0.0f);
-			pBuffer = m_ppBuffer[i] + n1;
-			for (n = n1; n < n2; ++n, fGainIter += fGainStep1)
-				*pBuffer++ *= fGainIter;
+			qtractorAudioKernel::ramp(m_ppBuffer[i] + n1, n2 - n1,
+				fGainIter, fGainStep1);
 		}
 		m_iRampGain = (m_iRampGain < 0 ? 1 : 0);
 	//	fPrevGain = fGain;
@@ -1409,8 +2155,8 @@ int qtractorAudioBuffer::readMixFrames (
 			pBuffer = m_ppBuffer[i];
 			fGainIter = fPrevGain * m_pfGains[i];
 			fGainStep2 = fGainStep1 * m_pfGains[i];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			qtractorAudioKernel::ramp_add(pFrames, pBuffer, nread,
+				fGainIter, fGainStep2);
 		}
 	}
 	else if (iChannels > iBuffers) {
@@ -1420,8 +2166,8 @@ int qtractorAudioBuffer::readMixFrames (
 			pBuffer = m_ppBuffer[j];
 			fGainIter = fPrevGain * m_pfGains[j];
 			fGainStep2 = fGainStep1 * m_pfGains[j];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			qtractorAudioKernel::ramp_add(pFrames, pBuffer, nread,
+				fGainIter, fGainStep2);
 			if (++j >= iBuffers)
 				j = 0;
 		}
@@ -1433,8 +2179,8 @@ int qtractorAudioBuffer::readMixFrames (
 			pBuffer = m_ppBuffer[j];
 			fGainIter = fPrevGain * m_pfGains[j];
 			fGainStep2 = fGainStep1 * m_pfGains[j];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			qtractorAudioKernel::ramp_add(pFrames, pBuffer, nread,
+				fGainIter, fGainStep2);
 			if (++i >= iChannels)
 				i = 0;
 		}
@@ -1444,6 +2190,205 @@ int qtractorAudioBuffer::readMixFrames (
 }
 
 
+// Whether it's being served from the preload cache.
+bool qtractorAudioBuffer::isCached (void) const
+{
+	return (m_pCacheItem != nullptr);
+}
+
+
+// Read-ahead (disk latency) statistics, as measured so far.
+const qtractorAudioBufferStats::Item& qtractorAudioBuffer::readStats (void) const
+{
+	return m_readStats;
+}
+
+
+// Current read-ahead size and refill threshold (in frames).
+unsigned int qtractorAudioBuffer::readAhead (void) const
+{
+	return (m_pRingBuffer ? m_pRingBuffer->bufferSize() : 0);
+}
+
+unsigned int qtractorAudioBuffer::readThreshold (void) const
+{
+	return m_iThreshold;
+}
+
+
+// Adapt refill threshold to the measured read latency:
+// keep some peak latency margin ahead of the real-time
+// thread, though never less than the default one...
+void qtractorAudioBuffer::updateThreshold (void)
+{
+	const unsigned int iBufferSize = m_pRingBuffer->bufferSize();
+	const unsigned long long iMargin
+		= ((m_readStats.peak * m_iSampleRate) / 1000000000ULL) << 3;
+
+	unsigned int iThreshold = (iBufferSize >> 4);
+	if (iMargin < iBufferSize - iThreshold)
+		iThreshold = iBufferSize - (unsigned int) iMargin;
+	if (iThreshold > (iBufferSize >> 2))
+		iThreshold = (iBufferSize >> 2);
+
+	m_iThreshold = iThreshold;
+}
+
+
+// Whole-file (preload) cache item acquisition;
+// remembers whether still waiting for it to get ready.
+qtractorAudioBufferCache::Item *qtractorAudioBuffer::acquireCache (void)
+{
+	m_bCacheWait = false;
+
+	if (m_bCacheDecode || m_bTimeStretch || m_bPitchShift)
+		return nullptr;
+
+	if (m_sFilename.isEmpty())
+		return nullptr;
+
+	qtractorAudioBufferCache *pCache = qtractorAudioBufferCache::getInstance();
+	if (!pCache->isEnabled())
+		return nullptr;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return nullptr;
+
+	m_iCacheSerial = pCache->serial();
+
+	qtractorAudioBufferCache::Item *pItem
+		= pCache->acquire(m_sFilename, m_iChannels, pSession->sampleRate());
+	if (pItem == nullptr) {
+		m_bCacheWait = true;
+		return nullptr;
+	}
+
+	if (pItem->channels != m_pRingBuffer->channels()) {
+		pCache->release(pItem);
+		return nullptr;
+	}
+
+	return pItem;
+}
+
+
+// Logical clip window ring-buffer over the whole decoded file.
+qtractorRingBuffer<float> *qtractorAudioBuffer::cacheRingBuffer (
+	qtractorAudioBufferCache::Item *pItem, unsigned long& iLength ) const
+{
+	unsigned long iOffset = m_iOffset;
+	iLength = 0;
+	if (iOffset < pItem->frames)
+		iLength = pItem->frames - iOffset;
+	else
+		iOffset = 0;
+	if (iLength > m_iLength)
+		iLength = m_iLength;
+
+	const unsigned short iBuffers = pItem->channels;
+	float **ppBuffer = new float * [iBuffers];
+	for (unsigned short i = 0; i < iBuffers; ++i)
+		ppBuffer[i] = pItem->buffer[i] + iOffset;
+
+	qtractorRingBuffer<float> *pRingBuffer
+		= new qtractorRingBuffer<float> (iBuffers, iLength + 2, ppBuffer);
+	pRingBuffer->setWriteIndex(iLength);
+
+	return pRingBuffer;
+}
+
+
+// Whole-file (preload) cache attachment, on initial sync.
+bool qtractorAudioBuffer::initCache (void)
+{
+	qtractorAudioBufferCache::Item *pItem = acquireCache();
+	if (pItem == nullptr)
+		return false;
+
+	unsigned long iLength = 0;
+	qtractorRingBuffer<float> *pRingBuffer = cacheRingBuffer(pItem, iLength);
+
+	// Replace the old streaming ring-buffer...
+	deleteIOBuffers();
+	delete m_pRingBuffer;
+	m_pRingBuffer = pRingBuffer;
+	m_pCacheItem  = pItem;
+
+	// Make it all integral, as if read in full...
+	m_iReadOffset  = m_iOffset;
+	m_iWriteOffset = m_iOffset + iLength;
+	m_iFileLength  = m_iWriteOffset;
+	m_bIntegral    = true;
+
+	return true;
+}
+
+
+// Whole-file (preload) cache attachment, as soon as
+// the item gets ready, while streaming (sync thread).
+bool qtractorAudioBuffer::attachCache (void)
+{
+	if (qtractorAudioBufferCache::getInstance()->serial() == m_iCacheSerial)
+		return false;
+
+	qtractorAudioBufferCache::Item *pItem = acquireCache();
+	if (pItem == nullptr)
+		return false;
+
+	// Stop streaming right here; the actual swap
+	// is left to the real-time thread, on next sync...
+	m_pCacheRingBuffer = cacheRingBuffer(pItem, m_iCacheLength);
+	m_pCacheItem = pItem;
+
+	m_cacheSwap.storeRelease(1);
+
+	return true;
+}
+
+
+// Swap in the late attached cache ring-buffer (RT-safe).
+void qtractorAudioBuffer::swapCache (void)
+{
+	// Keep on the current (or pending seek) position...
+	unsigned long iFrame = m_iReadOffset;
+	if (ATOMIC_TAZ(&m_seekPending))
+		iFrame = m_iSeekOffset;
+	if (iFrame < m_iOffset || iFrame > m_iOffset + m_iCacheLength)
+		iFrame = m_iOffset;
+
+	qtractorRingBuffer<float> *pRingBuffer = m_pRingBuffer;
+	m_pRingBuffer = m_pCacheRingBuffer;
+	m_pCacheRingBuffer = pRingBuffer;
+
+	// Make it all integral, as if read in full...
+	m_pRingBuffer->setReadIndex(iFrame - m_iOffset);
+	m_iReadOffset  = iFrame;
+	m_iWriteOffset = m_iOffset + m_iCacheLength;
+	m_iFileLength  = m_iWriteOffset;
+	m_bIntegral    = true;
+
+	setSyncFlag(ReadSync, false);
+
+	// Let the old one be freed (sync thread)...
+	m_cacheSwap.storeRelease(2);
+
+	if (m_pSyncThread)
+		m_pSyncThread->sync(this);
+}
+
+
+void qtractorAudioBuffer::releaseCache (void)
+{
+	m_bCacheWait = false;
+
+	if (m_pCacheItem) {
+		qtractorAudioBufferCache::getInstance()->release(m_pCacheItem);
+		m_pCacheItem = nullptr;
+	}
+}
+
+
 // I/O buffer release.
 void qtractorAudioBuffer::deleteIOBuffers (void)
 {
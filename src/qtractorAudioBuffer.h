@@ -34,11 +34,14 @@
 #include <QThread>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QHash>
+#include <QList>
 
 
 // Forward declarations.
 class qtractorAudioPeakFile;
 class qtractorAudioBuffer;
+class qtractorAudioBufferCacheThread;
 class qtractorTimeStretcher;
 
 
@@ -77,6 +80,13 @@ protected:
 
 private:
 
+	// Pending sync item (priority) descriptor.
+	struct SyncPending
+	{
+		qtractorAudioBuffer *buffer;
+		unsigned int         ahead;
+	};
+
 	// Instance variables.
 	unsigned int          m_iSyncSize;
 	unsigned int          m_iSyncMask;
@@ -85,6 +95,9 @@ private:
 	volatile unsigned int m_iSyncRead;
 	volatile unsigned int m_iSyncWrite;
 
+	// Pending sync items, most urgent first.
+	SyncPending          *m_pSyncPending;
+
 	// Whether the thread is logically running.
 	volatile bool m_bRunState;
 
@@ -94,6 +107,171 @@ private:
 };
 
 
+//----------------------------------------------------------------------
+// class qtractorAudioBufferCache -- Whole-file (preload) cache.
+//
+
+class qtractorAudioBufferCache
+{
+public:
+
+	// Constructor.
+	qtractorAudioBufferCache();
+
+	// Destructor.
+	~qtractorAudioBufferCache();
+
+	// Shared decoded file item.
+	struct Item
+	{
+		QString        key;
+		QString        filename;
+		unsigned int   sampleRate;
+		unsigned short channels;
+		unsigned long  frames;
+		float        **buffer;
+		unsigned long  size;	// in bytes.
+		int            refs;
+		bool           ready;
+		qint64         retry;	// failed, retry after (msecs).
+	};
+
+	// Preload mode enablement.
+	void setEnabled(bool bEnabled);
+	bool isEnabled() const;
+
+	// Memory budget (in bytes).
+	void setBudget(unsigned long iBudget);
+	unsigned long budget() const;
+
+	// Current memory usage (in bytes).
+	unsigned long size() const;
+
+	// Number of items done loading, so far; requesters
+	// still waiting may try and acquire again on change.
+	unsigned int serial() const;
+
+	// Shared item factory methods (non RT-safe);
+	// items not there yet are decoded in the background,
+	// meanwhile the requester should keep streaming.
+	Item *acquire(const QString& sFilename,
+		unsigned short iChannels, unsigned int iSampleRate);
+	void release(Item *pItem);
+
+	// Free all unreferenced (and failed) items.
+	void cleanup();
+
+	// Background loader executive (loader thread);
+	// returns whether there's still more to load.
+	bool load();
+
+	// Singleton instance accessor.
+	static qtractorAudioBufferCache *getInstance();
+
+protected:
+
+	// Shared item key (file modification and size aware).
+	static QString itemKey(const QString& sFilename,
+		unsigned short iChannels, unsigned int iSampleRate);
+
+	// Whole-file decoder.
+	bool decode(Item *pItem, qtractorAudioBuffer *pDecoder);
+
+	// Background loader thread termination.
+	void stopThread();
+
+	// Free least recently used items,
+	// until there's room for some more (locked).
+	void evict(unsigned long iSize);
+
+	// Item destroyer (locked).
+	void remove(Item *pItem);
+
+private:
+
+	// Instance variables.
+	QMutex m_mutex;
+
+	QHash<QString, Item *> m_items;
+
+	// Unreferenced items, least recently used first.
+	QList<Item *> m_lru;
+
+	// Items pending to load, first come first served.
+	QList<Item *> m_pending;
+
+	// Background loader thread.
+	qtractorAudioBufferCacheThread *m_pThread;
+
+	unsigned long m_iSize;
+	unsigned long m_iBudget;
+
+	volatile unsigned int m_iSerial;
+
+	bool m_bEnabled;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioBufferStats -- Read-ahead (disk latency) statistics.
+//
+
+class qtractorAudioBufferStats
+{
+public:
+
+	// Read latency statistics record.
+	struct Item
+	{
+		Item() : reads(0), frames(0), nsecs(0), peak(0) {}
+
+		unsigned long      reads;	// block reads.
+		unsigned long      frames;	// total frames read.
+		unsigned long long nsecs;	// total read time.
+		unsigned long long peak;	// peak block read time.
+	};
+
+	// Merge statistics of a just closed file (non RT-safe).
+	void update(const QString& sFilename, const Item& item);
+
+	// Best known statistics for a file, falling back
+	// to the ones of its storage/format source (non RT-safe).
+	bool lookup(const QString& sFilename, Item& item) const;
+
+	// Forget it all.
+	void clear();
+
+	// Average and peak block read latency (in msecs).
+	static float latency(const Item& item);
+	static float peakLatency(const Item& item);
+
+	// Read/decode time relative to real-time (0.0 = idle, 1.0 = full).
+	static float load(const Item& item, unsigned int iSampleRate);
+
+	// Read-ahead (ring-buffer) size estimate (in frames).
+	static unsigned int readAheadSize(
+		const Item& item, unsigned int iSampleRate);
+
+	// Singleton instance accessor.
+	static qtractorAudioBufferStats *getInstance();
+
+protected:
+
+	// Storage/format source key (directory and file suffix).
+	static QString sourceKey(const QString& sFilename);
+
+	// Accumulate statistics, decaying the old peak.
+	static void merge(Item& item, const Item& other);
+
+private:
+
+	// Instance variables.
+	mutable QMutex m_mutex;
+
+	QHash<QString, Item> m_items;
+};
+
+
 //----------------------------------------------------------------------
 // class qtractorAudioBuffer -- Ring buffer/cache template declaration.
 //
@@ -192,6 +370,16 @@ public:
 	// Base sync method.
 	void sync();
 
+	// Prioritized sync methods: partial read-ahead first,
+	// returning whether there's still more to read-ahead...
+	bool syncPartial();
+	// ...and the remaining read-ahead, later.
+	void syncAhead();
+
+	// Sync urgency: frames still available ahead of
+	// the real-time thread, until under/overrun.
+	unsigned int syncUrgency() const;
+
 	// Audio frame process synchronization predicate method.
 	bool inSync(unsigned long iFrameStart, unsigned long iFrameEnd);
 
@@ -220,10 +408,33 @@ public:
 	static void setDefaultResampleType(int iResampleType);
 	static int defaultResampleType();
 
+	// Whether it's being served from the preload cache.
+	bool isCached() const;
+
+	// Read-ahead (disk latency) statistics, as measured so far.
+	const qtractorAudioBufferStats::Item& readStats() const;
+
+	// Current read-ahead size and refill threshold (in frames).
+	unsigned int readAhead() const;
+	unsigned int readThreshold() const;
+
 protected:
 
-	// Read-sync mode methods (playback).
-	void readSync();
+	// Whole-file (preload) cache attachment.
+	qtractorAudioBufferCache::Item *acquireCache();
+	qtractorRingBuffer<float> *cacheRingBuffer(
+		qtractorAudioBufferCache::Item *pItem, unsigned long& iLength) const;
+	bool initCache();
+	bool attachCache();
+	void swapCache();
+	void releaseCache();
+
+	// Base sync executive (optionally limited read-ahead).
+	bool syncFrames(unsigned int iMaxFrames);
+
+	// Read-sync mode methods (playback);
+	// returns whether there's still more to read-ahead.
+	bool readSync(unsigned int iMaxFrames = 0);
 
 	// Write-sync mode method (recording).
 	void writeSync();
@@ -246,6 +457,9 @@ protected:
 	// I/O buffer release.
 	void deleteIOBuffers();
 
+	// Adapt refill threshold to the measured read latency.
+	void updateThreshold();
+
 	// Frame position converters.
 	unsigned long framesIn(unsigned long iFrames) const;
 	unsigned long framesOut(unsigned long iFrames) const;
@@ -261,9 +475,13 @@ private:
 
 	qtractorRingBuffer<float> *m_pRingBuffer;
 
-	unsigned int   m_iThreshold;
+	volatile unsigned int m_iThreshold;
 	unsigned int   m_iBufferSize;
 
+	unsigned int   m_iSampleRate;
+
+	qtractorAudioBufferStats::Item m_readStats;
+
 	volatile unsigned char m_syncFlags;
 
 	volatile unsigned long m_iReadOffset;
@@ -315,6 +533,26 @@ private:
 	bool           m_bWsolaTimeStretch;
 	bool           m_bWsolaQuickSeek;
 
+	// Whole-file (preload) cache stuff.
+	QString        m_sFilename;
+	bool           m_bCacheDecode;
+
+	qtractorAudioBufferCache::Item *m_pCacheItem;
+
+	// Still waiting for the cache item to get ready,
+	// as of the cache serial on the last try.
+	bool           m_bCacheWait;
+	unsigned int   m_iCacheSerial;
+
+	// Late cache attachment (ring-buffer swap) state:
+	// 0=none, 1=cache ring-buffer pending to swap in (RT),
+	// 2=streaming ring-buffer swapped out, pending to free.
+	qtractorAtomic m_cacheSwap;
+	qtractorRingBuffer<float> *m_pCacheRingBuffer;
+	unsigned long  m_iCacheLength;
+
+	friend class qtractorAudioBufferCache;
+
 	// Time-stretch mode global options.
 	static bool    g_bDefaultWsolaTimeStretch;
 	static bool    g_bDefaultWsolaQuickSeek;
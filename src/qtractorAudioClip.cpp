@@ -607,6 +607,11 @@ void qtractorAudioClip::process (
 	if (pAudioBus == nullptr)
 		return;
 
+	// Mix-down into the track's own buffer...
+	float **ppBuffer = track()->audioBuffer();
+	if (ppBuffer == nullptr)
+		return;
+
 	// Get the next bunch from the clip...
 	const unsigned long iClipStart = clipStart();
 	if (iClipStart > iFrameEnd)
@@ -622,7 +627,7 @@ void qtractorAudioClip::process (
 	if (iClipStart > iFrameStart) {
 		if (pBuff->inSync(0, iOffset)) {
 			pBuff->readMix(
-				pAudioBus->buffer(),
+				ppBuffer,
 				iOffset,
 				pAudioBus->channels(),
 				iClipStart - iFrameStart,
@@ -631,7 +636,7 @@ void qtractorAudioClip::process (
 	} else {
 		if (pBuff->inSync(iFrameStart - iClipStart, iOffset)) {
 			pBuff->readMix(
-				pAudioBus->buffer(),
+				ppBuffer,
 				(iFrameEnd < iClipEnd ? iFrameEnd : iClipEnd) - iFrameStart,
 				pAudioBus->channels(),
 				0,
@@ -670,9 +675,9 @@ void qtractorAudioClip::draw (
 	const unsigned long iFrameLength
 		= pSession->frameFromPixel(x0 + clipRect.width()) - iClipOffset;
 
-	// Grab them in...
+	// Grab them in (up to one peak per pixel column)...
 	qtractorAudioPeakFile::Frame *pPeakFrames
-		= m_pPeak->peakFrames(iFrameOffset, iFrameLength, clipRect.width());
+		= m_pPeak->peakFrames(iFrameOffset, iFrameLength, clipRect.width() << 1);
 	if (pPeakFrames == nullptr)
 		return;
 
@@ -681,9 +686,66 @@ void qtractorAudioClip::draw (
 	if (iPeakLength < 1)
 		return;
 
-	// Polygon init...
 	unsigned short k;
 	const unsigned short iChannels = m_pPeak->channels();
+
+	QColor fg(track()->foreground());
+	fg.setAlpha(200);
+
+	// Dense enough? Collapse into per-pixel column spans...
+	const int w = clipRect.width();
+	if (int(iPeakLength << 1) >= w) {
+		const int h1 = (clipRect.height() / iChannels);
+		const int h2 = (h1 >> 1);
+		QVector<QLine> linesMax(w * iChannels);
+		QVector<QLine> linesRms(w * iChannels);
+		const int n2 = int(iPeakLength);
+		int i = 0;
+		for (int c = 0; c < w; ++c) {
+			// Peak range covered by this pixel column...
+			int i2 = ((c + 1) * n2) / w;
+			if (i2 <= i)
+				i2 = i + 1;
+			if (i2 > n2)
+				i2 = n2;
+			const int x = clipRect.x() + c;
+			int y = clipRect.y() + h2;
+			for (k = 0; k < iChannels; ++k) {
+				const qtractorAudioPeakFile::Frame *pFrame
+					= &pPeakFrames[i * iChannels + k];
+				unsigned char vmax = pFrame->max;
+				unsigned char vmin = pFrame->min;
+				unsigned char vrms = pFrame->rms;
+				for (int j = i + 1; j < i2; ++j) {
+					pFrame += iChannels;
+					if (vmax < pFrame->max)
+						vmax = pFrame->max;
+					if (vmin < pFrame->min)
+						vmin = pFrame->min;
+					if (vrms < pFrame->rms)
+						vrms = pFrame->rms;
+				}
+				const FractGain& fractGain = m_pFractGains[k];
+				const int h2gain = (h2 * fractGain.num);
+				const int ymax = (h2gain * vmax) >> fractGain.den;
+				const int ymin = (h2gain * vmin) >> fractGain.den;
+				const int yrms = (h2gain * vrms) >> fractGain.den;
+				linesMax[k * w + c].setLine(x, y - ymax, x, y + ymin);
+				linesRms[k * w + c].setLine(x, y - yrms, x, y + yrms);
+				y += h1;
+			}
+			if (i2 < n2)
+				i = i2;
+		}
+		// Max spans first, then rms ones over...
+		pPainter->setPen(fg.lighter(140));
+		pPainter->drawLines(linesMax);
+		pPainter->setPen(fg);
+		pPainter->drawLines(linesRms);
+		return;
+	}
+
+	// Polygon init...
 	const unsigned int iPolyPoints = (iPeakLength << 1);
 	QPolygon **pPolyMax = new QPolygon* [iChannels];
 	QPolygon **pPolyRms = new QPolygon* [iChannels];
@@ -718,8 +780,6 @@ void qtractorAudioClip::draw (
 	}
 
 	// Close, draw and free the polygons...
-	QColor fg(track()->foreground());
-	fg.setAlpha(200);
 	pPainter->setPen(fg.lighter(140));
 	pPainter->setBrush(fg);
 	for (k = 0; k < iChannels; ++k) {
@@ -761,6 +821,23 @@ QString qtractorAudioClip::toolTip (void) const
 			if (pBuff->isPitchShift())
 				sToolTip += QObject::tr("\n\t(%1 semitones pitch shift)")
 					.arg(12.0f * ::logf(pBuff->pitchShift()) / M_LN2, 0, 'g', 2);
+			qtractorSession *pSession = qtractorSession::getInstance();
+			const unsigned int iSampleRate
+				= (pSession ? pSession->sampleRate() : 0);
+			const qtractorAudioBufferStats::Item& stats = pBuff->readStats();
+			if (pBuff->isCached()) {
+				sToolTip += QObject::tr("\nDisk:\t(preloaded)");
+			}
+			else
+			if (stats.reads > 0 && iSampleRate > 0) {
+				sToolTip += QObject::tr("\nDisk:\t%1 ms (%2 ms peak), %3% load")
+					.arg(qtractorAudioBufferStats::latency(stats), 0, 'f', 2)
+					.arg(qtractorAudioBufferStats::peakLatency(stats), 0, 'f', 2)
+					.arg(100.0f * qtractorAudioBufferStats::load(
+						stats, iSampleRate), 0, 'f', 1);
+				sToolTip += QObject::tr("\n\t%1 s read-ahead")
+					.arg(float(pBuff->readAhead()) / float(iSampleRate), 0, 'f', 1);
+			}
 		}
 	}
 
@@ -0,0 +1,213 @@
+// qtractorAudioDelay.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioDelay.h"
+
+#include <QThread>
+
+#include <cstring>
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioDelay -- Multi-channel audio delay line.
+//
+
+// Constructor.
+qtractorAudioDelay::qtractorAudioDelay (void)
+	: m_iChannels(0), m_iDelay(0), m_pState(nullptr)
+{
+	ATOMIC_SET(&m_readers, 0);
+}
+
+
+// Destructor.
+qtractorAudioDelay::~qtractorAudioDelay (void)
+{
+	deleteState(m_pState.fetchAndStoreOrdered(nullptr));
+}
+
+
+// Delay length (in frames) settler (non RT-safe).
+bool qtractorAudioDelay::setDelay (
+	unsigned short iChannels, unsigned long iDelay )
+{
+	if (iChannels == 0)
+		iDelay = 0;
+
+	if (iChannels == m_iChannels && iDelay == m_iDelay)
+		return false;
+
+	State *pState = createState(iChannels, iDelay);
+
+	// Same ring-buffer size will do, carry on its contents
+	// (a snapshot, as the old state may be still running)
+	// so that only the read position changes...
+	State *pOldState = m_pState.loadAcquire();
+	if (pState && pOldState && pState->channels == pOldState->channels
+		&& pState->size == pOldState->size) {
+		for (unsigned short i = 0; i < pState->channels; ++i) {
+			::memcpy(pState->buffers[i], pOldState->buffers[i],
+				pState->size * sizeof(float));
+		}
+		pState->index = pOldState->index;
+	}
+
+	m_iChannels = iChannels;
+	m_iDelay = iDelay;
+
+	swapState(pState);
+
+	return true;
+}
+
+
+// Clear delay line contents (non RT-safe).
+void qtractorAudioDelay::reset (void)
+{
+	swapState(createState(m_iChannels, m_iDelay));
+}
+
+
+// In-place delay processing (RT-safe).
+void qtractorAudioDelay::process ( float **ppBuffer,
+	unsigned int nframes, unsigned short iChannels )
+{
+	ATOMIC_INC(&m_readers);
+
+	State *pState = m_pState.loadAcquire();
+	if (pState == nullptr) {
+		ATOMIC_DEC(&m_readers);
+		return;
+	}
+
+	if (iChannels > pState->channels)
+		iChannels = pState->channels;
+
+	const unsigned long iMask = pState->mask;
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		float *pFrames = ppBuffer[i];
+		float *pDelay  = pState->buffers[i];
+		unsigned long w = pState->index;
+		unsigned long r = (w - pState->delay) & iMask;
+		for (unsigned int n = 0; n < nframes; ++n) {
+			pDelay[w] = pFrames[n];
+			pFrames[n] = pDelay[r];
+			w = (w + 1) & iMask;
+			r = (r + 1) & iMask;
+		}
+	}
+
+	pState->index = (pState->index + nframes) & iMask;
+
+	ATOMIC_DEC(&m_readers);
+}
+
+
+// Delayed gain-mix processing (RT-safe).
+void qtractorAudioDelay::process_add ( float **ppOBuffer, float **ppIBuffer,
+	unsigned int nframes, unsigned short iChannels, float fGain )
+{
+	ATOMIC_INC(&m_readers);
+
+	State *pState = m_pState.loadAcquire();
+	if (pState == nullptr) {
+		ATOMIC_DEC(&m_readers);
+		return;
+	}
+
+	if (iChannels > pState->channels)
+		iChannels = pState->channels;
+
+	const unsigned long iMask = pState->mask;
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		float *pOFrames = ppOBuffer[i];
+		float *pIFrames = ppIBuffer[i];
+		float *pDelay   = pState->buffers[i];
+		unsigned long w = pState->index;
+		unsigned long r = (w - pState->delay) & iMask;
+		for (unsigned int n = 0; n < nframes; ++n) {
+			pDelay[w] = pIFrames[n];
+			pOFrames[n] += fGain * pDelay[r];
+			w = (w + 1) & iMask;
+			r = (r + 1) & iMask;
+		}
+	}
+
+	pState->index = (pState->index + nframes) & iMask;
+
+	ATOMIC_DEC(&m_readers);
+}
+
+
+// State (de)allocation.
+qtractorAudioDelay::State *qtractorAudioDelay::createState (
+	unsigned short iChannels, unsigned long iDelay )
+{
+	if (iChannels == 0 || iDelay == 0)
+		return nullptr;
+
+	// Ring-buffer must be strictly larger than the delay...
+	unsigned long iSize = 4096;
+	while (iSize <= iDelay)
+		iSize <<= 1;
+
+	State *pState = new State;
+	pState->channels = iChannels;
+	pState->delay = iDelay;
+	pState->size  = iSize;
+	pState->mask  = iSize - 1;
+	pState->index = 0;
+	pState->buffers = new float * [iChannels];
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		pState->buffers[i] = new float [iSize];
+		::memset(pState->buffers[i], 0, iSize * sizeof(float));
+	}
+
+	return pState;
+}
+
+
+void qtractorAudioDelay::deleteState ( State *pState )
+{
+	if (pState) {
+		for (unsigned short i = 0; i < pState->channels; ++i)
+			delete [] pState->buffers[i];
+		delete [] pState->buffers;
+		delete pState;
+	}
+}
+
+
+// Swap in a new state; the RT side never waits, it just keeps
+// running on the old state until the very next call.
+void qtractorAudioDelay::swapState ( State *pState )
+{
+	State *pOldState = m_pState.fetchAndStoreOrdered(pState);
+
+	while (ATOMIC_GET(&m_readers) > 0)
+		QThread::yieldCurrentThread();
+
+	deleteState(pOldState);
+}
+
+
+// end of qtractorAudioDelay.cpp
@@ -0,0 +1,107 @@
+// qtractorAudioDelay.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioDelay_h
+#define __qtractorAudioDelay_h
+
+#include "qtractorAtomic.h"
+
+#include <QAtomicPointer>
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioDelay -- Multi-channel audio delay line.
+//
+
+class qtractorAudioDelay
+{
+public:
+
+	// Constructor.
+	qtractorAudioDelay();
+
+	// Destructor.
+	~qtractorAudioDelay();
+
+	// Delay length (in frames) settler (non RT-safe, but may be
+	// called while processing: a whole new state gets swapped in);
+	// returns whether anything has actually changed.
+	bool setDelay(unsigned short iChannels, unsigned long iDelay);
+
+	// Delay length (in frames) accessors.
+	unsigned long delay() const
+		{ return m_iDelay; }
+	unsigned short channels() const
+		{ return m_iChannels; }
+
+	// Clear delay line contents (non RT-safe).
+	void reset();
+
+	// In-place delay processing (RT-safe).
+	void process(float **ppBuffer,
+		unsigned int nframes, unsigned short iChannels);
+
+	// Delayed gain-mix processing (RT-safe).
+	void process_add(float **ppOBuffer, float **ppIBuffer,
+		unsigned int nframes, unsigned short iChannels, float fGain);
+
+protected:
+
+	// Delay line state (double-buffered).
+	struct State
+	{
+		unsigned short channels;
+		unsigned long  delay;
+
+		// Ring-buffer (power of two) size and write index.
+		unsigned long  size;
+		unsigned long  mask;
+		unsigned long  index;
+
+		float **buffers;
+	};
+
+	// State (de)allocation.
+	static State *createState(unsigned short iChannels, unsigned long iDelay);
+	static void deleteState(State *pState);
+
+	// Swap in a new state, wait until the old one is out of
+	// use and get rid of it (non RT-safe).
+	void swapState(State *pState);
+
+private:
+
+	// Instance variables (settler side).
+	unsigned short m_iChannels;
+	unsigned long  m_iDelay;
+
+	// Current processing state.
+	QAtomicPointer<State> m_pState;
+
+	// Number of processing (in-use) calls.
+	qtractorAtomic m_readers;
+};
+
+
+#endif  // __qtractorAudioDelay_h
+
+
+// end of qtractorAudioDelay.h
@@ -23,6 +23,9 @@
 #include "qtractorAudioEngine.h"
 #include "qtractorAudioMonitor.h"
 #include "qtractorAudioBuffer.h"
+#include "qtractorAudioGraph.h"
+#include "qtractorAudioKernel.h"
+#include "qtractorAudioExport.h"
 
 #include "qtractorSession.h"
 
@@ -30,9 +33,12 @@
 
 #include "qtractorMonitor.h"
 #include "qtractorSessionCursor.h"
+#include "qtractorSessionSnapshot.h"
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiManager.h"
+#include "qtractorMidiJackPort.h"
 #include "qtractorPlugin.h"
+#include "qtractorInsertPlugin.h"
 #include "qtractorClip.h"
 
 #include "qtractorMainForm.h"
@@ -70,200 +76,6 @@
 #define BLOCK_SIZE  64
 
 
-#if defined(__SSE__)
-
-#include <xmmintrin.h>
-
-// SSE detection.
-static inline bool sse_enabled (void)
-{
-#if defined(__GNUC__)
-	unsigned int eax, ebx, ecx, edx;
-#if defined(__x86_64__) || (!defined(PIC) && !defined(__PIC__))
-	__asm__ __volatile__ (
-		"cpuid\n\t" \
-		: "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#else
-	__asm__ __volatile__ (
-		"push %%ebx\n\t" \
-		"cpuid\n\t" \
-		"movl %%ebx,%1\n\t" \
-		"pop %%ebx\n\t" \
-		: "=a" (eax), "=r" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#endif
-	return (edx & (1 << 25));
-#else
-	return false;
-#endif
-}
-
-
-// SSE enabled mix-down processor version.
-static inline void sse_buffer_add (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iBuffers, unsigned short iChannels, unsigned int iOffset )
-{
-	unsigned short j = 0;
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[j] + iOffset;
-		float *pFrames = ppFrames[i] + iOffset;
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes)
-			*pBuffer++ += *pFrames++;
-		for (; nframes >= 4; nframes -= 4) {
-			_mm_store_ps(pBuffer,
-				_mm_add_ps(
-					_mm_loadu_ps(pBuffer),
-					_mm_loadu_ps(pFrames)));
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pBuffer++ += *pFrames++;
-		if (++j >= iBuffers)
-			j = 0;
-	}
-}
-
-#endif // __SSE__
-
-
-#if defined(__ARM_NEON__)
-
-#include "arm_neon.h"
-
-// NEON enabled mix-down processor version.
-static inline void neon_buffer_add (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iBuffers, unsigned short iChannels, unsigned int iOffset )
-{
-	unsigned short j = 0;
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[j] + iOffset;
-		float *pFrames = ppFrames[i] + iOffset;
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes)
-			*pBuffer++ += *pFrames++;
-		for (; nframes >= 4; nframes -= 4) {
-			vst1q_f32(pBuffer,
-				vaddq_f32(
-					vld1q_f32(pBuffer),
-					vld1q_f32(pFrames)));
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pBuffer++ += *pFrames++;
-		if (++j >= iBuffers)
-			j = 0;
-	}
-}
-
-#endif // __ARM_NEON__
-
-
-// Standard mix-down processor version.
-static inline void std_buffer_add (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iBuffers, unsigned short iChannels, unsigned int iOffset )
-{
-	unsigned short j = 0;
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[j] + iOffset;
-		float *pFrames = ppFrames[i] + iOffset;
-		for (unsigned int n = 0; n < iFrames; ++n)
-			*pBuffer++ += *pFrames++;
-		if (++j >= iBuffers)
-			j = 0;
-	}
-}
-
-
-//----------------------------------------------------------------------
-// qtractorAudioExportBuffer -- name tells all: audio export buffer.
-//
-
-class qtractorAudioExportBuffer
-{
-public:
-
-	// Constructor
-	qtractorAudioExportBuffer(
-		unsigned short iChannels, unsigned int iBufferSize )
-	{
-		m_iChannels = iChannels;
-		m_iBufferSize = iBufferSize;
-
-		m_ppBuffer = new float * [m_iChannels];
-
-		for (unsigned short i = 0; i < m_iChannels; ++i)
-			m_ppBuffer[i] = new float [iBufferSize];
-
-	#if defined(__SSE__)
-		if (sse_enabled())
-			m_pfnBufferAdd = sse_buffer_add;
-		else
-	#endif
-	#if defined(__ARM_NEON__)
-		m_pfnBufferAdd = neon_buffer_add;
-		if (false)
-	#endif
-			m_pfnBufferAdd = std_buffer_add;
-	}
-
-	// Destructor.
-	~qtractorAudioExportBuffer()
-	{
-		for (unsigned short i = 0; i < m_iChannels; ++i)
-			delete [] m_ppBuffer[i];
-
-		delete [] m_ppBuffer;
-	}
-
-	// Mix-down buffer accessors.
-	unsigned short channels() const
-		{ return m_iChannels; }
-
-	unsigned int bufferSize() const
-		{ return m_iBufferSize; }
-
-	float **buffer() const
-		{ return m_ppBuffer; }
-
-	// Prepare mix-down buffer.
-	void process_prepare(unsigned int nframes)
-	{
-		for (unsigned short i = 0; i < m_iChannels; ++i)
-			::memset(m_ppBuffer[i], 0, nframes * sizeof(float));
-	}
-
-	// Incremental mix-down buffer.
-	void process_add (qtractorAudioBus *pAudioBus,
-		unsigned int nframes, unsigned int offset = 0)
-	{
-		(*m_pfnBufferAdd)(m_ppBuffer, pAudioBus->out(),
-			nframes, m_iChannels, pAudioBus->channels(), offset);
-	}
-
-private:
-
-	unsigned short m_iChannels;
-	unsigned int m_iBufferSize;
-
-	// Mix-down buffer.
-	float **m_ppBuffer;
-
-	// Mix-down buffer processor.
-	void (*m_pfnBufferAdd)(float **, float **, unsigned int,
-		unsigned short, unsigned short, unsigned int);
-};
-
-
 //----------------------------------------------------------------------
 // qtractorAudioEngine_process -- JACK client process callback.
 //
@@ -516,16 +328,20 @@ qtractorAudioEngine::qtractorAudioEngine ( qtractorSession *pSession )
 	// Common audio buffer sync thread.
 	m_pSyncThread = nullptr;
 
+	// Parallel audio track process graph.
+	m_pAudioGraph = nullptr;
+
 	// Audio-export (in)active state.
 	m_bExporting   = false;
-	m_pExportFile  = nullptr;
-	m_pExportBuses = nullptr;
-	m_pExportBuffer = nullptr;
 	m_iExportOffset = 0;
 	m_iExportStart = 0;
 	m_iExportEnd   = 0;
 	m_bExportDone  = true;
 
+	// Audio-export offline mode and (in)active state.
+	m_bExportOffline = true;
+	m_bOffline = false;
+
 	// Audio metronome stuff.
 	m_bMetronome        = false;
 	m_bMetroBus         = false;
@@ -579,6 +395,8 @@ void qtractorAudioEngine::notifyShutEvent (void)
 
 void qtractorAudioEngine::notifyXrunEvent (void)
 {
+	qtractorDspLoad::getInstance()->notifyXrun();
+
 	m_proxy.notifyXrunEvent();
 }
 
@@ -727,6 +545,10 @@ bool qtractorAudioEngine::init (void)
 	m_pSyncThread = new qtractorAudioBufferThread();
 	m_pSyncThread->start(QThread::HighPriority);
 
+	// Our parallel audio track process graph and workers...
+	m_pAudioGraph = new qtractorAudioGraph(this,
+		qtractorAudioGraph::idealWorkers(), pSession->tracks().count());
+
 	return true;
 }
 
@@ -937,20 +759,9 @@ void qtractorAudioEngine::clean (void)
 	}
 
 	// Audio-export stilll around? weird...
-	if (m_pExportBuffer) {
-		delete m_pExportBuffer;
-		m_pExportBuffer = nullptr;
-	}
-
-	if (m_pExportBuses) {
-		delete m_pExportBuses;
-		m_pExportBuses = nullptr;
-	}
-
-	if (m_pExportFile) {
-		delete m_pExportFile;
-		m_pExportFile = nullptr;
-	}
+	qDeleteAll(m_exportWriters);
+	m_exportWriters.clear();
+	m_exportBuses.clear();
 
 	// Close the JACK client, finally.
 	if (m_pJackClient) {
@@ -958,6 +769,12 @@ void qtractorAudioEngine::clean (void)
 		m_pJackClient = nullptr;
 	}
 
+	// Terminate parallel audio track process graph workers...
+	if (m_pAudioGraph) {
+		delete m_pAudioGraph;
+		m_pAudioGraph = nullptr;
+	}
+
 	// Null sample-rate/period.
 	// m_iSampleRate = 0;
 	// m_iBufferSize = 0;
@@ -972,13 +789,27 @@ bool qtractorAudioEngine::isProcessing (void)
 	return g_bProcessing;
 }
 
+void qtractorAudioEngine::setProcessing ( bool bProcessing )
+{
+	g_bProcessing = bProcessing;
+}
+
+
+// Parallel audio track process graph accessor.
+qtractorAudioGraph *qtractorAudioEngine::audioGraph (void) const
+{
+	return m_pAudioGraph;
+}
+
 
 // Process cycle executive.
 int qtractorAudioEngine::process ( unsigned int nframes )
 {
 	// Don't bother with a thing, if not running.
-	if (!isActivated())
+	if (!isActivated()) {
+		qtractorMidiJackPort::clearAll(nframes);
 		return 0;
+	}
 
 	// Reset buffer offset.
 	m_iBufferOffset = 0;
@@ -986,27 +817,42 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 	// Are we actually freewheeling for export?...
 	// notice that freewheeling has no RT requirements.
 	if (m_bFreewheel) {
-		process_export(nframes);
+		if (!m_bOffline)
+			process_export(nframes);
+		else
+			process_silence(nframes);
+		qtractorMidiJackPort::clearAll(nframes);
 		return 0;
 	}
 
 	// Must have a valid session...
 	qtractorSession *pSession = session();
-	if (pSession == nullptr)
+	if (pSession == nullptr) {
+		qtractorMidiJackPort::clearAll(nframes);
 		return 0;
+	}
 
 	// Make sure we have an actual session cursor...
 	qtractorSessionCursor *pAudioCursor = sessionCursor();
-	if (pAudioCursor == nullptr)
+	if (pAudioCursor == nullptr) {
+		qtractorMidiJackPort::clearAll(nframes);
 		return 0;
+	}
 
 	// Session RT-safeness lock...
-	if (!pSession->acquire())
+	if (!pSession->acquire()) {
+		// JACK MIDI output buses would replay last cycle's...
+		qtractorMidiJackPort::clearAll(nframes);
 		return 0;
+	}
 
 	// We're in the audio/real-time thread...
 	g_bProcessing = true;
 
+	// Instrumentation cycle start...
+	qtractorDspLoad *pDspLoad = qtractorDspLoad::getInstance();
+	pDspLoad->cycle_start();
+
 	// Track whether audio output buses
 	// buses needs monitoring while idle...
 	int iOutputBus = 0;
@@ -1071,9 +917,13 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 				++iOutputBus;
 			pMidiManager = pMidiManager->next();
 		}
-		// Do the idle processing...
-		for (qtractorTrack *pTrack = pSession->tracks().first();
-				pTrack; pTrack = pTrack->next()) {
+		// Do the idle processing (on current render snapshot)...
+		qtractorSessionEpoch *pEpoch = pSession->epoch();
+		const unsigned int iEpoch = pEpoch->enter();
+		qtractorSessionSnapshot *pSnapshot = pEpoch->snapshot();
+		const unsigned int iTracks = (pSnapshot ? pSnapshot->tracks() : 0);
+		for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+			qtractorTrack *pTrack = pSnapshot->track(iTrack);
 			// Audio-buffers needs some preparation...
 			if (pTrack->trackType() == qtractorTrack::Audio) {
 				qtractorAudioBus *pInputBus
@@ -1096,15 +946,20 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 					qtractorAudioBus *pOutputBus
 						= static_cast<qtractorAudioBus *> (pTrack->outputBus());
 					if (pOutputBus) {
+						const unsigned long long t0 = qtractorDspLoad::start();
 						pOutputBus->buffer_prepare(nframes, pInputBus);
 						pPluginList->process(pOutputBus->buffer(), nframes);
+						// Aligned with the aux-send paths...
+						pTrack->processLatencyDelay(pOutputBus->buffer(), nframes);
 						pAudioMonitor->process(pOutputBus->buffer(), nframes);
 						pOutputBus->buffer_commit(nframes);
+						pTrack->dspProbe().add(t0);
 						++iOutputBus;
 					}
 				}
 			}
 		}
+		pEpoch->leave(iEpoch);
 		// Process audition/pre-listening bus...
 		if (m_bPlayerBus && m_pPlayerBus)
 			m_pPlayerBus->process_commit(nframes);
@@ -1114,8 +969,11 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 			if (pAudioBus && (iOutputBus > 0 || pAudioBus->isMonitor()))
 				pAudioBus->process_commit(nframes);
 		}
+		// JACK MIDI output buses...
+		process_midi(pSession, pAudioCursor->frameTime(), nframes);
 		// Done as idle...
 		pAudioCursor->process(nframes);
+		pDspLoad->cycle_end(pSession, nframes, sampleRate());
 		g_bProcessing = false;
 		pSession->release();
 		return 0;
@@ -1209,6 +1067,9 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 			pAudioBus->process_commit(nframes);
 	}
 
+	// JACK MIDI output buses...
+	process_midi(pSession, iFrameTimeStart, nframes);
+
 	// Regular range recording (if and when applicable)...
 	if (pSession->isRecording())
 		pSession->process_record(iFrameStart, iFrameEnd);
@@ -1236,6 +1097,9 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 	// (sure we have a MIDI engine, no?)
 	pSession->midiEngine()->sync();
 
+	// Instrumentation cycle end...
+	pDspLoad->cycle_end(pSession, nframes, sampleRate());
+
 	// Release RT-safeness lock...
 	g_bProcessing = false;
 	pSession->release();
@@ -1245,26 +1109,45 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 }
 
 
-// Freewheeling process cycle executive (needed for export).
-void qtractorAudioEngine::process_export ( unsigned int nframes )
+// JACK MIDI output buses process cycle executive.
+void qtractorAudioEngine::process_midi ( qtractorSession *pSession,
+	unsigned long iFrameTimeStart, unsigned int nframes )
 {
-	if (m_bExportDone)
-		return;
-	if (m_pExportBuses  == nullptr ||
-		m_pExportFile   == nullptr ||
-		m_pExportBuffer == nullptr)
+	qtractorMidiEngine *pMidiEngine = pSession->midiEngine();
+	if (pMidiEngine == nullptr)
 		return;
 
-	qtractorSession *pSession = session();
-	if (pSession == nullptr)
-		return;
+	const unsigned long iFrameTimeEnd = iFrameTimeStart + nframes;
 
-	qtractorSessionCursor *pAudioCursor = sessionCursor();
-	if (pAudioCursor == nullptr)
+	for (qtractorBus *pBus = pMidiEngine->buses().first();
+			pBus; pBus = pBus->next()) {
+		qtractorMidiBus *pMidiBus = static_cast<qtractorMidiBus *> (pBus);
+		qtractorMidiJackPort *pJackPort = pMidiBus->jackPort();
+		if (pJackPort)
+			pJackPort->process(iFrameTimeStart, iFrameTimeEnd);
+	}
+}
+
+
+// Silent process cycle executive (while exporting offline).
+void qtractorAudioEngine::process_silence ( unsigned int nframes )
+{
+	qtractorBus *pBus;
+	for (pBus = buses().first(); pBus; pBus = pBus->next())
+		static_cast<qtractorAudioBus *> (pBus)->process_silence(nframes);
+	for (pBus = busesEx().first(); pBus; pBus = pBus->next())
+		static_cast<qtractorAudioBus *> (pBus)->process_silence(nframes);
+}
+
+
+// Freewheeling process cycle executive (needed for export).
+void qtractorAudioEngine::process_export ( unsigned int nframes )
+{
+	if (m_bExportDone || m_exportWriters.isEmpty())
 		return;
 
 	// Make sure we're in a valid state...
-	QListIterator<qtractorAudioBus *> iter(*m_pExportBuses);
+	QListIterator<qtractorAudioBus *> iter(m_exportBuses);
 	// Prepare the output buses first...
 	while (iter.hasNext())
 		iter.next()->process_prepare(nframes);
@@ -1277,6 +1160,54 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 			pAudioBusEx->process_prepare(nframes);
 	}
 
+	process_export_cycle(nframes);
+}
+
+
+// Offline process cycle executive (export thread).
+bool qtractorAudioEngine::process_offline ( unsigned int nframes )
+{
+	if (!m_bExporting || m_bExportDone || m_exportWriters.isEmpty())
+		return false;
+
+	// Reset buffer offset.
+	m_iBufferOffset = 0;
+
+	// Prepare all audio buses, as there are no JACK ports here...
+	qtractorBus *pBus;
+	for (pBus = buses().first(); pBus; pBus = pBus->next()) {
+		qtractorAudioBus *pAudioBus
+			= static_cast<qtractorAudioBus *> (pBus);
+		if (pAudioBus)
+			pAudioBus->process_prepare_offline(nframes);
+	}
+	// Prepare all extra audio buses...
+	for (pBus = busesEx().first(); pBus; pBus = pBus->next()) {
+		qtractorAudioBus *pAudioBusEx
+			= static_cast<qtractorAudioBus *> (pBus);
+		if (pAudioBusEx)
+			pAudioBusEx->process_prepare_offline(nframes);
+	}
+
+	process_export_cycle(nframes);
+
+	return !m_bExportDone;
+}
+
+
+// Common export process cycle executive.
+void qtractorAudioEngine::process_export_cycle ( unsigned int nframes )
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorSessionCursor *pAudioCursor = sessionCursor();
+	if (pAudioCursor == nullptr)
+		return;
+
+	qtractorSessionEpoch *pEpoch = pSession->epoch();
+
 	// This the legal process cycle frame range...
 	const unsigned long iFrameStart = pAudioCursor->frame();
 	const unsigned long iFrameEnd   = iFrameStart + nframes;
@@ -1287,8 +1218,9 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 
 	// Write output bus buffers to export audio file...
 	if (iFrameStart < m_iExportEnd) {
-		// Prepare mix-down buffer...
-		m_pExportBuffer->process_prepare(nframes);
+		// Instrumentation cycle start (no real-time budget)...
+		qtractorDspLoad *pDspLoad = qtractorDspLoad::getInstance();
+		pDspLoad->cycle_start();
 		for (unsigned long iFrameStart2 = iFrameStart;
 				iFrameStart2 < iFrameEnd; iFrameStart2 += nframes2) {
 			// Update time(base) info...
@@ -1305,13 +1237,22 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 				pMidiManager = pMidiManager->next();
 			}
 			// Perform all tracks processing...
-			int iTrack = 0;
-			for (qtractorTrack *pTrack = pSession->tracks().first();
-					pTrack; pTrack = pTrack->next()) {
-				pTrack->process_export(pAudioCursor->clip(iTrack),
+			const unsigned int iEpoch = pEpoch->enter();
+			qtractorSessionSnapshot *pSnapshot = pEpoch->snapshot();
+			pAudioCursor->resync(pSnapshot);
+			if (m_pAudioGraph) {
+				m_pAudioGraph->process_export(pSnapshot, pAudioCursor,
 					iFrameStart2, iFrameEnd2);
-				++iTrack;
 			}
+			else
+			if (pSnapshot) {
+				const unsigned int iTracks = pSnapshot->tracks();
+				for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+					pSnapshot->track(iTrack)->process_export(
+						pAudioCursor->clips(iTrack), iFrameStart2, iFrameEnd2);
+				}
+			}
+			pEpoch->leave(iEpoch);
 			m_iBufferOffset += (iFrameEnd2 - iFrameStart2);
 		}
 		// Prepare advance for next cycle...
@@ -1319,15 +1260,16 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 		// Check end-of-export...
 		if (iFrameEnd > m_iExportEnd)
 			nframes -= (iFrameEnd - m_iExportEnd);
-		// Commit the output buses...
-		iter.toFront();
-		while (iter.hasNext()) {
-			qtractorAudioBus *pExportBus = iter.next();
-			pExportBus->process_commit(nframes);
-			m_pExportBuffer->process_add(pExportBus, nframes);
-		}
-		// Write to export file...
-		m_pExportFile->write(m_pExportBuffer->buffer(), nframes);
+		// Commit the output buses (once each)...
+		QListIterator<qtractorAudioBus *> iter(m_exportBuses);
+		while (iter.hasNext())
+			iter.next()->process_commit(nframes);
+		// Mix-down and queue to each export file...
+		QListIterator<qtractorAudioExportWriter *> writer_iter(m_exportWriters);
+		while (writer_iter.hasNext())
+			writer_iter.next()->process_add(nframes);
+		// Instrumentation cycle end...
+		pDspLoad->cycle_end(pSession, nframes, 0);
 		// HACK! Freewheeling observers update (non RT safe!)...
 		qtractorSubject::flushQueue(false);
 	} else {
@@ -1632,15 +1574,46 @@ unsigned long qtractorAudioEngine::exportLength (void) const
 
 
 
+// Audio-export offline (non-freewheeling) mode.
+void qtractorAudioEngine::setExportOffline ( bool bExportOffline )
+{
+	m_bExportOffline = bExportOffline;
+}
+
+bool qtractorAudioEngine::isExportOffline (void) const
+{
+	return m_bExportOffline;
+}
+
+
 // Audio-export method.
 bool qtractorAudioEngine::fileExport (
 	const QString& sExportPath, const QList<qtractorAudioBus *>& exportBuses,
 	unsigned long iExportStart, unsigned long iExportEnd, int iExportFormat )
+{
+	ExportSet exportSet;
+	exportSet.sExportPath = sExportPath;
+	exportSet.exportBuses = exportBuses;
+	exportSet.iExportFormat = iExportFormat;
+
+	QList<ExportSet> exportSets;
+	exportSets.append(exportSet);
+
+	return fileExport(exportSets, iExportStart, iExportEnd);
+}
+
+
+// Audio-export method (many bus sets, single pass).
+bool qtractorAudioEngine::fileExport ( const QList<ExportSet>& exportSets,
+	unsigned long iExportStart, unsigned long iExportEnd )
 {
 	// No simultaneous or foul exports...
 	if (!isActivated() || isPlaying() || isExporting())
 		return false;
 
+	if (exportSets.isEmpty())
+		return false;
+
 	// Make sure we have an actual session cursor...
 	qtractorSession *pSession = session();
 	if (pSession == nullptr)
@@ -1671,18 +1644,54 @@ bool qtractorAudioEngine::fileExport (
 	if (pExportBus == nullptr)
 		return false;
 
-	// Get proper file type class...
+	// Audio inserts need a live JACK round-trip,
+	// so these may only be exported while freewheeling...
+	bool bOffline = m_bExportOffline;
+	for (qtractorBus *pBusEx = busesEx().first();
+			pBusEx && bOffline; pBusEx = pBusEx->next()) {
+		bOffline = (pBusEx == m_pMetroBus || pBusEx == m_pPlayerBus);
+	}
+
 	const unsigned int iChannels = pExportBus->channels();
-	qtractorAudioFile *pExportFile
-		= qtractorAudioFileFactory::createAudioFile(sExportPath,
-			iChannels, sampleRate(), bufferSizeEx(), iExportFormat);
-	// No file ready for export?
-	if (pExportFile == nullptr)
-		return false;
-	// Go open it, for writing of course...
-	if (!pExportFile->open(sExportPath, qtractorAudioFile::Write)) {
-		delete pExportFile;
-		return false;
+	const unsigned int iBufferSizeEx = bufferSizeEx();
+
+	// Get proper file type class, one for each bus set...
+	QListIterator<ExportSet> set_iter(exportSets);
+	while (set_iter.hasNext()) {
+		const ExportSet& exportSet = set_iter.next();
+		qtractorAudioFile *pExportFile
+			= qtractorAudioFileFactory::createAudioFile(exportSet.sExportPath,
+				iChannels, sampleRate(), iBufferSizeEx, exportSet.iExportFormat);
+		// Go open it, for writing of course...
+		if (pExportFile == nullptr
+			|| !pExportFile->open(exportSet.sExportPath, qtractorAudioFile::Write)) {
+			if (pExportFile)
+				delete pExportFile;
+			qDeleteAll(m_exportWriters);
+			m_exportWriters.clear();
+			m_exportBuses.clear();
+			return false;
+		}
+		// Encoding is queued in larger blocks...
+		m_exportWriters.append(
+			new qtractorAudioExportWriter(pExportFile,
+				exportSet.exportBuses, exportSet.exportTracks,
+				iChannels, (iBufferSizeEx << 4)));
+		// Output buses are to be committed once only...
+		QListIterator<qtractorAudioBus *> bus_iter(exportSet.exportBuses);
+		while (bus_iter.hasNext()) {
+			qtractorAudioBus *pAudioBus = bus_iter.next();
+			if (!m_exportBuses.contains(pAudioBus))
+				m_exportBuses.append(pAudioBus);
+		}
+		// Exported tracks' output buses must be prepared too...
+		QListIterator<qtractorTrack *> track_iter(exportSet.exportTracks);
+		while (track_iter.hasNext()) {
+			qtractorAudioBus *pAudioBus = static_cast<qtractorAudioBus *> (
+				track_iter.next()->outputBus());
+			if (pAudioBus && !m_exportBuses.contains(pAudioBus))
+				m_exportBuses.append(pAudioBus);
+		}
 	}
 
 	// We'll be busy...
@@ -1693,13 +1702,15 @@ bool qtractorAudioEngine::fileExport (
 
 	// Start with fixing the export range...
 	m_bExporting   = true;
-	m_pExportBuses = new QList<qtractorAudioBus *> (exportBuses);
-	m_pExportFile  = pExportFile;
-	m_pExportBuffer = new qtractorAudioExportBuffer(iChannels, bufferSizeEx());
 	m_iExportStart = iExportStart;
 	m_iExportEnd   = iExportEnd;
 	m_bExportDone  = false;
 
+	// Start the encoders...
+	QListIterator<qtractorAudioExportWriter *> writer_iter(m_exportWriters);
+	while (writer_iter.hasNext())
+		writer_iter.next()->start();
+
 	// Prepare and show some progress...
 	pProgressBar->setRange(iExportStart, iExportEnd);
 	pProgressBar->reset();
@@ -1711,7 +1722,7 @@ bool qtractorAudioEngine::fileExport (
 	const unsigned long iLoopEnd   = pSession->loopEnd();
 
 	QHash<qtractorAudioBus *, bool> exportMonitors;
-	QListIterator<qtractorAudioBus *> bus_iter(exportBuses);
+	QListIterator<qtractorAudioBus *> bus_iter(m_exportBuses);
 	while (bus_iter.hasNext()) {
 		qtractorAudioBus *pAudioBus = bus_iter.next();
 		exportMonitors.insert(pAudioBus, pAudioBus->isMonitor());
@@ -1722,16 +1733,14 @@ bool qtractorAudioEngine::fileExport (
 	// maximum track latency is acquainted as offset...
 	m_iExportOffset = 0;
 
+	resetLatency();
+
 	for (qtractorTrack *pTrack = pSession->tracks().first();
 			pTrack; pTrack = pTrack->next()) {
 		if (!pTrack->isMute() && (!pSession->soloTracks() || pTrack->isSolo())) {
-			qtractorPluginList *pPluginList = pTrack->pluginList();
-			if (pPluginList) {
-				pPluginList->resetLatency();
-				const unsigned long iLatency = pPluginList->latency();
-				if (m_iExportOffset < iLatency)
-					m_iExportOffset = iLatency;
-			}
+			const unsigned long iLatency = pTrack->latencyComp();
+			if (m_iExportOffset < iLatency)
+				m_iExportOffset = iLatency;
 		}
 	}
 
@@ -1745,8 +1754,25 @@ bool qtractorAudioEngine::fileExport (
 	// Special initialization.
 	m_iBufferOffset = 0;
 
-	// Start export (freewheeling)...
-	jack_set_freewheel(m_pJackClient, 1);
+	qtractorBus *pBus;
+	qtractorAudioExportThread *pExportThread = nullptr;
+
+	if (bOffline) {
+		// Start export (offline), out of any JACK cycle...
+		pSession->lock();
+		for (pBus = buses().first(); pBus; pBus = pBus->next())
+			static_cast<qtractorAudioBus *> (pBus)->setOffline(true);
+		for (pBus = busesEx().first(); pBus; pBus = pBus->next())
+			static_cast<qtractorAudioBus *> (pBus)->setOffline(true);
+		m_bOffline = true;
+		m_bFreewheel = true;
+		pSession->unlock();
+		pExportThread = new qtractorAudioExportThread(this, iBufferSizeEx);
+		pExportThread->start();
+	} else {
+		// Start export (freewheeling)...
+		jack_set_freewheel(m_pJackClient, 1);
+	}
 
 	// Wait for the export to end.
 	struct timespec ts;
@@ -1764,11 +1790,27 @@ bool qtractorAudioEngine::fileExport (
 		pProgressBar->setValue(pSession->playHead());
 	}
 
-	// Stop export (freewheeling)...
-	jack_set_freewheel(m_pJackClient, 0);
+	if (pExportThread) {
+		// Stop export (offline)...
+		pExportThread->wait();
+		delete pExportThread;
+		pSession->lock();
+		m_bFreewheel = false;
+		m_bOffline = false;
+		for (pBus = buses().first(); pBus; pBus = pBus->next())
+			static_cast<qtractorAudioBus *> (pBus)->setOffline(false);
+		for (pBus = busesEx().first(); pBus; pBus = pBus->next())
+			static_cast<qtractorAudioBus *> (pBus)->setOffline(false);
+		pSession->unlock();
+	} else {
+		// Stop export (freewheeling)...
+		jack_set_freewheel(m_pJackClient, 0);
+	}
 
-	// May close the file...
-	m_pExportFile->close();
+	// May close the files (drain the encoders)...
+	writer_iter.toFront();
+	while (writer_iter.hasNext())
+		writer_iter.next()->close();
 
 	// Restore session at ease...
 	pSession->setLoop(iLoopStart, iLoopEnd);
@@ -1784,17 +1826,14 @@ bool qtractorAudioEngine::fileExport (
 	const bool bResult = m_bExporting;
 
 	// Free up things here.
-	delete m_pExportBuffer;
-	delete m_pExportBuses;
-	delete m_pExportFile;
+	qDeleteAll(m_exportWriters);
+	m_exportWriters.clear();
+	m_exportBuses.clear();
 
 	// Made some progress...
 	pProgressBar->hide();
 
 	m_bExporting   = false;
-	m_pExportBuses = nullptr;
-	m_pExportFile  = nullptr;
-	m_pExportBuffer = nullptr;
 //	m_iExportStart = 0;
 //	m_iExportEnd   = 0;
 	m_bExportDone  = true;
@@ -1812,7 +1851,9 @@ void qtractorAudioEngine::trackMute ( qtractorTrack *pTrack, bool bMute )
 {
 	if (bMute) (pTrack->pluginList())->resetBuffers();
 
-	sessionCursor()->updateTrackClip(pTrack);
+	// Have the session cursor re-seek this track clips...
+	pTrack->updateClipsRevision();
+	session()->updateSnapshot();
 }
 
 
@@ -2442,11 +2483,175 @@ void qtractorAudioEngine::resetAllMonitors (void)
 				= static_cast<qtractorAudioMonitor *> (pTrack->monitor());
 			if (pAudioMonitor)
 				pAudioMonitor->reset();
-			qtractorPluginList *pPluginList = pTrack->pluginList();
-			if (pPluginList)
-				pPluginList->resetLatency();
 		}
 	}
+
+	// Reset all plugin delay compensation...
+	resetLatency();
+}
+
+
+// Audio aux-send pseudo-plugin cast helper.
+static inline qtractorAudioAuxSendPlugin *audio_aux_send_plugin (
+	qtractorPlugin *pPlugin )
+{
+	qtractorPluginType *pType = pPlugin->type();
+	if (pType->typeHint() == qtractorPluginType::AuxSend && pType->index() > 0)
+		return static_cast<qtractorAudioAuxSendPlugin *> (pPlugin);
+	else
+		return nullptr;
+}
+
+
+// Output bus plugin chain latency helper.
+static inline unsigned long audio_bus_latency ( qtractorAudioBus *pAudioBus )
+{
+	if (pAudioBus == nullptr || !pAudioBus->isEnabled())
+		return 0;
+
+	qtractorPluginList *pPluginList = pAudioBus->pluginList_out();
+	return (pPluginList ? pPluginList->currentLatency() : 0);
+}
+
+
+// Reset all plugin chain latencies and delay lines (non RT-safe).
+void qtractorAudioEngine::resetLatency (void)
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		qtractorPluginList *pPluginList = pTrack->pluginList();
+		if (pPluginList && pTrack->trackType() == qtractorTrack::Audio)
+			pPluginList->resetLatency();
+	}
+
+	updateLatency(true);
+
+	// Clear all delay lines, as they're stale now...
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		pTrack->resetLatencyDelay();
+		qtractorPluginList *pPluginList = pTrack->pluginList();
+		if (pPluginList == nullptr)
+			continue;
+		for (qtractorPlugin *pPlugin = pPluginList->first();
+				pPlugin; pPlugin = pPlugin->next()) {
+			qtractorAudioAuxSendPlugin *pAuxSendPlugin
+				= audio_aux_send_plugin(pPlugin);
+			if (pAuxSendPlugin)
+				pAuxSendPlugin->resetLatencyDelay();
+		}
+	}
+}
+
+
+// Recompute session-wide plugin delay compensation (non RT-safe):
+// every compensated track gets its clips read ahead by its longest
+// path latency (plugin chain, output or aux-send bus chains), while
+// the shorter paths get delayed to match; returns whether anything
+// has (or would have, when not applied) changed.
+bool qtractorAudioEngine::updateLatency ( bool bApply )
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return false;
+
+	bool bUpdate = false;
+
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		qtractorPluginList *pPluginList = pTrack->pluginList();
+		if (pPluginList == nullptr)
+			continue;
+		const bool bLatency = pPluginList->isLatency();
+		const bool bAudio = (pTrack->trackType() == qtractorTrack::Audio);
+		// Main output path...
+		qtractorAudioBus *pOutputBus = nullptr;
+		if (bAudio) {
+			pOutputBus = static_cast<qtractorAudioBus *> (pTrack->outputBus());
+		} else {
+			qtractorMidiManager *pMidiManager = pPluginList->midiManager();
+			if (pMidiManager)
+				pOutputBus = pMidiManager->audioOutputBus();
+		}
+		unsigned long iLatency = 0;
+		if (bLatency) {
+			iLatency = pPluginList->currentLatency()
+				+ audio_bus_latency(pOutputBus);
+		}
+		// Longest aux-send path, if any...
+		unsigned long iMaxLatency = iLatency;
+		unsigned long iChainLatency = 0;
+		qtractorPlugin *pPlugin = pPluginList->first();
+		for ( ; pPlugin && bLatency && bAudio; pPlugin = pPlugin->next()) {
+			if (!pPlugin->isActivated())
+				continue;
+			qtractorAudioAuxSendPlugin *pAuxSendPlugin
+				= audio_aux_send_plugin(pPlugin);
+			if (pAuxSendPlugin) {
+				const unsigned long iAuxLatency = iChainLatency
+					+ audio_bus_latency(pAuxSendPlugin->audioBus());
+				if (iMaxLatency < iAuxLatency)
+					iMaxLatency = iAuxLatency;
+			}
+			iChainLatency += pPlugin->latency();
+		}
+		// Aux-send path delays...
+		iChainLatency = 0;
+		pPlugin = pPluginList->first();
+		for ( ; pPlugin; pPlugin = pPlugin->next()) {
+			const bool bActivated = pPlugin->isActivated();
+			qtractorAudioAuxSendPlugin *pAuxSendPlugin
+				= audio_aux_send_plugin(pPlugin);
+			if (pAuxSendPlugin) {
+				unsigned long iDelay = 0;
+				if (bLatency && bActivated) {
+					const unsigned long iAuxLatency = iChainLatency
+						+ audio_bus_latency(pAuxSendPlugin->audioBus());
+					if (iMaxLatency > iAuxLatency)
+						iDelay = iMaxLatency - iAuxLatency;
+				}
+				if (bApply ? pAuxSendPlugin->setLatencyDelay(iDelay)
+					: pAuxSendPlugin->latencyDelay() != iDelay)
+					bUpdate = true;
+			}
+			if (bActivated)
+				iChainLatency += pPlugin->latency();
+		}
+		// Main output path delay (audio tracks only)...
+		const unsigned long iDelay = iMaxLatency - iLatency;
+		if (bApply ? pTrack->setLatencyComp(iMaxLatency, iDelay)
+			: (pTrack->latencyComp() != iMaxLatency
+				|| pTrack->latencyDelay() != iDelay))
+			bUpdate = true;
+	}
+
+#ifdef CONFIG_DEBUG
+	if (bApply && bUpdate)
+		qDebug("qtractorAudioEngine::updateLatency()");
+#endif
+
+	return bUpdate;
+}
+
+
+// Check whether any plugin delay compensation path has
+// changed its latency, updating it as needed (non RT-safe).
+void qtractorAudioEngine::checkLatency (void)
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	if (!isActivated() || isFreewheel() || m_bOffline)
+		return;
+
+	// Delay lines are swapped RT-safely, no need to lock...
+	if (updateLatency(false))
+		updateLatency(true);
 }
 
 
@@ -2489,18 +2694,10 @@ qtractorAudioBus::qtractorAudioBus (
 	m_ppXBuffer = nullptr;
 	m_ppYBuffer = nullptr;
 
-	m_bEnabled  = false;
+	m_ppIBufferEx = nullptr;
+	m_ppOBufferEx = nullptr;
 
-#if defined(__SSE__)
-	if (sse_enabled())
-		m_pfnBufferAdd = sse_buffer_add;
-	else
-#endif
-#if defined(__ARM_NEON__)
-	m_pfnBufferAdd = neon_buffer_add;
-	if (false)
-#endif
-		m_pfnBufferAdd = std_buffer_add;
+	m_bEnabled  = false;
 }
 
 
@@ -2710,6 +2907,9 @@ void qtractorAudioBus::close (void)
 		delete [] m_ppYBuffer;
 		m_ppYBuffer = nullptr;
 	}
+
+	// Free offline buffers, if any.
+	setOffline(false);
 }
 
 
@@ -2866,6 +3066,100 @@ void qtractorAudioBus::process_prepare ( unsigned int nframes )
 }
 
 
+// Silence the actual JACK output ports (RT-safe).
+void qtractorAudioBus::process_silence ( unsigned int nframes )
+{
+	if (!m_bEnabled || m_ppOPorts == nullptr)
+		return;
+
+	if ((qtractorAudioBus::busMode() & qtractorBus::Output) == 0)
+		return;
+
+	for (unsigned short i = 0; i < m_iChannels; ++i) {
+		float *pFrames = static_cast<float *>
+			(jack_port_get_buffer(m_ppOPorts[i], nframes));
+		if (pFrames)
+			::memset(pFrames, 0, nframes * sizeof(float));
+	}
+}
+
+
+// Offline (non-JACK) port buffer surrogates (export).
+void qtractorAudioBus::setOffline ( bool bOffline )
+{
+	const qtractorBus::BusMode busMode
+		= qtractorAudioBus::busMode();
+
+	unsigned short i;
+
+	if (bOffline) {
+		qtractorAudioEngine *pAudioEngine
+			= static_cast<qtractorAudioEngine *> (engine());
+		if (pAudioEngine == nullptr)
+			return;
+		const unsigned int iBufferSizeEx
+			= pAudioEngine->bufferSizeEx();
+		if ((busMode & qtractorBus::Input) && m_ppIBufferEx == nullptr) {
+			m_ppIBufferEx = new float * [m_iChannels];
+			for (i = 0; i < m_iChannels; ++i)
+				m_ppIBufferEx[i] = new float [iBufferSizeEx];
+		}
+		if ((busMode & qtractorBus::Output) && m_ppOBufferEx == nullptr) {
+			m_ppOBufferEx = new float * [m_iChannels];
+			for (i = 0; i < m_iChannels; ++i)
+				m_ppOBufferEx[i] = new float [iBufferSizeEx];
+		}
+		return;
+	}
+
+	// Next JACK process cycle will get the real ones...
+	if (m_ppIBufferEx) {
+		for (i = 0; i < m_iChannels; ++i) {
+			if (m_ppIBuffer)
+				m_ppIBuffer[i] = nullptr;
+			delete [] m_ppIBufferEx[i];
+		}
+		delete [] m_ppIBufferEx;
+		m_ppIBufferEx = nullptr;
+	}
+
+	if (m_ppOBufferEx) {
+		for (i = 0; i < m_iChannels; ++i) {
+			if (m_ppOBuffer)
+				m_ppOBuffer[i] = nullptr;
+			delete [] m_ppOBufferEx[i];
+		}
+		delete [] m_ppOBufferEx;
+		m_ppOBufferEx = nullptr;
+	}
+}
+
+
+// Process cycle preparator (offline, non-JACK export).
+void qtractorAudioBus::process_prepare_offline ( unsigned int nframes )
+{
+	if (!m_bEnabled)
+		return;
+
+	unsigned short i;
+
+	// Inputs are just silent...
+	if (m_ppIBuffer && m_ppIBufferEx) {
+		for (i = 0; i < m_iChannels; ++i) {
+			m_ppIBuffer[i] = m_ppIBufferEx[i];
+			::memset(m_ppIBuffer[i], 0, nframes * sizeof(float));
+		}
+	}
+
+	if (m_ppOBuffer && m_ppOBufferEx) {
+		for (i = 0; i < m_iChannels; ++i) {
+			m_ppOBuffer[i] = m_ppOBufferEx[i];
+			::memset(m_ppOBuffer[i], 0, nframes * sizeof(float));
+		}
+	}
+}
+
+
 // Process cycle monitor.
 void qtractorAudioBus::process_monitor ( unsigned int nframes )
 {
@@ -2876,14 +3170,16 @@ void qtractorAudioBus::process_monitor ( unsigned int nframes )
 		= qtractorAudioBus::busMode();
 
 	if (busMode & qtractorBus::Input) {
+		const unsigned long long t0 = qtractorDspLoad::start();
 		if (m_pIPluginList)
 			m_pIPluginList->process(m_ppIBuffer, nframes);
 		if (m_pIAudioMonitor)
 			m_pIAudioMonitor->process(m_ppIBuffer, nframes);
 		if (isMonitor() && (busMode & qtractorBus::Output)) {
-			(*m_pfnBufferAdd)(m_ppOBuffer, m_ppIBuffer,
+			qtractorAudioKernel::buffer_add(m_ppOBuffer, m_ppIBuffer,
 				nframes, m_iChannels, m_iChannels, 0);
 		}
+		m_dspProbe.add(t0);
 	}
 }
 
@@ -2894,16 +3190,33 @@ void qtractorAudioBus::process_commit ( unsigned int nframes )
 	if (!m_bEnabled)
 		return;
 
+	const unsigned long long t0 = qtractorDspLoad::start();
+
 	if (m_pOPluginList)
 		m_pOPluginList->process(m_ppOBuffer, nframes);
 	if (m_pOAudioMonitor)
 		m_pOAudioMonitor->process(m_ppOBuffer, nframes);
+
+	m_dspProbe.add(t0);
 }
 
 
 // Bus-buffering methods.
 void qtractorAudioBus::buffer_prepare (
 	unsigned int nframes, qtractorAudioBus *pInputBus )
+{
+	buffer_prepare(nframes, pInputBus, m_ppXBuffer, m_ppYBuffer);
+}
+
+void qtractorAudioBus::buffer_commit ( unsigned int nframes )
+{
+	buffer_commit(nframes, m_ppXBuffer);
+}
+
+
+// Bus-buffering methods (external buffers).
+void qtractorAudioBus::buffer_prepare ( unsigned int nframes,
+	qtractorAudioBus *pInputBus, float **ppXBuffer, float **ppYBuffer )
 {
 	if (!m_bEnabled)
 		return;
@@ -2918,8 +3231,8 @@ void qtractorAudioBus::buffer_prepare (
 
 	if (pInputBus == nullptr) {
 		for (unsigned short i = 0; i < m_iChannels; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memset(m_ppYBuffer[i], 0, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memset(ppYBuffer[i], 0, nbytes);
 		}
 		return;
 	}
@@ -2930,31 +3243,31 @@ void qtractorAudioBus::buffer_prepare (
 	if (m_iChannels == iBuffers) {
 		// Exact buffer copy...
 		for (unsigned short i = 0; i < iBuffers; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memcpy(m_ppYBuffer[i], ppBuffer[i] + offset, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memcpy(ppYBuffer[i], ppBuffer[i] + offset, nbytes);
 		}
 	} else {
 		// Buffer merge/multiplex...
 		unsigned short i;
 		for (i = 0; i < m_iChannels; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memset(m_ppYBuffer[i], 0, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memset(ppYBuffer[i], 0, nbytes);
 		}
 		if (m_iChannels > iBuffers) {
 			unsigned short j = 0;
 			for (i = 0; i < m_iChannels; ++i) {
-				::memcpy(m_ppYBuffer[i], ppBuffer[j] + offset, nbytes);
+				::memcpy(ppYBuffer[i], ppBuffer[j] + offset, nbytes);
 				if (++j >= iBuffers)
 					j = 0;
 			}
 		} else { // (m_iChannels < iBuffers)
-			(*m_pfnBufferAdd)(m_ppXBuffer, ppBuffer,
+			qtractorAudioKernel::buffer_add(ppXBuffer, ppBuffer,
 				nframes, m_iChannels, iBuffers, offset);
 		}
 	}
 }
 
-void qtractorAudioBus::buffer_commit ( unsigned int nframes )
+void qtractorAudioBus::buffer_commit ( unsigned int nframes, float **ppXBuffer )
 {
 	if (!m_bEnabled || (busMode() & qtractorBus::Output) == 0)
 		return;
@@ -2964,7 +3277,7 @@ void qtractorAudioBus::buffer_commit ( unsigned int nframes )
 	if (pAudioEngine == nullptr)
 		return;
 
-	(*m_pfnBufferAdd)(m_ppOBuffer, m_ppXBuffer,
+	qtractorAudioKernel::buffer_add(m_ppOBuffer, ppXBuffer,
 		nframes, m_iChannels, m_iChannels, pAudioEngine->bufferOffset());
 }
 
@@ -24,6 +24,7 @@
 
 #include "qtractorAtomic.h"
 #include "qtractorEngine.h"
+#include "qtractorDspLoad.h"
 
 #include <jack/jack.h>
 
@@ -35,7 +36,9 @@ class qtractorAudioBus;
 class qtractorAudioBuffer;
 class qtractorAudioMonitor;
 class qtractorAudioFile;
-class qtractorAudioExportBuffer;
+class qtractorAudioExportWriter;
+class qtractorAudioExportThread;
+class qtractorAudioGraph;
 class qtractorPluginList;
 class qtractorCurveList;
 
@@ -115,6 +118,10 @@ public:
 	// Process cycle executive.
 	int process(unsigned int nframes);
 
+	// Offline process cycle executive (export thread);
+	// returns false when export is done or cancelled.
+	bool process_offline(unsigned int nframes);
+
 	// Timebase master callback.
 	void timebase(jack_position_t *pPos, int iNewPos);
 
@@ -156,12 +163,30 @@ public:
 	unsigned long exportOffset() const;
 	unsigned long exportLength() const;
 
+	// Audio-export offline (non-freewheeling) mode.
+	void setExportOffline(bool bExportOffline);
+	bool isExportOffline() const;
+
 	// Audio-export method.
 	bool fileExport(const QString& sExportPath,
 		const QList<qtractorAudioBus *>& exportBuses,
 		unsigned long iExportStart, unsigned long iExportEnd,
 		int iExportFormat = -1);
 
+	// Audio-export bus and/or track set (one export file each);
+	// tracks are tapped just before committing to their buses.
+	struct ExportSet
+	{
+		QString sExportPath;
+		QList<qtractorAudioBus *> exportBuses;
+		QList<qtractorTrack *> exportTracks;
+		int iExportFormat;
+	};
+
+	// Audio-export method (many bus sets, single pass).
+	bool fileExport(const QList<ExportSet>& exportSets,
+		unsigned long iExportStart, unsigned long iExportEnd);
+
 	// Special track-immediate methods.
 	void trackMute(qtractorTrack *pTrack, bool bMute);
 
@@ -244,8 +269,17 @@ public:
 	// Reset all audio monitoring...
 	void resetAllMonitors();
 
+	// Session-wide plugin delay compensation (non RT-safe).
+	void resetLatency();
+	bool updateLatency(bool bApply = true);
+	void checkLatency();
+
 	// Whether we're in the audio/real-time thread...
 	static bool isProcessing();
+	static void setProcessing(bool bProcessing);
+
+	// Parallel audio track process graph accessor.
+	qtractorAudioGraph *audioGraph() const;
 
 	// Time(base)/BBT info.
 	struct TimeInfo
@@ -294,6 +328,16 @@ protected:
 	// Freewheeling process cycle executive (needed for export).
 	void process_export(unsigned int nframes);
 
+	// Common export process cycle executive.
+	void process_export_cycle(unsigned int nframes);
+
+	// JACK MIDI output buses process cycle executive.
+	void process_midi(qtractorSession *pSession,
+		unsigned long iFrameTimeStart, unsigned int nframes);
+
+	// Silent process cycle executive (while exporting offline).
+	void process_silence(unsigned int nframes);
+
 	// Metronome latency offset compensation.
 	unsigned long metro_offset(unsigned long iFrame) const;
 
@@ -331,16 +375,23 @@ private:
 	// Common audio buffer sync thread.
 	qtractorAudioBufferThread *m_pSyncThread;
 
+	// Parallel audio track process graph.
+	qtractorAudioGraph *m_pAudioGraph;
+
 	// Audio-export (in)active state.
 	volatile bool        m_bExporting;
-	qtractorAudioFile   *m_pExportFile;
 	unsigned long        m_iExportOffset;
 	unsigned long        m_iExportStart;
 	unsigned long        m_iExportEnd;
 	volatile bool        m_bExportDone;
 
-	QList<qtractorAudioBus *> *m_pExportBuses;
-	qtractorAudioExportBuffer *m_pExportBuffer;
+	// Audio-export output buses (all sets) and file writers.
+	QList<qtractorAudioBus *> m_exportBuses;
+	QList<qtractorAudioExportWriter *> m_exportWriters;
+
+	// Audio-export offline mode and (in)active state.
+	bool                 m_bExportOffline;
+	volatile bool        m_bOffline;
 
 	// Audio metronome stuff.
 	bool                 m_bMetronome;
@@ -418,11 +469,24 @@ public:
 	void process_monitor(unsigned int nframes);
 	void process_commit(unsigned int nframes);
 
+	// Offline (non-JACK) port buffer surrogates (export).
+	void setOffline(bool bOffline);
+	void process_prepare_offline(unsigned int nframes);
+
+	// Silence the actual JACK output ports, leaving
+	// the (offline) bus buffers alone (RT-safe).
+	void process_silence(unsigned int nframes);
+
 	// Bus-buffering methods.
 	void buffer_prepare(unsigned int nframes,
 		qtractorAudioBus *pInputBus = nullptr);
 	void buffer_commit(unsigned int nframes);
 
+	// Bus-buffering methods (external buffers).
+	void buffer_prepare(unsigned int nframes, qtractorAudioBus *pInputBus,
+		float **ppXBuffer, float **ppYBuffer);
+	void buffer_commit(unsigned int nframes, float **ppXBuffer);
+
 	// Up-and-running predicate.
 	bool isEnabled() const { return m_bEnabled; }
 
@@ -444,6 +508,10 @@ public:
 	qtractorPluginList *pluginList_in()  const;
 	qtractorPluginList *pluginList_out() const;
 
+	// DSP time probe (instrumentation).
+	qtractorDspProbe& dspProbe()
+		{ return m_dspProbe; }
+
 	// Audio I/O port latency accessors.
 	unsigned int latency_in()  const;
 	unsigned int latency_out() const;
@@ -488,6 +556,9 @@ private:
 	qtractorPluginList *m_pIPluginList;
 	qtractorPluginList *m_pOPluginList;
 
+	// DSP time probe.
+	qtractorDspProbe m_dspProbe;
+
 	// Specific JACK ports stuff.
 	jack_port_t **m_ppIPorts;
 	jack_port_t **m_ppOPorts;
@@ -495,14 +566,12 @@ private:
 	float       **m_ppOBuffer;
 	float       **m_ppXBuffer;
 	float       **m_ppYBuffer;
+	float       **m_ppIBufferEx;
+	float       **m_ppOBufferEx;
 
 	// Special under-work flag...
 	// (r/w access should be atomic)
 	volatile bool m_bEnabled;
-
-	// Buffer mix-down processor.
-	void (*m_pfnBufferAdd)(float **, float **, unsigned int,
-		unsigned short, unsigned short, unsigned int);
 };
 
 
@@ -0,0 +1,241 @@
+// qtractorAudioExport.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioExport.h"
+#include "qtractorAudioEngine.h"
+#include "qtractorAudioFile.h"
+#include "qtractorAudioKernel.h"
+
+#include "qtractorTrack.h"
+
+#include <cstring>
+
+
+// Multi-channel mix-down into block offset, wrapping around block
+// channels; source buffers (bus outputs and track mix-down buffers
+// alike) are period-sized, thus not offset at all.
+static inline void qtractor_export_buffer_add (
+	float **ppBuffer, float **ppFrames, unsigned int iFrames,
+	unsigned short iBuffers, unsigned short iChannels, unsigned int iOffset )
+{
+	unsigned short j = 0;
+
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		qtractorAudioKernel::add(ppBuffer[j] + iOffset, ppFrames[i], iFrames);
+		if (++j >= iBuffers)
+			j = 0;
+	}
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioExportWriter -- Audio export (async) encoder queue.
+//
+
+// Constructor.
+qtractorAudioExportWriter::qtractorAudioExportWriter (
+	qtractorAudioFile *pExportFile,
+	const QList<qtractorAudioBus *>& exportBuses,
+	const QList<qtractorTrack *>& exportTracks,
+	unsigned short iChannels, unsigned int iBlockSize,
+	unsigned int iBlocks ) : QThread(),
+		m_pExportFile(pExportFile),
+		m_exportBuses(exportBuses), m_exportTracks(exportTracks),
+		m_iChannels(iChannels), m_iBlockSize(iBlockSize),
+		m_iBlocks(iBlocks < 2 ? 2 : iBlocks),
+		m_iWrite(0), m_iRead(0), m_iCount(0), m_bRunState(true)
+{
+	m_pBlocks = new Block [m_iBlocks];
+	for (unsigned int i = 0; i < m_iBlocks; ++i) {
+		Block *pBlock = &m_pBlocks[i];
+		pBlock->frames = new float * [m_iChannels];
+		for (unsigned short k = 0; k < m_iChannels; ++k)
+			pBlock->frames[k] = new float [m_iBlockSize];
+		pBlock->count = 0;
+	}
+}
+
+
+// Destructor.
+qtractorAudioExportWriter::~qtractorAudioExportWriter (void)
+{
+	if (isRunning()) do {
+		m_bRunState = false;
+		if (m_mutex.tryLock()) {
+			m_cond.wakeAll();
+			m_mutex.unlock();
+		}
+	} while (!wait(100));
+
+	for (unsigned int i = 0; i < m_iBlocks; ++i) {
+		Block *pBlock = &m_pBlocks[i];
+		for (unsigned short k = 0; k < m_iChannels; ++k)
+			delete [] pBlock->frames[k];
+		delete [] pBlock->frames;
+	}
+
+	delete [] m_pBlocks;
+
+	if (m_pExportFile)
+		delete m_pExportFile;
+}
+
+
+// Mix-down the export bus and track set and queue it for encoding
+// (export thread only; blocks while the queue is full).
+void qtractorAudioExportWriter::process_add ( unsigned int nframes )
+{
+	if (nframes > m_iBlockSize)
+		nframes = m_iBlockSize;
+
+	if (m_pBlocks[m_iWrite].count + nframes > m_iBlockSize)
+		commit();
+
+	Block *pBlock = &m_pBlocks[m_iWrite];
+	const unsigned int offset = pBlock->count;
+
+	for (unsigned short k = 0; k < m_iChannels; ++k)
+		::memset(pBlock->frames[k] + offset, 0, nframes * sizeof(float));
+
+	QListIterator<qtractorAudioBus *> iter(m_exportBuses);
+	while (iter.hasNext()) {
+		qtractorAudioBus *pExportBus = iter.next();
+		qtractor_export_buffer_add(pBlock->frames, pExportBus->out(),
+			nframes, m_iChannels, pExportBus->channels(), offset);
+	}
+
+	// Tracks are tapped as they would be committed to their buses...
+	QListIterator<qtractorTrack *> track_iter(m_exportTracks);
+	while (track_iter.hasNext()) {
+		qtractorTrack *pExportTrack = track_iter.next();
+		float **ppBuffer = pExportTrack->audioBufferEx();
+		if (ppBuffer) {
+			qtractor_export_buffer_add(pBlock->frames, ppBuffer,
+				nframes, m_iChannels, pExportTrack->audioChannels(), offset);
+		}
+	}
+
+	pBlock->count += nframes;
+}
+
+
+// Queue the current block for encoding.
+void qtractorAudioExportWriter::commit (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_pBlocks[m_iWrite].count < 1)
+		return;
+
+	m_iWrite = (m_iWrite + 1) % m_iBlocks;
+	++m_iCount;
+
+	m_cond.wakeAll();
+
+	// Wait for a free block, if queue is full...
+	while (m_iCount >= m_iBlocks && m_bRunState)
+		m_cond.wait(&m_mutex);
+
+	m_pBlocks[m_iWrite].count = 0;
+}
+
+
+// Drain the queue, stop encoding and close the file.
+void qtractorAudioExportWriter::close (void)
+{
+	commit();
+
+	m_mutex.lock();
+	m_bRunState = false;
+	m_cond.wakeAll();
+	m_mutex.unlock();
+
+	wait();
+
+	if (m_pExportFile)
+		m_pExportFile->close();
+}
+
+
+// The main thread executive.
+void qtractorAudioExportWriter::run (void)
+{
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioExportWriter[%p]::run(): started.", this);
+#endif
+
+	m_mutex.lock();
+
+	while (m_bRunState || m_iCount > 0) {
+		if (m_iCount > 0) {
+			Block *pBlock = &m_pBlocks[m_iRead];
+			// Encode it, unlocked...
+			m_mutex.unlock();
+			m_pExportFile->write(pBlock->frames, pBlock->count);
+			m_mutex.lock();
+			m_iRead = (m_iRead + 1) % m_iBlocks;
+			--m_iCount;
+			m_cond.wakeAll();
+		} else {
+			// Wait for more...
+			m_cond.wait(&m_mutex);
+		}
+	}
+
+	m_mutex.unlock();
+
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioExportWriter[%p]::run(): stopped.", this);
+#endif
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioExportThread -- Audio export (offline) render thread.
+//
+
+// Constructor.
+qtractorAudioExportThread::qtractorAudioExportThread (
+	qtractorAudioEngine *pAudioEngine, unsigned int iBufferSize )
+	: QThread(), m_pAudioEngine(pAudioEngine), m_iBufferSize(iBufferSize)
+{
+}
+
+
+// The main thread executive.
+void qtractorAudioExportThread::run (void)
+{
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioExportThread[%p]::run(): started.", this);
+#endif
+
+	// Render as fast as we can, until done or cancelled...
+	while (m_pAudioEngine->process_offline(m_iBufferSize))
+		;
+
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioExportThread[%p]::run(): stopped.", this);
+#endif
+}
+
+
+// end of qtractorAudioExport.cpp
@@ -0,0 +1,141 @@
+// qtractorAudioExport.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioExport_h
+#define __qtractorAudioExport_h
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+
+
+// Forward declarations.
+class qtractorAudioEngine;
+class qtractorAudioBus;
+class qtractorAudioFile;
+class qtractorTrack;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioExportWriter -- Audio export (async) encoder queue.
+//
+
+class qtractorAudioExportWriter : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioExportWriter(qtractorAudioFile *pExportFile,
+		const QList<qtractorAudioBus *>& exportBuses,
+		const QList<qtractorTrack *>& exportTracks,
+		unsigned short iChannels, unsigned int iBlockSize,
+		unsigned int iBlocks = 8);
+
+	// Destructor.
+	~qtractorAudioExportWriter();
+
+	// Export file, bus and track set accessors.
+	qtractorAudioFile *exportFile() const
+		{ return m_pExportFile; }
+	const QList<qtractorAudioBus *>& exportBuses() const
+		{ return m_exportBuses; }
+	const QList<qtractorTrack *>& exportTracks() const
+		{ return m_exportTracks; }
+
+	// Mix-down the export bus and track set and queue it for encoding
+	// (export thread only; blocks while the queue is full).
+	void process_add(unsigned int nframes);
+
+	// Drain the queue, stop encoding and close the file.
+	void close();
+
+protected:
+
+	// The main thread executive.
+	void run();
+
+	// Queue the current block for encoding.
+	void commit();
+
+private:
+
+	// Queue block descriptor.
+	struct Block
+	{
+		float      **frames;
+		unsigned int count;
+	};
+
+	// Instance variables.
+	qtractorAudioFile *m_pExportFile;
+
+	QList<qtractorAudioBus *> m_exportBuses;
+	QList<qtractorTrack *>    m_exportTracks;
+
+	unsigned short m_iChannels;
+	unsigned int   m_iBlockSize;
+
+	// Block queue (ring).
+	Block         *m_pBlocks;
+	unsigned int   m_iBlocks;
+	unsigned int   m_iWrite;
+	unsigned int   m_iRead;
+	unsigned int   m_iCount;
+
+	// Whether the thread is logically running.
+	volatile bool  m_bRunState;
+
+	// Thread synchronization objects.
+	QMutex         m_mutex;
+	QWaitCondition m_cond;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioExportThread -- Audio export (offline) render thread.
+//
+
+class qtractorAudioExportThread : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioExportThread(
+		qtractorAudioEngine *pAudioEngine, unsigned int iBufferSize);
+
+protected:
+
+	// The main thread executive.
+	void run();
+
+private:
+
+	// Instance variables.
+	qtractorAudioEngine *m_pAudioEngine;
+	unsigned int         m_iBufferSize;
+};
+
+
+#endif  // __qtractorAudioExport_h
+
+
+// end of qtractorAudioExport.h
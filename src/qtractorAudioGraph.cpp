@@ -0,0 +1,661 @@
+// qtractorAudioGraph.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioGraph.h"
+#include "qtractorAudioEngine.h"
+
+#include "qtractorSession.h"
+#include "qtractorSessionCursor.h"
+#include "qtractorSessionSnapshot.h"
+#include "qtractorInsertPlugin.h"
+#include "qtractorCurve.h"
+
+#if !defined(_WIN32)
+#include <jack/thread.h>
+#include <pthread.h>
+#endif
+
+
+// Null node/task index marker.
+#define QTRACTOR_GRAPH_NONE ((unsigned int) -1)
+
+// Maximum number of worker threads.
+#define QTRACTOR_GRAPH_MAX_WORKERS 32
+
+// Cycle word: serial above, enlisted workers below.
+#define QTRACTOR_GRAPH_CYCLE_BITS 6
+#define QTRACTOR_GRAPH_CYCLE_MASK ((1 << QTRACTOR_GRAPH_CYCLE_BITS) - 1)
+
+// Join spin bound, before blocking.
+#define QTRACTOR_GRAPH_JOIN_SPINS 1000
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraphThread -- Audio graph (RT) worker thread.
+//
+
+// Constructor.
+qtractorAudioGraphThread::qtractorAudioGraphThread (
+	qtractorAudioGraph *pAudioGraph, unsigned int iWorker ) : QThread()
+{
+	m_pAudioGraph = pAudioGraph;
+	m_iWorker     = iWorker;
+	m_bRunState   = false;
+}
+
+
+// Destructor.
+qtractorAudioGraphThread::~qtractorAudioGraphThread (void)
+{
+	if (isRunning()) do {
+		setRunState(false);
+	//	terminate();
+		sync();
+	} while (!wait(100));
+}
+
+
+// Run state accessor.
+void qtractorAudioGraphThread::setRunState ( bool bRunState )
+{
+	m_bRunState = bRunState;
+}
+
+bool qtractorAudioGraphThread::runState (void) const
+{
+	return m_bRunState;
+}
+
+
+// Wake from executive wait condition (RT-safe).
+void qtractorAudioGraphThread::sync (void)
+{
+	m_sem.release();
+}
+
+
+// Thread run executive.
+void qtractorAudioGraphThread::run (void)
+{
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioGraphThread[%p]::run(%u): started.", this, m_iWorker);
+#endif
+
+#if !defined(_WIN32)
+	// Get the same real-time scheduling as JACK's own...
+	qtractorAudioEngine *pAudioEngine = m_pAudioGraph->audioEngine();
+	jack_client_t *pJackClient = pAudioEngine->jackClient();
+	if (pJackClient && jack_is_realtime(pJackClient)) {
+		jack_acquire_real_time_scheduling(pthread_self(),
+			jack_client_real_time_priority(pJackClient));
+	}
+#endif
+
+	// We're in the audio/real-time thread, always...
+	qtractorAudioEngine::setProcessing(true);
+
+	m_bRunState = true;
+
+	while (m_bRunState) {
+		// Wait for next cycle...
+		m_sem.acquire();
+		// Do whatever we must...
+		if (m_bRunState)
+			m_pAudioGraph->process_worker(m_iWorker);
+	}
+
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioGraphThread[%p]::run(%u): stopped.", this, m_iWorker);
+#endif
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraph -- Parallel audio track process graph.
+//
+
+// Default number of worker threads (-1=auto, 0=none).
+int qtractorAudioGraph::g_iDefaultWorkers = -1;
+
+void qtractorAudioGraph::setDefaultWorkers ( int iWorkers )
+{
+	g_iDefaultWorkers = iWorkers;
+}
+
+int qtractorAudioGraph::defaultWorkers (void)
+{
+	return g_iDefaultWorkers;
+}
+
+
+// Effective number of worker threads, as from default.
+unsigned int qtractorAudioGraph::idealWorkers (void)
+{
+	int iWorkers = g_iDefaultWorkers;
+	if (iWorkers < 0) // Auto: one less than available cores...
+		iWorkers = QThread::idealThreadCount() - 1;
+	if (iWorkers > QTRACTOR_GRAPH_MAX_WORKERS)
+		iWorkers = QTRACTOR_GRAPH_MAX_WORKERS;
+	if (iWorkers < 0)
+		iWorkers = 0;
+
+	return (unsigned int) iWorkers;
+}
+
+
+// Constructor.
+qtractorAudioGraph::qtractorAudioGraph (
+	qtractorAudioEngine *pAudioEngine, unsigned int iWorkers,
+	unsigned int iSize ) : m_pAudioEngine(pAudioEngine),
+		m_iWorkers(iWorkers), m_ppThreads(nullptr),
+		m_iSize(0), m_pNodes(nullptr), m_iNodes(0),
+		m_pTasks(nullptr), m_iTasks(0),
+		m_ppBuses(nullptr), m_pBusNodes(nullptr), m_iBuses(0),
+		m_pSlices(nullptr), m_iSlices(0), m_piCycles(nullptr),
+		m_pJobPlugin(nullptr), m_iJobInstances(0), m_iJobFrames(0),
+		m_iFrameStart(0), m_iFrameEnd(0), m_bExport(false)
+{
+	ATOMIC_SET(&m_cycle, 0);
+
+	ATOMIC_SET(&m_graphJoin.pending, 0);
+	ATOMIC_SET(&m_graphJoin.waiting, 0);
+
+	ATOMIC_SET(&m_jobIndex, 0);
+	ATOMIC_SET(&m_jobHelpers, 0);
+	ATOMIC_SET(&m_jobBusy, 0);
+
+	ATOMIC_SET(&m_jobJoin.pending, 0);
+	ATOMIC_SET(&m_jobJoin.waiting, 0);
+
+	checkSize(iSize);
+
+	// One slice for each worker, plus the caller's own...
+	m_pSlices = new Slice [m_iWorkers + 1];
+	for (unsigned int i = 0; i <= m_iWorkers; ++i) {
+		ATOMIC_SET(&m_pSlices[i].index, 0);
+		m_pSlices[i].end = 0;
+	}
+
+	// Last cycle seen, by each worker...
+	m_piCycles = new int [m_iWorkers + 1];
+	for (unsigned int i = 0; i <= m_iWorkers; ++i)
+		m_piCycles[i] = 0;
+
+	if (m_iWorkers > 0) {
+		m_ppThreads = new qtractorAudioGraphThread * [m_iWorkers];
+		for (unsigned int i = 0; i < m_iWorkers; ++i) {
+			m_ppThreads[i] = new qtractorAudioGraphThread(this, i + 1);
+			m_ppThreads[i]->start(QThread::TimeCriticalPriority);
+		}
+	}
+}
+
+
+// Destructor.
+qtractorAudioGraph::~qtractorAudioGraph (void)
+{
+	if (m_ppThreads) {
+		for (unsigned int i = 0; i < m_iWorkers; ++i)
+			delete m_ppThreads[i];
+		delete [] m_ppThreads;
+	}
+
+	delete [] m_piCycles;
+	delete [] m_pSlices;
+
+	if (m_pBusNodes)
+		delete [] m_pBusNodes;
+	if (m_ppBuses)
+		delete [] m_ppBuses;
+	if (m_pTasks)
+		delete [] m_pTasks;
+	if (m_pNodes)
+		delete [] m_pNodes;
+}
+
+
+// Conditional resize check (non RT-safe).
+void qtractorAudioGraph::checkSize ( unsigned int iTracks )
+{
+	if (iTracks < m_iSize)
+		return;
+
+	unsigned int iNewSize = (m_iSize > 0 ? m_iSize : 8);
+	while (iNewSize <= iTracks)
+		iNewSize <<= 1;
+
+	Node *pNewNodes = new Node [iNewSize];
+	unsigned int *pNewTasks = new unsigned int [iNewSize];
+	qtractorBus **ppNewBuses = new qtractorBus * [iNewSize];
+	unsigned int *pNewBusNodes = new unsigned int [iNewSize];
+
+	Node *pOldNodes = m_pNodes;
+	unsigned int *pOldTasks = m_pTasks;
+	qtractorBus **ppOldBuses = m_ppBuses;
+	unsigned int *pOldBusNodes = m_pBusNodes;
+
+	// Make it sure we're not in the middle of a cycle...
+	qtractorSession *pSession = m_pAudioEngine->session();
+	if (pSession) pSession->lock();
+
+	m_pNodes = pNewNodes;
+	m_pTasks = pNewTasks;
+	m_ppBuses = ppNewBuses;
+	m_pBusNodes = pNewBusNodes;
+	m_iSize = iNewSize;
+
+	if (pSession) pSession->unlock();
+
+	if (pOldBusNodes)
+		delete [] pOldBusNodes;
+	if (ppOldBuses)
+		delete [] ppOldBuses;
+	if (pOldTasks)
+		delete [] pOldTasks;
+	if (pOldNodes)
+		delete [] pOldNodes;
+}
+
+
+// Node group (union-find) helpers.
+unsigned int qtractorAudioGraph::findNode ( unsigned int iNode )
+{
+	while (m_pNodes[iNode].parent != iNode) {
+		Node *pNode = &m_pNodes[iNode];
+		pNode->parent = m_pNodes[pNode->parent].parent;
+		iNode = pNode->parent;
+	}
+
+	return iNode;
+}
+
+void qtractorAudioGraph::unionNodes ( unsigned int iNode1, unsigned int iNode2 )
+{
+	iNode1 = findNode(iNode1);
+	iNode2 = findNode(iNode2);
+
+	// Group root is always the first (track order) node...
+	if (iNode1 < iNode2)
+		m_pNodes[iNode2].parent = iNode1;
+	else
+	if (iNode2 < iNode1)
+		m_pNodes[iNode1].parent = iNode2;
+}
+
+
+// Aux-send bus edge helper: all tracks sending to the same
+// bus are grouped together, so to be processed in serial.
+bool qtractorAudioGraph::addBusNode ( qtractorBus *pBus, unsigned int iNode )
+{
+	for (unsigned int i = 0; i < m_iBuses; ++i) {
+		if (m_ppBuses[i] == pBus) {
+			unionNodes(m_pBusNodes[i], iNode);
+			return true;
+		}
+	}
+
+	if (m_iBuses >= m_iSize)
+		return false;
+
+	m_ppBuses[m_iBuses] = pBus;
+	m_pBusNodes[m_iBuses] = iNode;
+	++m_iBuses;
+
+	return true;
+}
+
+
+// (Re)build current cycle graph nodes and tasks (RT-safe).
+bool qtractorAudioGraph::build ( qtractorSessionSnapshot *pSnapshot,
+	qtractorSessionCursor *pSessionCursor )
+{
+	m_iNodes = 0;
+	m_iTasks = 0;
+	m_iBuses = 0;
+
+	// Collect all audio tracks as graph nodes...
+	const unsigned int iTracks = pSnapshot->tracks();
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
+		if (pTrack->trackType() == qtractorTrack::Audio) {
+			if (m_iNodes >= m_iSize)
+				return false;
+			const unsigned int iNode = m_iNodes++;
+			Node *pNode = &m_pNodes[iNode];
+			pNode->track  = pTrack;
+			pNode->clips  = pSessionCursor->clips(iTrack);
+			pNode->parent = iNode;
+			pNode->next   = QTRACTOR_GRAPH_NONE;
+			pNode->last   = iNode;
+			// Aux-send edges: track -> aux-send target bus...
+			// (inserts have their own dedicated bus, so no edges)
+			qtractorSessionChain *pChain = pTrack->pluginList()->chain();
+			const unsigned int iPlugins = (pChain ? pChain->plugins() : 0);
+			for (unsigned int i = 0; i < iPlugins; ++i) {
+				qtractorPlugin *pPlugin = pChain->plugin(i);
+				if (!pPlugin->isActivated())
+					continue;
+				qtractorPluginType *pType = pPlugin->type();
+				if (pType->typeHint() != qtractorPluginType::AuxSend
+					|| pType->index() < 1)
+					continue;
+				qtractorAudioAuxSendPlugin *pAudioAuxSendPlugin
+					= static_cast<qtractorAudioAuxSendPlugin *> (pPlugin);
+				qtractorAudioBus *pAudioBus = pAudioAuxSendPlugin->audioBus();
+				if (pAudioBus && !addBusNode(pAudioBus, iNode))
+					return false;
+			}
+		}
+	}
+
+	// Chain all grouped nodes into tasks, in track order...
+	for (unsigned int iNode = 0; iNode < m_iNodes; ++iNode) {
+		const unsigned int iRoot = findNode(iNode);
+		if (iRoot == iNode) {
+			m_pTasks[m_iTasks++] = iNode;
+		} else {
+			Node *pRoot = &m_pNodes[iRoot];
+			m_pNodes[pRoot->last].next = iNode;
+			pRoot->last = iNode;
+		}
+	}
+
+	return true;
+}
+
+
+// Process cycle executive (RT-safe).
+void qtractorAudioGraph::process ( qtractorSessionSnapshot *pSnapshot,
+	qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	process_graph(pSnapshot, pSessionCursor, iFrameStart, iFrameEnd, false);
+}
+
+
+// Freewheeling/offline process cycle executive (export).
+void qtractorAudioGraph::process_export ( qtractorSessionSnapshot *pSnapshot,
+	qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	process_graph(pSnapshot, pSessionCursor, iFrameStart, iFrameEnd, true);
+}
+
+
+// Common process cycle executive.
+void qtractorAudioGraph::process_graph ( qtractorSessionSnapshot *pSnapshot,
+	qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport )
+{
+	if (pSnapshot == nullptr)
+		return;
+
+	// Track automation processing first (serial)...
+	const unsigned int iTracks = pSnapshot->tracks();
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorCurveList *pCurveList = pSnapshot->track(iTrack)->curveList();
+		if (pCurveList && pCurveList->isProcess())
+			pCurveList->process(iFrameStart);
+	}
+
+	// Exporting MIDI tracks are not graph nodes (serial)...
+	if (bExport) {
+		for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+			qtractorTrack *pTrack = pSnapshot->track(iTrack);
+			if (pTrack->trackType() != qtractorTrack::Audio) {
+				pTrack->process_export_buffer(pSessionCursor->clips(iTrack),
+					iFrameStart, iFrameEnd);
+			}
+		}
+	}
+
+	m_bExport = bExport;
+
+	// (Re)build the graph, fallback to serial on overflow...
+	if (!build(pSnapshot, pSessionCursor)) {
+		process_serial(pSnapshot, pSessionCursor, iFrameStart, iFrameEnd);
+		return;
+	}
+
+	m_iFrameStart = iFrameStart;
+	m_iFrameEnd   = iFrameEnd;
+
+	// Split tasks into participant slices...
+	unsigned int iWorkers = m_iWorkers;
+	if (iWorkers + 1 > m_iTasks)
+		iWorkers = (m_iTasks > 0 ? m_iTasks - 1 : 0);
+
+	m_iSlices = iWorkers + 1;
+	for (unsigned int i = 0; i < m_iSlices; ++i) {
+		Slice *pSlice = &m_pSlices[i];
+		ATOMIC_SET(&pSlice->index, (i * m_iTasks) / m_iSlices);
+		pSlice->end = ((i + 1) * m_iTasks) / m_iSlices;
+	}
+
+	// Enlist and wake up the workers...
+	join_reset(&m_graphJoin, int(iWorkers));
+	const int iCycle = (ATOMIC_GET(&m_cycle) & ~QTRACTOR_GRAPH_CYCLE_MASK)
+		+ (1 << QTRACTOR_GRAPH_CYCLE_BITS);
+	m_cycle.storeRelease(iCycle | int(iWorkers));
+	for (unsigned int i = 0; i < iWorkers; ++i)
+		m_ppThreads[i]->sync();
+
+	// Do our own share...
+	process_tasks(0);
+
+	// Wait for all workers to finish (join)...
+	join_wait(&m_graphJoin);
+
+	// No workers enlisted anymore...
+	m_cycle.storeRelease(iCycle);
+
+	// Commit all track buffers, in deterministic (track) order...
+	const unsigned int nframes = iFrameEnd - iFrameStart;
+	for (unsigned int iNode = 0; iNode < m_iNodes; ++iNode)
+		m_pNodes[iNode].track->process_commit(nframes);
+}
+
+
+// Worker thread cycle executive (RT-safe).
+void qtractorAudioGraph::process_worker ( unsigned int iWorker )
+{
+	// Workers are also woken for plugin instance jobs, so take
+	// part on the current cycle only if enlisted and just once...
+	const int iCycle = m_cycle.loadAcquire();
+	if (m_piCycles[iWorker] != iCycle
+		&& iWorker <= (unsigned int) (iCycle & QTRACTOR_GRAPH_CYCLE_MASK)) {
+		m_piCycles[iWorker] = iCycle;
+		process_tasks(iWorker);
+		join_done(&m_graphJoin);
+	}
+
+	// Help on any plugin instances job in flight...
+	process_jobs();
+}
+
+
+// Plugin instances fork-join executive (RT-safe).
+void qtractorAudioGraph::process_instances ( qtractorPlugin *pPlugin,
+	unsigned short iInstances, unsigned int nframes )
+{
+	// Only one job in flight at a time (eg. other plugins
+	// being processed concurrently on the audio graph);
+	// just go serial, the caller's own share, if busy...
+	if (m_iWorkers < 1 || iInstances < 2 || !ATOMIC_TAS(&m_jobBusy)) {
+		for (unsigned short i = 0; i < iInstances; ++i)
+			pPlugin->process_instance(i, nframes);
+		return;
+	}
+
+	m_iJobInstances = iInstances;
+	m_iJobFrames    = nframes;
+
+	ATOMIC_SET(&m_jobIndex, 0);
+	join_reset(&m_jobJoin, iInstances);
+
+	m_pJobPlugin.storeRelease(pPlugin);
+
+	// Wake up just as many idle (not enlisted) workers as needed;
+	// enlisted ones will help as soon as done with their tasks...
+	unsigned int iWorker = (m_cycle.loadAcquire() & QTRACTOR_GRAPH_CYCLE_MASK);
+	unsigned int iWorkers = iWorker + iInstances - 1;
+	if (iWorkers > m_iWorkers)
+		iWorkers = m_iWorkers;
+	for ( ; iWorker < iWorkers; ++iWorker)
+		m_ppThreads[iWorker]->sync();
+
+	// Do our own share...
+	process_job(pPlugin);
+
+	// Wait for all instances to finish (join)...
+	join_wait(&m_jobJoin);
+
+	// Retract the job; then wait for any late helper still
+	// holding it, which may only be failing to claim one...
+	m_pJobPlugin.fetchAndStoreOrdered(nullptr);
+	while (ATOMIC_GET(&m_jobHelpers) > 0)
+		;
+
+	ATOMIC_SET(&m_jobBusy, 0);
+}
+
+
+// Help on any plugin instances job in flight (RT-safe).
+void qtractorAudioGraph::process_jobs (void)
+{
+	if (m_pJobPlugin.loadAcquire() == nullptr)
+		return;
+
+	ATOMIC_INC(&m_jobHelpers);
+
+	qtractorPlugin *pPlugin = m_pJobPlugin.loadAcquire();
+	if (pPlugin)
+		process_job(pPlugin);
+
+	ATOMIC_DEC(&m_jobHelpers);
+}
+
+
+// Claim and run plugin instances, till none left (RT-safe).
+void qtractorAudioGraph::process_job ( qtractorPlugin *pPlugin )
+{
+	for (;;) {
+		const unsigned int i = ATOMIC_INC(&m_jobIndex) - 1;
+		if (i >= m_iJobInstances)
+			break;
+		pPlugin->process_instance(i, m_iJobFrames);
+		join_done(&m_jobJoin);
+	}
+}
+
+
+// Fork-join barrier: arm for a number of pending parties.
+void qtractorAudioGraph::join_reset ( Join *pJoin, int iPending )
+{
+	ATOMIC_SET(&pJoin->waiting, 0);
+	pJoin->pending.storeRelease(iPending);
+}
+
+
+// Fork-join barrier: one party done (RT-safe).
+void qtractorAudioGraph::join_done ( Join *pJoin )
+{
+	if (ATOMIC_DEC(&pJoin->pending) == 0 && ATOMIC_TAZ(&pJoin->waiting))
+		pJoin->sem.release();
+}
+
+
+// Fork-join barrier: spin a bounded while, helping on any
+// plugin instances job, then block until all parties done.
+void qtractorAudioGraph::join_wait ( Join *pJoin )
+{
+	for (int i = 0; i < QTRACTOR_GRAPH_JOIN_SPINS; ++i) {
+		if (pJoin->pending.loadAcquire() < 1)
+			return;
+		process_jobs();
+	}
+
+	// Either the last party sees us waiting and wakes us up,
+	// or we see it done, and take the wake-up back if still ours...
+	ATOMIC_TAS(&pJoin->waiting);
+	if (pJoin->pending.loadAcquire() > 0 || !ATOMIC_TAZ(&pJoin->waiting))
+		pJoin->sem.acquire();
+}
+
+
+// Run tasks from own slice first, then steal from others' (RT-safe).
+void qtractorAudioGraph::process_tasks ( unsigned int iSlice )
+{
+	for (unsigned int k = 0; k < m_iSlices; ++k) {
+		Slice *pSlice = &m_pSlices[(iSlice + k) % m_iSlices];
+		for (;;) {
+			const unsigned int iTask = ATOMIC_INC(&pSlice->index) - 1;
+			if (iTask >= pSlice->end)
+				break;
+			process_task(iTask);
+		}
+	}
+}
+
+
+// Single task executive: all grouped tracks in serial (RT-safe).
+void qtractorAudioGraph::process_task ( unsigned int iTask )
+{
+	unsigned int iNode = m_pTasks[iTask];
+	while (iNode != QTRACTOR_GRAPH_NONE) {
+		Node *pNode = &m_pNodes[iNode];
+		if (m_bExport) {
+			pNode->track->process_export_buffer(pNode->clips,
+				m_iFrameStart, m_iFrameEnd);
+		} else {
+			pNode->track->process_buffer(pNode->clips,
+				m_iFrameStart, m_iFrameEnd);
+		}
+		iNode = pNode->next;
+	}
+}
+
+
+// Serial (fallback) process cycle executive.
+void qtractorAudioGraph::process_serial (
+	qtractorSessionSnapshot *pSnapshot,
+	qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	const unsigned int iTracks = pSnapshot->tracks();
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
+		if (pTrack->trackType() != qtractorTrack::Audio)
+			continue;
+		if (m_bExport) {
+			pTrack->process_export_buffer(pSessionCursor->clips(iTrack),
+				iFrameStart, iFrameEnd);
+			pTrack->process_commit(iFrameEnd - iFrameStart);
+		} else {
+			pTrack->process(pSessionCursor->clips(iTrack),
+				iFrameStart, iFrameEnd);
+		}
+	}
+}
+
+
+// end of qtractorAudioGraph.cpp
@@ -0,0 +1,253 @@
+// qtractorAudioGraph.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioGraph_h
+#define __qtractorAudioGraph_h
+
+#include "qtractorAtomic.h"
+
+#include <QThread>
+#include <QSemaphore>
+#include <QAtomicPointer>
+
+
+// Forward declarations.
+class qtractorAudioEngine;
+class qtractorAudioGraph;
+class qtractorSessionCursor;
+class qtractorSessionSnapshot;
+class qtractorTrack;
+class qtractorClip;
+class qtractorBus;
+class qtractorPlugin;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraphThread -- Audio graph (RT) worker thread.
+//
+
+class qtractorAudioGraphThread : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioGraphThread(
+		qtractorAudioGraph *pAudioGraph, unsigned int iWorker);
+
+	// Destructor.
+	~qtractorAudioGraphThread();
+
+	// Thread run state accessors.
+	void setRunState(bool bRunState);
+	bool runState() const;
+
+	// Wake from executive wait condition (RT-safe).
+	void sync();
+
+protected:
+
+	// The main thread executive.
+	void run();
+
+private:
+
+	// Instance variables.
+	qtractorAudioGraph *m_pAudioGraph;
+	unsigned int        m_iWorker;
+
+	// Whether the thread is logically running.
+	volatile bool m_bRunState;
+
+	// Thread synchronization object.
+	QSemaphore m_sem;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraph -- Parallel audio track process graph.
+//
+
+class qtractorAudioGraph
+{
+public:
+
+	// Constructor.
+	qtractorAudioGraph(qtractorAudioEngine *pAudioEngine,
+		unsigned int iWorkers, unsigned int iSize = 0);
+
+	// Destructor.
+	~qtractorAudioGraph();
+
+	// Audio engine accessor.
+	qtractorAudioEngine *audioEngine() const
+		{ return m_pAudioEngine; }
+
+	// Number of (RT) worker threads.
+	unsigned int workers() const
+		{ return m_iWorkers; }
+
+	// Conditional resize check (non RT-safe).
+	void checkSize(unsigned int iTracks);
+
+	// Process cycle executive (RT-safe).
+	void process(qtractorSessionSnapshot *pSnapshot,
+		qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Freewheeling/offline process cycle executive (export).
+	void process_export(qtractorSessionSnapshot *pSnapshot,
+		qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Plugin instances fork-join executive (RT-safe);
+	// shares the graph workers, serial when none idle.
+	void process_instances(qtractorPlugin *pPlugin,
+		unsigned short iInstances, unsigned int nframes);
+
+	// Worker thread cycle executive (RT-safe).
+	void process_worker(unsigned int iWorker);
+
+	// Default number of worker threads (-1=auto, 0=none).
+	static void setDefaultWorkers(int iWorkers);
+	static int defaultWorkers();
+
+	// Effective number of worker threads, as from default.
+	static unsigned int idealWorkers();
+
+protected:
+
+	// Common process cycle executive.
+	void process_graph(qtractorSessionSnapshot *pSnapshot,
+		qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport);
+
+	// (Re)build current cycle graph nodes and tasks (RT-safe);
+	// returns false on node capacity overflow.
+	bool build(qtractorSessionSnapshot *pSnapshot,
+		qtractorSessionCursor *pSessionCursor);
+
+	// Node group (union-find) helpers.
+	unsigned int findNode(unsigned int iNode);
+	void unionNodes(unsigned int iNode1, unsigned int iNode2);
+
+	// Aux-send bus edge helper.
+	bool addBusNode(qtractorBus *pBus, unsigned int iNode);
+
+	// Task executives.
+	void process_tasks(unsigned int iSlice);
+	void process_task(unsigned int iTask);
+
+	// Serial (fallback) process cycle executive.
+	void process_serial(qtractorSessionSnapshot *pSnapshot,
+		qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Plugin instance job helpers (RT-safe).
+	void process_jobs();
+	void process_job(qtractorPlugin *pPlugin);
+
+private:
+
+	// Fork-join barrier: bounded spin, then blocking wait.
+	struct Join
+	{
+		qtractorAtomic pending;
+		qtractorAtomic waiting;
+		QSemaphore     sem;
+	};
+
+	void join_reset(Join *pJoin, int iPending);
+	void join_done(Join *pJoin);
+	void join_wait(Join *pJoin);
+
+	// Graph node (track) descriptor.
+	struct Node
+	{
+		qtractorTrack *track;
+		qtractorClip **clips;
+		unsigned int   parent;	// Group root (union-find).
+		unsigned int   next;	// Next node in same task chain.
+		unsigned int   last;	// Last node in task chain (root only).
+	};
+
+	// Per-participant task slice (work-stealing).
+	struct Slice
+	{
+		qtractorAtomic index;
+		unsigned int   end;
+	};
+
+	// Instance variables.
+	qtractorAudioEngine *m_pAudioEngine;
+
+	unsigned int m_iWorkers;
+
+	qtractorAudioGraphThread **m_ppThreads;
+
+	// Graph node/task capacity.
+	unsigned int  m_iSize;
+
+	Node         *m_pNodes;
+	unsigned int  m_iNodes;
+
+	unsigned int *m_pTasks;
+	unsigned int  m_iTasks;
+
+	// Aux-send target bus edges.
+	qtractorBus **m_ppBuses;
+	unsigned int *m_pBusNodes;
+	unsigned int  m_iBuses;
+
+	// Work-stealing slices (one per participant).
+	Slice        *m_pSlices;
+	unsigned int  m_iSlices;
+
+	// Woken workers still running (graph join).
+	Join           m_graphJoin;
+
+	// Current cycle serial and number of enlisted workers,
+	// packed in one word; and each worker's last cycle seen.
+	qtractorAtomic m_cycle;
+	int           *m_piCycles;
+
+	// Plugin instances job slot (one in flight at a time).
+	QAtomicPointer<qtractorPlugin> m_pJobPlugin;
+	unsigned short m_iJobInstances;
+	unsigned int   m_iJobFrames;
+	qtractorAtomic m_jobIndex;
+	qtractorAtomic m_jobHelpers;
+	qtractorAtomic m_jobBusy;
+	Join           m_jobJoin;
+
+	// Current cycle frame range and mode.
+	unsigned long m_iFrameStart;
+	unsigned long m_iFrameEnd;
+	bool          m_bExport;
+
+	// Default number of worker threads.
+	static int g_iDefaultWorkers;
+};
+
+
+#endif  // __qtractorAudioGraph_h
+
+
+// end of qtractorAudioGraph.h
@@ -0,0 +1,1115 @@
+// qtractorAudioKernel.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAudioKernel.h"
+
+#include <cstring>
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONFIG_KERNEL_X86
+#include <immintrin.h>
+#define KERNEL_SSE2   __attribute__ ((target ("sse2")))
+#define KERNEL_AVX2   __attribute__ ((target ("avx2,fma")))
+#define KERNEL_AVX512 __attribute__ ((target ("avx512f")))
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CONFIG_KERNEL_NEON
+#include "arm_neon.h"
+#endif
+
+
+//----------------------------------------------------------------------
+// Standard processor versions.
+//
+
+static void std_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pBuffer[n] += pFrames[n];
+}
+
+static void std_gain (
+	float *pFrames, unsigned int iFrames, float fGain )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pFrames[n] *= fGain;
+}
+
+static void std_gain_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames, float fGain )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pBuffer[n] += fGain * pFrames[n];
+}
+
+static void std_dry_wet (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fDry, float fWet )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pBuffer[n] = fWet * pBuffer[n] + fDry * pFrames[n];
+}
+
+static void std_ramp (
+	float *pFrames, unsigned int iFrames, float fGain, float fGainStep )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pFrames[n] *= fGain + float(n) * fGainStep;
+}
+
+static void std_ramp_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pBuffer[n] += (fGain + float(n) * fGainStep) * pFrames[n];
+}
+
+static void std_peak (
+	const float *pFrames, unsigned int iFrames, float *pfPeak )
+{
+	float fPeak = *pfPeak;
+	for (unsigned int n = 0; n < iFrames; ++n) {
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void std_gain_peak (
+	float *pFrames, unsigned int iFrames, float fGain, float *pfPeak )
+{
+	float fPeak = *pfPeak;
+	for (unsigned int n = 0; n < iFrames; ++n) {
+		pFrames[n] *= fGain;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void std_ramp_peak (
+	float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep, float *pfPeak )
+{
+	float fPeak = *pfPeak;
+	for (unsigned int n = 0; n < iFrames; ++n) {
+		pFrames[n] *= fGain + float(n) * fGainStep;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void std_interleave (
+	float *pBuffer, float **ppFrames,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels == 1) {
+		::memcpy(pBuffer, ppFrames[0], iFrames * sizeof(float));
+		return;
+	}
+
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		const float *pFrames = ppFrames[i];
+		float *pFrame = pBuffer + i;
+		for (unsigned int n = 0; n < iFrames; ++n) {
+			*pFrame = pFrames[n];
+			pFrame += iChannels;
+		}
+	}
+}
+
+static void std_deinterleave (
+	float **ppFrames, const float *pBuffer,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels == 1) {
+		::memcpy(ppFrames[0], pBuffer, iFrames * sizeof(float));
+		return;
+	}
+
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		float *pFrames = ppFrames[i];
+		const float *pFrame = pBuffer + i;
+		for (unsigned int n = 0; n < iFrames; ++n) {
+			pFrames[n] = *pFrame;
+			pFrame += iChannels;
+		}
+	}
+}
+
+
+#if defined(CONFIG_KERNEL_X86)
+
+//----------------------------------------------------------------------
+// SSE2 enabled processor versions.
+//
+
+KERNEL_SSE2 static inline float sse2_hmax ( __m128 v )
+{
+	v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_cvtss_f32(v);
+}
+
+KERNEL_SSE2 static inline __m128 sse2_ramp_init ( float fGain, float fGainStep )
+{
+	return _mm_add_ps(_mm_set1_ps(fGain),
+		_mm_mul_ps(_mm_set1_ps(fGainStep), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f)));
+}
+
+KERNEL_SSE2 static void sse2_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames )
+{
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pBuffer + n, _mm_add_ps(
+			_mm_loadu_ps(pBuffer + n), _mm_loadu_ps(pFrames + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += pFrames[n];
+}
+
+KERNEL_SSE2 static void sse2_gain (
+	float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m128 vGain = _mm_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4)
+		_mm_storeu_ps(pFrames + n, _mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain));
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain;
+}
+
+KERNEL_SSE2 static void sse2_gain_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m128 vGain = _mm_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pBuffer + n, _mm_add_ps(_mm_loadu_ps(pBuffer + n),
+			_mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += fGain * pFrames[n];
+}
+
+KERNEL_SSE2 static void sse2_dry_wet (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fDry, float fWet )
+{
+	const __m128 vDry = _mm_set1_ps(fDry);
+	const __m128 vWet = _mm_set1_ps(fWet);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pBuffer + n, _mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(pBuffer + n), vWet),
+			_mm_mul_ps(_mm_loadu_ps(pFrames + n), vDry)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] = fWet * pBuffer[n] + fDry * pFrames[n];
+}
+
+KERNEL_SSE2 static void sse2_ramp (
+	float *pFrames, unsigned int iFrames, float fGain, float fGainStep )
+{
+	__m128 vGain = sse2_ramp_init(fGain, fGainStep);
+	const __m128 vStep = _mm_set1_ps(4.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pFrames + n, _mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain));
+		vGain = _mm_add_ps(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain + float(n) * fGainStep;
+}
+
+KERNEL_SSE2 static void sse2_ramp_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep )
+{
+	__m128 vGain = sse2_ramp_init(fGain, fGainStep);
+	const __m128 vStep = _mm_set1_ps(4.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pBuffer + n, _mm_add_ps(_mm_loadu_ps(pBuffer + n),
+			_mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain)));
+		vGain = _mm_add_ps(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += (fGain + float(n) * fGainStep) * pFrames[n];
+}
+
+KERNEL_SSE2 static void sse2_peak (
+	const float *pFrames, unsigned int iFrames, float *pfPeak )
+{
+	__m128 vPeak = _mm_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4)
+		vPeak = _mm_max_ps(vPeak, _mm_loadu_ps(pFrames + n));
+	float fPeak = sse2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+KERNEL_SSE2 static void sse2_gain_peak (
+	float *pFrames, unsigned int iFrames, float fGain, float *pfPeak )
+{
+	const __m128 vGain = _mm_set1_ps(fGain);
+	__m128 vPeak = _mm_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const __m128 v = _mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain);
+		vPeak = _mm_max_ps(vPeak, v);
+		_mm_storeu_ps(pFrames + n, v);
+	}
+	float fPeak = sse2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+KERNEL_SSE2 static void sse2_ramp_peak (
+	float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep, float *pfPeak )
+{
+	__m128 vGain = sse2_ramp_init(fGain, fGainStep);
+	const __m128 vStep = _mm_set1_ps(4.0f * fGainStep);
+	__m128 vPeak = _mm_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const __m128 v = _mm_mul_ps(_mm_loadu_ps(pFrames + n), vGain);
+		vPeak = _mm_max_ps(vPeak, v);
+		_mm_storeu_ps(pFrames + n, v);
+		vGain = _mm_add_ps(vGain, vStep);
+	}
+	float fPeak = sse2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain + float(n) * fGainStep;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+KERNEL_SSE2 static void sse2_interleave (
+	float *pBuffer, float **ppFrames,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels != 2) {
+		std_interleave(pBuffer, ppFrames, iChannels, iFrames);
+		return;
+	}
+
+	const float *pFrames0 = ppFrames[0];
+	const float *pFrames1 = ppFrames[1];
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const __m128 v0 = _mm_loadu_ps(pFrames0 + n);
+		const __m128 v1 = _mm_loadu_ps(pFrames1 + n);
+		_mm_storeu_ps(pBuffer + (n << 1), _mm_unpacklo_ps(v0, v1));
+		_mm_storeu_ps(pBuffer + (n << 1) + 4, _mm_unpackhi_ps(v0, v1));
+	}
+	for (; n < iFrames; ++n) {
+		pBuffer[(n << 1)] = pFrames0[n];
+		pBuffer[(n << 1) + 1] = pFrames1[n];
+	}
+}
+
+KERNEL_SSE2 static void sse2_deinterleave (
+	float **ppFrames, const float *pBuffer,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels != 2) {
+		std_deinterleave(ppFrames, pBuffer, iChannels, iFrames);
+		return;
+	}
+
+	float *pFrames0 = ppFrames[0];
+	float *pFrames1 = ppFrames[1];
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const __m128 v0 = _mm_loadu_ps(pBuffer + (n << 1));
+		const __m128 v1 = _mm_loadu_ps(pBuffer + (n << 1) + 4);
+		_mm_storeu_ps(pFrames0 + n, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(pFrames1 + n, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+	for (; n < iFrames; ++n) {
+		pFrames0[n] = pBuffer[(n << 1)];
+		pFrames1[n] = pBuffer[(n << 1) + 1];
+	}
+}
+
+
+//----------------------------------------------------------------------
+// AVX2 (and FMA) enabled processor versions.
+//
+
+KERNEL_AVX2 static inline float avx2_hmax ( __m256 v )
+{
+	__m128 v4 = _mm_max_ps(
+		_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	v4 = _mm_max_ps(v4, _mm_shuffle_ps(v4, v4, _MM_SHUFFLE(2, 3, 0, 1)));
+	v4 = _mm_max_ps(v4, _mm_shuffle_ps(v4, v4, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_cvtss_f32(v4);
+}
+
+KERNEL_AVX2 static inline __m256 avx2_ramp_init ( float fGain, float fGainStep )
+{
+	return _mm256_fmadd_ps(_mm256_set1_ps(fGainStep),
+		_mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f),
+		_mm256_set1_ps(fGain));
+}
+
+KERNEL_AVX2 static void avx2_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames )
+{
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pBuffer + n, _mm256_add_ps(
+			_mm256_loadu_ps(pBuffer + n), _mm256_loadu_ps(pFrames + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += pFrames[n];
+}
+
+KERNEL_AVX2 static void avx2_gain (
+	float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m256 vGain = _mm256_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pFrames + n,
+			_mm256_mul_ps(_mm256_loadu_ps(pFrames + n), vGain));
+	}
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain;
+}
+
+KERNEL_AVX2 static void avx2_gain_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m256 vGain = _mm256_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pBuffer + n, _mm256_fmadd_ps(
+			_mm256_loadu_ps(pFrames + n), vGain, _mm256_loadu_ps(pBuffer + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += fGain * pFrames[n];
+}
+
+KERNEL_AVX2 static void avx2_dry_wet (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fDry, float fWet )
+{
+	const __m256 vDry = _mm256_set1_ps(fDry);
+	const __m256 vWet = _mm256_set1_ps(fWet);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pBuffer + n, _mm256_fmadd_ps(
+			_mm256_loadu_ps(pFrames + n), vDry,
+			_mm256_mul_ps(_mm256_loadu_ps(pBuffer + n), vWet)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] = fWet * pBuffer[n] + fDry * pFrames[n];
+}
+
+KERNEL_AVX2 static void avx2_ramp (
+	float *pFrames, unsigned int iFrames, float fGain, float fGainStep )
+{
+	__m256 vGain = avx2_ramp_init(fGain, fGainStep);
+	const __m256 vStep = _mm256_set1_ps(8.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pFrames + n,
+			_mm256_mul_ps(_mm256_loadu_ps(pFrames + n), vGain));
+		vGain = _mm256_add_ps(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain + float(n) * fGainStep;
+}
+
+KERNEL_AVX2 static void avx2_ramp_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep )
+{
+	__m256 vGain = avx2_ramp_init(fGain, fGainStep);
+	const __m256 vStep = _mm256_set1_ps(8.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pBuffer + n, _mm256_fmadd_ps(
+			_mm256_loadu_ps(pFrames + n), vGain, _mm256_loadu_ps(pBuffer + n)));
+		vGain = _mm256_add_ps(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += (fGain + float(n) * fGainStep) * pFrames[n];
+}
+
+KERNEL_AVX2 static void avx2_peak (
+	const float *pFrames, unsigned int iFrames, float *pfPeak )
+{
+	__m256 vPeak = _mm256_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8)
+		vPeak = _mm256_max_ps(vPeak, _mm256_loadu_ps(pFrames + n));
+	float fPeak = avx2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+KERNEL_AVX2 static void avx2_gain_peak (
+	float *pFrames, unsigned int iFrames, float fGain, float *pfPeak )
+{
+	const __m256 vGain = _mm256_set1_ps(fGain);
+	__m256 vPeak = _mm256_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(pFrames + n), vGain);
+		vPeak = _mm256_max_ps(vPeak, v);
+		_mm256_storeu_ps(pFrames + n, v);
+	}
+	float fPeak = avx2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+KERNEL_AVX2 static void avx2_ramp_peak (
+	float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep, float *pfPeak )
+{
+	__m256 vGain = avx2_ramp_init(fGain, fGainStep);
+	const __m256 vStep = _mm256_set1_ps(8.0f * fGainStep);
+	__m256 vPeak = _mm256_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 8 <= iFrames; n += 8) {
+		const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(pFrames + n), vGain);
+		vPeak = _mm256_max_ps(vPeak, v);
+		_mm256_storeu_ps(pFrames + n, v);
+		vGain = _mm256_add_ps(vGain, vStep);
+	}
+	float fPeak = avx2_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain + float(n) * fGainStep;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+
+//----------------------------------------------------------------------
+// AVX-512 enabled processor versions (masked tails).
+//
+
+// Masked forms avoid _mm512_undefined_ps() warnings on some GCC versions.
+KERNEL_AVX512 static inline __m512 avx512_max ( __m512 a, __m512 b )
+{
+	return _mm512_mask_max_ps(a, __mmask16(0xffff), a, b);
+}
+
+KERNEL_AVX512 static inline float avx512_hmax ( __m512 v )
+{
+	float afPeak[16];
+	_mm512_storeu_ps(afPeak, v);
+	float fPeak = afPeak[0];
+	for (unsigned int n = 1; n < 16; ++n) {
+		if (fPeak < afPeak[n])
+			fPeak = afPeak[n];
+	}
+	return fPeak;
+}
+
+KERNEL_AVX512 static inline __mmask16 avx512_mask ( unsigned int iFrames )
+{
+	return __mmask16((1U << iFrames) - 1);
+}
+
+KERNEL_AVX512 static inline __m512 avx512_ramp_init ( float fGain, float fGainStep )
+{
+	return _mm512_fmadd_ps(_mm512_set1_ps(fGainStep),
+		_mm512_setr_ps(
+			 0.0f,  1.0f,  2.0f,  3.0f,  4.0f,  5.0f,  6.0f,  7.0f,
+			 8.0f,  9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f),
+		_mm512_set1_ps(fGain));
+}
+
+KERNEL_AVX512 static void avx512_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames )
+{
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pBuffer + n, _mm512_add_ps(
+			_mm512_loadu_ps(pBuffer + n), _mm512_loadu_ps(pFrames + n)));
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pBuffer + n, m, _mm512_add_ps(
+			_mm512_maskz_loadu_ps(m, pBuffer + n),
+			_mm512_maskz_loadu_ps(m, pFrames + n)));
+	}
+}
+
+KERNEL_AVX512 static void avx512_gain (
+	float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m512 vGain = _mm512_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pFrames + n,
+			_mm512_mul_ps(_mm512_loadu_ps(pFrames + n), vGain));
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pFrames + n, m,
+			_mm512_mul_ps(_mm512_maskz_loadu_ps(m, pFrames + n), vGain));
+	}
+}
+
+KERNEL_AVX512 static void avx512_gain_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames, float fGain )
+{
+	const __m512 vGain = _mm512_set1_ps(fGain);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pBuffer + n, _mm512_fmadd_ps(
+			_mm512_loadu_ps(pFrames + n), vGain, _mm512_loadu_ps(pBuffer + n)));
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pBuffer + n, m, _mm512_fmadd_ps(
+			_mm512_maskz_loadu_ps(m, pFrames + n), vGain,
+			_mm512_maskz_loadu_ps(m, pBuffer + n)));
+	}
+}
+
+KERNEL_AVX512 static void avx512_dry_wet (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fDry, float fWet )
+{
+	const __m512 vDry = _mm512_set1_ps(fDry);
+	const __m512 vWet = _mm512_set1_ps(fWet);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pBuffer + n, _mm512_fmadd_ps(
+			_mm512_loadu_ps(pFrames + n), vDry,
+			_mm512_mul_ps(_mm512_loadu_ps(pBuffer + n), vWet)));
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pBuffer + n, m, _mm512_fmadd_ps(
+			_mm512_maskz_loadu_ps(m, pFrames + n), vDry,
+			_mm512_mul_ps(_mm512_maskz_loadu_ps(m, pBuffer + n), vWet)));
+	}
+}
+
+KERNEL_AVX512 static void avx512_ramp (
+	float *pFrames, unsigned int iFrames, float fGain, float fGainStep )
+{
+	__m512 vGain = avx512_ramp_init(fGain, fGainStep);
+	const __m512 vStep = _mm512_set1_ps(16.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pFrames + n,
+			_mm512_mul_ps(_mm512_loadu_ps(pFrames + n), vGain));
+		vGain = _mm512_add_ps(vGain, vStep);
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pFrames + n, m,
+			_mm512_mul_ps(_mm512_maskz_loadu_ps(m, pFrames + n), vGain));
+	}
+}
+
+KERNEL_AVX512 static void avx512_ramp_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep )
+{
+	__m512 vGain = avx512_ramp_init(fGain, fGainStep);
+	const __m512 vStep = _mm512_set1_ps(16.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		_mm512_storeu_ps(pBuffer + n, _mm512_fmadd_ps(
+			_mm512_loadu_ps(pFrames + n), vGain, _mm512_loadu_ps(pBuffer + n)));
+		vGain = _mm512_add_ps(vGain, vStep);
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		_mm512_mask_storeu_ps(pBuffer + n, m, _mm512_fmadd_ps(
+			_mm512_maskz_loadu_ps(m, pFrames + n), vGain,
+			_mm512_maskz_loadu_ps(m, pBuffer + n)));
+	}
+}
+
+KERNEL_AVX512 static void avx512_peak (
+	const float *pFrames, unsigned int iFrames, float *pfPeak )
+{
+	__m512 vPeak = _mm512_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16)
+		vPeak = avx512_max(vPeak, _mm512_loadu_ps(pFrames + n));
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		vPeak = _mm512_mask_max_ps(vPeak, m, vPeak,
+			_mm512_maskz_loadu_ps(m, pFrames + n));
+	}
+	*pfPeak = avx512_hmax(vPeak);
+}
+
+KERNEL_AVX512 static void avx512_gain_peak (
+	float *pFrames, unsigned int iFrames, float fGain, float *pfPeak )
+{
+	const __m512 vGain = _mm512_set1_ps(fGain);
+	__m512 vPeak = _mm512_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		const __m512 v = _mm512_mul_ps(_mm512_loadu_ps(pFrames + n), vGain);
+		vPeak = avx512_max(vPeak, v);
+		_mm512_storeu_ps(pFrames + n, v);
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		const __m512 v = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, pFrames + n), vGain);
+		vPeak = _mm512_mask_max_ps(vPeak, m, vPeak, v);
+		_mm512_mask_storeu_ps(pFrames + n, m, v);
+	}
+	*pfPeak = avx512_hmax(vPeak);
+}
+
+KERNEL_AVX512 static void avx512_ramp_peak (
+	float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep, float *pfPeak )
+{
+	__m512 vGain = avx512_ramp_init(fGain, fGainStep);
+	const __m512 vStep = _mm512_set1_ps(16.0f * fGainStep);
+	__m512 vPeak = _mm512_set1_ps(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 16 <= iFrames; n += 16) {
+		const __m512 v = _mm512_mul_ps(_mm512_loadu_ps(pFrames + n), vGain);
+		vPeak = avx512_max(vPeak, v);
+		_mm512_storeu_ps(pFrames + n, v);
+		vGain = _mm512_add_ps(vGain, vStep);
+	}
+	if (n < iFrames) {
+		const __mmask16 m = avx512_mask(iFrames - n);
+		const __m512 v = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, pFrames + n), vGain);
+		vPeak = _mm512_mask_max_ps(vPeak, m, vPeak, v);
+		_mm512_mask_storeu_ps(pFrames + n, m, v);
+	}
+	*pfPeak = avx512_hmax(vPeak);
+}
+
+#endif // CONFIG_KERNEL_X86
+
+
+#if defined(CONFIG_KERNEL_NEON)
+
+//----------------------------------------------------------------------
+// NEON enabled processor versions.
+//
+
+static inline float neon_hmax ( float32x4_t v )
+{
+	float32x2_t v2 = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+	v2 = vpmax_f32(v2, v2);
+	return vget_lane_f32(v2, 0);
+}
+
+static inline float32x4_t neon_ramp_init ( float fGain, float fGainStep )
+{
+	const float fInitGain[4] = {
+		fGain,
+		fGain + fGainStep,
+		fGain + 2.0f * fGainStep,
+		fGain + 3.0f * fGainStep };
+	return vld1q_f32(fInitGain);
+}
+
+static void neon_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames )
+{
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pBuffer + n,
+			vaddq_f32(vld1q_f32(pBuffer + n), vld1q_f32(pFrames + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += pFrames[n];
+}
+
+static void neon_gain (
+	float *pFrames, unsigned int iFrames, float fGain )
+{
+	const float32x4_t vGain = vdupq_n_f32(fGain);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4)
+		vst1q_f32(pFrames + n, vmulq_f32(vld1q_f32(pFrames + n), vGain));
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain;
+}
+
+static void neon_gain_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames, float fGain )
+{
+	const float32x4_t vGain = vdupq_n_f32(fGain);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		// Vr[i] := Va[i] + Vb[i] * Vc[i]
+		vst1q_f32(pBuffer + n,
+			vmlaq_f32(vld1q_f32(pBuffer + n), vGain, vld1q_f32(pFrames + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += fGain * pFrames[n];
+}
+
+static void neon_dry_wet (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fDry, float fWet )
+{
+	const float32x4_t vDry = vdupq_n_f32(fDry);
+	const float32x4_t vWet = vdupq_n_f32(fWet);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pBuffer + n, vmlaq_f32(
+			vmulq_f32(vld1q_f32(pBuffer + n), vWet),
+			vDry, vld1q_f32(pFrames + n)));
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] = fWet * pBuffer[n] + fDry * pFrames[n];
+}
+
+static void neon_ramp (
+	float *pFrames, unsigned int iFrames, float fGain, float fGainStep )
+{
+	float32x4_t vGain = neon_ramp_init(fGain, fGainStep);
+	const float32x4_t vStep = vdupq_n_f32(4.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pFrames + n, vmulq_f32(vld1q_f32(pFrames + n), vGain));
+		vGain = vaddq_f32(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pFrames[n] *= fGain + float(n) * fGainStep;
+}
+
+static void neon_ramp_add (
+	float *pBuffer, const float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep )
+{
+	float32x4_t vGain = neon_ramp_init(fGain, fGainStep);
+	const float32x4_t vStep = vdupq_n_f32(4.0f * fGainStep);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pBuffer + n,
+			vmlaq_f32(vld1q_f32(pBuffer + n), vGain, vld1q_f32(pFrames + n)));
+		vGain = vaddq_f32(vGain, vStep);
+	}
+	for (; n < iFrames; ++n)
+		pBuffer[n] += (fGain + float(n) * fGainStep) * pFrames[n];
+}
+
+static void neon_peak (
+	const float *pFrames, unsigned int iFrames, float *pfPeak )
+{
+	float32x4_t vPeak = vdupq_n_f32(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4)
+		vPeak = vmaxq_f32(vPeak, vld1q_f32(pFrames + n));
+	float fPeak = neon_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void neon_gain_peak (
+	float *pFrames, unsigned int iFrames, float fGain, float *pfPeak )
+{
+	const float32x4_t vGain = vdupq_n_f32(fGain);
+	float32x4_t vPeak = vdupq_n_f32(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const float32x4_t v = vmulq_f32(vld1q_f32(pFrames + n), vGain);
+		vPeak = vmaxq_f32(vPeak, v);
+		vst1q_f32(pFrames + n, v);
+	}
+	float fPeak = neon_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void neon_ramp_peak (
+	float *pFrames, unsigned int iFrames,
+	float fGain, float fGainStep, float *pfPeak )
+{
+	float32x4_t vGain = neon_ramp_init(fGain, fGainStep);
+	const float32x4_t vStep = vdupq_n_f32(4.0f * fGainStep);
+	float32x4_t vPeak = vdupq_n_f32(*pfPeak);
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const float32x4_t v = vmulq_f32(vld1q_f32(pFrames + n), vGain);
+		vPeak = vmaxq_f32(vPeak, v);
+		vst1q_f32(pFrames + n, v);
+		vGain = vaddq_f32(vGain, vStep);
+	}
+	float fPeak = neon_hmax(vPeak);
+	for (; n < iFrames; ++n) {
+		pFrames[n] *= fGain + float(n) * fGainStep;
+		if (fPeak < pFrames[n])
+			fPeak = pFrames[n];
+	}
+	*pfPeak = fPeak;
+}
+
+static void neon_interleave (
+	float *pBuffer, float **ppFrames,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels != 2) {
+		std_interleave(pBuffer, ppFrames, iChannels, iFrames);
+		return;
+	}
+
+	const float *pFrames0 = ppFrames[0];
+	const float *pFrames1 = ppFrames[1];
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		float32x4x2_t v;
+		v.val[0] = vld1q_f32(pFrames0 + n);
+		v.val[1] = vld1q_f32(pFrames1 + n);
+		vst2q_f32(pBuffer + (n << 1), v);
+	}
+	for (; n < iFrames; ++n) {
+		pBuffer[(n << 1)] = pFrames0[n];
+		pBuffer[(n << 1) + 1] = pFrames1[n];
+	}
+}
+
+static void neon_deinterleave (
+	float **ppFrames, const float *pBuffer,
+	unsigned short iChannels, unsigned int iFrames )
+{
+	if (iChannels != 2) {
+		std_deinterleave(ppFrames, pBuffer, iChannels, iFrames);
+		return;
+	}
+
+	float *pFrames0 = ppFrames[0];
+	float *pFrames1 = ppFrames[1];
+	unsigned int n = 0;
+	for (; n + 4 <= iFrames; n += 4) {
+		const float32x4x2_t v = vld2q_f32(pBuffer + (n << 1));
+		vst1q_f32(pFrames0 + n, v.val[0]);
+		vst1q_f32(pFrames1 + n, v.val[1]);
+	}
+	for (; n < iFrames; ++n) {
+		pFrames0[n] = pBuffer[(n << 1)];
+		pFrames1[n] = pBuffer[(n << 1) + 1];
+	}
+}
+
+#endif // CONFIG_KERNEL_NEON
+
+
+//----------------------------------------------------------------------
+// Kernel dispatch tables.
+//
+
+static const qtractorAudioKernel::Kernels g_std_kernels = {
+	std_add, std_gain, std_gain_add, std_dry_wet,
+	std_ramp, std_ramp_add,
+	std_peak, std_gain_peak, std_ramp_peak,
+	std_interleave, std_deinterleave
+};
+
+#if defined(CONFIG_KERNEL_X86)
+
+static const qtractorAudioKernel::Kernels g_sse2_kernels = {
+	sse2_add, sse2_gain, sse2_gain_add, sse2_dry_wet,
+	sse2_ramp, sse2_ramp_add,
+	sse2_peak, sse2_gain_peak, sse2_ramp_peak,
+	sse2_interleave, sse2_deinterleave
+};
+
+// Interleaving is memory bound: SSE2 versions are just as fine.
+static const qtractorAudioKernel::Kernels g_avx2_kernels = {
+	avx2_add, avx2_gain, avx2_gain_add, avx2_dry_wet,
+	avx2_ramp, avx2_ramp_add,
+	avx2_peak, avx2_gain_peak, avx2_ramp_peak,
+	sse2_interleave, sse2_deinterleave
+};
+
+static const qtractorAudioKernel::Kernels g_avx512_kernels = {
+	avx512_add, avx512_gain, avx512_gain_add, avx512_dry_wet,
+	avx512_ramp, avx512_ramp_add,
+	avx512_peak, avx512_gain_peak, avx512_ramp_peak,
+	sse2_interleave, sse2_deinterleave
+};
+
+#endif // CONFIG_KERNEL_X86
+
+#if defined(CONFIG_KERNEL_NEON)
+
+static const qtractorAudioKernel::Kernels g_neon_kernels = {
+	neon_add, neon_gain, neon_gain_add, neon_dry_wet,
+	neon_ramp, neon_ramp_add,
+	neon_peak, neon_gain_peak, neon_ramp_peak,
+	neon_interleave, neon_deinterleave
+};
+
+#endif // CONFIG_KERNEL_NEON
+
+
+// Current dispatch table (statically initialized as standard).
+qtractorAudioKernel::Kernels qtractorAudioKernel::g_kernels = {
+	std_add, std_gain, std_gain_add, std_dry_wet,
+	std_ramp, std_ramp_add,
+	std_peak, std_gain_peak, std_ramp_peak,
+	std_interleave, std_deinterleave
+};
+
+// Current level.
+static qtractorAudioKernel::Level g_kernelLevel = qtractorAudioKernel::Std;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioKernel -- Runtime dispatched audio DSP kernels.
+//
+
+// Current and highest supported level.
+qtractorAudioKernel::Level qtractorAudioKernel::level (void)
+{
+	return g_kernelLevel;
+}
+
+
+qtractorAudioKernel::Level qtractorAudioKernel::maxLevel (void)
+{
+#if defined(CONFIG_KERNEL_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return AVX512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SSE2;
+#endif
+#if defined(CONFIG_KERNEL_NEON)
+	return NEON;
+#endif
+	return Std;
+}
+
+
+// Level override, clamped to highest supported (non RT-safe).
+void qtractorAudioKernel::setLevel ( Level level )
+{
+	const Level max_level = maxLevel();
+	if (level > max_level)
+		level = max_level;
+
+	switch (level) {
+#if defined(CONFIG_KERNEL_X86)
+	case AVX512:
+		g_kernels = g_avx512_kernels;
+		break;
+	case AVX2:
+		g_kernels = g_avx2_kernels;
+		break;
+	case SSE2:
+		g_kernels = g_sse2_kernels;
+		break;
+#endif
+#if defined(CONFIG_KERNEL_NEON)
+	case NEON:
+		g_kernels = g_neon_kernels;
+		break;
+#endif
+	default:
+		level = Std;
+		g_kernels = g_std_kernels;
+		break;
+	}
+
+	g_kernelLevel = level;
+}
+
+
+// Pretty level name.
+const char *qtractorAudioKernel::levelName ( Level level )
+{
+	switch (level) {
+	case NEON:   return "NEON";
+	case SSE2:   return "SSE2";
+	case AVX2:   return "AVX2";
+	case AVX512: return "AVX-512";
+	default:     return "Standard";
+	}
+}
+
+
+// Multi-channel mix-down, wrapping around output buffers.
+void qtractorAudioKernel::buffer_add (
+	float **ppBuffer, float **ppFrames, unsigned int iFrames,
+	unsigned short iBuffers, unsigned short iChannels, unsigned int iOffset )
+{
+	unsigned short j = 0;
+
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		(*g_kernels.add)(ppBuffer[j] + iOffset, ppFrames[i] + iOffset, iFrames);
+		if (++j >= iBuffers)
+			j = 0;
+	}
+}
+
+
+// Highest supported level auto-selection, on startup.
+static struct qtractorAudioKernelInit
+{
+	qtractorAudioKernelInit() { qtractorAudioKernel::setLevel(
+		qtractorAudioKernel::maxLevel()); }
+
+} g_audioKernelInit;
+
+
+// end of qtractorAudioKernel.cpp
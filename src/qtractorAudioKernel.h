@@ -0,0 +1,132 @@
+// qtractorAudioKernel.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioKernel_h
+#define __qtractorAudioKernel_h
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioKernel -- Runtime dispatched audio DSP kernels.
+//
+
+class qtractorAudioKernel
+{
+public:
+
+	// Instruction set levels.
+	enum Level { Std = 0, NEON, SSE2, AVX2, AVX512 };
+
+	// Current and highest supported level.
+	static Level level();
+	static Level maxLevel();
+
+	// Level override, clamped to highest supported (non RT-safe).
+	static void setLevel(Level level);
+
+	// Pretty level name.
+	static const char *levelName(Level level);
+
+	// Mix-down: pBuffer[n] += pFrames[n]
+	static void add(float *pBuffer, const float *pFrames,
+		unsigned int iFrames)
+		{ (*g_kernels.add)(pBuffer, pFrames, iFrames); }
+
+	// Gain: pFrames[n] *= fGain
+	static void gain(float *pFrames, unsigned int iFrames, float fGain)
+		{ (*g_kernels.gain)(pFrames, iFrames, fGain); }
+
+	// Gain mix-down: pBuffer[n] += fGain * pFrames[n]
+	static void gain_add(float *pBuffer, const float *pFrames,
+		unsigned int iFrames, float fGain)
+		{ (*g_kernels.gain_add)(pBuffer, pFrames, iFrames, fGain); }
+
+	// Dry/wet mix: pBuffer[n] = fWet * pBuffer[n] + fDry * pFrames[n]
+	static void dry_wet(float *pBuffer, const float *pFrames,
+		unsigned int iFrames, float fDry, float fWet)
+		{ (*g_kernels.dry_wet)(pBuffer, pFrames, iFrames, fDry, fWet); }
+
+	// Gain ramp: pFrames[n] *= fGain + n * fGainStep
+	static void ramp(float *pFrames, unsigned int iFrames,
+		float fGain, float fGainStep)
+		{ (*g_kernels.ramp)(pFrames, iFrames, fGain, fGainStep); }
+
+	// Gain ramp mix-down: pBuffer[n] += (fGain + n * fGainStep) * pFrames[n]
+	static void ramp_add(float *pBuffer, const float *pFrames,
+		unsigned int iFrames, float fGain, float fGainStep)
+		{ (*g_kernels.ramp_add)(pBuffer, pFrames, iFrames, fGain, fGainStep); }
+
+	// Peak meter: *pfPeak = max(*pfPeak, pFrames[n])
+	static void peak(const float *pFrames, unsigned int iFrames,
+		float *pfPeak)
+		{ (*g_kernels.peak)(pFrames, iFrames, pfPeak); }
+
+	// Gain and peak meter, in one pass.
+	static void gain_peak(float *pFrames, unsigned int iFrames,
+		float fGain, float *pfPeak)
+		{ (*g_kernels.gain_peak)(pFrames, iFrames, fGain, pfPeak); }
+
+	// Gain ramp and peak meter, in one pass.
+	static void ramp_peak(float *pFrames, unsigned int iFrames,
+		float fGain, float fGainStep, float *pfPeak)
+		{ (*g_kernels.ramp_peak)(pFrames, iFrames, fGain, fGainStep, pfPeak); }
+
+	// Interleave channel buffers into a frame buffer.
+	static void interleave(float *pBuffer, float **ppFrames,
+		unsigned short iChannels, unsigned int iFrames)
+		{ (*g_kernels.interleave)(pBuffer, ppFrames, iChannels, iFrames); }
+
+	// De-interleave a frame buffer into channel buffers.
+	static void deinterleave(float **ppFrames, const float *pBuffer,
+		unsigned short iChannels, unsigned int iFrames)
+		{ (*g_kernels.deinterleave)(ppFrames, pBuffer, iChannels, iFrames); }
+
+	// Multi-channel mix-down, wrapping around output buffers.
+	static void buffer_add(float **ppBuffer, float **ppFrames,
+		unsigned int iFrames, unsigned short iBuffers,
+		unsigned short iChannels, unsigned int iOffset);
+
+	// Kernel dispatch table.
+	struct Kernels
+	{
+		void (*add)(float *, const float *, unsigned int);
+		void (*gain)(float *, unsigned int, float);
+		void (*gain_add)(float *, const float *, unsigned int, float);
+		void (*dry_wet)(float *, const float *, unsigned int, float, float);
+		void (*ramp)(float *, unsigned int, float, float);
+		void (*ramp_add)(float *, const float *, unsigned int, float, float);
+		void (*peak)(const float *, unsigned int, float *);
+		void (*gain_peak)(float *, unsigned int, float, float *);
+		void (*ramp_peak)(float *, unsigned int, float, float, float *);
+		void (*interleave)(float *, float **, unsigned short, unsigned int);
+		void (*deinterleave)(float **, const float *, unsigned short, unsigned int);
+	};
+
+private:
+
+	// Current dispatch table.
+	static Kernels g_kernels;
+};
+
+
+#endif  // __qtractorAudioKernel_h
+
+
+// end of qtractorAudioKernel.h
@@ -22,223 +22,31 @@
 #include "qtractorAudioMonitor.h"
 
 #include "qtractorAudioMeter.h"
+#include "qtractorAudioKernel.h"
 
 #include <cmath>
 
 
-#if defined(__SSE__)
-
-#include <xmmintrin.h>
-
-// SSE detection.
-static inline bool sse_enabled (void)
-{
-#if defined(__GNUC__)
-	unsigned int eax, ebx, ecx, edx;
-#if defined(__x86_64__) || (!defined(PIC) && !defined(__PIC__))
-	__asm__ __volatile__ (
-		"cpuid\n\t" \
-		: "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#else
-	__asm__ __volatile__ (
-		"push %%ebx\n\t" \
-		"cpuid\n\t" \
-		"movl %%ebx,%1\n\t" \
-		"pop %%ebx\n\t" \
-		: "=a" (eax), "=r" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#endif
-	return (edx & (1 << 25));
-#else
-	return false;
-#endif
-}
-
-// SSE enabled processor versions.
-static inline void sse_process (
+// Monitoring evaluator processors.
+static inline void monitor_process (
 	float *pFrames, unsigned int iFrames, float fGain, float *pfValue )
 {
-	__m128 v0 = _mm_load_ps1(&fGain);
-	__m128 v1 = _mm_load_ps1(pfValue);
-	__m128 v2;
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames)
-		*pFrames++ *= fGain;
-	
-	for (; iFrames >= 4; iFrames -= 4) {
-		v2 = _mm_mul_ps(_mm_loadu_ps(pFrames), v0);
-		v1 = _mm_max_ps(v2, v1);
-		_mm_store_ps(pFrames, v2);
-		pFrames += 4;
-	}
-	
-	for (; iFrames > 0; --iFrames)
-		*pFrames++ *= fGain;
-
-	*pfValue = *(float *) &v1; // CHEAT: take 1st of 4 possible values.
+	qtractorAudioKernel::gain_peak(pFrames, iFrames, fGain, pfValue);
 }
 
-static inline void sse_process_ramp ( float *pFrames, unsigned int iFrames,
-	float fGainIter, float fGainLast, float *pfValue )
-{
-	__m128 v1 = _mm_load_ps1(pfValue);
-	__m128 v2;
-
-	const float fGainStep = 4.0f * (fGainLast - fGainIter) / float(iFrames);
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames)
-		*pFrames++ *= fGainIter;
-
-	for (; iFrames >= 4; iFrames -= 4) {
-		v2 = _mm_mul_ps(_mm_loadu_ps(pFrames), _mm_load_ps1(&fGainIter));
-		v1 = _mm_max_ps(v2, v1);
-		_mm_store_ps(pFrames, v2);
-		fGainIter += fGainStep;
-		pFrames += 4;
-	}
-
-	for (; iFrames > 0; --iFrames)
-		*pFrames++ *= fGainIter;
-
-	*pfValue = *(float *) &v1; // CHEAT: take 1st of 4 possible values.
-}
-
-static inline void sse_process_meter (
-	float *pFrames, unsigned int iFrames, float *pfValue )
-{
-	__m128 v1 = _mm_load_ps1(pfValue);
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames)
-		++pFrames;
-	
-	for (; iFrames >= 4; iFrames -= 4) {
-		v1 = _mm_max_ps(_mm_loadu_ps(pFrames), v1);
-		pFrames += 4;
-	}
-	
-	*pfValue = *(float *) &v1; // CHEAT: take 1st of 4 possible values.
-}
-
-#endif // __SSE__
-
-
-#if defined(__ARM_NEON__)
-
-#include "arm_neon.h"
-
-// NEON enabled processor versions.
-static inline void neon_process (
-	float *pFrames, unsigned int iFrames, float fGain, float *pfValue )
-{
-	float32x4_t v0 = vld1q_dup_f32(&fGain);
-	float32x4_t v1 = vld1q_dup_f32(pfValue);
-	float32x4_t v2;
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames)
-		*pFrames++ *= fGain;
-
-	for (; iFrames >= 4; iFrames -= 4) {
-		v2 = vmulq_f32(vld1q_f32(pFrames), v0);
-		v1 = vmaxq_f32(v2, v1);
-		vst1q_f32(pFrames, v2);
-		pFrames += 4;
-	}
-
-	for (; iFrames > 0; --iFrames)
-		*pFrames++ *= fGain;
-
-	vst1q_lane_f32(pfValue, v1, 0); // CHEAT: take 1st of 4 possible values.
-}
-
-static inline void neon_process_ramp ( float *pFrames, unsigned int iFrames,
-	float fGainIter, float fGainLast, float *pfValue )
-{
-	const float fGainStepSingle = (fGainLast - fGainIter) / float(iFrames);
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames) {
-		*pFrames++ *= fGainIter;
-		fGainIter += fGainStepSingle;
-	}
-
-	float __attribute__ ((aligned (16))) fInitGainIter[4] = {
-		fGainIter,
-		fGainIter + fGainStepSingle,
-		fGainIter + 2.0f * fGainStepSingle,
-		fGainIter + 3.0f * fGainStepSingle };
-
-	const float fGainStep = 4.0f * fGainStepSingle;
-	float32x4_t vGainIter = vld1q_f32(fInitGainIter);
-	float32x4_t vGainStep = vld1q_dup_f32(&fGainStep);
-	float32x4_t v1 = vld1q_dup_f32(pfValue);
-	float32x4_t v2;
-
-	for (; iFrames >= 4; iFrames -= 4) {
-		v2 = vmulq_f32(vld1q_f32(pFrames), vGainIter);
-		v1 = vmaxq_f32(v2, v1);
-		vst1q_f32(pFrames, v2);
-		vGainIter += vGainStep;
-		pFrames += 4;
-	}
-
-	for (; iFrames > 0; --iFrames) {
-		*pFrames++ *= fGainIter;
-		fGainIter += fGainStepSingle;
-	}
-
-	vst1q_lane_f32(pfValue, v1, 3); // CHEAT: take 4th of 4 possible values.
-}
-
-static inline void neon_process_meter (
-	float *pFrames, unsigned int iFrames, float *pfValue )
-{
-	float32x4_t v1 = vld1q_dup_f32(pfValue);
-
-	for (; (long(pFrames) & 15) && (iFrames > 0); --iFrames)
-		++pFrames;
-
-	for (; iFrames >= 4; iFrames -= 4) {
-		v1 = vmaxq_f32(vld1q_f32(pFrames), v1);
-		pFrames += 4;
-	}
-
-	vst1q_lane_f32(pfValue, v1, 0); // CHEAT: take 1st of 4 possible values.
-}
-
-#endif // __ARM_NEON__
-
-
-// Standard processor versions.
-static inline void std_process (
-	float *pFrames, unsigned int iFrames, float fGain, float *pfValue )
-{
-	for (unsigned int n = 0; n < iFrames; ++n) {
-		pFrames[n] *= fGain;
-		if (*pfValue < pFrames[n])
-			*pfValue = pFrames[n];
-	}
-}
-
-static inline void std_process_ramp ( float *pFrames, unsigned int iFrames,
+static inline void monitor_process_ramp ( float *pFrames, unsigned int iFrames,
 	float fGainIter, float fGainLast, float *pfValue )
 {
 	const float fGainStep = (fGainLast - fGainIter) / float(iFrames);
 
-	for (unsigned int n = 0; n < iFrames; ++n) {
-		pFrames[n] *= fGainIter;
-		if (*pfValue < pFrames[n])
-			*pfValue = pFrames[n];
-		fGainIter += fGainStep;
-	}
+	qtractorAudioKernel::ramp_peak(pFrames, iFrames,
+		fGainIter, fGainStep, pfValue);
 }
 
-static inline void std_process_meter (
+static inline void monitor_process_meter (
 	float *pFrames, unsigned int iFrames, float *pfValue )
 {
-	for (unsigned int n = 0; n < iFrames; ++n) {
-		if (*pfValue < pFrames[n])
-			*pfValue = pFrames[n];
-	}
+	qtractorAudioKernel::peak(pFrames, iFrames, pfValue);
 }
 
 
@@ -254,25 +62,6 @@ qtractorAudioMonitor::qtractorAudioMonitor ( unsigned short iChannels,
 	qtractorMonitor::gainSubject()->setMaxValue(2.0f);	// +6dB
 	qtractorMonitor::gainObserver()->setLogarithmic(true);
 
-#if defined(__SSE__)
-	if (sse_enabled()) {
-		m_pfnProcess = sse_process;
-		m_pfnProcessRamp = sse_process_ramp;
-		m_pfnProcessMeter = sse_process_meter;
-	} else
-#endif
-#if defined(__ARM_NEON__)
-	m_pfnProcess = neon_process;
-	m_pfnProcessRamp = neon_process_ramp;
-	m_pfnProcessMeter = neon_process_meter;
-	if (false)
-#endif
-	{
-		m_pfnProcess = std_process;
-		m_pfnProcessRamp = std_process_ramp;
-		m_pfnProcessMeter = std_process_meter;
-	}
-
 	setChannels(iChannels);
 }
 
@@ -393,7 +182,7 @@ void qtractorAudioMonitor::process (
 		// Do ramp-processing...
 		if (iChannels == m_iChannels) {
 			for (unsigned short i = 0; i < m_iChannels; ++i) {
-				(*m_pfnProcessRamp)(ppFrames[i], iFrames,
+				monitor_process_ramp(ppFrames[i], iFrames,
 					m_pfPrevGains[i], m_pfGains[i], &m_pfValues[i]);
 			//	m_pfPrevGains[i] = m_pfGains[i];
 			}
@@ -401,7 +190,7 @@ void qtractorAudioMonitor::process (
 		else if (iChannels > m_iChannels) {
 			unsigned short i = 0;
 			for (unsigned short j = 0; j < iChannels; ++j) {
-				(*m_pfnProcessRamp)(ppFrames[j], iFrames,
+				monitor_process_ramp(ppFrames[j], iFrames,
 					m_pfPrevGains[i], m_pfGains[i], &m_pfValues[i]);
 			//	m_pfPrevGains[i] = m_pfGains[i];
 				if (++i >= m_iChannels)
@@ -411,7 +200,7 @@ void qtractorAudioMonitor::process (
 		else { // (iChannels < m_iChannels)
 			unsigned short j = 0;
 			for (unsigned short i = 0; i < m_iChannels; ++i) {
-				(*m_pfnProcessRamp)(ppFrames[j], iFrames,
+				monitor_process_ramp(ppFrames[j], iFrames,
 					m_pfPrevGains[i], m_pfGains[i], &m_pfValues[i]);
 			//	m_pfPrevGains[i] = m_pfGains[i];
 				if (++j >= iChannels)
@@ -423,14 +212,14 @@ void qtractorAudioMonitor::process (
 		// Do normal-processing...
 		if (iChannels == m_iChannels) {
 			for (unsigned short i = 0; i < m_iChannels; ++i) {
-				(*m_pfnProcess)(ppFrames[i], iFrames,
+				monitor_process(ppFrames[i], iFrames,
 					m_pfGains[i], &m_pfValues[i]);
 			}
 		}
 		else if (iChannels > m_iChannels) {
 			unsigned short i = 0;
 			for (unsigned short j = 0; j < iChannels; ++j) {
-				(*m_pfnProcess)(ppFrames[j], iFrames,
+				monitor_process(ppFrames[j], iFrames,
 					m_pfGains[i], &m_pfValues[i]);
 				if (++i >= m_iChannels)
 					i = 0;
@@ -439,7 +228,7 @@ void qtractorAudioMonitor::process (
 		else { // (iChannels < m_iChannels)
 			unsigned short j = 0;
 			for (unsigned short i = 0; i < m_iChannels; ++i) {
-				(*m_pfnProcess)(ppFrames[j], iFrames,
+				monitor_process(ppFrames[j], iFrames,
 					m_pfGains[i], &m_pfValues[i]);
 				if (++j >= iChannels)
 					j = 0;
@@ -458,12 +247,12 @@ void qtractorAudioMonitor::process_meter (
 
 	if (iChannels == m_iChannels) {
 		for (unsigned short i = 0; i < m_iChannels; ++i)
-			(*m_pfnProcessMeter)(ppFrames[i], iFrames, &m_pfValues[i]);
+			monitor_process_meter(ppFrames[i], iFrames, &m_pfValues[i]);
 	}
 	else if (iChannels > m_iChannels) {
 		unsigned short j = 0;
 		for (unsigned short i = 0; i < iChannels; ++i) {
-			(*m_pfnProcessMeter)(ppFrames[i], iFrames, &m_pfValues[j]);
+			monitor_process_meter(ppFrames[i], iFrames, &m_pfValues[j]);
 			if (++j >= m_iChannels)
 				j = 0;
 		}
@@ -471,7 +260,7 @@ void qtractorAudioMonitor::process_meter (
 	else { // (iChannels < m_iChannels)
 		unsigned short i = 0;
 		for (unsigned short j = 0; j < m_iChannels; ++j) {
-			(*m_pfnProcessMeter)(ppFrames[i], iFrames, &m_pfValues[j]);
+			monitor_process_meter(ppFrames[i], iFrames, &m_pfValues[j]);
 			if (++i >= iChannels)
 				i = 0;
 		}
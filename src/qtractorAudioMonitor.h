@@ -75,11 +75,6 @@ private:
 	float         *m_pfGains;
 	float         *m_pfPrevGains;
 	volatile int   m_iProcessRamp;
-
-	// Monitoring evaluator processor.
-	void (*m_pfnProcess)(float *, unsigned int, float, float *);
-	void (*m_pfnProcessRamp)(float *, unsigned int, float, float, float *);
-	void (*m_pfnProcessMeter)(float *, unsigned int, float *);
 };
 
 
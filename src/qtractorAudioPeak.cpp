@@ -50,14 +50,17 @@ static const unsigned int c_iAudioFrames = (32 * 1024);
 static const unsigned int c_iPeakFrames = (8 * 1024);
 
 // Default peak period as a digest representation in frames per channel.
-static const unsigned short c_iPeakPeriod = 1024;
+static const unsigned short c_iPeakPeriod = 256;
+
+// Peak file format signature (multi-resolution/mipmap levels).
+static const unsigned int c_iPeakMagic = 0x4b505451; // "QTPK"
 
 // Default peak filename extension.
 static const QString c_sPeakFileExt = ".peak";
 
 
 //----------------------------------------------------------------------
-// class qtractorAudioPeakThread -- Audio Peak file thread.
+// class qtractorAudioPeakThread -- Audio Peak file worker thread.
 //
 
 class qtractorAudioPeakThread : public QThread
@@ -65,17 +68,12 @@ class qtractorAudioPeakThread : public QThread
 public:
 
 	// Constructor.
-	qtractorAudioPeakThread(unsigned int iSyncSize = 128);
-	// Destructor.
-	~qtractorAudioPeakThread();
+	qtractorAudioPeakThread(qtractorAudioPeakPool *pPeakPool);
 
 	// Thread run state accessors.
 	void setRunState(bool bRunState);
 	bool runState() const;
 
-	// Wake from executive wait condition.
-	void sync(qtractorAudioPeakFile *pPeakFile = nullptr);
-
 protected:
 
 	// The main thread executive.
@@ -87,25 +85,14 @@ protected:
 	bool writePeakFile();
 	void closePeakFile();
 
-	void notifyPeakEvent() const;
-
 private:
 
-	// The peak file queue instance reference.
-	unsigned int            m_iSyncSize;
-	unsigned int            m_iSyncMask;
-	qtractorAudioPeakFile **m_ppSyncItems;
-
-	volatile unsigned int   m_iSyncRead;
-	volatile unsigned int   m_iSyncWrite;
+	// The owner worker pool (shared queue).
+	qtractorAudioPeakPool *m_pPeakPool;
 
 	// Whether the thread is logically running.
 	volatile bool m_bRunState;
 
-	// Thread synchronization objects.
-	QMutex m_mutex;
-	QWaitCondition m_cond;
-
 	// Current audio peak file instance.
 	qtractorAudioPeakFile *m_pPeakFile;
 
@@ -114,42 +101,84 @@ private:
 
 	// Current audio file buffer.
 	float **m_ppAudioFrames;
+
+	// Whether the whole audio file has been read.
+	bool m_bComplete;
 };
 
 
-// Constructor.
-qtractorAudioPeakThread::qtractorAudioPeakThread ( unsigned int iSyncSize )
+//----------------------------------------------------------------------
+// class qtractorAudioPeakPool -- Audio Peak file worker thread pool.
+//
+
+class qtractorAudioPeakPool
 {
-	m_iSyncSize = (64 << 1);
-	while (m_iSyncSize < iSyncSize)
-		m_iSyncSize <<= 1;
-	m_iSyncMask = (m_iSyncSize - 1);
-	m_ppSyncItems = new qtractorAudioPeakFile * [m_iSyncSize];
-	m_iSyncRead   = 0;
-	m_iSyncWrite  = 0;
+public:
+
+	// Constructor.
+	qtractorAudioPeakPool(unsigned int iThreads = 0);
+	// Destructor.
+	~qtractorAudioPeakPool();
+
+	// Queue a peak file for creation, visible ones first;
+	// or cancel all pending ones, if none given (any thread).
+	void sync(qtractorAudioPeakFile *pPeakFile = nullptr, bool bVisible = true);
 
-	::memset(m_ppSyncItems, 0, m_iSyncSize * sizeof(qtractorAudioPeakFile *));
+	// Wait until all workers are idle.
+	void wait();
 
+	// Progress counters.
+	unsigned int pending();
+	unsigned int total();
+
+	// Worker thread interface: next peak file to create,
+	// blocks until there's one or null when stopping...
+	qtractorAudioPeakFile *next(qtractorAudioPeakThread *pPeakThread);
+	// ...and done with it.
+	void done(qtractorAudioPeakFile *pPeakFile);
+
+	// Send notification event, someway...
+	void notifyPeakEvent() const;
+
+private:
+
+	// The worker threads.
+	QList<qtractorAudioPeakThread *> m_threads;
+
+	// The peak file queues (visible first).
+	QList<qtractorAudioPeakFile *> m_visible;
+	QList<qtractorAudioPeakFile *> m_background;
+
+	// Progress counters.
+	unsigned int m_iBusy;
+	unsigned int m_iTotal;
+	unsigned int m_iDone;
+
+	// Thread synchronization objects.
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+	QWaitCondition m_idle;
+};
+
+
+// Constructor.
+qtractorAudioPeakThread::qtractorAudioPeakThread (
+	qtractorAudioPeakPool *pPeakPool )
+	: m_pPeakPool(pPeakPool)
+{
 	m_bRunState = false;
 
 	m_pPeakFile  = nullptr;
 	m_pAudioFile = nullptr;
 	m_ppAudioFrames = nullptr;
-}
 
-
-// Destructor.
-qtractorAudioPeakThread::~qtractorAudioPeakThread (void)
-{
-	delete [] m_ppSyncItems;
+	m_bComplete = false;
 }
 
 
 // Run state accessor.
 void qtractorAudioPeakThread::setRunState ( bool bRunState )
 {
-//	QMutexLocker locker(&m_mutex);
-
 	m_bRunState = bRunState;
 }
 
@@ -159,49 +188,6 @@ bool qtractorAudioPeakThread::runState (void) const
 }
 
 
-// Wake from executive wait condition.
-void qtractorAudioPeakThread::sync ( qtractorAudioPeakFile *pPeakFile )
-{
-	if (pPeakFile == nullptr) {
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		while (r != w) {
-			qtractorAudioPeakFile *pSyncItem = m_ppSyncItems[r];
-			if (pSyncItem)
-				pSyncItem->setWaitSync(false);
-			++r &= m_iSyncMask;
-			w = m_iSyncWrite;
-		}
-	//	m_iSyncRead = r;
-	} else {
-		// !pPeakFile->isWaitSync()
-		unsigned int n;
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		if (w > r) {
-			n = ((r - w + m_iSyncSize) & m_iSyncMask) - 1;
-		} else if (r > w) {
-			n = (r - w) - 1;
-		} else {
-			n = m_iSyncSize - 1;
-		}
-		if (n > 0) {
-			pPeakFile->setWaitSync(true);
-			m_ppSyncItems[w] = pPeakFile;
-			m_iSyncWrite = (w + 1) & m_iSyncMask;
-		}
-	}
-
-	if (m_mutex.tryLock()) {
-		m_cond.wakeAll();
-		m_mutex.unlock();
-	}
-#ifdef CONFIG_DEBUG_0
-	else qDebug("qtractorAudioPeakThread[%p]::sync(): tryLock() failed.", this);
-#endif
-}
-
-
 // The main thread executive cycle.
 void qtractorAudioPeakThread::run (void)
 {
@@ -209,42 +195,23 @@ void qtractorAudioPeakThread::run (void)
 	qDebug("qtractorAudioPeakThread[%p]::run(): started...", this);
 #endif
 
-	m_mutex.lock();
-
-	m_bRunState = true;
-
-	while (m_bRunState) {
-		// Do whatever we must, then wait for more...
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		while (m_bRunState && r != w) {
-			m_pPeakFile = m_ppSyncItems[r];
-			if (m_pPeakFile && m_pPeakFile->isWaitSync()) {
-				if (openPeakFile()) {
-					// Go ahead with the whole bunch...
-					while (writePeakFile());
-					// We're done.
-					closePeakFile();
-				}
-				m_pPeakFile->setWaitSync(false);
-				m_pPeakFile = nullptr;
+	// Do whatever we must, while there's more...
+	while ((m_pPeakFile = m_pPeakPool->next(this)) != nullptr) {
+		if (m_pPeakFile->isWaitSync()) {
+			if (openPeakFile()) {
+				// Go ahead with the whole bunch...
+				while (writePeakFile());
+				// We're done.
+				closePeakFile();
 			}
-			m_ppSyncItems[r] = nullptr;
-			++r &= m_iSyncMask;
-			w = m_iSyncWrite;
-		}
-		m_iSyncRead = r;
-		// Are we still in the game?
-		if (m_bRunState) {
-			// Send notification event, anyway...
-			notifyPeakEvent();
-			// Wait for sync...
-			m_cond.wait(&m_mutex);
+			m_pPeakFile->setWaitSync(false);
 		}
+		m_pPeakPool->done(m_pPeakFile);
+		m_pPeakFile = nullptr;
+		// Send notification event, anyway...
+		m_pPeakPool->notifyPeakEvent();
 	}
 
-	m_mutex.unlock();
-
 #ifdef CONFIG_DEBUG_0
 	qDebug("qtractorAudioPeakThread[%p]::run(): stopped.\n", this);
 #endif
@@ -287,6 +254,8 @@ bool qtractorAudioPeakThread::openPeakFile (void)
 	// Make sure audio file decoder makes no head-start...
 	m_pAudioFile->seek(0);
 
+	m_bComplete = false;
+
 	return true;
 }
 
@@ -297,6 +266,10 @@ bool qtractorAudioPeakThread::writePeakFile (void)
 	if (!m_bRunState)
 		return false;
 
+	// Aborted meanwhile?
+	if (!m_pPeakFile->isWaitSync())
+		return false;
+
 	if (m_ppAudioFrames == nullptr)
 		return false;
 
@@ -306,6 +279,12 @@ bool qtractorAudioPeakThread::writePeakFile (void)
 
 	// Read another bunch of frames from the physical audio file...
 	int nread = m_pAudioFile->read(m_ppAudioFrames, c_iAudioFrames);
+	if (nread == 0) {
+		// End of audio file reached...
+		m_bComplete = true;
+		return false;
+	}
+
 	if (nread > 0)
 		nread = m_pPeakFile->write(m_ppAudioFrames, nread);
 
@@ -320,8 +299,9 @@ void qtractorAudioPeakThread::closePeakFile (void)
 	qDebug("qtractorAudioPeakThread::closePeakFile(%p)", m_pPeakFile);
 #endif
 
-	// Always force target file close.
-	m_pPeakFile->closeWrite();
+	// Always force target file close;
+	// incomplete ones are removed.
+	m_pPeakFile->closeWrite(m_bComplete);
 
 	// Get rid of physical used stuff.
 	if (m_ppAudioFrames) {
@@ -337,18 +317,176 @@ void qtractorAudioPeakThread::closePeakFile (void)
 		delete m_pAudioFile;
 		m_pAudioFile = nullptr;
 	}
+}
 
-	// Send notification event, someway...
-	notifyPeakEvent();
+
+
+
+// Constructor.
+qtractorAudioPeakPool::qtractorAudioPeakPool ( unsigned int iThreads )
+	: m_iBusy(0), m_iTotal(0), m_iDone(0)
+{
+	if (iThreads < 1) {
+		const int iIdealThreads = QThread::idealThreadCount();
+		iThreads = (iIdealThreads > 0 ? iIdealThreads : 1);
+	}
+
+	for (unsigned int i = 0; i < iThreads; ++i) {
+		qtractorAudioPeakThread *pPeakThread = new qtractorAudioPeakThread(this);
+		pPeakThread->setRunState(true);
+		pPeakThread->start(QThread::LowPriority);
+		m_threads.append(pPeakThread);
+	}
 }
 
 
-// Send notification event, someway...
-void qtractorAudioPeakThread::notifyPeakEvent (void) const
+// Destructor.
+qtractorAudioPeakPool::~qtractorAudioPeakPool (void)
 {
-	if (!m_bRunState)
+	QListIterator<qtractorAudioPeakThread *> iter(m_threads);
+	while (iter.hasNext())
+		iter.next()->setRunState(false);
+
+	iter.toFront();
+	while (iter.hasNext()) {
+		qtractorAudioPeakThread *pPeakThread = iter.next();
+		if (pPeakThread->isRunning()) do {
+			m_mutex.lock();
+			m_cond.wakeAll();
+			m_mutex.unlock();
+		} while (!pPeakThread->wait(100));
+	}
+
+	qDeleteAll(m_threads);
+	m_threads.clear();
+}
+
+
+// Queue a peak file for creation, visible ones first;
+// or cancel all pending ones, if none given (any thread).
+void qtractorAudioPeakPool::sync (
+	qtractorAudioPeakFile *pPeakFile, bool bVisible )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (pPeakFile == nullptr) {
+		QListIterator<qtractorAudioPeakFile *> iter(m_visible);
+		while (iter.hasNext())
+			iter.next()->setWaitSync(false);
+		iter = m_background;
+		while (iter.hasNext())
+			iter.next()->setWaitSync(false);
+		m_iDone += m_visible.count() + m_background.count();
+		m_visible.clear();
+		m_background.clear();
+		if (m_iBusy == 0)
+			m_iTotal = m_iDone = 0;
 		return;
+	}
+
+	// Already first in line?
+	if (m_visible.contains(pPeakFile))
+		return;
+
+	// Promote from background, if visible now...
+	if (m_background.contains(pPeakFile)) {
+		if (bVisible) {
+			m_background.removeOne(pPeakFile);
+			m_visible.prepend(pPeakFile);
+		}
+		return;
+	}
+
+	// Being created already?
+	if (pPeakFile->isWaitSync())
+		return;
+
+	pPeakFile->setWaitSync(true);
+
+	if (bVisible)
+		m_visible.prepend(pPeakFile);
+	else
+		m_background.append(pPeakFile);
+
+	++m_iTotal;
+
+	m_cond.wakeOne();
+}
+
+
+// Wait until all workers are idle.
+void qtractorAudioPeakPool::wait (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	while (m_iBusy > 0)
+		m_idle.wait(&m_mutex);
+}
+
+
+// Progress counters.
+unsigned int qtractorAudioPeakPool::pending (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	return m_iTotal - m_iDone;
+}
+
+unsigned int qtractorAudioPeakPool::total (void)
+{
+	QMutexLocker locker(&m_mutex);
 
+	return m_iTotal;
+}
+
+
+// Worker thread interface: next peak file to create,
+// blocks until there's one or null when stopping...
+qtractorAudioPeakFile *qtractorAudioPeakPool::next (
+	qtractorAudioPeakThread *pPeakThread )
+{
+	QMutexLocker locker(&m_mutex);
+
+	while (pPeakThread->runState()) {
+		qtractorAudioPeakFile *pPeakFile = nullptr;
+		if (!m_visible.isEmpty())
+			pPeakFile = m_visible.takeFirst();
+		else
+		if (!m_background.isEmpty())
+			pPeakFile = m_background.takeFirst();
+		if (pPeakFile) {
+			++m_iBusy;
+			return pPeakFile;
+		}
+		m_cond.wait(&m_mutex);
+	}
+
+	return nullptr;
+}
+
+
+// ...and done with it.
+void qtractorAudioPeakPool::done ( qtractorAudioPeakFile */*pPeakFile*/ )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_iBusy > 0)
+		--m_iBusy;
+
+	++m_iDone;
+
+	// Reset progress when all's done...
+	if (m_iBusy == 0) {
+		if (m_visible.isEmpty() && m_background.isEmpty())
+			m_iTotal = m_iDone = 0;
+		m_idle.wakeAll();
+	}
+}
+
+
+// Send notification event, someway...
+void qtractorAudioPeakPool::notifyPeakEvent (void) const
+{
 	qtractorAudioPeakFactory *pPeakFactory
 		= qtractorAudioPeakFactory::getInstance();
 	if (pPeakFactory)
@@ -370,18 +508,22 @@ qtractorAudioPeakFile::qtractorAudioPeakFile (
 
 	m_openMode = None;
 
-	m_peakHeader.period   = 0;
-	m_peakHeader.channels = 0;
+	::memset(&m_peakHeader, 0, sizeof(m_peakHeader));
 
 	m_pBuffer      = nullptr;
 	m_iBuffSize    = 0;
 	m_iBuffLength  = 0;
 	m_iBuffOffset  = 0;
+	m_iBuffLevel   = 0;
+
+	m_pMapped = nullptr;
 
 	m_bWaitSync = false;
 
 	m_iRefCount = 0;
 
+	m_iSerial = 0;
+
 	m_pWriter = nullptr;
 
 	// Set (unique) peak filename...
@@ -417,16 +559,18 @@ bool qtractorAudioPeakFile::openRead (void)
 		return true;
 
 	// Are we still waiting for its creation?
-	if (m_bWaitSync)
+	// (being visible, make it first in line)
+	if (m_bWaitSync) {
+		qtractorAudioPeakFactory *pPeakFactory
+			= qtractorAudioPeakFactory::getInstance();
+		if (pPeakFactory)
+			pPeakFactory->sync(this);
 		return false;
+	}
 
-	// Need some preliminary file information...
-	QFileInfo fileInfo(m_sFilename);
-	QFileInfo peakInfo(m_peakFile.fileName());
 	// Have we a peak file up-to-date,
 	// or must the peak file be (re)created?
-	if (!peakInfo.exists() || peakInfo.birthTime() < fileInfo.birthTime()) {
-	//	|| peakInfo.lastModified() < fileInfo.lastModified()) {
+	if (!isUpToDate()) {
 		qtractorAudioPeakFactory *pPeakFactory
 			= qtractorAudioPeakFactory::getInstance();
 		if (pPeakFactory)
@@ -448,9 +592,28 @@ bool qtractorAudioPeakFile::openRead (void)
 		return false;
 	}
 
+	// Older or otherwise incomplete peak file format?
+	if (m_peakHeader.magic  != c_iPeakMagic
+		|| m_peakHeader.factor != LevelFactor
+		|| m_peakHeader.levels <  1
+		|| m_peakHeader.levels >  MaxLevels) {
+		m_peakFile.close();
+		::memset(&m_peakHeader, 0, sizeof(m_peakHeader));
+		locker.unlock();
+		// Must be (re)created...
+		qtractorAudioPeakFactory *pPeakFactory
+			= qtractorAudioPeakFactory::getInstance();
+		if (pPeakFactory)
+			pPeakFactory->sync(this);
+		return false;
+	}
+
 	// Set open mode...
 	m_openMode = Read;
 
+	// Map it all, if we can (otherwise it's buffered reads)...
+	m_pMapped = m_peakFile.map(0, m_peakFile.size());
+
 #ifdef CONFIG_DEBUG_0
 	qDebug("qtractorAudioPeakFile[%p]::openRead() ---", this);
 	qDebug("name        = %s", m_peakFile.fileName().toUtf8().constData());
@@ -460,6 +623,9 @@ bool qtractorAudioPeakFile::openRead (void)
 	qDebug("frame       = %lu", sizeof(Frame));
 	qDebug("period      = %d", m_peakHeader.period);
 	qDebug("channels    = %d", m_peakHeader.channels);
+	qDebug("levels      = %d", m_peakHeader.levels);
+	for (unsigned short i = 0; i < m_peakHeader.levels; ++i)
+		qDebug("frames[%d]   = %u", i, m_peakHeader.frames[i]);
 	qDebug("---");
 #endif
 
@@ -468,6 +634,18 @@ bool qtractorAudioPeakFile::openRead (void)
 }
 
 
+// Whether the peak file exists and is not older than the audio file.
+bool qtractorAudioPeakFile::isUpToDate (void) const
+{
+	// Need some preliminary file information...
+	const QFileInfo fileInfo(m_sFilename);
+	const QFileInfo peakInfo(m_peakFile.fileName());
+
+	return (peakInfo.exists() && peakInfo.birthTime() >= fileInfo.birthTime());
+	//	&& peakInfo.lastModified() >= fileInfo.lastModified());
+}
+
+
 // Free all attended resources for this peak file.
 void qtractorAudioPeakFile::closeRead (void)
 {
@@ -476,6 +654,9 @@ void qtractorAudioPeakFile::closeRead (void)
 
 	// Close file.
 	if (m_openMode == Read) {
+		if (m_pMapped)
+			m_peakFile.unmap(const_cast<uchar *> (m_pMapped));
+		m_pMapped = nullptr;
 		m_peakFile.close();
 		m_openMode = None;
 	}
@@ -487,6 +668,7 @@ void qtractorAudioPeakFile::closeRead (void)
 	m_iBuffSize   = 0;
 	m_iBuffLength = 0;
 	m_iBuffOffset = 0;
+	m_iBuffLevel  = 0;
 }
 
 
@@ -525,25 +707,88 @@ unsigned short qtractorAudioPeakFile::channels (void)
 }
 
 
+// Multi-resolution (mipmap) level properties.
+unsigned short qtractorAudioPeakFile::levels (void)
+{
+	return m_peakHeader.levels;
+}
+
+unsigned long qtractorAudioPeakFile::levelPeriod ( unsigned short iLevel )
+{
+	unsigned long iPeriod = m_peakHeader.period;
+	for (unsigned short i = 0; i < iLevel; ++i)
+		iPeriod *= LevelFactor;
+
+	return iPeriod;
+}
+
+unsigned int qtractorAudioPeakFile::levelFrames ( unsigned short iLevel )
+{
+	return (iLevel < m_peakHeader.levels ? m_peakHeader.frames[iLevel] : 0);
+}
+
+
+// Level start offset in peak file (in bytes).
+qint64 qtractorAudioPeakFile::levelOffset ( unsigned short iLevel ) const
+{
+	const unsigned int nsize = m_peakHeader.channels * sizeof(Frame);
+
+	// Levels are laid out in sequence, just after the header...
+	qint64 iLevelOffset = sizeof(Header);
+	for (unsigned short i = 0; i < iLevel; ++i)
+		iLevelOffset += qint64(m_peakHeader.frames[i]) * nsize;
+
+	return iLevelOffset;
+}
+
+
+// Coarsest level not exceeding given frames per peak.
+unsigned short qtractorAudioPeakFile::level ( unsigned long iFramesPerPeak )
+{
+	unsigned short iLevel = 0;
+	unsigned long iPeriod = m_peakHeader.period * LevelFactor;
+	while (iLevel + 1 < m_peakHeader.levels
+		&& m_peakHeader.frames[iLevel + 1] > 0
+		&& iPeriod <= iFramesPerPeak) {
+		iPeriod *= LevelFactor;
+		++iLevel;
+	}
+
+	return iLevel;
+}
+
+
 // Read frames from peak file.
 qtractorAudioPeakFile::Frame *qtractorAudioPeakFile::read (
-	unsigned long iPeakOffset, unsigned int iPeakLength )
+	unsigned long iPeakOffset, unsigned int iPeakLength, unsigned short iLevel )
 {
 	// Must be open for something...
 	if (m_openMode == None)
 		return nullptr;
 
+	// Level might not be there (yet)...
+	if (iLevel >= m_peakHeader.levels)
+		iLevel = 0;
+
+	// Straight from the mapping, if complete and in range (lock-free)...
+	if (m_pMapped && iPeakOffset + iPeakLength <= m_peakHeader.frames[iLevel]) {
+		const unsigned int nsize = m_peakHeader.channels * sizeof(Frame);
+		return (Frame *) (m_pMapped + levelOffset(iLevel) + iPeakOffset * nsize);
+	}
+
 	// Make things critical...
 	QMutexLocker locker(&m_mutex);
 
 #ifdef CONFIG_DEBUG_0
-	qDebug("qtractorAudioPeakFile[%p]::read(%lu, %u) [%lu, %u, %u]", this,
-		iPeakOffset, iPeakLength, m_iBuffOffset, m_iBuffLength, m_iBuffSize);
+	qDebug("qtractorAudioPeakFile[%p]::read(%lu, %u, %u) [%lu, %u, %u]", this,
+		iPeakOffset, iPeakLength, iLevel,
+		m_iBuffOffset, m_iBuffLength, m_iBuffSize);
 #endif
 
 	// Cache effect, only valid if we're really reading...
 	const unsigned long iPeakEnd = iPeakOffset + iPeakLength;
-	if (iPeakOffset >= m_iBuffOffset && m_iBuffOffset < iPeakEnd) {
+	if (iLevel == m_iBuffLevel
+		&& iPeakOffset >= m_iBuffOffset && m_iBuffOffset < iPeakEnd) {
 		const unsigned long iBuffEnd = m_iBuffOffset + m_iBuffLength;
 		const unsigned long iBuffOffset
 			= m_peakHeader.channels * (iPeakOffset - m_iBuffOffset);
@@ -557,6 +802,7 @@ qtractorAudioPeakFile::Frame *qtractorAudioPeakFile::read (
 	}
 
 	// Read peak data as requested...
+	m_iBuffLevel  = iLevel;
 	m_iBuffLength = readBuffer(0, iPeakOffset, iPeakLength);
 	m_iBuffOffset = iPeakOffset;
 
@@ -587,14 +833,27 @@ unsigned int qtractorAudioPeakFile::readBuffer (
 		m_iBuffOffset, m_iBuffLength, m_iBuffSize);
 #endif
 
+	const qint64 iLevelOffset = levelOffset(m_iBuffLevel);
+
+	// Never read beyond current level end...
+	const unsigned long iLevelFrames = m_peakHeader.frames[m_iBuffLevel];
+	unsigned int iReadLength = 0;
+	if (iPeakOffset < iLevelFrames) {
+		iReadLength = iPeakLength;
+		if (iPeakOffset + iReadLength > iLevelFrames)
+			iReadLength = iLevelFrames - iPeakOffset;
+	}
+
 	// Grab new contents from peak file...
 	char *pBuffer = (char *) (m_pBuffer + m_peakHeader.channels * iBuffOffset);
-	const unsigned long iOffset	= iPeakOffset * nsize;
-	const unsigned int iLength  = iPeakLength * nsize;
+	const qint64 iOffset = qint64(iPeakOffset) * nsize;
+	const unsigned int iLength = iPeakLength * nsize;
 
 	int nread = 0;
-	if (m_peakFile.seek(sizeof(Header) + iOffset))
-		nread = int(m_peakFile.read(&pBuffer[0], iLength));
+	if (iReadLength > 0 && m_peakFile.seek(iLevelOffset + iOffset))
+		nread = int(m_peakFile.read(&pBuffer[0], iReadLength * nsize));
+	if (nread < 0)
+		nread = 0;
 
 	// Zero the remaining...
 	if (nread < int(iLength))
@@ -623,10 +882,16 @@ bool qtractorAudioPeakFile::openWrite (
 
 	// We'll force (re)open if already reading (duh?)
 	if (m_openMode == Read) {
+		if (m_pMapped)
+			m_peakFile.unmap(const_cast<uchar *> (m_pMapped));
+		m_pMapped = nullptr;
 		m_peakFile.close();
 		m_openMode = None;
 	}
 
+	// Brand new contents...
+	++m_iSerial;
+
 	// Just open and go ahead with it...
 	if (!m_peakFile.open(QIODevice::ReadWrite | QIODevice::Truncate))
 		return false;
@@ -634,9 +899,13 @@ bool qtractorAudioPeakFile::openWrite (
 	// Set open mode...
 	m_openMode = Write;
 
-	// Initialize header...
+	// Initialize header (only base level is readable while writing;
+	// signature is only set when complete, see writeLevels)...
+	::memset(&m_peakHeader, 0, sizeof(m_peakHeader));
 	m_peakHeader.period   = pPeakFactory->peakPeriod();
 	m_peakHeader.channels = iChannels;
+	m_peakHeader.levels   = 1;
+	m_peakHeader.factor   = LevelFactor;
 
 	// Write peak file header.
 	if (m_peakFile.write((const char *) &m_peakHeader, sizeof(Header))
@@ -668,6 +937,16 @@ bool qtractorAudioPeakFile::openWrite (
 	for (unsigned short i = 0; i < m_peakHeader.channels; ++i)
 		m_pWriter->amax[i] = m_pWriter->amin[i] = m_pWriter->arms[i] = 0.0f;
 
+	// Decimated levels are accumulated in one single pass...
+	const unsigned int nlevels = MaxLevels * m_peakHeader.channels;
+	m_pWriter->lmax = new float [nlevels];
+	m_pWriter->lmin = new float [nlevels];
+	m_pWriter->lrms = new float [nlevels];
+	for (unsigned int i = 0; i < nlevels; ++i)
+		m_pWriter->lmax[i] = m_pWriter->lmin[i] = m_pWriter->lrms[i] = 0.0f;
+	for (unsigned short i = 0; i < MaxLevels; ++i)
+		m_pWriter->lpeak[i] = 0;
+
 	// Get resample/timestretch-aware internal peak period ratio...
 	m_pWriter->period_p = iSampleRate;
 	qtractorAudioEngine *pAudioEngine = nullptr;
@@ -699,24 +978,33 @@ bool qtractorAudioPeakFile::openWrite (
 }
 
 
-// Close the (hopefully) created peak file.
-void qtractorAudioPeakFile::closeWrite (void)
+// Close the (hopefully) created peak file;
+// only a complete one gets its final signature,
+// otherwise it's physically removed.
+void qtractorAudioPeakFile::closeWrite ( bool bComplete )
 {
 	// Make things critical...
 	QMutexLocker locker(&m_mutex);
 
 	// Flush and close...
 	if (m_openMode == Write) {
-		if (m_pWriter && m_pWriter->npeak > 0)
+		if (bComplete && m_pWriter && m_pWriter->npeak > 0)
 			writeFrame();
+		if (bComplete && m_pWriter)
+			bComplete = writeLevels();
 		m_peakFile.close();
 		m_openMode = None;
+		if (!bComplete)
+			m_peakFile.remove();
 	}
 
 	if (m_pWriter) {
 		delete [] m_pWriter->amax;
 		delete [] m_pWriter->amin;
 		delete [] m_pWriter->arms;
+		delete [] m_pWriter->lmax;
+		delete [] m_pWriter->lmin;
+		delete [] m_pWriter->lrms;
 		delete m_pWriter;
 		m_pWriter = nullptr;
 	}
@@ -797,7 +1085,110 @@ void qtractorAudioPeakFile::writeFrame (void)
 		fmax = fmin = frms = 0.0f;
 		// Bail out?...
 		m_pWriter->offset += m_peakFile.write((const char *) &frame, sizeof(Frame));
+		// Next level up...
+		writeLevel(1, k, frame);
 	}
+
+	// Base level is readable while writing...
+	m_peakHeader.frames[0] = m_pWriter->offset
+		/ (m_peakHeader.channels * sizeof(Frame));
+
+	commitLevel(1);
+}
+
+
+// Accumulate a lower level peak frame into a decimated level.
+void qtractorAudioPeakFile::writeLevel (
+	unsigned short iLevel, unsigned short k, const Frame& frame )
+{
+	if (iLevel >= MaxLevels)
+		return;
+
+	const unsigned int i = iLevel * m_peakHeader.channels + k;
+	float& fmax = m_pWriter->lmax[i];
+	float& fmin = m_pWriter->lmin[i];
+	float& frms = m_pWriter->lrms[i];
+	if (fmax < float(frame.max))
+		fmax = float(frame.max);
+	if (fmin < float(frame.min))
+		fmin = float(frame.min);
+	frms += float(frame.rms) * float(frame.rms);
+}
+
+
+// Count a lower level peak frame, flush when due.
+void qtractorAudioPeakFile::commitLevel ( unsigned short iLevel )
+{
+	if (iLevel >= MaxLevels)
+		return;
+
+	if (++m_pWriter->lpeak[iLevel] >= LevelFactor)
+		flushLevel(iLevel);
+}
+
+
+// Close current decimated level frame, if any.
+void qtractorAudioPeakFile::flushLevel ( unsigned short iLevel )
+{
+	if (iLevel >= MaxLevels)
+		return;
+
+	unsigned short& npeak = m_pWriter->lpeak[iLevel];
+	if (npeak < 1)
+		return;
+
+	Frame frame;
+	for (unsigned short k = 0; k < m_peakHeader.channels; ++k) {
+		const unsigned int i = iLevel * m_peakHeader.channels + k;
+		float& fmax = m_pWriter->lmax[i];
+		float& fmin = m_pWriter->lmin[i];
+		float& frms = m_pWriter->lrms[i];
+		frame.max = (unsigned char) fmax;
+		frame.min = (unsigned char) fmin;
+		frame.rms = (unsigned char) ::sqrtf(frms / float(npeak));
+		fmax = fmin = frms = 0.0f;
+		m_pWriter->ldata[iLevel].append((const char *) &frame, sizeof(Frame));
+		writeLevel(iLevel + 1, k, frame);
+	}
+
+	npeak = 0;
+
+	commitLevel(iLevel + 1);
+}
+
+
+// Append all decimated levels and finalize header.
+bool qtractorAudioPeakFile::writeLevels (void)
+{
+	const unsigned int nsize = m_peakHeader.channels * sizeof(Frame);
+	if (nsize < 1)
+		return false;
+
+	// Flush any pending partial frames, bottom-up...
+	for (unsigned short i = 1; i < MaxLevels; ++i)
+		flushLevel(i);
+
+	m_peakHeader.frames[0] = m_pWriter->offset / nsize;
+
+	if (!m_peakFile.seek(sizeof(Header) + m_pWriter->offset))
+		return false;
+
+	for (unsigned short i = 1; i < MaxLevels; ++i) {
+		const QByteArray& data = m_pWriter->ldata[i];
+		if (m_peakFile.write(data) != qint64(data.size()))
+			return false;
+		m_peakHeader.frames[i] = data.size() / nsize;
+	}
+
+	m_peakHeader.magic  = c_iPeakMagic;
+	m_peakHeader.levels = MaxLevels;
+
+	// Rewrite the final header...
+	if (!m_peakFile.seek(0))
+		return false;
+
+	return (m_peakFile.write((const char *) &m_peakHeader, sizeof(Header))
+		== qint64(sizeof(Header)));
 }
 
 
@@ -829,7 +1220,7 @@ void qtractorAudioPeakFile::cleanup ( bool bAutoRemove )
 	m_bWaitSync = false;
 
 	// Close the file, anyway now.
-	closeWrite();
+	closeWrite(!bAborted);
 	closeRead();
 
 	// Physically remove the file if aborted...
@@ -864,8 +1255,7 @@ QString qtractorAudioPeakFile::peakName (
 
 // Constructor.
 qtractorAudioPeak::qtractorAudioPeak ( qtractorAudioPeakFile *pPeakFile )
-	: m_pPeakFile(pPeakFile), m_pPeakFrames(nullptr),
-		m_iPeakLength(0), m_iPeakHash(0)
+	: m_pPeakFile(pPeakFile), m_iPeakLength(0)
 {
 	m_pPeakFile->addRef();
 }
@@ -873,8 +1263,7 @@ qtractorAudioPeak::qtractorAudioPeak ( qtractorAudioPeakFile *pPeakFile )
 
 // Copy contructor.
 qtractorAudioPeak::qtractorAudioPeak ( const qtractorAudioPeak& peak )
-	: m_pPeakFile(peak.m_pPeakFile), m_pPeakFrames(nullptr),
-		m_iPeakLength(0), m_iPeakHash(0)
+	: m_pPeakFile(peak.m_pPeakFile), m_iPeakLength(0)
 {
 	m_pPeakFile->addRef();
 }
@@ -884,9 +1273,6 @@ qtractorAudioPeak::qtractorAudioPeak ( const qtractorAudioPeak& peak )
 qtractorAudioPeak::~qtractorAudioPeak (void)
 {
 	m_pPeakFile->removeRef();
-
-	if (m_pPeakFrames)
-		delete [] m_pPeakFrames;
 }
 
 
@@ -894,6 +1280,8 @@ qtractorAudioPeak::~qtractorAudioPeak (void)
 qtractorAudioPeakFile::Frame *qtractorAudioPeak::peakFrames (
 	unsigned long iFrameOffset, unsigned long iFrameLength, int width )
 {
+	m_iPeakLength = 0;
+
 	// Skip empty blanks...
 	if (width < 1)
 		return nullptr;
@@ -903,10 +1291,14 @@ qtractorAudioPeakFile::Frame *qtractorAudioPeak::peakFrames (
 		return nullptr;
 
 	// Just in case resolutions might change...
-	const unsigned short iPeakPeriod = m_pPeakFile->period();
-	if (iPeakPeriod < 1)
+	if (m_pPeakFile->period() < 1)
 		return nullptr;
 
+	// Pick the coarsest level that still yields some peaks per pixel...
+	const unsigned short iLevel
+		= m_pPeakFile->level(iFrameLength / ((width >> 1) + 1));
+	const unsigned long iPeakPeriod = m_pPeakFile->levelPeriod(iLevel);
+
 	// Peak frames length estimation...
 	const unsigned int iPeakLength = (iFrameLength / iPeakPeriod);
 	if (iPeakLength < 1)
@@ -917,75 +1309,119 @@ qtractorAudioPeakFile::Frame *qtractorAudioPeak::peakFrames (
 	if (iChannels < 1)
 		return nullptr;
 
-	// Have we been here before?
-	if (m_pPeakFrames) {
-		// Check if we have the same previous hash...
-		if (!m_pPeakFile->isWaitSync()) {
-			const unsigned int iPeakHash
-				= qHash(iPeakPeriod)
-				^ qHash(iFrameOffset)
-				^ qHash(iFrameLength)
-				^ qHash(width);
-			if (m_iPeakHash == iPeakHash)
-				return m_pPeakFrames;
-			m_iPeakHash = iPeakHash;
-		}
-		// Clenup previous frame-buffers...
-		delete [] m_pPeakFrames;
-		m_pPeakFrames = nullptr;
-		m_iPeakLength = 0;
+	const unsigned long iPeakOffset = (iFrameOffset / iPeakPeriod);
+
+	// Direct frame-buffer (no copy, mapped whenever possible)...
+	const int p1 = int(iPeakLength);
+	if (width >= p1 || width < 2) {
+		qtractorAudioPeakFile::Frame *pPeakFrames
+			= m_pPeakFile->read(iPeakOffset, iPeakLength, iLevel);
+		if (pPeakFrames)
+			m_iPeakLength = iPeakLength;
+		return pPeakFrames;
+	}
+
+	// Have we (or anyone else) been here before?
+	qtractorAudioPeakFactory *pPeakFactory
+		= qtractorAudioPeakFactory::getInstance();
+	if (pPeakFactory == nullptr)
+		return nullptr;
+
+	qtractorAudioPeakCache *pPeakCache = pPeakFactory->peakCache();
+
+	qtractorAudioPeakCache::Key key;
+	key.peakFile = m_pPeakFile;
+	key.serial   = m_pPeakFile->serial();
+	key.frames   = m_pPeakFile->levelFrames(iLevel);
+	key.level    = iLevel;
+	key.offset   = iPeakOffset;
+	key.length   = iPeakLength;
+	key.width    = width;
+
+	qtractorAudioPeakCache::Item *pItem = pPeakCache->find(key);
+	if (pItem) {
+		m_iPeakLength = pItem->length;
+		return pItem->frames;
 	}
 
 	// Grab them in...
-	const unsigned long iPeakOffset = (iFrameOffset / iPeakPeriod);
 	qtractorAudioPeakFile::Frame *pPeakFrames
-		= m_pPeakFile->read(iPeakOffset, iPeakLength);
+		= m_pPeakFile->read(iPeakOffset, iPeakLength, iLevel);
 	if (pPeakFrames == nullptr)
 		return nullptr;
 
-	// Check if we better aggregate over the frame buffer....
-	const int p1 = int(iPeakLength);
-	const int n1 = iChannels * p1;
-
-	if (width < p1 && width > 1) {
-		const int w2 = (width >> 1) + 1;
-		const int n2 = iChannels * w2;
-		m_pPeakFrames = new qtractorAudioPeakFile::Frame [n2];
-		int n = 0; int i = 0;
-		while (n < n2) {
-			const int i2 = (n * p1) / w2;
-			for (unsigned short k = 0; k < iChannels; ++k) {
-				qtractorAudioPeakFile::Frame *pNewFrame = &m_pPeakFrames[n++];
-				qtractorAudioPeakFile::Frame *pOldFrame = &pPeakFrames[i + k];
-				pNewFrame->max = pOldFrame->max;
-				pNewFrame->min = pOldFrame->min;
-				pNewFrame->rms = pOldFrame->rms;
-				for (int j = i + 1; j < i2; j += iChannels) {
-					pOldFrame += iChannels;
-					if (pNewFrame->max < pOldFrame->max)
-						pNewFrame->max = pOldFrame->max;
-					if (pNewFrame->min < pOldFrame->min)
-						pNewFrame->min = pOldFrame->min;
-					if (pNewFrame->rms < pOldFrame->rms)
-						pNewFrame->rms = pOldFrame->rms;
-				}
+	// Aggregate over the frame buffer....
+	const int w2 = (width >> 1) + 1;
+	const int n2 = iChannels * w2;
+	pItem = new qtractorAudioPeakCache::Item(n2);
+	int n = 0; int i = 0;
+	while (n < n2) {
+		const int i2 = (n * p1) / w2;
+		for (unsigned short k = 0; k < iChannels; ++k) {
+			qtractorAudioPeakFile::Frame *pNewFrame = &pItem->frames[n++];
+			const qtractorAudioPeakFile::Frame *pOldFrame = &pPeakFrames[i + k];
+			pNewFrame->max = pOldFrame->max;
+			pNewFrame->min = pOldFrame->min;
+			pNewFrame->rms = pOldFrame->rms;
+			for (int j = i + 1; j < i2; j += iChannels) {
+				pOldFrame += iChannels;
+				if (pNewFrame->max < pOldFrame->max)
+					pNewFrame->max = pOldFrame->max;
+				if (pNewFrame->min < pOldFrame->min)
+					pNewFrame->min = pOldFrame->min;
+				if (pNewFrame->rms < pOldFrame->rms)
+					pNewFrame->rms = pOldFrame->rms;
 			}
-			i = i2;
 		}
-		// New-indirect frame buffer length...
-		m_iPeakLength = n / iChannels;
-		// Done-indirect.
-	} else {
-		// Direct-copy frame-buffer...
-		m_pPeakFrames = new qtractorAudioPeakFile::Frame [n1];
-		::memcpy(m_pPeakFrames, pPeakFrames,
-			n1 * sizeof(qtractorAudioPeakFile::Frame));
-		// New-direct frame buffer length...
-		m_iPeakLength = iPeakLength;
-		// Done-direct.
+		i = i2;
 	}
 
-	return m_pPeakFrames;
+	// New-indirect frame buffer length...
+	pItem->length = n / iChannels;
+
+	pItem = pPeakCache->insert(key, pItem, n2);
+	if (pItem == nullptr)
+		return nullptr;
+
+	m_iPeakLength = pItem->length;
+	return pItem->frames;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPeakCache -- Audio peak aggregate cache (shared).
+//
+
+// Constructor (maximum cost in peak frames).
+qtractorAudioPeakCache::qtractorAudioPeakCache ( int iMaxFrames )
+	: m_items(iMaxFrames)
+{
+}
+
+
+// Cache lookup.
+qtractorAudioPeakCache::Item *qtractorAudioPeakCache::find ( const Key& key )
+{
+	return m_items.object(key);
+}
+
+
+// Cache insertion (takes ownership).
+qtractorAudioPeakCache::Item *qtractorAudioPeakCache::insert (
+	const Key& key, Item *pItem, int iFrames )
+{
+	// Item gets deleted if it won't fit anyway...
+	if (!m_items.insert(key, pItem, iFrames))
+		return nullptr;
+
+	return pItem;
+}
+
+
+// Cleanup method.
+void qtractorAudioPeakCache::clear (void)
+{
+	m_items.clear();
 }
 
 
@@ -1006,7 +1442,7 @@ qtractorAudioPeakFactory *qtractorAudioPeakFactory::getInstance (void)
 // Constructor.
 qtractorAudioPeakFactory::qtractorAudioPeakFactory ( QObject *pParent )
 	: QObject(pParent), m_bAutoRemove(false),
-		m_pPeakThread(nullptr), m_iPeakPeriod(c_iPeakPeriod)
+		m_pPeakPool(nullptr), m_iPeakPeriod(c_iPeakPeriod)
 {
 	// Pseudo-singleton reference setup.
 	g_pPeakFactory = this;
@@ -1016,14 +1452,10 @@ qtractorAudioPeakFactory::qtractorAudioPeakFactory ( QObject *pParent )
 // Default destructor.
 qtractorAudioPeakFactory::~qtractorAudioPeakFactory (void)
 {
-	if (m_pPeakThread) {
-		if (m_pPeakThread->isRunning()) do {
-			m_pPeakThread->setRunState(false);
-		//	m_pPeakThread->terminate();
-			m_pPeakThread->sync();
-		} while (!m_pPeakThread->wait(100));
-		delete m_pPeakThread;
-		m_pPeakThread = nullptr;
+	if (m_pPeakPool) {
+		m_pPeakPool->sync(nullptr);
+		delete m_pPeakPool;
+		m_pPeakPool = nullptr;
 	}
 
 	cleanup();
@@ -1045,14 +1477,25 @@ void qtractorAudioPeakFactory::setPeakPeriod ( unsigned short iPeakPeriod )
 
 	m_iPeakPeriod = iPeakPeriod;
 
-	// Refresh all current peak files (asynchronously)...
+	// Abort any pending or in-progress ones...
 	PeakFiles::ConstIterator iter = m_peaks.constBegin();
 	const PeakFiles::ConstIterator& iter_end = m_peaks.constEnd();
-	for ( ; iter != iter_end; ++iter) {
-		qtractorAudioPeakFile *pPeakFile = iter.value();
-		pPeakFile->cleanup(true);
-		sync(pPeakFile);
-	}
+	for ( ; iter != iter_end; ++iter)
+		iter.value()->setWaitSync(false);
+
+	// Make sure no one's still on the older ones...
+	if (m_pPeakPool)
+		m_pPeakPool->wait();
+
+	// Refresh all current peak files (asynchronously)...
+	for (iter = m_peaks.constBegin(); iter != iter_end; ++iter)
+		iter.value()->cleanup(true);
+
+	m_peakCache.clear();
+
+	// Visible ones will get promoted on next redraw...
+	for (iter = m_peaks.constBegin(); iter != iter_end; ++iter)
+		sync(iter.value(), false);
 }
 
 
@@ -1068,10 +1511,8 @@ qtractorAudioPeak* qtractorAudioPeakFactory::createPeak (
 {
 	QMutexLocker locker(&m_mutex);
 
-	if (m_pPeakThread == nullptr) {
-		m_pPeakThread = new qtractorAudioPeakThread();
-		m_pPeakThread->start();
-	}
+	if (m_pPeakPool == nullptr)
+		m_pPeakPool = new qtractorAudioPeakPool();
 
 	const QString& sPeakName
 		= qtractorAudioPeakFile::peakName(sFilename, fTimeStretch);
@@ -1079,6 +1520,9 @@ qtractorAudioPeak* qtractorAudioPeakFactory::createPeak (
 	if (pPeakFile == nullptr) {
 		pPeakFile = new qtractorAudioPeakFile(sFilename, fTimeStretch);
 		m_peaks.insert(sPeakName, pPeakFile);
+		// Get it started in background, if missing or stale...
+		if (!pPeakFile->isUpToDate())
+			sync(pPeakFile, false);
 	}
 
 	return new qtractorAudioPeak(pPeakFile);
@@ -1104,10 +1548,23 @@ void qtractorAudioPeakFactory::notifyPeakEvent (void)
 }
 
 
+// Progress status (pending and total peak files in current batch).
+unsigned int qtractorAudioPeakFactory::peakPending (void) const
+{
+	return (m_pPeakPool ? m_pPeakPool->pending() : 0);
+}
+
+unsigned int qtractorAudioPeakFactory::peakTotal (void) const
+{
+	return (m_pPeakPool ? m_pPeakPool->total() : 0);
+}
+
+
 // Base sync method.
-void qtractorAudioPeakFactory::sync ( qtractorAudioPeakFile *pPeakFile )
+void qtractorAudioPeakFactory::sync (
+	qtractorAudioPeakFile *pPeakFile, bool bVisible )
 {
-	if (m_pPeakThread) m_pPeakThread->sync(pPeakFile);
+	if (m_pPeakPool) m_pPeakPool->sync(pPeakFile, bVisible);
 }
 
 
@@ -1118,14 +1575,30 @@ void qtractorAudioPeakFactory::cleanup (void)
 
 	sync(nullptr);
 
-	// Cleanup all current registered peak files...
+	// Abort any pending or in-progress ones...
+	QList<qtractorAudioPeakFile *> aborted;
 	PeakFiles::ConstIterator iter = m_peaks.constBegin();
 	const PeakFiles::ConstIterator& iter_end = m_peaks.constEnd();
 	for ( ; iter != iter_end; ++iter) {
 		qtractorAudioPeakFile *pPeakFile = iter.value();
-		pPeakFile->cleanup(m_bAutoRemove);
+		if (pPeakFile->isWaitSync()) {
+			pPeakFile->setWaitSync(false);
+			aborted.append(pPeakFile);
+		}
 	}
 
+	// Make sure no one's still on them...
+	if (m_pPeakPool)
+		m_pPeakPool->wait();
+
+	// Cleanup all current registered peak files...
+	for (iter = m_peaks.constBegin(); iter != iter_end; ++iter) {
+		qtractorAudioPeakFile *pPeakFile = iter.value();
+		pPeakFile->cleanup(m_bAutoRemove || aborted.contains(pPeakFile));
+	}
+
+	m_peakCache.clear();
+
 	qDeleteAll(m_peaks);
 	m_peaks.clear();
 
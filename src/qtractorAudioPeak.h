@@ -25,6 +25,8 @@
 #include <QString>
 #include <QFile>
 #include <QHash>
+#include <QCache>
+#include <QByteArray>
 
 #include <QMutex>
 
@@ -32,7 +34,7 @@
 
 
 // Forward declarations.
-class qtractorAudioPeakThread;
+class qtractorAudioPeakPool;
 
 
 //----------------------------------------------------------------------
@@ -60,11 +62,25 @@ public:
 	unsigned short period();
 	unsigned short channels();
 
+	// Multi-resolution (mipmap) level properties.
+	enum { MaxLevels = 4, LevelFactor = 16 };
+
+	unsigned short levels();
+	unsigned long levelPeriod(unsigned short iLevel);
+	unsigned int levelFrames(unsigned short iLevel);
+
+	// Coarsest level not exceeding given frames per peak.
+	unsigned short level(unsigned long iFramesPerPeak);
+
 	// Audio peak file header.
 	struct Header
 	{
 		unsigned short period;
 		unsigned short channels;
+		unsigned int   magic;
+		unsigned short levels;
+		unsigned short factor;
+		unsigned int   frames[MaxLevels];
 	};
 
 	// Audio peak file frame record.
@@ -75,15 +91,19 @@ public:
 		unsigned char rms;
 	};
 
+	// Whether the peak file exists and is not stale.
+	bool isUpToDate() const;
+
 	// Peak cache file methods.
 	bool openRead();
-	Frame *read(unsigned long iPeakOffset, unsigned int iPeakLength);
+	Frame *read(unsigned long iPeakOffset, unsigned int iPeakLength,
+		unsigned short iLevel = 0);
 	void closeRead();
 
 	// Write peak from audio frame methods.
 	bool openWrite(unsigned short iChannels, unsigned int iSampleRate);
 	int write(float **ppAudioFrames, unsigned int iAudioFrames);
-	void closeWrite();
+	void closeWrite(bool bComplete = true);
 
 	// Reference count methods.
 	void addRef();
@@ -99,6 +119,10 @@ public:
 	void setWaitSync(bool bWaitSync);
 	bool isWaitSync() const;
 
+	// Contents serial number (bumped on each creation).
+	unsigned int serial() const
+		{ return m_iSerial; }
+
 	// Peak filename standard.
 	static QString peakName(const QString& sFilename, float fTimeStretch);
 
@@ -107,10 +131,20 @@ protected:
 	// Internal creational methods.
 	void writeFrame();
 
+	// Decimated (mipmap) levels creational methods.
+	void writeLevel(unsigned short iLevel,
+		unsigned short k, const Frame& frame);
+	void commitLevel(unsigned short iLevel);
+	void flushLevel(unsigned short iLevel);
+	bool writeLevels();
+
 	// Read frames from peak file into local buffer cache.
 	unsigned int readBuffer(unsigned int iBuffOffset,
 		unsigned long iPeakOffset, unsigned int iPeakFrames);
 
+	// Level start offset in peak file (in bytes).
+	qint64 levelOffset(unsigned short iLevel) const;
+
 private:
 
 	// Instance variables.
@@ -127,6 +161,10 @@ private:
 	unsigned int   m_iBuffSize;
 	unsigned int   m_iBuffLength;
 	unsigned long  m_iBuffOffset;
+	unsigned short m_iBuffLevel;
+
+	// Memory-mapped peak file (read-only, when complete).
+	const uchar   *m_pMapped;
 
 	QMutex         m_mutex;
 
@@ -135,6 +173,9 @@ private:
 	// Current reference count.
 	unsigned int   m_iRefCount;
 
+	// Contents serial number.
+	unsigned int   m_iSerial;
+
 	// Peak-writer context state.
 	struct Writer
 	{
@@ -149,6 +190,12 @@ private:
 		unsigned short npeak;
 		unsigned long  nread;
 		unsigned long  nwrite;
+		// Decimated (mipmap) levels accumulators.
+		float         *lmax;
+		float         *lmin;
+		float         *lrms;
+		unsigned short lpeak[MaxLevels];
+		QByteArray     ldata[MaxLevels];
 
 	} *m_pWriter;
 };
@@ -197,14 +244,79 @@ private:
 	// Instance variable (ref'counted).
 	qtractorAudioPeakFile *m_pPeakFile;
 
-	// Interim scaling buffer and hash.
-	qtractorAudioPeakFile::Frame *m_pPeakFrames;
-
+	// Last peak frame buffer length.
 	unsigned int m_iPeakLength;
-	unsigned int m_iPeakHash;
 };
 
 
+//----------------------------------------------------------------------
+// class qtractorAudioPeakCache -- Audio peak aggregate cache (shared).
+//
+
+class qtractorAudioPeakCache
+{
+public:
+
+	// Constructor (maximum cost in peak frames).
+	qtractorAudioPeakCache(int iMaxFrames = 1024 * 1024);
+
+	// Aggregate cache key (file contents, range and zoom).
+	struct Key
+	{
+		bool operator== (const Key& key) const
+		{
+			return peakFile == key.peakFile
+				&& serial == key.serial
+				&& frames == key.frames
+				&& level  == key.level
+				&& offset == key.offset
+				&& length == key.length
+				&& width  == key.width;
+		}
+
+		const qtractorAudioPeakFile *peakFile;
+		unsigned int   serial;
+		unsigned int   frames;
+		unsigned short level;
+		unsigned long  offset;
+		unsigned long  length;
+		int            width;
+	};
+
+	// Aggregate cache item (owned peak frames).
+	struct Item
+	{
+		Item(unsigned int iFrames)
+			: frames(new qtractorAudioPeakFile::Frame [iFrames]), length(0) {}
+		~Item() { delete [] frames; }
+
+		qtractorAudioPeakFile::Frame *frames;
+		unsigned int length;
+	};
+
+	// Cache lookup and insertion (takes ownership); returned
+	// items are valid until next insertion or clear.
+	Item *find(const Key& key);
+	Item *insert(const Key& key, Item *pItem, int iFrames);
+
+	// Cleanup method.
+	void clear();
+
+private:
+
+	// The LRU cache proper.
+	QCache<Key, Item> m_items;
+};
+
+
+// Aggregate cache key hash function.
+inline uint qHash ( const qtractorAudioPeakCache::Key& key )
+{
+	return qHash(key.peakFile) ^ qHash(key.serial ^ key.frames ^ key.level)
+		^ qHash(key.offset) ^ qHash(key.length) ^ qHash(key.width);
+}
+
+
 //----------------------------------------------------------------------
 // class qtractorAudioPeakFactory -- Audio peak file factory (singleton).
 //
@@ -235,8 +347,16 @@ public:
 	// Peak ready event notification.
 	void notifyPeakEvent();
 
-	// Base sync method.
-	void sync(qtractorAudioPeakFile *pPeakFile = nullptr);
+	// Progress status (pending and total peak files in current batch).
+	unsigned int peakPending() const;
+	unsigned int peakTotal() const;
+
+	// Base sync method (visible ones go first).
+	void sync(qtractorAudioPeakFile *pPeakFile = nullptr, bool bVisible = true);
+
+	// Shared aggregate cache (GUI thread only).
+	qtractorAudioPeakCache *peakCache()
+		{ return &m_peakCache; }
 
 	// Cleanup method.
 	void cleanup();
@@ -262,12 +382,15 @@ private:
 	// Auto-delete property.
 	bool m_bAutoRemove;
 
-	// The peak file creation detached thread.
-	qtractorAudioPeakThread *m_pPeakThread;
+	// The peak file creation worker thread pool.
+	qtractorAudioPeakPool *m_pPeakPool;
 
 	// The current running peak-period.
 	unsigned short m_iPeakPeriod;
 
+	// The shared aggregate cache.
+	qtractorAudioPeakCache m_peakCache;
+
 	// The pseudo-singleton instance.
 	static qtractorAudioPeakFactory *g_pPeakFactory;
 };
@@ -21,6 +21,61 @@
 
 #include "qtractorAbout.h"
 #include "qtractorAudioSndFile.h"
+#include "qtractorAudioKernel.h"
+
+#ifdef CONFIG_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cmath>
+#endif
+
+
+#ifdef CONFIG_MMAP
+
+// Raw PCM sample decoders (memory-mapped read mode).
+static inline int sample_s16 ( const unsigned char *p, bool bBigEndian )
+{
+	return (bBigEndian
+		? int(short((p[0] << 8) | p[1]))
+		: int(short((p[1] << 8) | p[0])));
+}
+
+static inline int sample_s24 ( const unsigned char *p, bool bBigEndian )
+{
+	const unsigned int s = (bBigEndian
+		? ((((unsigned int) p[0]) << 24) | (p[1] << 16) | (p[2] << 8))
+		: ((((unsigned int) p[2]) << 24) | (p[1] << 16) | (p[0] << 8)));
+	return (int(s) >> 8);
+}
+
+static inline int sample_s32 ( const unsigned char *p, bool bBigEndian )
+{
+	return int(bBigEndian
+		? ((((unsigned int) p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3])
+		: ((((unsigned int) p[3]) << 24) | (p[2] << 16) | (p[1] << 8) | p[0]));
+}
+
+static inline float sample_f32 ( const unsigned char *p, bool bBigEndian )
+{
+	union { unsigned int i; float f; } u;
+	u.i = (unsigned int) sample_s32(p, bBigEndian);
+	return u.f;
+}
+
+static inline float sample_f64 ( const unsigned char *p, bool bBigEndian )
+{
+	union { unsigned long long i; double d; } u;
+	const unsigned long long hi = (unsigned int) sample_s32(
+		bBigEndian ? p : p + 4, bBigEndian);
+	const unsigned long long lo = (unsigned int) sample_s32(
+		bBigEndian ? p + 4 : p, bBigEndian);
+	u.i = (hi << 32) | lo;
+	return float(u.d);
+}
+
+#endif	// CONFIG_MMAP
 
 
 //----------------------------------------------------------------------
@@ -43,6 +98,16 @@ qtractorAudioSndFile::qtractorAudioSndFile ( unsigned short iChannels,
 	m_pBuffer     = nullptr;
 	m_iBufferSize = 1024;
 
+#ifdef CONFIG_MMAP
+	m_pMmapAddr   = nullptr;
+	m_iMmapSize   = 0;
+	m_pMmapData   = nullptr;
+	m_iMmapFrame  = 0;
+	m_iMmapBytes  = 0;
+	m_iMmapFormat = 0;
+	m_bMmapBigEndian = false;
+#endif
+
 	// Adjust size the next nearest power-of-two.
 	while (m_iBufferSize < iBufferSize)
 		m_iBufferSize <<= 1;
@@ -87,6 +152,18 @@ bool qtractorAudioSndFile::open ( const QString& sFilename, int iMode )
 
 	// Now open it.
 	QByteArray aFilename = sFilename.toUtf8();
+#ifdef CONFIG_MMAP
+	int fd = -1;
+	if (sfmode & SFM_READ) {
+		fd = ::open(aFilename.constData(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		m_pSndFile = ::sf_open_fd(fd, sfmode, &m_sfinfo, SF_TRUE);
+		if (m_pSndFile == nullptr)
+			::close(fd);
+	}
+	else
+#endif
 	m_pSndFile = ::sf_open(aFilename.constData(), sfmode, &m_sfinfo);
 	if (m_pSndFile == nullptr)
 		return false;
@@ -97,6 +174,12 @@ bool qtractorAudioSndFile::open ( const QString& sFilename, int iMode )
 	// Allocate initial de/interleaving buffer stuff.
 	m_pBuffer = new float [m_sfinfo.channels * m_iBufferSize];
 
+#ifdef CONFIG_MMAP
+	// Try the memory-mapped read mode, whenever possible...
+	if (fd >= 0 && !openMmap(fd))
+		::sf_seek(m_pSndFile, 0, SEEK_SET);
+#endif
+
 	return true;
 }
 
@@ -106,16 +189,19 @@ int qtractorAudioSndFile::read ( float **ppFrames, unsigned int iFrames )
 {
 #ifdef DEBUG_0
 	qDebug("qtractorAudioSndFile::read(%p, %d)", ppFrames, iFrames);
+#endif
+#ifdef CONFIG_MMAP
+	if (m_pMmapData) {
+		const int nread = readMmap(ppFrames, iFrames, m_iMmapFrame);
+		m_iMmapFrame += nread;
+		return nread;
+	}
 #endif
 	allocBufferCheck(iFrames);
 	int nread = ::sf_readf_float(m_pSndFile, m_pBuffer, iFrames);
 	if (nread > 0) {
-		unsigned short i;
-		unsigned int n, k = 0;
-		for (n = 0; n < (unsigned int) nread; ++n) {
-			for (i = 0; i < (unsigned short) m_sfinfo.channels; ++i)
-				ppFrames[i][n] = m_pBuffer[k++];
-		}
+		qtractorAudioKernel::deinterleave(ppFrames, m_pBuffer,
+			(unsigned short) m_sfinfo.channels, (unsigned int) nread);
 	}
 	return nread;
 }
@@ -128,12 +214,8 @@ int qtractorAudioSndFile::write ( float **ppFrames, unsigned int iFrames )
 	qDebug("qtractorAudioSndFile::write(%p, %d)", ppFrames, iFrames);
 #endif
 	allocBufferCheck(iFrames);
-	unsigned short i;
-	unsigned int n, k = 0;
-	for (n = 0; n < iFrames; ++n) {
-		for (i = 0; i < (unsigned short) m_sfinfo.channels; ++i)
-			m_pBuffer[k++] = ppFrames[i][n];
-	}
+	qtractorAudioKernel::interleave(m_pBuffer, ppFrames,
+		(unsigned short) m_sfinfo.channels, iFrames);
 	return ::sf_writef_float(m_pSndFile, m_pBuffer, iFrames);
 }
 
@@ -143,6 +225,14 @@ bool qtractorAudioSndFile::seek ( unsigned long iOffset )
 {
 #ifdef DEBUG_0
 	qDebug("qtractorAudioSndFile::seek(%d)", iOffset);
+#endif
+#ifdef CONFIG_MMAP
+	if (m_pMmapData) {
+		if (iOffset > (unsigned long) m_sfinfo.frames)
+			return false;
+		m_iMmapFrame = iOffset;
+		return true;
+	}
 #endif
 	return (::sf_seek(m_pSndFile, iOffset, SEEK_SET) == long(iOffset));
 }
@@ -155,6 +245,10 @@ void qtractorAudioSndFile::close (void)
 	qDebug("qtractorAudioSndFile::close()");
 #endif
 
+#ifdef CONFIG_MMAP
+	closeMmap();
+#endif
+
 	if (m_pSndFile) {
 		::sf_close(m_pSndFile);
 		m_pSndFile = nullptr;
@@ -213,6 +307,228 @@ void qtractorAudioSndFile::allocBufferCheck ( unsigned int iBufferSize )
 }
 
 
+#ifdef CONFIG_MMAP
+
+// Memory-mapped read mode (uncompressed PCM only).
+bool qtractorAudioSndFile::openMmap ( int fd )
+{
+	closeMmap();
+
+	if (m_sfinfo.channels < 1 || m_sfinfo.frames < 1)
+		return false;
+
+	// Only the most common uncompressed containers...
+	switch (m_sfinfo.format & SF_FORMAT_TYPEMASK) {
+	case SF_FORMAT_WAV:
+	case SF_FORMAT_WAVEX:
+	case SF_FORMAT_AIFF:
+	case SF_FORMAT_CAF:
+	case SF_FORMAT_W64:
+	case SF_FORMAT_RF64:
+		break;
+	default:
+		return false;
+	}
+
+	// ...and plain sample formats.
+	m_iMmapFormat = (m_sfinfo.format & SF_FORMAT_SUBMASK);
+	switch (m_iMmapFormat) {
+	case SF_FORMAT_PCM_16:
+		m_iMmapBytes = 2;
+		break;
+	case SF_FORMAT_PCM_24:
+		m_iMmapBytes = 3;
+		break;
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
+		m_iMmapBytes = 4;
+		break;
+	case SF_FORMAT_DOUBLE:
+		m_iMmapBytes = 8;
+		break;
+	default:
+		return false;
+	}
+
+	// Raw data byte order...
+	const bool bEndSwap = (::sf_command(m_pSndFile,
+		SFC_RAW_DATA_NEEDS_ENDSWAP, nullptr, 0) == SF_TRUE);
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+	m_bMmapBigEndian = !bEndSwap;
+#else
+	m_bMmapBigEndian =  bEndSwap;
+#endif
+
+	// Sample data starts where libsndfile is
+	// currently at, right after header parsing...
+	const off_t iDataOffset = ::lseek(fd, 0, SEEK_CUR);
+	if (iDataOffset < 0)
+		return false;
+
+	struct stat st;
+	if (::fstat(fd, &st) < 0)
+		return false;
+
+	const unsigned long iDataSize = (unsigned long) m_sfinfo.frames
+		* m_sfinfo.channels * m_iMmapBytes;
+	if ((unsigned long) iDataOffset + iDataSize > (unsigned long) st.st_size)
+		return false;
+
+	void *pAddr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (pAddr == MAP_FAILED)
+		return false;
+
+	::madvise(pAddr, st.st_size, MADV_SEQUENTIAL);
+
+	m_pMmapAddr  = pAddr;
+	m_iMmapSize  = st.st_size;
+	m_pMmapData  = static_cast<const unsigned char *> (pAddr) + iDataOffset;
+	m_iMmapFrame = 0;
+
+	// Validate against libsndfile's own decoding,
+	// at the beginning, middle and end of file...
+	const unsigned long iFrames = m_sfinfo.frames;
+	const unsigned int iProbe = (iFrames < 64 ? iFrames : 64);
+	if (!probeMmap(0, iProbe)
+		|| !probeMmap((iFrames - iProbe) >> 1, iProbe)
+		|| !probeMmap(iFrames - iProbe, iProbe)) {
+		closeMmap();
+		return false;
+	}
+
+	return true;
+}
+
+
+void qtractorAudioSndFile::closeMmap (void)
+{
+	if (m_pMmapAddr) {
+		::munmap(m_pMmapAddr, m_iMmapSize);
+		m_pMmapAddr = nullptr;
+	}
+
+	m_iMmapSize  = 0;
+	m_pMmapData  = nullptr;
+	m_iMmapFrame = 0;
+}
+
+
+// Memory-mapped read mode: straight PCM to float de-interleaving.
+int qtractorAudioSndFile::readMmap ( float **ppFrames, unsigned int iFrames,
+	unsigned long iFrame ) const
+{
+	const unsigned long iTotal = m_sfinfo.frames;
+	if (iFrame >= iTotal)
+		return 0;
+
+	if (iFrames > iTotal - iFrame)
+		iFrames = iTotal - iFrame;
+
+	const unsigned short iChannels = m_sfinfo.channels;
+	const unsigned int iStride = iChannels * m_iMmapBytes;
+	const unsigned char *pData = m_pMmapData + iFrame * iStride;
+	const bool bBigEndian = m_bMmapBigEndian;
+
+	unsigned short i;
+	unsigned int n;
+
+	switch (m_iMmapFormat) {
+	case SF_FORMAT_PCM_16: {
+		const float fScale = 1.0f / float(0x8000);
+		for (i = 0; i < iChannels; ++i) {
+			const unsigned char *p = pData + (i << 1);
+			float *pFrames = ppFrames[i];
+			for (n = 0; n < iFrames; ++n, p += iStride)
+				pFrames[n] = fScale * float(sample_s16(p, bBigEndian));
+		}
+		break;
+	}
+	case SF_FORMAT_PCM_24: {
+		const float fScale = 1.0f / float(0x800000);
+		for (i = 0; i < iChannels; ++i) {
+			const unsigned char *p = pData + (i * 3);
+			float *pFrames = ppFrames[i];
+			for (n = 0; n < iFrames; ++n, p += iStride)
+				pFrames[n] = fScale * float(sample_s24(p, bBigEndian));
+		}
+		break;
+	}
+	case SF_FORMAT_PCM_32: {
+		const float fScale = 1.0f / float(0x80000000U);
+		for (i = 0; i < iChannels; ++i) {
+			const unsigned char *p = pData + (i << 2);
+			float *pFrames = ppFrames[i];
+			for (n = 0; n < iFrames; ++n, p += iStride)
+				pFrames[n] = fScale * float(sample_s32(p, bBigEndian));
+		}
+		break;
+	}
+	case SF_FORMAT_FLOAT: {
+		for (i = 0; i < iChannels; ++i) {
+			const unsigned char *p = pData + (i << 2);
+			float *pFrames = ppFrames[i];
+			for (n = 0; n < iFrames; ++n, p += iStride)
+				pFrames[n] = sample_f32(p, bBigEndian);
+		}
+		break;
+	}
+	case SF_FORMAT_DOUBLE: {
+		for (i = 0; i < iChannels; ++i) {
+			const unsigned char *p = pData + (i << 3);
+			float *pFrames = ppFrames[i];
+			for (n = 0; n < iFrames; ++n, p += iStride)
+				pFrames[n] = sample_f64(p, bBigEndian);
+		}
+		break;
+	}
+	default:
+		return 0;
+	}
+
+	return iFrames;
+}
+
+
+// Memory-mapped read mode probe/validation.
+bool qtractorAudioSndFile::probeMmap (
+	unsigned long iFrame, unsigned int iFrames )
+{
+	if (iFrames < 1)
+		return true;
+
+	allocBufferCheck(iFrames);
+
+	if (::sf_seek(m_pSndFile, iFrame, SEEK_SET) != long(iFrame))
+		return false;
+	if (::sf_readf_float(m_pSndFile, m_pBuffer, iFrames) != long(iFrames))
+		return false;
+
+	const unsigned short iChannels = m_sfinfo.channels;
+
+	float **ppFrames = new float * [iChannels];
+	unsigned short i;
+	for (i = 0; i < iChannels; ++i)
+		ppFrames[i] = new float [iFrames];
+
+	bool bResult = (readMmap(ppFrames, iFrames, iFrame) == int(iFrames));
+	unsigned int n, k = 0;
+	for (n = 0; bResult && n < iFrames; ++n) {
+		for (i = 0; bResult && i < iChannels; ++i) {
+			if (::fabsf(ppFrames[i][n] - m_pBuffer[k++]) > 1e-6f)
+				bResult = false;
+		}
+	}
+
+	for (i = 0; i < iChannels; ++i)
+		delete [] ppFrames[i];
+	delete [] ppFrames;
+
+	return bResult;
+}
+
+#endif	// CONFIG_MMAP
+
+
 // Check whether given file type/format is valid. (static)
 bool qtractorAudioSndFile::isValidFormat ( int iType, int iFormat )
 {
@@ -70,6 +70,18 @@ protected:
 	// De/interleaving buffer (re)allocation check.
 	void allocBufferCheck(unsigned int iBufferSize);
 
+#ifdef CONFIG_MMAP
+	// Memory-mapped read mode (uncompressed PCM only).
+	bool openMmap(int fd);
+	void closeMmap();
+
+	int  readMmap(float **ppFrames, unsigned int iFrames,
+		unsigned long iFrame) const;
+
+	// Memory-mapped read mode probe/validation.
+	bool probeMmap(unsigned long iFrame, unsigned int iFrames);
+#endif
+
 private:
 
 	int           m_iMode;          // open mode (Read|Write).
@@ -79,6 +91,19 @@ private:
 	// De/interleaving buffer stuff.
 	float        *m_pBuffer;
 	unsigned int  m_iBufferSize;
+
+#ifdef CONFIG_MMAP
+	// Memory-mapped read mode stuff.
+	void         *m_pMmapAddr;
+	unsigned long m_iMmapSize;
+
+	const unsigned char *m_pMmapData;
+
+	unsigned long  m_iMmapFrame;    // current read position.
+	unsigned short m_iMmapBytes;    // bytes per sample.
+	int            m_iMmapFormat;   // libsndfile sub-format.
+	bool           m_bMmapBigEndian;
+#endif
 };
 
 
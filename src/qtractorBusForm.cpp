@@ -175,6 +175,9 @@ qtractorBusForm::qtractorBusForm ( QWidget *pParent )
 	QObject::connect(m_ui.MidiSysexPushButton,
 		SIGNAL(clicked()),
 		SLOT(midiSysex()));
+	QObject::connect(m_ui.MidiJackCheckBox,
+		SIGNAL(clicked()),
+		SLOT(changed()));
 
 	QObject::connect(m_ui.InputPluginListView,
 		SIGNAL(currentRowChanged(int)),
@@ -347,6 +350,7 @@ void qtractorBusForm::showBus ( qtractorBus *pBus )
 						pMidiBus->instrumentName());
 				m_ui.MidiInstrumentComboBox->setCurrentIndex(
 					iInstrumentIndex > 0 ? iInstrumentIndex : 0);
+				m_ui.MidiJackCheckBox->setChecked(pMidiBus->isJackMidi());
 				// Set plugin lists...
 				if (pMidiBus->busMode() & qtractorBus::Input)
 					m_ui.InputPluginListView->setPluginList(
@@ -577,6 +581,8 @@ bool qtractorBusForm::updateBus ( qtractorBus *pBus )
 			m_ui.MidiInstrumentComboBox->currentIndex() > 0
 			? m_ui.MidiInstrumentComboBox->currentText()
 			: QString());
+		pUpdateBusCommand->setJackMidi(
+			m_ui.MidiJackCheckBox->isChecked());
 		// Fall thru...
 	case qtractorTrack::None:
 	default:
@@ -683,6 +689,8 @@ void qtractorBusForm::createBus (void)
 			m_ui.MidiInstrumentComboBox->currentIndex() > 0
 			? m_ui.MidiInstrumentComboBox->currentText()
 			: QString());
+		pCreateBusCommand->setJackMidi(
+			m_ui.MidiJackCheckBox->isChecked());
 		// Fall thru...
 	case qtractorTrack::None:
 	default:
@@ -848,6 +856,7 @@ void qtractorBusForm::stabilizeForm (void)
 		m_ui.MidiInstrumentComboBox->setEnabled(bEnabled);
 		m_ui.MidiSysexPushButton->setEnabled(bEnabled);
 		m_ui.MidiSysexTextLabel->setEnabled(bEnabled);
+		m_ui.MidiJackCheckBox->setEnabled(bEnabled);
 	} else {
 		m_ui.AudioBusGroup->setEnabled(false);
 		m_ui.AudioBusGroup->setVisible(true);
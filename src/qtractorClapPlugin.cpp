@@ -640,6 +640,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency () const;
 
+	// Plugin declared tail length (in frames);
+	long tail () const;
+
 	// Total parameter count.
 	unsigned long getParameterCount() const
 		{ return m_param_infos.count(); }
@@ -1695,6 +1698,25 @@ unsigned long qtractorClapPlugin::Impl::latency (void) const
 }
 
 
+// Plugin declared tail length (in frames);
+long qtractorClapPlugin::Impl::tail (void) const
+{
+	if (m_plugin) {
+		const clap_plugin_tail *tail
+			= static_cast<const clap_plugin_tail *> (
+				m_plugin->get_extension(m_plugin, CLAP_EXT_TAIL));
+		if (tail && tail->get) {
+			const uint32_t iTail = tail->get(m_plugin);
+			if (iTail >= uint32_t(INT32_MAX))
+				return qtractorPlugin::TailInfinite;
+			return long(iTail);
+		}
+	}
+
+	return qtractorPlugin::TailUnknown;
+}
+
+
 // Set/add a parameter value/point.
 void qtractorClapPlugin::Impl::setParameter (
 	clap_id id, double value )
@@ -1964,6 +1986,9 @@ void qtractorClapPlugin::Impl::plugin_request_restart (void)
 		m_pPlugin->restart();
 
 	activate();
+
+	if (m_pPlugin)
+		m_pPlugin->updateSilenceBypass();
 }
 
 
@@ -3465,6 +3490,13 @@ unsigned long qtractorClapPlugin::latency (void) const
 }
 
 
+// Plugin declared tail length (in frames);
+long qtractorClapPlugin::tail (void) const
+{
+	return m_pImpl->tail();
+}
+
+
 // Plugin preset i/o (configuration from/to state files).
 bool qtractorClapPlugin::loadPresetFile ( const QString& sFilename )
 {
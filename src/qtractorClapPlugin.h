@@ -175,6 +175,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency() const;
 
+	// Plugin declared tail length (in frames);
+	long tail() const;
+
 	// Plugin preset i/o (configuration from/to state files).
 	bool loadPresetFile(const QString& sFilename);
 	bool savePresetFile(const QString& sFilename);
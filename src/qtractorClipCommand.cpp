@@ -31,6 +31,7 @@
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiClip.h"
 #include "qtractorTracks.h"
+#include "qtractorTrackView.h"
 #include "qtractorFiles.h"
 
 #include "qtractorMidiEditCommand.h"
@@ -609,8 +610,6 @@ bool qtractorClipCommand::execute ( bool bRedo )
 	if (pSession == nullptr)
 		return false;
 
-	pSession->lock();
-
 	QListIterator<qtractorTrackCommand *> track(m_trackCommands);
 	while (track.hasNext()) {
 	    qtractorTrackCommand *pTrackCommand = track.next();
@@ -620,6 +619,29 @@ bool qtractorClipCommand::execute ( bool bRedo )
 			pTrackCommand->undo();
 	}
 
+	// Withdraw all clips about to be changed from rendering
+	// (scalar property changes are left in place)...
+	QList<qtractorClip *> clips = m_clips.keys();
+	QListIterator<Item *> item(m_items);
+	while (item.hasNext()) {
+		Item *pItem = item.next();
+		switch (pItem->command) {
+		case RenameClip:
+		case GainClip:
+		case PanningClip:
+		case FadeInClip:
+		case FadeOutClip:
+		case TakeInfoClip:
+			break;
+		default:
+			if (pItem->clip && !clips.contains(pItem->clip))
+				clips.append(pItem->clip);
+			break;
+		}
+	}
+
+	pSession->withdrawClips(clips);
+
 	// Pre-close needed clips once...
 	QHash<qtractorClip *, bool>::ConstIterator clip = m_clips.constBegin();
 	const QHash<qtractorClip *, bool>::ConstIterator& clip_end = m_clips.constEnd();
@@ -628,11 +650,19 @@ bool qtractorClipCommand::execute ( bool bRedo )
 			clip.key()->close();
 	}
 
+	// Track lanes to be redrawn (only when no track commands)...
+	QList<qtractorTrack *> tracks;
+
 	QListIterator<Item *> iter(m_items);
 	while (iter.hasNext()) {
 		Item *pItem = iter.next();
 		qtractorClip  *pClip  = pItem->clip;
 		qtractorTrack *pTrack = pItem->track;
+		// Keep track of track lanes affected...
+		if (pClip && pClip->track() && !tracks.contains(pClip->track()))
+			tracks.append(pClip->track());
+		if (pTrack && !tracks.contains(pTrack))
+			tracks.append(pTrack);
 		// Execute the command item...
 		switch (pItem->command) {
 		case AddClip: {
@@ -861,7 +891,18 @@ bool qtractorClipCommand::execute ( bool bRedo )
 	for (clip = m_clips.constBegin(); clip != clip_end; ++clip)
 		clip.key()->open();
 
-	pSession->unlock();
+	pSession->restoreClips();
+
+	// Redraw affected track lanes only...
+	if (m_trackCommands.isEmpty() && isRefresh()) {
+		qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
+		qtractorTracks *pTracks = (pMainForm ? pMainForm->tracks() : nullptr);
+		if (pTracks) {
+			QListIterator<qtractorTrack *> iter2(tracks);
+			while (iter2.hasNext())
+				pTracks->trackView()->invalidateTrack(iter2.next());
+		}
+	}
 
 	return true;
 }
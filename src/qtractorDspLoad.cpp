@@ -0,0 +1,371 @@
+// qtractorDspLoad.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorDspLoad.h"
+
+#include "qtractorSession.h"
+#include "qtractorSessionSnapshot.h"
+#include "qtractorAudioEngine.h"
+#include "qtractorMidiManager.h"
+#include "qtractorPlugin.h"
+#include "qtractorTrack.h"
+
+#include <cstring>
+
+
+//----------------------------------------------------------------------
+// class qtractorDspProbe -- DSP time probe (lock-free, single writer).
+//
+
+// Fold current cycle time into statistics;
+// returns the folded cycle time (RT-safe).
+unsigned long long qtractorDspProbe::commit (void)
+{
+	const unsigned long long t = m_iCycle;
+	if (t == 0)	// Not processed on this cycle.
+		return 0;
+
+	m_iCycle = 0;
+
+	m_iLast = t;
+	if (m_iMin > t || m_iCount == 0)
+		m_iMin = t;
+	if (m_iMax < t)
+		m_iMax = t;
+	m_iSum += t;
+	++m_iCount;
+
+	++m_bins[bin(t)];
+
+	return t;
+}
+
+
+// Reset all statistics (RT-safe, engine thread only).
+void qtractorDspProbe::reset (void)
+{
+	m_iCycle = 0;
+	m_iLast  = 0;
+	m_iMin   = 0;
+	m_iMax   = 0;
+	m_iSum   = 0;
+	m_iCount = 0;
+
+	::memset(m_bins, 0, sizeof(m_bins));
+}
+
+
+// Histogram based (upper bound) percentile estimate.
+unsigned long long qtractorDspProbe::percentile ( float fPercent ) const
+{
+	if (m_iCount < 1)
+		return 0;
+
+	unsigned long iTarget
+		= (unsigned long) (0.01f * fPercent * float(m_iCount));
+	if (iTarget < 1)
+		iTarget = 1;
+
+	unsigned long iCount = 0;
+	for (unsigned int i = 0; i < Bins; ++i) {
+		iCount += m_bins[i];
+		if (iCount >= iTarget) {
+			const unsigned long long t = binLimit(i);
+			return (t < m_iMax ? t : m_iMax);
+		}
+	}
+
+	return m_iMax;
+}
+
+
+// Histogram bin helpers: half-octave microsecond bins.
+unsigned int qtractorDspProbe::bin ( unsigned long long nsecs )
+{
+	const unsigned long long usecs = nsecs / 1000;
+	if (usecs == 0)
+		return 0;
+
+	unsigned int b = 0;
+	while ((usecs >> (b + 1)) > 0)
+		++b;
+
+	const unsigned int n = (b > 0 ? ((usecs >> (b - 1)) & 1) : 0);
+	const unsigned int i = 1 + (b << 1) + n;
+
+	return (i < Bins ? i : Bins - 1);
+}
+
+unsigned long long qtractorDspProbe::binLimit ( unsigned int iBin )
+{
+	if (iBin == 0)
+		return 1000;
+
+	const unsigned int b = ((iBin - 1) >> 1);
+	const unsigned int n = ((iBin - 1) & 1);
+
+	if (b == 0)
+		return 2000;
+
+	return 1000ULL * ((1ULL << b) + ((n + 1ULL) << (b - 1)));
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorDspLoad -- Real-time engine instrumentation.
+//
+
+// The local instrumentation singleton.
+static qtractorDspLoad g_dspLoad;
+
+qtractorDspLoad *qtractorDspLoad::getInstance (void)
+{
+	return &g_dspLoad;
+}
+
+
+// Instrumentation enablement.
+bool qtractorDspLoad::g_bEnabled = false;
+
+void qtractorDspLoad::setEnabled ( bool bEnabled )
+{
+	g_bEnabled = bEnabled;
+}
+
+bool qtractorDspLoad::isEnabled (void)
+{
+	return g_bEnabled;
+}
+
+
+// Constructor.
+qtractorDspLoad::qtractorDspLoad (void)
+	: m_iCycleStart(0), m_iCycles(0), m_iBudget(0),
+		m_bResetting(false), m_iXrunsLast(0),
+		m_iOverrunRead(0), m_iOverrunWrite(0)
+{
+	::memset(&m_curr, 0, sizeof(m_curr));
+	::memset(&m_last, 0, sizeof(m_last));
+
+	ATOMIC_SET(&m_xruns, 0);
+	ATOMIC_SET(&m_resetPending, 0);
+}
+
+
+// Engine cycle executives (engine thread only).
+void qtractorDspLoad::cycle_start (void)
+{
+	m_iCycleStart = start();
+}
+
+
+void qtractorDspLoad::cycle_end ( qtractorSession *pSession,
+	unsigned int nframes, unsigned int iSampleRate )
+{
+	// Disabled, at least since this cycle started?
+	if (m_iCycleStart == 0 || pSession == nullptr)
+		return;
+
+	m_cycle.add(m_iCycleStart);
+	m_iCycleStart = 0;
+
+	// Whether a statistics reset was requested...
+	m_bResetting = ATOMIC_TAZ(&m_resetPending);
+	if (m_bResetting)
+		m_iCycles = 0;
+
+	m_curr.cycle  = m_iCycles++;
+	m_curr.frames = nframes;
+	m_curr.budget = (iSampleRate > 0
+		? (1000000000ULL * nframes) / iSampleRate : 0);
+	m_curr.total  = commitProbe(&m_cycle);
+	m_curr.probe  = nullptr;
+	m_curr.probeTime  = 0;
+	m_curr.plugin = nullptr;
+	m_curr.pluginTime = 0;
+	m_curr.xrun   = false;
+
+	m_iBudget = m_curr.budget;
+
+	// Tracks (on current render snapshot)...
+	qtractorSessionEpoch *pEpoch = pSession->epoch();
+	const unsigned int iEpoch = pEpoch->enter();
+	qtractorSessionSnapshot *pSnapshot = pEpoch->snapshot();
+	const unsigned int iTracks = (pSnapshot ? pSnapshot->tracks() : 0);
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
+		topProbe(&pTrack->dspProbe());
+		qtractorPluginList *pPluginList = pTrack->pluginList();
+		if (pPluginList && pPluginList->midiManager() == nullptr)
+			commitPlugins(pPluginList);
+	}
+	pEpoch->leave(iEpoch);
+
+	// Audio buses...
+	qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+	if (pAudioEngine) {
+		for (int i = 0; i < 2; ++i) {
+			qtractorBus *pBus = (i == 0
+				? pAudioEngine->buses().first()
+				: pAudioEngine->busesEx().first());
+			for ( ; pBus; pBus = pBus->next()) {
+				qtractorAudioBus *pAudioBus
+					= static_cast<qtractorAudioBus *> (pBus);
+				topProbe(&pAudioBus->dspProbe());
+				qtractorPluginList *pPluginList = pAudioBus->pluginList_in();
+				if (pPluginList && pPluginList->midiManager() == nullptr)
+					commitPlugins(pPluginList);
+				pPluginList = pAudioBus->pluginList_out();
+				if (pPluginList && pPluginList->midiManager() == nullptr)
+					commitPlugins(pPluginList);
+			}
+		}
+	}
+
+	// MIDI managers...
+	qtractorMidiManager *pMidiManager = pSession->midiManagers().first();
+	for ( ; pMidiManager; pMidiManager = pMidiManager->next()) {
+		topProbe(&pMidiManager->dspProbe());
+		commitPlugins(pMidiManager->pluginList());
+	}
+
+	// Tag this cycle, if it overran its own budget...
+	if (m_bResetting)
+		m_curr.budget = 0;
+	else
+	if (m_curr.budget > 0 && m_curr.total >= m_curr.budget)
+		pushOverrun(m_curr);
+
+	// Tag last cycle, if JACK reported an XRUN meanwhile...
+	const int iXruns = ATOMIC_GET(&m_xruns);
+	if (m_iXrunsLast != iXruns) {
+		m_iXrunsLast = iXruns;
+		if (m_last.budget > 0) {
+			m_last.xrun = true;
+			pushOverrun(m_last);
+		}
+	}
+
+	m_last = m_curr;
+}
+
+
+// JACK XRUN notification (any thread).
+void qtractorDspLoad::notifyXrun (void)
+{
+	if (g_bEnabled)
+		ATOMIC_INC(&m_xruns);
+}
+
+
+// Fold a plugin chain probes (engine thread only).
+void qtractorDspLoad::commitPlugins ( qtractorPluginList *pPluginList )
+{
+	if (pPluginList == nullptr)
+		return;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return;
+
+	// Plugin chain render snapshot read-side section...
+	qtractorSessionEpoch *pEpoch = pSession->epoch();
+	const unsigned int iEpoch = pEpoch->enter();
+	qtractorSessionChain *pChain = pPluginList->chain();
+	const unsigned int iPlugins = (pChain ? pChain->plugins() : 0);
+	for (unsigned int i = 0; i < iPlugins; ++i)
+		topPlugin(&pChain->plugin(i)->dspProbe());
+	pEpoch->leave(iEpoch);
+}
+
+
+// Fold (or reset) a probe current cycle (engine thread only).
+unsigned long long qtractorDspLoad::commitProbe ( qtractorDspProbe *pProbe )
+{
+	if (m_bResetting) {
+		pProbe->reset();
+		return 0;
+	}
+
+	return pProbe->commit();
+}
+
+
+// Keep track of top offenders.
+void qtractorDspLoad::topProbe ( qtractorDspProbe *pProbe )
+{
+	const unsigned long long t = commitProbe(pProbe);
+	if (m_curr.probeTime < t) {
+		m_curr.probeTime = t;
+		m_curr.probe = pProbe;
+	}
+}
+
+void qtractorDspLoad::topPlugin ( qtractorDspProbe *pProbe )
+{
+	const unsigned long long t = commitProbe(pProbe);
+	if (m_curr.pluginTime < t) {
+		m_curr.pluginTime = t;
+		m_curr.plugin = pProbe;
+	}
+}
+
+
+// Overrun log producer (RT-safe, engine thread only).
+void qtractorDspLoad::pushOverrun ( const Overrun& overrun )
+{
+	const unsigned int w = m_iOverrunWrite;
+	if (((w + 1) & OverrunMask) == (m_iOverrunRead & OverrunMask))
+		return; // Full, drop it.
+
+	m_overruns[w & OverrunMask] = overrun;
+	m_iOverrunWrite = ((w + 1) & OverrunMask);
+}
+
+
+// Overrun log consumer (non RT-safe, GUI thread only).
+bool qtractorDspLoad::nextOverrun ( Overrun& overrun )
+{
+	const unsigned int r = m_iOverrunRead;
+	if (r == m_iOverrunWrite)
+		return false;
+
+	overrun = m_overruns[r & OverrunMask];
+	m_iOverrunRead = ((r + 1) & OverrunMask);
+
+	return true;
+}
+
+
+// Statistics reset request (non RT-safe, GUI thread only).
+void qtractorDspLoad::reset (void)
+{
+	ATOMIC_SET(&m_resetPending, 1);
+
+	// Discard the overrun log too...
+	Overrun overrun;
+	while (nextOverrun(overrun))
+		;
+}
+
+
+// end of qtractorDspLoad.cpp
@@ -0,0 +1,223 @@
+// qtractorDspLoad.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorDspLoad_h
+#define __qtractorDspLoad_h
+
+#include "qtractorAtomic.h"
+
+#include <chrono>
+
+
+// Forward declarations.
+class qtractorSession;
+class qtractorPluginList;
+
+
+//----------------------------------------------------------------------
+// class qtractorDspProbe -- DSP time probe (lock-free, single writer).
+//
+
+class qtractorDspProbe
+{
+public:
+
+	// Constructor.
+	qtractorDspProbe() { reset(); }
+
+	// Histogram resolution (half-octave microsecond bins).
+	enum { Bins = 48 };
+
+	// Accumulate time since a start stamp, if any (RT-safe).
+	void add(unsigned long long t0);
+
+	// Fold current cycle time into statistics;
+	// returns the folded cycle time (RT-safe).
+	unsigned long long commit();
+
+	// Reset all statistics (RT-safe, engine thread only).
+	void reset();
+
+	// Statistics accessors, all in nanoseconds (non RT-safe).
+	unsigned long count() const
+		{ return m_iCount; }
+	unsigned long long last() const
+		{ return m_iLast; }
+	unsigned long long minimum() const
+		{ return m_iMin; }
+	unsigned long long maximum() const
+		{ return m_iMax; }
+	unsigned long long average() const
+		{ return (m_iCount > 0 ? m_iSum / m_iCount : 0); }
+
+	// Histogram based (upper bound) percentile estimate.
+	unsigned long long percentile(float fPercent) const;
+
+	// Histogram bin helpers.
+	static unsigned int bin(unsigned long long nsecs);
+	static unsigned long long binLimit(unsigned int iBin);
+
+private:
+
+	// Instance variables.
+	unsigned long long m_iCycle;
+	unsigned long long m_iLast;
+	unsigned long long m_iMin;
+	unsigned long long m_iMax;
+	unsigned long long m_iSum;
+	unsigned long      m_iCount;
+
+	unsigned long      m_bins[Bins];
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorDspLoad -- Real-time engine instrumentation.
+//
+
+class qtractorDspLoad
+{
+public:
+
+	// Constructor.
+	qtractorDspLoad();
+
+	// Monotonic time stamp (in nanoseconds).
+	static unsigned long long now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds> (
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Probe start stamp, null when disabled (RT-safe).
+	static unsigned long long start()
+		{ return (g_bEnabled ? now() : 0); }
+
+	// Instrumentation enablement.
+	static void setEnabled(bool bEnabled);
+	static bool isEnabled();
+
+	// Overrun (tagged) cycle record.
+	struct Overrun
+	{
+		unsigned long      cycle;	// cycle serial number.
+		unsigned int       frames;	// cycle period (in frames).
+		unsigned long long budget;	// cycle period (in nsecs).
+		unsigned long long total;	// engine cycle time (in nsecs).
+		const qtractorDspProbe *probe;	// top track, bus or manager.
+		unsigned long long probeTime;
+		const qtractorDspProbe *plugin;	// top plugin.
+		unsigned long long pluginTime;
+		bool               xrun;	// reported by JACK.
+	};
+
+	// Engine cycle executives (engine thread only).
+	void cycle_start();
+	void cycle_end(qtractorSession *pSession,
+		unsigned int nframes, unsigned int iSampleRate);
+
+	// JACK XRUN notification (any thread).
+	void notifyXrun();
+
+	// Whole engine cycle probe.
+	const qtractorDspProbe& cycleProbe() const
+		{ return m_cycle; }
+
+	// Cycle counters.
+	unsigned long cycles() const
+		{ return m_iCycles; }
+	unsigned long long budget() const
+		{ return m_iBudget; }
+
+	// Overrun log consumer (non RT-safe, GUI thread only).
+	bool nextOverrun(Overrun& overrun);
+
+	// Statistics reset request (non RT-safe, GUI thread only).
+	void reset();
+
+	// Singleton instance accessor.
+	static qtractorDspLoad *getInstance();
+
+protected:
+
+	// Fold (or reset) a probe current cycle (engine thread only).
+	unsigned long long commitProbe(qtractorDspProbe *pProbe);
+
+	// Fold a plugin chain probes (engine thread only).
+	void commitPlugins(qtractorPluginList *pPluginList);
+
+	// Fold probes, keeping track of top offenders.
+	void topProbe(qtractorDspProbe *pProbe);
+	void topPlugin(qtractorDspProbe *pProbe);
+
+	// Overrun log producer (RT-safe, engine thread only).
+	void pushOverrun(const Overrun& overrun);
+
+private:
+
+	// Instance variables.
+	qtractorDspProbe   m_cycle;
+
+	unsigned long long m_iCycleStart;
+	unsigned long      m_iCycles;
+	unsigned long long m_iBudget;
+
+	bool               m_bResetting;
+
+	// Current and last cycle summaries.
+	Overrun            m_curr;
+	Overrun            m_last;
+
+	// XRUN notification counters.
+	qtractorAtomic     m_xruns;
+	int                m_iXrunsLast;
+
+	// Statistics reset request.
+	qtractorAtomic     m_resetPending;
+
+	// Overrun log ring-buffer (single producer, single consumer).
+	enum { OverrunSize = 256, OverrunMask = OverrunSize - 1 };
+
+	Overrun            m_overruns[OverrunSize];
+
+	volatile unsigned int m_iOverrunRead;
+	volatile unsigned int m_iOverrunWrite;
+
+	// Instrumentation enablement.
+	static bool g_bEnabled;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorDspProbe -- Inline methods.
+//
+
+// Accumulate time since a start stamp, if any (RT-safe).
+inline void qtractorDspProbe::add ( unsigned long long t0 )
+{
+	if (t0) m_iCycle += qtractorDspLoad::now() - t0;
+}
+
+
+#endif  // __qtractorDspLoad_h
+
+
+// end of qtractorDspLoad.h
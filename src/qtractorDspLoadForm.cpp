@@ -0,0 +1,423 @@
+// qtractorDspLoadForm.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorDspLoadForm.h"
+
+#include "qtractorDspLoad.h"
+
+#include "qtractorSession.h"
+#include "qtractorAudioEngine.h"
+#include "qtractorMidiManager.h"
+#include "qtractorPlugin.h"
+#include "qtractorTrack.h"
+
+#include "qtractorOptions.h"
+
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QTextStream>
+#include <QDateTime>
+#include <QTimer>
+#include <QFileInfo>
+#include <QFile>
+
+
+// Refresh period (msecs).
+#define DSP_LOAD_REFRESH_MSECS 1000
+
+// Maximum overrun log items.
+#define DSP_LOAD_OVERRUNS_MAX  1000
+
+
+//----------------------------------------------------------------------
+// qtractorDspLoadListItem -- Numeric sortable item.
+//
+
+class qtractorDspLoadListItem : public QTreeWidgetItem
+{
+public:
+
+	// Contructor.
+	qtractorDspLoadListItem(QTreeWidget *pTreeWidget)
+		: QTreeWidgetItem(pTreeWidget) {}
+
+protected:
+
+	bool operator< ( const QTreeWidgetItem& other ) const
+	{
+		QTreeWidget *pTreeWidget = QTreeWidgetItem::treeWidget();
+		if (pTreeWidget == nullptr)
+			return QTreeWidgetItem::operator< (other);
+
+		const int iColumn = pTreeWidget->sortColumn();
+		const QVariant& v1 = QTreeWidgetItem::data(iColumn, Qt::UserRole);
+		const QVariant& v2 = other.data(iColumn, Qt::UserRole);
+		if (v1.isValid() && v2.isValid())
+			return v1.toDouble() < v2.toDouble();
+
+		return QTreeWidgetItem::operator< (other);
+	}
+};
+
+
+// Nanoseconds to milliseconds text (and sort) helper.
+static void setItemMsecs ( QTreeWidgetItem *pItem,
+	int iColumn, unsigned long long nsecs )
+{
+	const double msecs = 1e-6 * double(nsecs);
+	pItem->setText(iColumn, QString::number(msecs, 'f', 3));
+	pItem->setData(iColumn, Qt::UserRole, msecs);
+	pItem->setTextAlignment(iColumn, Qt::AlignRight | Qt::AlignVCenter);
+}
+
+
+//----------------------------------------------------------------------------
+// qtractorDspLoadForm -- UI wrapper form.
+
+// Constructor.
+qtractorDspLoadForm::qtractorDspLoadForm ( QWidget *pParent )
+	: QDialog(pParent)
+{
+	// Setup UI struct...
+	m_ui.setupUi(this);
+#if QT_VERSION < QT_VERSION_CHECK(6, 1, 0)
+	QDialog::setWindowIcon(QIcon(":/images/qtractor.png"));
+#endif
+
+	QHeaderView *pHeader = m_ui.DspLoadListView->header();
+	pHeader->setDefaultAlignment(Qt::AlignLeft);
+	pHeader->setStretchLastSection(false);
+	pHeader->resizeSection(1, 200);
+	m_ui.DspLoadListView->sortByColumn(7, Qt::DescendingOrder);
+
+	pHeader = m_ui.OverrunListView->header();
+	pHeader->setDefaultAlignment(Qt::AlignLeft);
+	m_ui.OverrunListView->sortByColumn(0, Qt::DescendingOrder);
+
+	m_ui.EnabledCheckBox->setChecked(qtractorDspLoad::isEnabled());
+
+	// Periodic refresh...
+	m_pRefreshTimer = new QTimer(this);
+	m_pRefreshTimer->setInterval(DSP_LOAD_REFRESH_MSECS);
+
+	// Try to restore old window positioning.
+	adjustSize();
+
+	// UI signal/slot connections...
+	QObject::connect(m_pRefreshTimer,
+		SIGNAL(timeout()),
+		SLOT(refresh()));
+	QObject::connect(m_ui.EnabledCheckBox,
+		SIGNAL(toggled(bool)),
+		SLOT(enabled(bool)));
+	QObject::connect(m_ui.ResetPushButton,
+		SIGNAL(clicked()),
+		SLOT(reset()));
+	QObject::connect(m_ui.SavePushButton,
+		SIGNAL(clicked()),
+		SLOT(save()));
+	QObject::connect(m_ui.ClosePushButton,
+		SIGNAL(clicked()),
+		SLOT(close()));
+}
+
+
+// Destructor.
+qtractorDspLoadForm::~qtractorDspLoadForm (void)
+{
+}
+
+
+// Window show/hide events.
+void qtractorDspLoadForm::showEvent ( QShowEvent *pShowEvent )
+{
+	QDialog::showEvent(pShowEvent);
+
+	refresh();
+
+	m_pRefreshTimer->start();
+}
+
+void qtractorDspLoadForm::hideEvent ( QHideEvent *pHideEvent )
+{
+	m_pRefreshTimer->stop();
+
+	QDialog::hideEvent(pHideEvent);
+}
+
+
+// Instrumentation enablement.
+void qtractorDspLoadForm::enabled ( bool bOn )
+{
+	qtractorDspLoad::setEnabled(bOn);
+
+	refresh();
+}
+
+
+// Reset all statistics.
+void qtractorDspLoadForm::reset (void)
+{
+	qtractorDspLoad::getInstance()->reset();
+
+	m_ui.OverrunListView->clear();
+
+	refresh();
+}
+
+
+// Refresh all statistics.
+void qtractorDspLoadForm::refresh (void)
+{
+	qtractorDspLoad *pDspLoad = qtractorDspLoad::getInstance();
+
+	m_names.clear();
+
+	m_ui.DspLoadListView->setUpdatesEnabled(false);
+	m_ui.DspLoadListView->clear();
+
+	const qtractorDspProbe& cycle = pDspLoad->cycleProbe();
+	addProbeItem(tr("Engine"), tr("(process cycle)"), cycle);
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession) {
+		// Tracks...
+		for (qtractorTrack *pTrack = pSession->tracks().first();
+				pTrack; pTrack = pTrack->next()) {
+			addProbeItem(tr("Track"), pTrack->trackName(), pTrack->dspProbe());
+			qtractorPluginList *pPluginList = pTrack->pluginList();
+			if (pPluginList && pPluginList->midiManager() == nullptr)
+				addPluginItems(pPluginList);
+		}
+		// Audio buses...
+		qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+		if (pAudioEngine) {
+			for (int i = 0; i < 2; ++i) {
+				qtractorBus *pBus = (i == 0
+					? pAudioEngine->buses().first()
+					: pAudioEngine->busesEx().first());
+				for ( ; pBus; pBus = pBus->next()) {
+					qtractorAudioBus *pAudioBus
+						= static_cast<qtractorAudioBus *> (pBus);
+					addProbeItem(tr("Bus"), pAudioBus->busName(),
+						pAudioBus->dspProbe());
+					qtractorPluginList *pPluginList = pAudioBus->pluginList_in();
+					if (pPluginList && pPluginList->midiManager() == nullptr)
+						addPluginItems(pPluginList);
+					pPluginList = pAudioBus->pluginList_out();
+					if (pPluginList && pPluginList->midiManager() == nullptr)
+						addPluginItems(pPluginList);
+				}
+			}
+		}
+		// MIDI managers...
+		qtractorMidiManager *pMidiManager = pSession->midiManagers().first();
+		for ( ; pMidiManager; pMidiManager = pMidiManager->next()) {
+			qtractorPluginList *pPluginList = pMidiManager->pluginList();
+			addProbeItem(tr("MIDI"), pPluginList->name(),
+				pMidiManager->dspProbe());
+			addPluginItems(pPluginList);
+		}
+	}
+
+	m_ui.DspLoadListView->setUpdatesEnabled(true);
+
+	// Overall cycle load...
+	const unsigned long long iBudget = pDspLoad->budget();
+	if (iBudget > 0 && cycle.count() > 0) {
+		m_ui.CycleLoadTextLabel->setText(
+			tr("%1 cycles, %2% average, %3% peak load")
+			.arg(pDspLoad->cycles())
+			.arg(100.0 * double(cycle.average()) / double(iBudget), 0, 'f', 1)
+			.arg(100.0 * double(cycle.maximum()) / double(iBudget), 0, 'f', 1));
+	} else {
+		m_ui.CycleLoadTextLabel->clear();
+	}
+
+	updateOverruns();
+}
+
+
+// Add a probe statistics item.
+void qtractorDspLoadForm::addProbeItem ( const QString& sType,
+	const QString& sName, const qtractorDspProbe& probe )
+{
+	m_names.insert(&probe, sType + ": " + sName);
+
+	if (probe.count() < 1)
+		return;
+
+	QTreeWidgetItem *pItem = new qtractorDspLoadListItem(m_ui.DspLoadListView);
+	pItem->setText(0, sType);
+	pItem->setText(1, sName);
+	setItemMsecs(pItem, 2, probe.last());
+	setItemMsecs(pItem, 3, probe.minimum());
+	setItemMsecs(pItem, 4, probe.average());
+	setItemMsecs(pItem, 5, probe.percentile(95.0f));
+	setItemMsecs(pItem, 6, probe.percentile(99.0f));
+	setItemMsecs(pItem, 7, probe.maximum());
+
+	const unsigned long long iBudget
+		= qtractorDspLoad::getInstance()->budget();
+	if (iBudget > 0) {
+		const double fLoad = 100.0 * double(probe.average()) / double(iBudget);
+		pItem->setText(8, QString::number(fLoad, 'f', 1) + '%');
+		pItem->setData(8, Qt::UserRole, fLoad);
+		pItem->setTextAlignment(8, Qt::AlignRight | Qt::AlignVCenter);
+	}
+}
+
+
+// Add a plugin chain probes.
+void qtractorDspLoadForm::addPluginItems ( qtractorPluginList *pPluginList )
+{
+	for (qtractorPlugin *pPlugin = pPluginList->first();
+			pPlugin; pPlugin = pPlugin->next()) {
+		addProbeItem(tr("Plugin"),
+			pPluginList->name() + " / " + pPlugin->type()->name(),
+			pPlugin->dspProbe());
+	}
+}
+
+
+// Drain pending overruns into the log.
+void qtractorDspLoadForm::updateOverruns (void)
+{
+	qtractorDspLoad *pDspLoad = qtractorDspLoad::getInstance();
+
+	const QString& sTime
+		= QDateTime::currentDateTime().toString("hh:mm:ss");
+	const QString sUnknown("-");
+
+	qtractorDspLoad::Overrun overrun;
+	while (pDspLoad->nextOverrun(overrun)) {
+		QTreeWidgetItem *pItem = new qtractorDspLoadListItem(m_ui.OverrunListView);
+		pItem->setText(0, QString::number(overrun.cycle));
+		pItem->setData(0, Qt::UserRole, double(overrun.cycle));
+		pItem->setText(1, sTime);
+		setItemMsecs(pItem, 2, overrun.budget);
+		setItemMsecs(pItem, 3, overrun.total);
+		pItem->setText(4, overrun.probe
+			? m_names.value(overrun.probe, sUnknown) : sUnknown);
+		pItem->setText(5, overrun.plugin
+			? m_names.value(overrun.plugin, sUnknown) : sUnknown);
+		pItem->setText(6, overrun.xrun ? tr("Yes") : QString());
+	}
+
+	// Keep the log within reasonable bounds...
+	while (m_ui.OverrunListView->topLevelItemCount() > DSP_LOAD_OVERRUNS_MAX) {
+		QTreeWidgetItem *pItem = m_ui.OverrunListView->topLevelItem(
+			m_ui.OverrunListView->topLevelItemCount() - 1);
+		delete pItem;
+	}
+}
+
+
+// Dump current statistics and overrun log as plain text.
+void qtractorDspLoadForm::dump ( QTextStream& ts ) const
+{
+	int i, j;
+
+	QTreeWidget *ppTreeWidgets[2]
+		= { m_ui.DspLoadListView, m_ui.OverrunListView };
+
+	for (int k = 0; k < 2; ++k) {
+		QTreeWidget *pTreeWidget = ppTreeWidgets[k];
+		QTreeWidgetItem *pHeaderItem = pTreeWidget->headerItem();
+		const int iColumns = pTreeWidget->columnCount();
+		for (j = 0; j < iColumns; ++j) {
+			if (j > 0) ts << '\t';
+			ts << pHeaderItem->text(j);
+		}
+		ts << '\n';
+		const int iItems = pTreeWidget->topLevelItemCount();
+		for (i = 0; i < iItems; ++i) {
+			QTreeWidgetItem *pItem = pTreeWidget->topLevelItem(i);
+			for (j = 0; j < iColumns; ++j) {
+				if (j > 0) ts << '\t';
+				ts << pItem->text(j);
+			}
+			ts << '\n';
+		}
+		ts << '\n';
+	}
+}
+
+
+// Save statistics and overrun log to file.
+void qtractorDspLoadForm::save (void)
+{
+	qtractorOptions *pOptions = qtractorOptions::getInstance();
+	if (pOptions == nullptr)
+		return;
+
+	// Make it fresh...
+	refresh();
+
+	const QString  sExt("log");
+	const QString& sTitle
+		= tr("Save DSP Load Log");
+
+	QStringList filters;
+	filters.append(tr("Log files (*.%1)").arg(sExt));
+	filters.append(tr("All files (*.*)"));
+	const QString& sFilter = filters.join(";;");
+
+	QString sPath = QFileInfo(pOptions->sSessionDir,
+		tr("dspload") + '.' + sExt).absoluteFilePath();
+
+	QWidget *pParentWidget = nullptr;
+	QFileDialog::Options options;
+	if (pOptions->bDontUseNativeDialogs) {
+		options |= QFileDialog::DontUseNativeDialog;
+		pParentWidget = QWidget::window();
+	}
+
+	// Ask for the filename to save...
+	sPath = QFileDialog::getSaveFileName(pParentWidget,
+		sTitle, sPath, sFilter, nullptr, options);
+
+	if (sPath.isEmpty() || sPath.at(0) == '.')
+		return;
+
+	// Enforce .log extension...
+	if (QFileInfo(sPath).suffix().isEmpty())
+		sPath += '.' + sExt;
+
+	QFile file(sPath);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+		QMessageBox::critical(this,
+			tr("Error"),
+			tr("Could not open file for writing:\n\n"
+			"\"%1\"").arg(sPath),
+			QMessageBox::Cancel);
+		return;
+	}
+
+	QTextStream ts(&file);
+	dump(ts);
+	file.close();
+}
+
+
+// end of qtractorDspLoadForm.cpp
@@ -0,0 +1,94 @@
+// qtractorDspLoadForm.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorDspLoadForm_h
+#define __qtractorDspLoadForm_h
+
+#include "ui_qtractorDspLoadForm.h"
+
+#include <QHash>
+
+
+// Forward declarations.
+class qtractorDspProbe;
+class qtractorPluginList;
+
+class QTextStream;
+class QTimer;
+
+
+//----------------------------------------------------------------------------
+// qtractorDspLoadForm -- UI wrapper form.
+
+class qtractorDspLoadForm : public QDialog
+{
+	Q_OBJECT
+
+public:
+
+	// Constructor.
+	qtractorDspLoadForm(QWidget *pParent = nullptr);
+	// Destructor.
+	~qtractorDspLoadForm();
+
+	// Dump current statistics and overrun log as plain text.
+	void dump(QTextStream& ts) const;
+
+protected slots:
+
+	void refresh();
+	void enabled(bool bOn);
+	void reset();
+	void save();
+
+protected:
+
+	// Add a probe statistics item.
+	void addProbeItem(const QString& sType, const QString& sName,
+		const qtractorDspProbe& probe);
+
+	// Add a plugin chain probes.
+	void addPluginItems(qtractorPluginList *pPluginList);
+
+	// Drain pending overruns into the log.
+	void updateOverruns();
+
+	// Window show/hide events.
+	void showEvent(QShowEvent *pShowEvent);
+	void hideEvent(QHideEvent *pHideEvent);
+
+private:
+
+	// The Qt-designer UI struct...
+	Ui::qtractorDspLoadForm m_ui;
+
+	// Probe names, as last refreshed.
+	QHash<const qtractorDspProbe *, QString> m_names;
+
+	// Refresh timer.
+	QTimer *m_pRefreshTimer;
+};
+
+
+#endif	// __qtractorDspLoadForm_h
+
+
+// end of qtractorDspLoadForm.h
@@ -46,7 +46,7 @@ qtractorBusCommand::qtractorBusCommand ( const QString& sName,
 	qtractorBus *pBus, qtractorBus::BusMode busMode )
 	: qtractorCommand(sName), m_pBus(pBus), m_busMode(busMode),
 		m_busType(qtractorTrack::None), m_bMonitor(false),
-		m_iChannels(0), m_bAutoConnect(false)
+		m_iChannels(0), m_bAutoConnect(false), m_bJackMidi(false)
 {
 	setRefresh(false);
 
@@ -72,6 +72,7 @@ qtractorBusCommand::qtractorBusCommand ( const QString& sName,
 				= static_cast<qtractorMidiBus *> (m_pBus);
 			if (pMidiBus) {
 				m_sInstrumentName = pMidiBus->instrumentName();
+				m_bJackMidi = pMidiBus->isJackMidi();
 			}
 			break;
 		}
@@ -117,6 +118,7 @@ bool qtractorBusCommand::createBus (void)
 			pMidiBus = new qtractorMidiBus(pMidiEngine,
 				m_sBusName, m_busMode, m_bMonitor);
 			pMidiBus->setInstrumentName(m_sInstrumentName);
+			pMidiBus->setJackMidi(m_bJackMidi);
 			pMidiEngine->addBus(pMidiBus);
 			pMidiEngine->resetControlBus();
 			pMidiEngine->resetMetroBus();
@@ -192,6 +194,7 @@ bool qtractorBusCommand::updateBus (void)
 	unsigned short iChannels = 0;
 	bool bAutoConnect = false;
 	QString sInstrumentName;
+	bool bJackMidi = false;
 	switch (m_pBus->busType()) {
 	case qtractorTrack::Audio:
 		pAudioBus = static_cast<qtractorAudioBus *> (m_pBus);
@@ -204,6 +207,7 @@ bool qtractorBusCommand::updateBus (void)
 		pMidiBus = static_cast<qtractorMidiBus *> (m_pBus);
 		if (pMidiBus) {
 			sInstrumentName = pMidiBus->instrumentName();
+			bJackMidi = pMidiBus->isJackMidi();
 		}
 		break;
 	case qtractorTrack::None:
@@ -301,6 +305,7 @@ bool qtractorBusCommand::updateBus (void)
 	}
 	if (pMidiBus) {
 		pMidiBus->setInstrumentName(m_sInstrumentName);
+		pMidiBus->setJackMidi(m_bJackMidi);
 	}
 
 	// May reopen up the bus...
@@ -368,6 +373,7 @@ bool qtractorBusCommand::updateBus (void)
 	m_iChannels = iChannels;
 	m_bAutoConnect = bAutoConnect;
 	m_sInstrumentName = sInstrumentName;
+	m_bJackMidi = bJackMidi;
 
 	// Carry on...
 	pSession->setPlaying(bPlaying);
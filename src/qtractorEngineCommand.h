@@ -85,6 +85,11 @@ public:
 	const QString& instrumentName() const
 		{ return m_sInstrumentName; }
 
+	void setJackMidi(bool bJackMidi)
+		{ m_bJackMidi = bJackMidi; }
+	bool isJackMidi() const
+		{ return m_bJackMidi; }
+
 protected:
 
 	// Bus command methods.
@@ -106,6 +111,7 @@ private:
 	unsigned short           m_iChannels;
 	bool                     m_bAutoConnect;
 	QString                  m_sInstrumentName;
+	bool                     m_bJackMidi;
 };
 
 
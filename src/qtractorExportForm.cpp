@@ -37,6 +37,7 @@
 #include <QPushButton>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QDir>
 #include <QUrl>
 
 
@@ -99,6 +100,9 @@ qtractorExportForm::qtractorExportForm ( QWidget *pParent )
 	QObject::connect(m_ui.ExportBusNameListBox,
 		SIGNAL(currentRowChanged(int)),
 		SLOT(stabilizeForm()));
+	QObject::connect(m_ui.ExportModeComboBox,
+		SIGNAL(activated(int)),
+		SLOT(stabilizeForm()));
 	QObject::connect(m_ui.ExportStartSpinBox,
 		SIGNAL(valueChanged(unsigned long)),
 		SLOT(valueChanged()));
@@ -176,6 +180,7 @@ void qtractorExportForm::setExportType ( qtractorTrack::TrackType exportType )
 			m_sExportType = tr("MIDI");
 			m_sExportExt  = "mid";
 			m_ui.ExportTypeWidget->removeWidget(m_ui.AudioExportTypePage);
+			m_ui.ExportModeComboBox->hide();
 			break;
 		case qtractorTrack::None:
 		default:
@@ -211,6 +216,7 @@ void qtractorExportForm::setExportType ( qtractorTrack::TrackType exportType )
 				sAudioExportExt, iAudioExportType);
 			m_ui.AudioExportFormatComboBox->setCurrentIndex(iAudioExportFormat);
 			m_ui.AudioExportQualitySpinBox->setValue(iAudioExportQuality);
+			m_ui.ExportModeComboBox->setCurrentIndex(pOptions->iAudioExportMode);
 			m_sExportExt = m_ui.AudioExportTypeComboBox->currentExt();
 			break;
 		}
@@ -625,6 +631,7 @@ void qtractorExportForm::saveExportOptions (void)
 		pOptions->iAudioExportType = m_ui.AudioExportTypeComboBox->currentType(handle);
 		pOptions->iAudioExportFormat = m_ui.AudioExportFormatComboBox->currentIndex();
 		pOptions->iAudioExportQuality = m_ui.AudioExportQualitySpinBox->value();
+		pOptions->iAudioExportMode = m_ui.ExportModeComboBox->currentIndex();
 		break;
 	}
 	case qtractorTrack::Midi:
@@ -725,14 +732,40 @@ void qtractorExportTrackForm::accept (void)
 	if (QFileInfo(sExportPath).suffix().isEmpty())
 		sExportPath += '.' + m_sExportExt;
 
-	// Check (again) wether the file already exists...
-	if (QFileInfo(sExportPath).exists()) {
+	// Audio stems make up one file for each bus or track...
+	QList<qtractorAudioEngine::ExportSet> exportSets;
+	QStringList exportPaths;
+	if (m_exportType == qtractorTrack::Audio) {
+		exportSets = audioExportSets(sExportPath,
+			ExportMode(m_ui.ExportModeComboBox->currentIndex()),
+			exportBusNameItems);
+		QListIterator<qtractorAudioEngine::ExportSet> set_iter(exportSets);
+		while (set_iter.hasNext())
+			exportPaths.append(set_iter.next().sExportPath);
+		if (exportPaths.isEmpty())
+			return;
+	}
+	else exportPaths.append(sExportPath);
+
+	// Check (again) wether any of the files already exist...
+	QStringList existingPaths;
+	QStringListIterator path_iter(exportPaths);
+	while (path_iter.hasNext()) {
+		const QString& sPath = path_iter.next();
+		if (QFileInfo(sPath).exists())
+			existingPaths.append('"' + sPath + '"');
+	}
+
+	if (!existingPaths.isEmpty()) {
+		const QString& sText = (existingPaths.count() > 1
+			? tr("The following files already exist:\n\n"
+				"%1\n\n"
+				"Do you want to replace them?")
+			: tr("The file already exists:\n\n"
+				"%1\n\n"
+				"Do you want to replace it?"));
 		if (QMessageBox::warning(this,
-			tr("Warning"),
-			tr("The file already exists:\n\n"
-			"\"%1\"\n\n"
-			"Do you want to replace it?")
-			.arg(sExportPath),
+			tr("Warning"), sText.arg(existingPaths.join('\n')),
 			QMessageBox::Ok | QMessageBox::Cancel) == QMessageBox::Cancel) {
 			m_ui.ExportPathComboBox->setFocus();
 			return;
@@ -763,28 +796,19 @@ void qtractorExportTrackForm::accept (void)
 		// Audio file export...
 		qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
 		if (pAudioEngine) {
-			// Get the export buses by name...
-			QList<qtractorAudioBus *> exportBuses;
-			QListIterator<QListWidgetItem *> iter(exportBusNameItems);
-			while (iter.hasNext()) {
-				qtractorAudioBus *pExportBus
-					= static_cast<qtractorAudioBus *> (
-						pAudioEngine->findOutputBus(iter.next()->text()));
-				if (pExportBus)
-					exportBuses.append(pExportBus);
-			}
 			// Log this event...
-			pMainForm->appendMessages(
-				tr("Audio file export: \"%1\" started...")
-				.arg(sExportPath));
+			path_iter.toFront();
+			while (path_iter.hasNext()) {
+				pMainForm->appendMessages(
+					tr("Audio file export: \"%1\" started...")
+					.arg(path_iter.next()));
+			}
 			// Do the export as commanded...
 			QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-			// Go...
-			const bool bResult = pAudioEngine->fileExport(
-				sExportPath, exportBuses,
+			// Go (all files in one single pass)...
+			const bool bResult = pAudioEngine->fileExport(exportSets,
 				m_ui.ExportStartSpinBox->value(),
-				m_ui.ExportEndSpinBox->value(),
-				audioExportFormat());
+				m_ui.ExportEndSpinBox->value());
 			// Done.
 			QApplication::restoreOverrideCursor();
 			if (bResult) {
@@ -792,22 +816,28 @@ void qtractorExportTrackForm::accept (void)
 				qtractorTracks *pTracks = pMainForm->tracks();
 				if (pTracks && m_ui.AddTrackCheckBox->isChecked()) {
 					pTracks->addAudioTracks(
-						QStringList(sExportPath),
+						exportPaths,
 						pAudioEngine->exportStart(),
 						pAudioEngine->exportOffset(),
 						pAudioEngine->exportLength(),
 						pTracks->currentTrack());
+				} else {
+					path_iter.toFront();
+					while (path_iter.hasNext())
+						pMainForm->addAudioFile(path_iter.next());
 				}
-				else pMainForm->addAudioFile(sExportPath);
 				// Log the success...
-				pMainForm->appendMessages(
-					tr("Audio file export: \"%1\" complete.")
-					.arg(sExportPath));
+				path_iter.toFront();
+				while (path_iter.hasNext()) {
+					pMainForm->appendMessages(
+						tr("Audio file export: \"%1\" complete.")
+						.arg(path_iter.next()));
+				}
 			} else {
 				// Log the failure...
 				pMainForm->appendMessagesError(
 					tr("Audio file export:\n\n\"%1\"\n\nfailed.")
-					.arg(sExportPath));
+					.arg(exportPaths.join('\n')));
 			}
 			// HACK: Reset all (internal) MIDI controllers...
 			qtractorMidiEngine *pMidiEngine = pSession->midiEngine();
@@ -880,6 +910,93 @@ void qtractorExportTrackForm::accept (void)
 }
 
 
+// Make up audio export sets, one for each file.
+QList<qtractorAudioEngine::ExportSet> qtractorExportTrackForm::audioExportSets (
+	const QString& sExportPath, ExportMode exportMode,
+	const QList<QListWidgetItem *>& exportBusNameItems ) const
+{
+	QList<qtractorAudioEngine::ExportSet> exportSets;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return exportSets;
+
+	qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+	if (pAudioEngine == nullptr)
+		return exportSets;
+
+	// Get the export buses by name...
+	QList<qtractorAudioBus *> exportBuses;
+	QListIterator<QListWidgetItem *> iter(exportBusNameItems);
+	while (iter.hasNext()) {
+		qtractorAudioBus *pExportBus
+			= static_cast<qtractorAudioBus *> (
+				pAudioEngine->findOutputBus(iter.next()->text()));
+		if (pExportBus)
+			exportBuses.append(pExportBus);
+	}
+
+	qtractorAudioEngine::ExportSet exportSet;
+	exportSet.iExportFormat = audioExportFormat();
+
+	switch (exportMode) {
+	case TrackStems: {
+		// One file per audio track, as routed to export buses...
+		for (qtractorTrack *pTrack = pSession->tracks().first();
+				pTrack; pTrack = pTrack->next()) {
+			if (pTrack->trackType() != qtractorTrack::Audio)
+				continue;
+			qtractorAudioBus *pAudioBus
+				= static_cast<qtractorAudioBus *> (pTrack->outputBus());
+			if (pAudioBus == nullptr || !exportBuses.contains(pAudioBus))
+				continue;
+			exportSet.sExportPath
+				= stemExportPath(sExportPath, pTrack->trackName());
+			exportSet.exportTracks.clear();
+			exportSet.exportTracks.append(pTrack);
+			exportSets.append(exportSet);
+		}
+		break;
+	}
+	case BusStems: {
+		// One file per export bus...
+		QListIterator<qtractorAudioBus *> bus_iter(exportBuses);
+		while (bus_iter.hasNext()) {
+			qtractorAudioBus *pAudioBus = bus_iter.next();
+			exportSet.sExportPath
+				= stemExportPath(sExportPath, pAudioBus->busName());
+			exportSet.exportBuses.clear();
+			exportSet.exportBuses.append(pAudioBus);
+			exportSets.append(exportSet);
+		}
+		break;
+	}
+	case MixDown:
+	default:
+		// One single mix-down file...
+		if (!exportBuses.isEmpty()) {
+			exportSet.sExportPath = sExportPath;
+			exportSet.exportBuses = exportBuses;
+			exportSets.append(exportSet);
+		}
+		break;
+	}
+
+	return exportSets;
+}
+
+
+// Make up a stem export file path.
+QString qtractorExportTrackForm::stemExportPath (
+	const QString& sExportPath, const QString& sStemName )
+{
+	const QFileInfo info(sExportPath);
+	return info.dir().filePath(info.completeBaseName()
+		+ '-' + qtractorSession::sanitize(sStemName)
+		+ '.' + info.suffix());
+}
+
+
 // Executive slots -- reject settings (Cancel button slot).
 void qtractorExportTrackForm::reject (void)
 {
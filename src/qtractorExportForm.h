@@ -25,6 +25,7 @@
 #include "ui_qtractorExportForm.h"
 
 #include "qtractorTrack.h"
+#include "qtractorAudioEngine.h"
 
 
 //----------------------------------------------------------------------------
@@ -85,6 +86,9 @@ protected:
 	// Range types.
 	enum RangeType { Session = 0, Loop, Punch, Edit, Custom };
 
+	// (Audio) export modes.
+	enum ExportMode { MixDown = 0, BusStems, TrackStems };
+
 	// The Qt-designer UI struct...
 	Ui::qtractorExportForm m_ui;
 
@@ -127,6 +131,15 @@ protected:
 	QString windowTitleEx(
 		const QString& sExportTitle,
 		const QString& sExportType) const;
+
+	// Make up audio export sets, one for each file.
+	QList<qtractorAudioEngine::ExportSet> audioExportSets(
+		const QString& sExportPath, ExportMode exportMode,
+		const QList<QListWidgetItem *>& exportBusNameItems) const;
+
+	// Make up a stem export file path.
+	static QString stemExportPath(
+		const QString& sExportPath, const QString& sStemName);
 };
 
 
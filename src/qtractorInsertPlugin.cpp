@@ -27,261 +27,36 @@
 #include "qtractorSession.h"
 #include "qtractorSessionCursor.h"
 #include "qtractorAudioEngine.h"
+#include "qtractorAudioKernel.h"
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiManager.h"
 
 #include "qtractorPluginListView.h"
 
 
-#if defined(__SSE__)
-
-#include <xmmintrin.h>
-
-// SSE detection.
-static inline bool sse_enabled (void)
-{
-#if defined(__GNUC__)
-	unsigned int eax, ebx, ecx, edx;
-#if defined(__x86_64__) || (!defined(PIC) && !defined(__PIC__))
-	__asm__ __volatile__ (
-		"cpuid\n\t" \
-		: "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#else
-	__asm__ __volatile__ (
-		"push %%ebx\n\t" \
-		"cpuid\n\t" \
-		"movl %%ebx,%1\n\t" \
-		"pop %%ebx\n\t" \
-		: "=a" (eax), "=r" (ebx), "=c" (ecx), "=d" (edx) \
-		: "a" (1) : "cc");
-#endif
-	return (edx & (1 << 25));
-#else
-	return false;
-#endif
-}
-
-// SSE enabled processor versions.
-static inline void sse_process_gain (
+// Multi-channel processors.
+static inline void insert_process_gain (
 	float **ppFrames, unsigned int iFrames,
 	unsigned short iChannels, float fGain )
 {
-	__m128 v0 = _mm_load_ps1(&fGain);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pFrames) & 15) && (nframes > 0); --nframes)
-			*pFrames++ *= fGain;	
-		for (; nframes >= 4; nframes -= 4) {
-			_mm_store_ps(pFrames,
-				_mm_mul_ps(
-					_mm_loadu_ps(pFrames), v0
-				)
-			);
-			pFrames += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pFrames++ *= fGain;
-	}
-}
-
-static inline void sse_process_dry_wet (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fDry, float fWet )
-{
-	__m128 v0 = _mm_load_ps1(&fDry);
-	__m128 v1 = _mm_load_ps1(&fWet);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes) {
-			*pBuffer   *= fWet;
-			*pBuffer++ += fDry * *pFrames++;
-		}
-		for (; nframes >= 4; nframes -= 4) {
-			_mm_store_ps(pBuffer,
-				_mm_mul_ps(
-					_mm_loadu_ps(pBuffer), v1
-				)
-			);
-			_mm_store_ps(pBuffer,
-				_mm_add_ps(
-					_mm_loadu_ps(pBuffer),
-					_mm_mul_ps(
-						_mm_loadu_ps(pFrames), v0)
-					)
-			);
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes) {
-			*pBuffer   *= fWet;
-			*pBuffer++ += fDry * *pFrames++;
-		}
-	}
-}
-
-static inline void sse_process_add (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fGain )
-{
-	__m128 v0 = _mm_load_ps1(&fGain);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes)
-			*pBuffer++ += fGain * *pFrames++;
-		for (; nframes >= 4; nframes -= 4) {
-			_mm_store_ps(pBuffer,
-				_mm_add_ps(
-					_mm_loadu_ps(pBuffer),
-					_mm_mul_ps(
-						_mm_loadu_ps(pFrames), v0)
-					)
-			);
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pBuffer++ += fGain * *pFrames++;
-	}
-}
-
-#endif // __SSE__
-
-
-#if defined(__ARM_NEON__)
-
-#include "arm_neon.h"
-
-// NEON enabled processor versions.
-static inline void neon_process_gain (
-	float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fGain )
-{
-	float32x4_t vGain = vdupq_n_f32(fGain);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pFrames) & 15) && (nframes > 0); --nframes)
-			*pFrames++ *= fGain;
-		for (; nframes >= 4; nframes -= 4) {
-			vst1q_f32(pFrames,
-				vmulq_f32(
-					vld1q_f32(pFrames), vGain
-				)
-			);
-			pFrames += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pFrames++ *= fGain;
-	}
-}
-
-static inline void neon_process_dry_wet (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fDry, float fWet )
-{
-	float32x4_t vDry = vdupq_n_f32(fDry);
-	float32x4_t vWet = vdupq_n_f32(fWet);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes) {
-			*pBuffer   *= fWet;
-			*pBuffer++ += fDry * *pFrames++;
-		}
-		for (; nframes >= 4; nframes -= 4) {
-			float32x4_t vBuffer = vld1q_f32(pBuffer);
-			vBuffer = vmulq_f32(vBuffer, vWet);
-			float32x4_t vFrames = vld1q_f32(pFrames);
-			// Vr[i] := Va[i] + Vb[i] * Vc[i]
-			vBuffer = vmlaq_f32(vBuffer, vDry, vFrames);
-			vst1q_f32(pBuffer, vBuffer);
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes) {
-			*pBuffer   *= fWet;
-			*pBuffer++ += fDry * *pFrames++;
-		}
-	}
-}
-
-static inline void neon_process_add (
-	float **ppBuffer, float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fGain )
-{
-	float32x4_t vGain = vdupq_n_f32(fGain);
-
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		unsigned int nframes = iFrames;
-		for (; (long(pBuffer) & 15) && (nframes > 0); --nframes)
-			*pBuffer++ += fGain * *pFrames++;
-		for (; nframes >= 4; nframes -= 4) {
-			float32x4_t vBuffer = vld1q_f32(pBuffer);
-			float32x4_t vFrames = vld1q_f32(pFrames);
-			//Vr[i] := Va[i] + Vb[i] * Vc[i]
-			vBuffer = vmlaq_f32(vBuffer, vGain, vFrames);
-			vst1q_f32(pBuffer, vBuffer);
-			pFrames += 4;
-			pBuffer += 4;
-		}
-		for (; nframes > 0; --nframes)
-			*pBuffer++ += fGain * *pFrames++;
-	}
-}
-
-#endif // __ARM_NEON__
-
-
-// Standard processor versions.
-static inline void std_process_gain (
-	float **ppFrames, unsigned int iFrames,
-	unsigned short iChannels, float fGain )
-{
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pFrames = ppFrames[i];
-		for (unsigned int n = 0; n < iFrames; ++n)
-			*pFrames++ *= fGain;
-	}
+	for (unsigned short i = 0; i < iChannels; ++i)
+		qtractorAudioKernel::gain(ppFrames[i], iFrames, fGain);
 }
 
-static inline void std_process_dry_wet (
+static inline void insert_process_dry_wet (
 	float **ppBuffer, float **ppFrames, unsigned int iFrames,
 	unsigned short iChannels, float fDry, float fWet )
 {
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		for (unsigned int n = 0; n < iFrames; ++n) {
-			*pBuffer   *= fWet;
-			*pBuffer++ += fDry * *pFrames++;
-		}
-	}
+	for (unsigned short i = 0; i < iChannels; ++i)
+		qtractorAudioKernel::dry_wet(ppBuffer[i], ppFrames[i], iFrames, fDry, fWet);
 }
 
-static inline void std_process_add (
+static inline void insert_process_add (
 	float **ppBuffer, float **ppFrames, unsigned int iFrames,
 	unsigned short iChannels, float fGain )
 {
-	for (unsigned short i = 0; i < iChannels; ++i) {
-		float *pBuffer = ppBuffer[i];
-		float *pFrames = ppFrames[i];
-		for (unsigned int n = 0; n < iFrames; ++n)
-			*pBuffer++ += fGain * *pFrames++;
-	}
+	for (unsigned short i = 0; i < iChannels; ++i)
+		qtractorAudioKernel::gain_add(ppBuffer[i], ppFrames[i], iFrames, fGain);
 }
 
 
@@ -452,23 +227,6 @@ qtractorAudioInsertPlugin::qtractorAudioInsertPlugin (
 		this, pInsertType->channels());
 #endif
 
-	// Custom optimized processors.
-#if defined(__SSE__)
-	if (sse_enabled()) {
-		m_pfnProcessGain = sse_process_gain;
-		m_pfnProcessDryWet = sse_process_dry_wet;
-	} else
-#endif
-#if defined(__ARM_NEON__)
-	m_pfnProcessGain = neon_process_gain;
-	m_pfnProcessDryWet = neon_process_dry_wet;
-	if (false)
-#endif
-	{
-		m_pfnProcessGain = std_process_gain;
-		m_pfnProcessDryWet = std_process_dry_wet;
-	}
-
 	// Create and attach the custom parameters...
 	m_pSendGainParam = new Param(this, 0);
 	m_pSendGainParam->setName(QObject::tr("Send Gain"));
@@ -625,16 +383,26 @@ void qtractorAudioInsertPlugin::process (
 	}
 
 	const float fGain = m_pSendGainParam->value();
-	(*m_pfnProcessGain)(ppOut, nframes, iChannels, fGain);
+	insert_process_gain(ppOut, nframes, iChannels, fGain);
 
 	const float fDry = m_pDryGainParam->value();
 	const float fWet = m_pWetGainParam->value();
-	(*m_pfnProcessDryWet)(ppOBuffer, ppIBuffer, nframes, iChannels, fDry, fWet);
+	insert_process_dry_wet(ppOBuffer, ppIBuffer, nframes, iChannels, fDry, fWet);
 
 //	m_pAudioBus->process_commit(nframes);
 }
 
 
+// Send/return round-trip latency (in frames).
+unsigned long qtractorAudioInsertPlugin::latency (void) const
+{
+	if (m_pAudioBus == nullptr || !m_pAudioBus->isEnabled())
+		return 0;
+
+	return m_pAudioBus->latency_out() + m_pAudioBus->latency_in();
+}
+
+
 // Pseudo-plugin configuration handlers.
 void qtractorAudioInsertPlugin::configure (
 	const QString& sKey, const QString& sValue )
@@ -1210,20 +978,6 @@ qtractorAudioAuxSendPlugin::qtractorAudioAuxSendPlugin (
 		this, pAuxSendType->channels());
 #endif
 
-	// Custom optimized processors.
-#if defined(__SSE__)
-	if (sse_enabled()) {
-		m_pfnProcessAdd = sse_process_add;
-	} else
-#endif
-#if defined(__ARM_NEON__)
-	m_pfnProcessAdd = neon_process_add;
-	if (false)
-#endif
-	{
-		m_pfnProcessAdd = std_process_add;
-	}
-
 	// Create and attach the custom parameters...
 	m_pSendGainParam = new Param(this, 0);
 	m_pSendGainParam->setName(QObject::tr("Send Gain"));
@@ -1352,6 +1106,12 @@ const QString& qtractorAudioAuxSendPlugin::audioBusName (void) const
 }
 
 
+qtractorAudioBus *qtractorAudioAuxSendPlugin::audioBus (void) const
+{
+	return m_pAudioBus;
+}
+
+
 // Audio bus to appear on plugin lists.
 void qtractorAudioAuxSendPlugin::updateAudioBusName (void) const
 {
@@ -1383,12 +1143,30 @@ void qtractorAudioAuxSendPlugin::process (
 		::memcpy(ppOBuffer[i], ppIBuffer[i], nframes * sizeof(float));
 
 	const float fGain = m_pSendGainParam->value();
-	(*m_pfnProcessAdd)(ppOut, ppOBuffer, nframes, iChannels, fGain);
+	if (m_latencyDelay.delay() > 0) {
+		// Delay compensation (send path)...
+		m_latencyDelay.process_add(ppOut, ppIBuffer,
+			nframes, iChannels, fGain);
+	} else {
+		insert_process_add(ppOut, ppOBuffer, nframes, iChannels, fGain);
+	}
 
 //	m_pAudioBus->process_commit(nframes);
 }
 
 
+// Delay compensation (send path) accessors (non RT-safe).
+bool qtractorAudioAuxSendPlugin::setLatencyDelay ( unsigned long iDelay )
+{
+	return m_latencyDelay.setDelay(channels(), iDelay);
+}
+
+void qtractorAudioAuxSendPlugin::resetLatencyDelay (void)
+{
+	m_latencyDelay.reset();
+}
+
+
 // Do the actual activation.
 void qtractorAudioAuxSendPlugin::activate (void)
 {
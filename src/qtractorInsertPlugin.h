@@ -24,6 +24,7 @@
 #define __qtractorInsertPlugin_h
 
 #include "qtractorPlugin.h"
+#include "qtractorAudioDelay.h"
 
 
 // Forward declarations.
@@ -159,6 +160,9 @@ public:
 	// Audio specific accessor.
 	qtractorAudioBus *audioBus() const;
 
+	// Send/return round-trip latency (in frames).
+	unsigned long latency() const;
+
 protected:
 
 	// Plugin configuration (connections).
@@ -172,12 +176,6 @@ private:
 	Param *m_pSendGainParam;
 	Param *m_pDryGainParam;
 	Param *m_pWetGainParam;
-
-	// Custom optimized processors.
-	void (*m_pfnProcessGain)(float **, unsigned int,
-		unsigned short, float);
-	void (*m_pfnProcessDryWet)(float **, float **, unsigned int,
-		unsigned short, float, float);
 };
 
 
@@ -359,9 +357,17 @@ public:
 	void setAudioBusName(const QString& sAudioBusName);
 	const QString& audioBusName() const;
 
+	qtractorAudioBus *audioBus() const;
+
 	// Audio bus to appear on plugin lists.
 	void updateAudioBusName() const;
 
+	// Delay compensation (send path) accessors (non RT-safe).
+	bool setLatencyDelay(unsigned long iDelay);
+	unsigned long latencyDelay() const
+		{ return m_latencyDelay.delay(); }
+	void resetLatencyDelay();
+
 protected:
 
 	// Do the actual (de)activation.
@@ -376,9 +382,7 @@ private:
 
 	Param *m_pSendGainParam;
 
-	// Custom optimized processors.
-	void (*m_pfnProcessAdd)(float **, float **, unsigned int,
-		unsigned short, float);
+	qtractorAudioDelay m_latencyDelay;
 };
 
 
@@ -458,12 +458,24 @@ void qtractorLadspaPlugin::process (
 			(*pLadspaDescriptor->connect_port)(handle,
 				m_piAudioOuts[j], ppOBuffer[iOChannel++]);
 		}
-		// Make it run...
-		(*pLadspaDescriptor->run)(handle, nframes);
-		// Wrap dangling output channels?...
-		for (j = iOChannel; j < iChannels; ++j)
-			::memset(ppOBuffer[j], 0, nframes * sizeof(float));
 	}
+
+	// Make them all run (in parallel, if more than one)...
+	process_instances(nframes);
+
+	// Wrap dangling output channels?...
+	for (j = iOChannel; j < iChannels; ++j)
+		::memset(ppOBuffer[j], 0, nframes * sizeof(float));
+}
+
+
+// Single instance processing procedure.
+void qtractorLadspaPlugin::process_instance (
+	unsigned short iInstance, unsigned int nframes )
+{
+	const LADSPA_Descriptor *pLadspaDescriptor = ladspa_descriptor();
+	if (pLadspaDescriptor && m_phInstances)
+		(*pLadspaDescriptor->run)(m_phInstances[iInstance], nframes);
 }
 
 
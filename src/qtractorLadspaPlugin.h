@@ -100,6 +100,9 @@ public:
 	// The main plugin processing procedure.
 	void process(float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
 
+	// Single instance processing procedure.
+	void process_instance(unsigned short iInstance, unsigned int nframes);
+
 	// Specific accessors.
 	const LADSPA_Descriptor *ladspa_descriptor() const;
 	LADSPA_Handle ladspa_handle(unsigned short iInstance) const;
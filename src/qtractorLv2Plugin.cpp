@@ -3041,6 +3041,22 @@ void qtractorLv2Plugin::process (
 	unsigned short iOChannel = 0;
 	unsigned short i, j;
 
+	// Instances may only run in parallel when
+	// they share no event/atom buffers nor worker...
+	bool bParallel = (iInstances > 1);
+#ifdef CONFIG_LV2_EVENT
+	if (iEventIns + iEventOuts > 0)
+		bParallel = false;
+#endif
+#ifdef CONFIG_LV2_ATOM
+	if (iAtomIns + iAtomOuts > 0)
+		bParallel = false;
+#endif
+#ifdef CONFIG_LV2_WORKER
+	if (m_lv2_worker)
+		bParallel = false;
+#endif
+
 	// For each plugin instance...
 	for (i = 0; i < iInstances; ++i) {
 		LilvInstance *instance = m_ppInstances[i];
@@ -3148,7 +3164,9 @@ void qtractorLv2Plugin::process (
 			}
 		#endif	// CONFIG_LV2_UI
 		#endif	// CONFIG_LV2_ATOM
-			// Make it run...
+			// Make it run, unless deferred to parallel...
+			if (bParallel)
+				continue;
 			lilv_instance_run(instance, nframes);
 			// Wrap dangling output channels?...
 			for (j = iOChannel; j < iChannels; ++j)
@@ -3156,6 +3174,14 @@ void qtractorLv2Plugin::process (
 		}
 	}
 
+	// Make them all run in parallel, now...
+	if (bParallel) {
+		process_instances(nframes);
+		// Wrap dangling output channels?...
+		for (j = iOChannel; j < iChannels; ++j)
+			::memset(ppOBuffer[j], 0, nframes * sizeof(float));
+	}
+
 #ifdef CONFIG_LV2_WORKER
 	if (m_lv2_worker)
 		m_lv2_worker->commit();
@@ -3221,6 +3247,17 @@ void qtractorLv2Plugin::process (
 }
 
 
+// Single instance processing procedure.
+void qtractorLv2Plugin::process_instance (
+	unsigned short iInstance, unsigned int nframes )
+{
+	LilvInstance *instance
+		= (m_ppInstances ? m_ppInstances[iInstance] : nullptr);
+	if (instance)
+		lilv_instance_run(instance, nframes);
+}
+
+
 #ifdef CONFIG_LV2_UI
 
 // Open editor.
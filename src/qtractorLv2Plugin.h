@@ -244,6 +244,9 @@ public:
 	// The main plugin processing procedure.
 	void process(float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
 
+	// Single instance processing procedure.
+	void process_instance(unsigned short iInstance, unsigned int nframes);
+
 	// Specific accessors.
 	LilvPlugin *lv2_plugin() const;
 	LilvInstance *lv2_instance(unsigned short iInstance) const;
@@ -41,6 +41,7 @@
 #include "qtractorAudioPeak.h"
 #include "qtractorAudioBuffer.h"
 #include "qtractorAudioEngine.h"
+#include "qtractorAudioGraph.h"
 #include "qtractorMidiEngine.h"
 
 #include "qtractorSessionCursor.h"
@@ -69,6 +70,8 @@
 #include "qtractorMidiControlForm.h"
 #include "qtractorInstrumentForm.h"
 #include "qtractorTimeScaleForm.h"
+#include "qtractorDspLoadForm.h"
+#include "qtractorDspLoad.h"
 #include "qtractorBusForm.h"
 
 #include "qtractorTakeRangeForm.h"
@@ -245,6 +248,7 @@ qtractorMainForm::qtractorMainForm (
 	m_pFiles       = nullptr;
 	m_pMixer       = nullptr;
 	m_pConnections = nullptr;
+	m_pDspLoadForm = nullptr;
 	m_pTracks      = nullptr;
 
 	// To remember last time we've shown the playhead.
@@ -1092,6 +1096,9 @@ qtractorMainForm::qtractorMainForm (
 	QObject::connect(m_ui.viewTempoMapAction,
 		SIGNAL(triggered(bool)),
 		SLOT(viewTempoMap()));
+	QObject::connect(m_ui.viewDspLoadAction,
+		SIGNAL(triggered(bool)),
+		SLOT(viewDspLoad()));
 	QObject::connect(m_ui.viewOptionsAction,
 		SIGNAL(triggered(bool)),
 		SLOT(viewOptions()));
@@ -1231,6 +1238,8 @@ qtractorMainForm::~qtractorMainForm (void)
 		delete m_pMixer;
 	if (m_pConnections)
 		delete m_pConnections;
+	if (m_pDspLoadForm)
+		delete m_pDspLoadForm;
 	if (m_pFiles)
 		delete m_pFiles;
 	if (m_pFileSystem)
@@ -1505,6 +1514,11 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 		m_pOptions->bAudioOutputBus);
 	qtractorMidiManager::setDefaultAudioOutputAutoConnect(
 		m_pOptions->bAudioOutputAutoConnect);
+	// Set plugin chain silence auto-bypass mode.
+	qtractorPluginList::setSilenceBypass(
+		m_pOptions->bSilenceBypass);
+	qtractorPluginList::setSilenceHold(
+		m_pOptions->fSilenceHold);
 	// Set default audio-buffer quality...
 	qtractorAudioBuffer::setDefaultResampleType(
 		m_pOptions->iAudioResampleType);
@@ -1512,6 +1526,16 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 		m_pOptions->bAudioWsolaTimeStretch);
 	qtractorAudioBuffer::setDefaultWsolaQuickSeek(
 		m_pOptions->bAudioWsolaQuickSeek);
+	// Set default audio track parallel process workers...
+	qtractorAudioGraph::setDefaultWorkers(
+		m_pOptions->iAudioProcessWorkers);
+	// Set default audio whole-file preload cache...
+	qtractorAudioBufferCache *pAudioBufferCache
+		= qtractorAudioBufferCache::getInstance();
+	pAudioBufferCache->setBudget(
+		(unsigned long) m_pOptions->iAudioPreloadBudget << 20);
+	pAudioBufferCache->setEnabled(
+		m_pOptions->bAudioPreload);
 	qtractorTrack::setTrackColorSaturation(
 		m_pOptions->iTrackColorSaturation);
 
@@ -1527,8 +1551,10 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 
 	// Some special defaults...
 	qtractorAudioEngine *pAudioEngine = m_pSession->audioEngine();
-	if (pAudioEngine)
+	if (pAudioEngine) {
 		pAudioEngine->setMasterAutoConnect(m_pOptions->bAudioMasterAutoConnect);
+		pAudioEngine->setExportOffline(m_pOptions->bAudioExportOffline);
+	}
 	
 	// Final widget slot connections....
 	QObject::connect(m_pFileSystem->toggleViewAction(),
@@ -5112,6 +5138,21 @@ void qtractorMainForm::viewTempoMap (void)
 }
 
 
+// Show DSP load (instrumentation) dialog.
+void qtractorMainForm::viewDspLoad (void)
+{
+	// Instrumentation is mostly wanted while it's around...
+	if (m_pDspLoadForm == nullptr) {
+		qtractorDspLoad::setEnabled(true);
+		m_pDspLoadForm = new qtractorDspLoadForm(this);
+	}
+
+	m_pDspLoadForm->show();
+	m_pDspLoadForm->raise();
+	m_pDspLoadForm->activateWindow();
+}
+
+
 // Show options dialog.
 void qtractorMainForm::viewOptions (void)
 {
@@ -7978,6 +8019,12 @@ void qtractorMainForm::slowTimerSlot (void)
 		}
 	}
 
+	// Check whether plugin delay compensation is due...
+	pAudioEngine->checkLatency();
+
+	// Catch up on any stale MIDI clip playback forms...
+	pMidiEngine->updatePacked();
+
 	// Slower plugin UI idle cycle...
 #ifdef CONFIG_DSSI
 #ifdef CONFIG_LIBLO
@@ -8026,6 +8073,18 @@ void qtractorMainForm::audioPeakNotify (void)
 	// An audio peak file has just been (re)created;
 	// try to postpone the event effect a little more...
 	if (m_iAudioPeakTimer < 2) ++m_iAudioPeakTimer;
+
+	// Show some progress, if there's still more to come...
+	qtractorAudioPeakFactory *pAudioPeakFactory
+		= m_pSession->audioPeakFactory();
+	if (pAudioPeakFactory) {
+		const unsigned int iPending = pAudioPeakFactory->peakPending();
+		const unsigned int iTotal = pAudioPeakFactory->peakTotal();
+		if (iPending > 0 && iTotal > 1) {
+			statusBar()->showMessage(tr("Building peak files: %1 of %2...")
+				.arg(iTotal - iPending).arg(iTotal), 3000);
+		}
+	}
 }
 
 
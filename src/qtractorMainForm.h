@@ -37,6 +37,7 @@ class qtractorFileSystem;
 class qtractorFiles;
 class qtractorMessages;
 class qtractorConnections;
+class qtractorDspLoadForm;
 class qtractorMixer;
 class qtractorMmcEvent;
 class qtractorCtlEvent;
@@ -261,6 +262,7 @@ public slots:
 	void viewControllers();
 	void viewBuses();
 	void viewTempoMap();
+	void viewDspLoad();
 	void viewOptions();
 
 	void transportBackward();
@@ -468,6 +470,7 @@ private:
 	qtractorFiles *m_pFiles;
 	qtractorMessages *m_pMessages;
 	qtractorConnections *m_pConnections;
+	qtractorDspLoadForm *m_pDspLoadForm;
 	qtractorMixer *m_pMixer;
 	qtractorTracks *m_pTracks;
 	qtractorMessageList *m_pMessageList;
@@ -24,6 +24,7 @@
 #include "qtractorMidiEngine.h"
 
 #include "qtractorSession.h"
+#include "qtractorSessionSnapshot.h"
 #include "qtractorFileList.h"
 
 #include "qtractorDocument.h"
@@ -185,6 +186,12 @@ qtractorMidiClip::qtractorMidiClip ( qtractorTrack *pTrack )
 
 	m_iBeatsPerBar2 = 0;
 	m_iBeatDivisor2 = 0;
+
+	m_pThumbSeq    = nullptr;
+	m_iThumbSerial = 0;
+	m_thumbColor   = 0;
+
+	m_iPlayIndex = 0;
 }
 
 
@@ -215,6 +222,12 @@ qtractorMidiClip::qtractorMidiClip ( const qtractorMidiClip& clip )
 
 	m_iBeatsPerBar2 = clip.beatsPerBar2();
 	m_iBeatDivisor2 = clip.beatDivisor2();
+
+	m_pThumbSeq    = nullptr;
+	m_iThumbSerial = 0;
+	m_thumbColor   = 0;
+
+	m_iPlayIndex = 0;
 }
 
 
@@ -379,6 +392,7 @@ bool qtractorMidiClip::openMidiFile (
 			// Uh oh...
 			m_playCursor.reset(pSeq);
 			m_drawCursor.reset(pSeq);
+			updatePacked();
 			return true;
 		}
 	}
@@ -516,6 +530,10 @@ bool qtractorMidiClip::openMidiFile (
 	m_playCursor.reset(pSeq);
 	m_drawCursor.reset(pSeq);
 
+	// Compact playback form, if not on a pre-writing status...
+	if (!bWrite)
+		updatePacked();
+
 	// Something might have changed...
 	updateHashKey();
 	insertHashKey();
@@ -553,6 +571,10 @@ void qtractorMidiClip::closeMidiFile (void)
 		delete m_pFile;
 		m_pFile = nullptr;
 	}
+
+	// Drop note-density thumbnail...
+	m_pThumbSeq = nullptr;
+	m_thumb = QImage();
 }
 
 
@@ -826,6 +848,7 @@ void qtractorMidiClip::seek ( unsigned long iFrame )
 
 	// Seek for the nearest sequence event...
 	m_playCursor.seek(pSeq, (t1 > t0 ? t1 - t0 : 0));
+	m_iPlayIndex = 0;
 }
 
 
@@ -838,6 +861,7 @@ void qtractorMidiClip::reset ( bool /* bLooping */ )
 
 	// Reset to the first sequence event...
 	m_playCursor.reset(pSeq);
+	m_iPlayIndex = 0;
 }
 
 
@@ -946,23 +970,75 @@ void qtractorMidiClip::process (
 	const bool bMute = (pTrack->isMute()
 		|| (pSession->soloTracks() && !pTrack->isSolo()));
 
-	const unsigned long t0 = pSession->tickFromFrame(clipStart());
+	// Local tempo-map cursor (events are in ascending time)...
+	qtractorTimeScale::Cursor cursor(pSession->timeScale());
 
-	const unsigned long iTimeStart = pSession->tickFromFrame(iFrameStart);
-	const unsigned long iTimeEnd   = pSession->tickFromFrame(iFrameEnd);
+	const unsigned long iClipStart = clipStart();
+	qtractorTimeScale::Node *pNode = cursor.seekFrame(iClipStart);
+	const unsigned long t0 = pNode->tickFromFrame(iClipStart);
+
+	pNode = cursor.seekFrame(iFrameStart);
+	const unsigned long iTimeStart = pNode->tickFromFrame(iFrameStart);
+	pNode = cursor.seekFrame(iFrameEnd);
+	const unsigned long iTimeEnd   = pNode->tickFromFrame(iFrameEnd);
 
 	// Enqueue the requested events...
 	const float fGain = clipGain();
-	qtractorMidiEvent *pEvent
-		= m_playCursor.seek(pSeq, iTimeStart > t0 ? iTimeStart - t0 : 0);
+	const unsigned long iTime = (iTimeStart > t0 ? iTimeStart - t0 : 0);
+
+	// Compact playback form, if any; even if stale, it's still
+	// better than the event list, which might be under edit...
+	qtractorMidiPacked *pPacked = pSeq->packed();
+	if (pPacked) {
+		// Event times get converted in batches...
+		enum { BatchSize = 64 };
+		unsigned long ticks[BatchSize];
+		unsigned long frames[BatchSize];
+		const unsigned int iCount = pPacked->count();
+		unsigned int i = pPacked->seek(iTime, m_iPlayIndex);
+		for (;;) {
+			unsigned int n = 0;
+			while (n < BatchSize && i + n < iCount) {
+				const unsigned long t1 = t0 + pPacked->time(i + n);
+				if (t1 >= iTimeEnd)
+					break;
+				ticks[n++] = t1;
+			}
+			if (n < 1)
+				break;
+			cursor.framesFromTicks(ticks, frames, n);
+			for (unsigned int k = 0; k < n; ++k, ++i) {
+				const qtractorMidiEvent::EventType etype = pPacked->type(i);
+				if (bMute && etype == qtractorMidiEvent::NOTEON)
+					continue;
+				const unsigned long t1 = ticks[k];
+				const float fGainFade = fGain
+					* fadeInOutGain(frames[k] - iClipStart);
+				if (etype == qtractorMidiEvent::SYSEX) {
+					pMidiEngine->enqueue(pTrack, pPacked->sysex(i), t1, fGainFade);
+				} else {
+					qtractorMidiEvent event(pPacked->time(i), etype,
+						pPacked->param(i), pPacked->value(i), pPacked->duration(i));
+					pMidiEngine->enqueue(pTrack, &event, t1, fGainFade);
+				}
+			}
+		}
+		m_iPlayIndex = i;
+		return;
+	}
+
+	// Otherwise, go through the event list...
+	qtractorMidiEvent *pEvent = m_playCursor.seek(pSeq, iTime);
 	while (pEvent) {
 		const unsigned long t1 = t0 + pEvent->time();
 		if (t1 >= iTimeEnd)
 			break;
 		if (t1 >= iTimeStart
-			&& (!bMute || pEvent->type() != qtractorMidiEvent::NOTEON))
+			&& (!bMute || pEvent->type() != qtractorMidiEvent::NOTEON)) {
+			pNode = cursor.seekTick(t1);
 			pMidiEngine->enqueue(pTrack, pEvent, t1, fGain
-				* fadeInOutGain(pSession->frameFromTick(t1) - clipStart()));
+				* fadeInOutGain(pNode->frameFromTick(t1) - iClipStart));
+		}
 		pEvent = pEvent->next();
 	}
 }
@@ -988,10 +1064,17 @@ void qtractorMidiClip::process_export (
 	const bool bMute = (pTrack->isMute()
 		|| (pSession->soloTracks() && !pTrack->isSolo()));
 
-	const unsigned long t0 = pSession->tickFromFrame(clipStart());
+	// Local tempo-map cursor (events are in ascending time)...
+	qtractorTimeScale::Cursor cursor(pSession->timeScale());
 
-	const unsigned long iTimeStart = pSession->tickFromFrame(iFrameStart);
-	const unsigned long iTimeEnd   = pSession->tickFromFrame(iFrameEnd);
+	const unsigned long iClipStart = clipStart();
+	qtractorTimeScale::Node *pNode = cursor.seekFrame(iClipStart);
+	const unsigned long t0 = pNode->tickFromFrame(iClipStart);
+
+	pNode = cursor.seekFrame(iFrameStart);
+	const unsigned long iTimeStart = pNode->tickFromFrame(iFrameStart);
+	pNode = cursor.seekFrame(iFrameEnd);
+	const unsigned long iTimeEnd   = pNode->tickFromFrame(iFrameEnd);
 
 	// Enqueue the requested events...
 	const float fGain = clipGain();
@@ -1003,8 +1086,9 @@ void qtractorMidiClip::process_export (
 			break;
 		if (t1 >= iTimeStart
 			&& (!bMute || pEvent->type() != qtractorMidiEvent::NOTEON)) {
+			pNode = cursor.seekTick(t1);
 			enqueue_export(pTrack, pEvent, t1, fGain
-				* fadeInOutGain(pSession->frameFromTick(t1) - clipStart()));
+				* fadeInOutGain(pNode->frameFromTick(t1) - iClipStart));
 		}
 		pEvent = pEvent->next();
 	}
@@ -1056,6 +1140,42 @@ void qtractorMidiClip::draw (
 	const int h1 = clipRect.height() - 2;
 	const int h2 = (h1 / iNoteSpan) + 1;
 
+	// Far zoom-out: notes are sub-pixel wide,
+	// so draw from the note-density thumbnail instead...
+	const unsigned long iThumbTicks = thumbTicks(pSeq);
+	if (!bClipRecord && cw > 0 && iTimeEnd > iTimeStart
+		&& (iTimeEnd - iTimeStart) >= iThumbTicks * cw
+		&& updateThumb(pSeq, fg)) {
+		const int y1 = clipRect.bottom() - (h1 * (iNoteSpan - 1)) / iNoteSpan;
+		const int r1 = ThumbNoteTop - (iNoteMin + iNoteSpan - 1);
+		const qreal w1 = qreal(m_thumb.width());
+		// Tick to pixel is linear in between tempo-map nodes...
+		unsigned long t1 = iTimeStart;
+		pNode = cursor.seekTick(t1);
+		while (pNode && t1 < iTimeEnd) {
+			qtractorTimeScale::Node *pNext = pNode->next();
+			const unsigned long t2
+				= (pNext && pNext->tick < iTimeEnd ? pNext->tick : iTimeEnd);
+			const qreal x1 = clipRect.x() + pNode->pixelFromTick(t1) - cx;
+			qreal x2 = clipRect.x() + pNode->pixelFromTick(t2) - cx;
+			const qreal c1 = qreal(t1 - t0) / qreal(iThumbTicks);
+			qreal c2 = qreal(t2 - t0) / qreal(iThumbTicks);
+			if (c1 >= w1)
+				break;
+			if (c2 > w1) {
+				x2 = x1 + (x2 - x1) * (w1 - c1) / (c2 - c1);
+				c2 = w1;
+			}
+			if (x2 > x1) {
+				pPainter->drawImage(QRectF(x1, y1, x2 - x1, h1),
+					m_thumb, QRectF(c1, r1, c2 - c1, iNoteSpan));
+			}
+			t1 = t2;
+			pNode = pNext;
+		}
+		return;
+	}
+
 	const bool bDrumMode = pTrack->isMidiDrums();
 	QVector<QPoint> diamond;
 	if (bDrumMode) {
@@ -1110,6 +1230,105 @@ void qtractorMidiClip::draw (
 }
 
 
+// Note-density thumbnail resolution (in ticks per column).
+unsigned long qtractorMidiClip::thumbTicks ( qtractorMidiSequence *pSeq )
+{
+	unsigned long iThumbTicks = (pSeq->ticksPerBeat() >> 2);
+	if (iThumbTicks < 1)
+		iThumbTicks = 1;
+
+	const unsigned long iDuration = pSeq->duration();
+	if (iDuration > ThumbColumnsMax * iThumbTicks)
+		iThumbTicks = (iDuration / ThumbColumnsMax) + 1;
+
+	return iThumbTicks;
+}
+
+
+// Note-density thumbnail (re)builder.
+bool qtractorMidiClip::updateThumb (
+	qtractorMidiSequence *pSeq, const QColor& color )
+{
+	const QRgb rgb = color.rgb();
+	if (m_pThumbSeq == pSeq
+		&& m_iThumbSerial == pSeq->serial()
+		&& m_thumbColor == rgb && !m_thumb.isNull())
+		return true;
+
+	const unsigned long iThumbTicks = thumbTicks(pSeq);
+	const int iColumns = int(pSeq->duration() / iThumbTicks) + 1;
+
+	// Accumulate note coverage (in ticks) per column and note...
+	QVector<unsigned long> cover(iColumns * ThumbNotes, 0);
+	qtractorMidiEvent *pEvent = pSeq->events().first();
+	for ( ; pEvent; pEvent = pEvent->next()) {
+		if (pEvent->type() != qtractorMidiEvent::NOTEON)
+			continue;
+		const int r = ThumbNoteTop - int(pEvent->note());
+		unsigned long t1 = pEvent->time();
+		const unsigned long t2 = t1 + (pEvent->duration() > 0
+			? pEvent->duration() : 1);
+		while (t1 < t2) {
+			const unsigned long c = (t1 / iThumbTicks);
+			if (c >= (unsigned long) iColumns)
+				break;
+			unsigned long t = (c + 1) * iThumbTicks;
+			if (t > t2)
+				t = t2;
+			cover[r * iColumns + c] += (t - t1);
+			t1 = t;
+		}
+	}
+
+	// Render coverage as translucency...
+	m_thumb = QImage(iColumns, ThumbNotes, QImage::Format_ARGB32_Premultiplied);
+	for (int r = 0; r < ThumbNotes; ++r) {
+		QRgb *line = reinterpret_cast<QRgb *> (m_thumb.scanLine(r));
+		const unsigned long *pCover = cover.constData() + r * iColumns;
+		for (int c = 0; c < iColumns; ++c) {
+			unsigned long t = pCover[c];
+			if (t > iThumbTicks)
+				t = iThumbTicks;
+			const int a = (t > 0 ? 128 + int((127 * t) / iThumbTicks) : 0);
+			line[c] = qPremultiply(qRgba(
+				qRed(rgb), qGreen(rgb), qBlue(rgb), a));
+		}
+	}
+
+	m_pThumbSeq    = pSeq;
+	m_iThumbSerial = pSeq->serial();
+	m_thumbColor   = rgb;
+
+	return true;
+}
+
+
+// Compact playback form (re)builder (non RT-safe).
+void qtractorMidiClip::updatePacked (void)
+{
+	qtractorTrack *pTrack = track();
+	if (pTrack == nullptr)
+		return;
+
+	// Not while being recorded on (by the input thread)...
+	if (pTrack->clipRecord() == this)
+		return;
+
+	qtractorSession *pSession = pTrack->session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorMidiSequence *pSeq = sequence();
+	if (pSeq == nullptr)
+		return;
+
+	// Old one goes away only when the output thread is done with it...
+	qtractorMidiPacked *pOldPacked = pSeq->updatePacked();
+	if (pOldPacked)
+		pSession->epoch()->retire(pOldPacked);
+}
+
+
 // Clip update method. (rolling stats)
 void qtractorMidiClip::update (void)
 {
@@ -30,6 +30,7 @@
 
 #include <QPoint>
 #include <QSize>
+#include <QImage>
 
 
 // Forward declartiuons.
@@ -124,6 +125,9 @@ public:
 	// Clip update method (rolling stats).
 	void update();
 
+	// Compact playback form (re)builder (non RT-safe).
+	void updatePacked();
+
 	// Clip editor methods.
 	bool startEditor(QWidget *pParent = nullptr);
 	void updateEditor(bool bSelectClear);
@@ -311,6 +315,15 @@ protected:
 	void enqueue_export(qtractorTrack *pTrack,
 		qtractorMidiEvent *pEvent, unsigned long iTime, float fGain) const;
 
+	// Note-density thumbnail geometry (rows are padded notes).
+	enum { ThumbNotes = 136, ThumbNoteTop = 131, ThumbColumnsMax = 4096 };
+
+	// Note-density thumbnail resolution (in ticks per column).
+	static unsigned long thumbTicks(qtractorMidiSequence *pSeq);
+
+	// Note-density thumbnail (re)builder.
+	bool updateThumb(qtractorMidiSequence *pSeq, const QColor& color);
+
 private:
 
 	// Instance variables.
@@ -337,6 +350,16 @@ private:
 	qtractorMidiCursor m_playCursor;
 	qtractorMidiCursor m_drawCursor;
 
+	// Compact playback form position hint.
+	unsigned int m_iPlayIndex;
+
+	// Note-density thumbnail (far zoom-out drawing).
+	QImage m_thumb;
+
+	qtractorMidiSequence *m_pThumbSeq;
+	unsigned int  m_iThumbSerial;
+	QRgb          m_thumbColor;
+
 	// This clip editor form widget.
 	qtractorMidiEditorForm *m_pMidiEditorForm;
 
@@ -23,6 +23,10 @@
 #include "qtractorMidiSequence.h"
 
 
+// Maximum linear steps before falling back to an indexed seek.
+#define QTRACTOR_MIDI_CURSOR_STEPS 64
+
+
 //-------------------------------------------------------------------------
 // qtractorMidiCursor -- MIDI event cursor capsule.
 
@@ -43,22 +47,25 @@ qtractorMidiEvent *qtractorMidiCursor::seek (
 	}
 	else
 	if (iTime > m_iTime) {
-		// Seek forward...
+		// Seek forward (short steps only)...
 		if (m_pEvent == nullptr)
 			m_pEvent = pSeq->events().first();
+		int iSteps = 0;
 		while (m_pEvent && m_pEvent->next()
-			&& (m_pEvent->next())->time() < iTime)
+			&& (m_pEvent->next())->time() < iTime) {
+			if (++iSteps > QTRACTOR_MIDI_CURSOR_STEPS) {
+				m_pEvent = pSeq->seekEvent(iTime);
+				break;
+			}
 			m_pEvent = m_pEvent->next();
+		}
 		if (m_pEvent == nullptr)
-			m_pEvent = pSeq->events().last();
+			m_pEvent = pSeq->events().first();
 	}
 	else
 	if (iTime < m_iTime) {
-		// Seek backward...
-		if (m_pEvent == nullptr)
-			m_pEvent = pSeq->events().last();
-		while (m_pEvent && m_pEvent->time() >= iTime)
-			m_pEvent = m_pEvent->prev();
+		// Seek backward (indexed)...
+		m_pEvent = pSeq->seekEvent(iTime);
 		if (m_pEvent == nullptr)
 			m_pEvent = pSeq->events().first();
 	}
@@ -75,8 +82,14 @@ qtractorMidiEvent *qtractorMidiCursor::reset (
 	// Reset-seek forward...
 	if (m_iTime >= iTime)
 		m_pEvent = nullptr;
-	if (m_pEvent == nullptr)
-		m_pEvent = pSeq->events().first();
+	if (m_pEvent == nullptr) {
+		// Skip all events that surely end before target time...
+		const unsigned long iDurationMax = pSeq->durationMax();
+		if (iTime > iDurationMax)
+			m_pEvent = pSeq->seekEvent(iTime - iDurationMax);
+		if (m_pEvent == nullptr)
+			m_pEvent = pSeq->events().first();
+	}
 	while (m_pEvent && m_pEvent->time() + m_pEvent->duration() < iTime)
 		m_pEvent = m_pEvent->next();
 	while (m_pEvent && m_pEvent->time() > iTime)
@@ -225,6 +225,9 @@ bool qtractorMidiEditCommand::execute ( bool bRedo )
 		}
 	}
 
+	// Playback form is stale, definitely...
+	m_pMidiClip->updatePacked();
+
 	// Just reset/update editor internals...
 	m_pMidiClip->updateEditorEx(iSelectClear > 0);
 
@@ -33,6 +33,7 @@
 
 #include "qtractorMidiClip.h"
 #include "qtractorMidiManager.h"
+#include "qtractorMidiJackPort.h"
 #include "qtractorMidiControl.h"
 #include "qtractorMidiTimer.h"
 #include "qtractorMidiSysex.h"
@@ -1434,6 +1435,26 @@ void qtractorMidiEngine::resetAllMonitors (void)
 }
 
 
+// Rebuild all stale MIDI clip playback forms (non RT-safe);
+// catches up on all sequence changes not rebuilt otherwise.
+void qtractorMidiEngine::updatePacked (void)
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		if (pTrack->trackType() != qtractorTrack::Midi)
+			continue;
+		for (qtractorClip *pClip = pTrack->clips().first();
+				pClip; pClip = pClip->next()) {
+			static_cast<qtractorMidiClip *> (pClip)->updatePacked();
+		}
+	}
+}
+
+
 // Reset all MIDI instrument/controllers...
 void qtractorMidiEngine::resetAllControllers ( bool bForceImmediate )
 {
@@ -2108,20 +2129,8 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 			break;
 	}
 
-	// Pump it into the queue.
-	snd_seq_event_output(m_pAlsaSeq, &ev);
-
-	// MIDI track monitoring...
-	qtractorMidiMonitor *pMidiMonitor
-		= static_cast<qtractorMidiMonitor *> (pTrack->monitor());
-	if (pMidiMonitor)
-		pMidiMonitor->enqueue(pEvent->type(), pEvent->value(), tick);
-	// MIDI bus monitoring...
-	if (pMidiBus->midiMonitor_out())
-		pMidiBus->midiMonitor_out()->enqueue(
-			pEvent->type(), pEvent->value(), tick);
-
-	// Do it for the MIDI track plugins too...
+	// Event frame times, for the MIDI plugins
+	// and JACK MIDI output scheduling...
 	qtractorTimeScale::Cursor& cursor = pSession->timeScale()->cursor();
 	qtractorTimeScale::Node *pNode = cursor.seekTick(iTime);
 	const long f0 = m_iFrameStart;
@@ -2135,6 +2144,25 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 		t2 += (pNode->frameFromTick(iTimeOff) - t0);
 	}
 
+	// Pump it into the queue,
+	// or have it scheduled in-process...
+	qtractorMidiJackPort *pJackPort = pMidiBus->jackPort();
+	if (pJackPort)
+		pJackPort->queued(&ev, t1, t2);
+	else
+		snd_seq_event_output(m_pAlsaSeq, &ev);
+
+	// MIDI track monitoring...
+	qtractorMidiMonitor *pMidiMonitor
+		= static_cast<qtractorMidiMonitor *> (pTrack->monitor());
+	if (pMidiMonitor)
+		pMidiMonitor->enqueue(pEvent->type(), pEvent->value(), tick);
+	// MIDI bus monitoring...
+	if (pMidiBus->midiMonitor_out())
+		pMidiBus->midiMonitor_out()->enqueue(
+			pEvent->type(), pEvent->value(), tick);
+
+	// Do it for the MIDI track plugins too...
 	qtractorMidiManager *pMidiManager
 		= (pTrack->pluginList())->midiManager();
 	if (pMidiManager)
@@ -2447,6 +2475,9 @@ void qtractorMidiEngine::stop (void)
 	snd_seq_drop_input(m_pAlsaSeq);
 	snd_seq_drop_output(m_pAlsaSeq);
 
+	// Cleanup JACK MIDI output schedules...
+	resetJackPorts();
+
 	// Stop queue timer...
 	snd_seq_stop_queue(m_pAlsaSeq, m_iAlsaQueue, nullptr);
 
@@ -2566,6 +2597,17 @@ void qtractorMidiEngine::restartLoop (void)
 }
 
 
+// Drop all JACK MIDI output schedules (eg. on stop or seek).
+void qtractorMidiEngine::resetJackPorts (void)
+{
+	for (qtractorBus *pBus = buses().first(); pBus; pBus = pBus->next()) {
+		qtractorMidiBus *pMidiBus = static_cast<qtractorMidiBus *> (pBus);
+		if (pMidiBus && pMidiBus->jackPort())
+			pMidiBus->jackPort()->reset();
+	}
+}
+
+
 // The delta-time/frame accessors.
 long qtractorMidiEngine::timeStart (void) const
 {
@@ -2610,9 +2652,12 @@ void qtractorMidiEngine::trackMute ( qtractorTrack *pTrack, bool bMute )
 			| SND_SEQ_REMOVE_DEST_CHANNEL | SND_SEQ_REMOVE_IGNORE_OFF
 			| SND_SEQ_REMOVE_TAG_MATCH);
 		snd_seq_remove_events(m_pAlsaSeq, pre);
-		// Immediate all current notes off.
 		qtractorMidiBus *pMidiBus
 			= static_cast<qtractorMidiBus *> (pTrack->outputBus());
+		// Same for the JACK MIDI output schedules...
+		if (pMidiBus && pMidiBus->jackPort())
+			pMidiBus->jackPort()->purge(pTrack->midiTag() & 0xff);
+		// Immediate all current notes off.
 		if (pMidiBus)
 			pMidiBus->setController(pTrack, ALL_NOTES_OFF);
 		// Clear/reset track monitor...
@@ -2669,6 +2714,9 @@ void qtractorMidiEngine::metroMute ( bool bMute )
 			| SND_SEQ_REMOVE_DEST_CHANNEL | SND_SEQ_REMOVE_IGNORE_OFF
 			| SND_SEQ_REMOVE_TAG_MATCH);
 		snd_seq_remove_events(m_pAlsaSeq, pre);
+		// Same for the JACK MIDI output schedules, if any...
+		if (m_pMetroBus && m_pMetroBus->jackPort())
+			m_pMetroBus->jackPort()->purge(0xff);
 		// Done metronome mute.
 	} else {
 		// Must redirect to MIDI ouput thread:
@@ -3853,6 +3901,9 @@ qtractorMidiBus::qtractorMidiBus ( qtractorMidiEngine *pMidiEngine,
 {
 	m_iAlsaPort = -1;
 
+	m_bJackMidi = false;
+	m_pJackPort = nullptr;
+
 	if ((busMode & qtractorBus::Input) && !(busMode & qtractorBus::Ex)) {
 		m_pIMidiMonitor = new qtractorMidiMonitor();
 		m_pIPluginList  = createPluginList(qtractorPluginList::MidiInBus);
@@ -3889,6 +3940,9 @@ qtractorMidiBus::~qtractorMidiBus (void)
 
 	if (m_pSysexList)
 		delete m_pSysexList;
+
+	if (m_pJackPort)
+		delete m_pJackPort;
 }
 
 
@@ -3958,6 +4012,21 @@ bool qtractorMidiBus::open (void)
 	if (m_pIMidiMonitor)
 		pMidiEngine->addInputBus(this);
 
+	// JACK MIDI output port, if applicable...
+	if (m_bJackMidi
+		&& (busMode & qtractorBus::Output) && !(busMode & qtractorBus::Ex)) {
+		qtractorAudioEngine *pAudioEngine
+			= pMidiEngine->session()->audioEngine();
+		if (pAudioEngine) {
+			if (m_pJackPort == nullptr) {
+				m_pJackPort = new qtractorMidiJackPort(
+					qtractorMidiBuffer::MinBufferSize << 2);
+			}
+			m_pJackPort->open(pAudioEngine->jackClient(),
+				busName() + "/midi_out");
+		}
+	}
+
 	// Done.
 	return true;
 }
@@ -3980,6 +4049,13 @@ void qtractorMidiBus::close (void)
 
 	shutOff(true);
 
+	if (m_pJackPort) {
+		qtractorAudioEngine *pAudioEngine
+			= pMidiEngine->session()->audioEngine();
+		m_pJackPort->close(pAudioEngine
+			? pAudioEngine->jackClient() : nullptr);
+	}
+
 	snd_seq_delete_simple_port(pAlsaSeq, m_iAlsaPort);
 
 	m_iAlsaPort = -1;
@@ -4095,6 +4171,25 @@ void qtractorMidiBus::shutOff ( bool bClose ) const
 }
 
 
+// JACK MIDI output mode accessors (effective on next open).
+void qtractorMidiBus::setJackMidi ( bool bJackMidi )
+{
+	m_bJackMidi = bJackMidi;
+}
+
+bool qtractorMidiBus::isJackMidi (void) const
+{
+	return m_bJackMidi;
+}
+
+
+// JACK MIDI output port accessor (null if not in use).
+qtractorMidiJackPort *qtractorMidiBus::jackPort (void) const
+{
+	return (m_pJackPort && m_pJackPort->jackPort() ? m_pJackPort : nullptr);
+}
+
+
 // Default instrument name accessors.
 void qtractorMidiBus::setInstrumentName ( const QString& sInstrumentName )
 {
@@ -4280,7 +4375,10 @@ void qtractorMidiBus::setControllerEx ( unsigned short iChannel,
 	ev.data.control.channel = iChannel;
 	ev.data.control.param   = iController;
 	ev.data.control.value   = iValue;
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	if (m_pJackPort && m_pJackPort->jackPort())
+		m_pJackPort->direct(&ev);
+	else
+		snd_seq_event_output_direct(pAlsaSeq, &ev);
 
 	// Do it for the MIDI plugins too...
 	if (pTrack && (pTrack->pluginList())->midiManager())
@@ -4389,7 +4487,10 @@ void qtractorMidiBus::sendEvent ( qtractorMidiEvent::EventType etype,
 		break;
 	}
 
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	if (m_pJackPort && m_pJackPort->jackPort())
+		m_pJackPort->direct(&ev);
+	else
+		snd_seq_event_output_direct(pAlsaSeq, &ev);
 }
 
 
@@ -4432,7 +4533,10 @@ void qtractorMidiBus::sendNote (
 	ev.data.note.channel  = iChannel;
 	ev.data.note.note     = iNote;
 	ev.data.note.velocity = iVelocity;
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	if (m_pJackPort && m_pJackPort->jackPort())
+		m_pJackPort->direct(&ev);
+	else
+		snd_seq_event_output_direct(pAlsaSeq, &ev);
 
 	// Do it for the MIDI plugins too...
 	if ((pTrack->pluginList())->midiManager())
@@ -4494,7 +4598,10 @@ void qtractorMidiBus::sendSysex (
 	// Just set SYSEX stuff and send it out..
 	ev.type = SND_SEQ_EVENT_SYSEX;
 	snd_seq_ev_set_sysex(&ev, iSysex, pSysex);
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	if (m_pJackPort && m_pJackPort->jackPort())
+		m_pJackPort->direct(&ev);
+	else
+		snd_seq_event_output_direct(pAlsaSeq, &ev);
 
 //	pMidiEngine->flush();
 }
@@ -4543,7 +4650,10 @@ void qtractorMidiBus::sendSysexList (void) const
 		// Just set SYSEX stuff and send it out..
 		ev.type = SND_SEQ_EVENT_SYSEX;
 		snd_seq_ev_set_sysex(&ev, pSysex->size(), pSysex->data());
-		snd_seq_event_output(pAlsaSeq, &ev);
+		if (m_pJackPort && m_pJackPort->jackPort())
+			m_pJackPort->direct(&ev);
+		else
+			snd_seq_event_output(pAlsaSeq, &ev);
 		// AG: Do it for the MIDI plugins too...
 		if (pluginList_out() && pluginList_out()->midiManager())
 			(pluginList_out()->midiManager())->direct(&ev);
@@ -4885,6 +4995,9 @@ bool qtractorMidiBus::loadElement (
 			qtractorMidiBus::loadMidiMap(pDocument, &eProp);
 		} else if (eProp.tagName() == "midi-instrument-name") {
 			qtractorMidiBus::setInstrumentName(eProp.text());
+		} else if (eProp.tagName() == "jack-midi") {
+			qtractorMidiBus::setJackMidi(
+				qtractorDocument::boolFromText(eProp.text()));
 		} else if (eProp.tagName() == "input-gain") {
 			if (qtractorMidiBus::monitor_in())
 				qtractorMidiBus::monitor_in()->setGain(
@@ -4992,6 +5105,10 @@ bool qtractorMidiBus::saveElement (
 				pDocument, &eOutputPlugins);
 			pElement->appendChild(eOutputPlugins);
 		}
+		// Save JACK MIDI output mode...
+		pDocument->saveTextElement("jack-midi",
+			qtractorDocument::textFromBool(
+				qtractorMidiBus::isJackMidi()), pElement);
 		// Save output bus connections...
 		QDomElement eMidiOutputs
 			= pDocument->document()->createElement("output-connects");
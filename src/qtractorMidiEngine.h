@@ -42,6 +42,7 @@ class qtractorMidiMonitor;
 class qtractorMidiSysexList;
 class qtractorMidiInputBuffer;
 class qtractorMidiPlayer;
+class qtractorMidiJackPort;
 class qtractorPluginList;
 class qtractorCurveList;
 
@@ -121,6 +122,9 @@ public:
 	// Reset all MIDI monitoring...
 	void resetAllMonitors();
 
+	// Rebuild all stale MIDI clip playback forms (non RT-safe).
+	void updatePacked();
+
 	// Reset all MIDI controllers...
 	void resetAllControllers(bool bForceImmediate);
 	bool isResetAllControllersPending() const;
@@ -155,6 +159,9 @@ public:
 	// Special rewind method, on queue loop.
 	void restartLoop();
 
+	// Drop all JACK MIDI output schedules (eg. on stop or seek).
+	void resetJackPorts();
+
 	// The delta-time/frame accessors.
 	long timeStart() const;
 
@@ -435,6 +442,13 @@ public:
 	// Shut-off everything out there.
 	void shutOff(bool bClose = false) const;
 
+	// JACK MIDI output mode accessors (effective on next open).
+	void setJackMidi(bool bJackMidi);
+	bool isJackMidi() const;
+
+	// JACK MIDI output port accessor (null if not in use).
+	qtractorMidiJackPort *jackPort() const;
+
 	// SysEx setup list accessors.
 	qtractorMidiSysexList *sysexList() const;
 
@@ -554,6 +568,10 @@ private:
 	// Instance variables.
 	int m_iAlsaPort;
 
+	// JACK MIDI output mode and port.
+	bool m_bJackMidi;
+	qtractorMidiJackPort *m_pJackPort;
+
 	// Specific monitor instances.
 	qtractorMidiMonitor *m_pIMidiMonitor;
 	qtractorMidiMonitor *m_pOMidiMonitor;
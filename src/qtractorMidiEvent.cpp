@@ -0,0 +1,357 @@
+// qtractorMidiEvent.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2023, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorMidiEvent.h"
+
+#include <QMutex>
+
+#include <new>
+
+#include <cstdlib>
+#include <cstdint>
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiEventPool -- Fixed-size chunk slab allocator.
+//
+// Chunks are handed out from per-thread caches, which get refilled
+// and flushed in batches from the shared slabs, under lock; slabs
+// are aligned to their size, so that a chunk always knows its own,
+// and slabs left with no chunks in use are given back, but one.
+//
+
+class qtractorMidiEventPool
+{
+public:
+
+	// Constructor.
+	qtractorMidiEventPool(size_t iChunkSize)
+		: m_iChunkSize(align(iChunkSize < sizeof(Chunk)
+			? sizeof(Chunk) : iChunkSize)),
+			m_pSlabs(nullptr), m_pSpare(nullptr) {}
+
+	// Chunk size accessor.
+	size_t chunkSize() const { return m_iChunkSize; }
+
+	// Per-thread cache size.
+	enum { CacheSize = 64 };
+
+	// Per-thread chunk cache.
+	class Cache
+	{
+	public:
+
+		// Constructor.
+		Cache(qtractorMidiEventPool *pPool)
+			: m_pPool(pPool), m_iCount(0) {}
+
+		// Destructor; all goes back to slabs.
+		~Cache() { m_pPool->flush(m_chunks, m_iCount); m_iCount = 0; }
+
+		// Chunk allocation.
+		void *alloc()
+		{
+			if (m_iCount == 0)
+				m_iCount = m_pPool->refill(m_chunks, CacheSize >> 1);
+			return (m_iCount > 0 ? m_chunks[--m_iCount] : nullptr);
+		}
+
+		// Chunk release.
+		void free(void *pv)
+		{
+			if (m_iCount >= CacheSize) {
+				m_iCount -= (CacheSize >> 1);
+				m_pPool->flush(m_chunks + m_iCount, CacheSize >> 1);
+			}
+			m_chunks[m_iCount++] = pv;
+		}
+
+	private:
+
+		// Instance variables.
+		qtractorMidiEventPool *m_pPool;
+
+		void        *m_chunks[CacheSize];
+		unsigned int m_iCount;
+	};
+
+	// Take some chunks from slabs (locked).
+	unsigned int refill(void **ppChunks, unsigned int iCount)
+	{
+		QMutexLocker locker(&m_mutex);
+
+		unsigned int i = 0;
+		while (i < iCount) {
+			Slab *pSlab = m_pSlabs;
+			if (pSlab == nullptr) {
+				pSlab = (m_pSpare ? m_pSpare : newSlab());
+				if (pSlab == nullptr)
+					break;
+				m_pSpare = nullptr;
+				linkSlab(pSlab);
+			}
+			Chunk *pChunk = pSlab->free;
+			pSlab->free = pChunk->next;
+			++pSlab->used;
+			ppChunks[i++] = pChunk;
+			// Full slabs are out of sight...
+			if (pSlab->free == nullptr)
+				unlinkSlab(pSlab);
+		}
+
+		return i;
+	}
+
+	// Give chunks back to their slabs (locked).
+	void flush(void **ppChunks, unsigned int iCount)
+	{
+		QMutexLocker locker(&m_mutex);
+
+		for (unsigned int i = 0; i < iCount; ++i) {
+			Chunk *pChunk = static_cast<Chunk *> (ppChunks[i]);
+			Slab *pSlab = slab(pChunk);
+			// Full slabs are back in sight...
+			if (pSlab->free == nullptr)
+				linkSlab(pSlab);
+			pChunk->next = pSlab->free;
+			pSlab->free = pChunk;
+			// Empty slabs go away, but one spare...
+			if (--pSlab->used == 0) {
+				unlinkSlab(pSlab);
+				if (m_pSpare)
+					::free(pSlab);
+				else
+					m_pSpare = pSlab;
+			}
+		}
+	}
+
+private:
+
+	// Slab size, also its alignment.
+	enum { SlabSize = 0x10000 };
+
+	// Free chunk link.
+	struct Chunk { Chunk *next; };
+
+	// Slab header.
+	struct Slab
+	{
+		Slab        *prev;
+		Slab        *next;
+		Chunk       *free;
+		unsigned int used;
+	};
+
+	// Chunk alignment helper.
+	static size_t align(size_t iSize)
+		{ return (iSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1); }
+
+	// Chunk owner slab.
+	static Slab *slab(void *pv)
+	{
+		return reinterpret_cast<Slab *> (
+			uintptr_t(pv) & ~uintptr_t(SlabSize - 1));
+	}
+
+	// Grab a brand new slab and split it in chunks.
+	Slab *newSlab()
+	{
+		char *pSlabData = static_cast<char *> (
+			::aligned_alloc(SlabSize, SlabSize));
+		if (pSlabData == nullptr)
+			return nullptr;
+
+		Slab *pSlab = reinterpret_cast<Slab *> (pSlabData);
+		pSlab->prev = nullptr;
+		pSlab->next = nullptr;
+		pSlab->free = nullptr;
+		pSlab->used = 0;
+
+		const size_t iOffset = align(sizeof(Slab));
+		const size_t iChunks = (SlabSize - iOffset) / m_iChunkSize;
+		for (size_t i = iChunks; i > 0; --i) {
+			Chunk *pChunk = reinterpret_cast<Chunk *> (
+				pSlabData + iOffset + (i - 1) * m_iChunkSize);
+			pChunk->next = pSlab->free;
+			pSlab->free = pChunk;
+		}
+
+		return pSlab;
+	}
+
+	// Slabs with free chunks list.
+	void linkSlab(Slab *pSlab)
+	{
+		pSlab->prev = nullptr;
+		pSlab->next = m_pSlabs;
+		if (m_pSlabs)
+			m_pSlabs->prev = pSlab;
+		m_pSlabs = pSlab;
+	}
+
+	void unlinkSlab(Slab *pSlab)
+	{
+		if (pSlab->prev)
+			pSlab->prev->next = pSlab->next;
+		else
+			m_pSlabs = pSlab->next;
+		if (pSlab->next)
+			pSlab->next->prev = pSlab->prev;
+		pSlab->prev = nullptr;
+		pSlab->next = nullptr;
+	}
+
+	// Instance variables.
+	size_t m_iChunkSize;
+
+	Slab  *m_pSlabs;
+	Slab  *m_pSpare;
+
+	QMutex m_mutex;
+};
+
+
+// Pools are kept for the whole process lifetime, on purpose,
+// as some events may well outlive any static destruction order.
+static qtractorMidiEventPool *eventPool (void)
+{
+	static qtractorMidiEventPool *s_pEventPool
+		= new qtractorMidiEventPool(sizeof(qtractorMidiEvent));
+	return s_pEventPool;
+}
+
+static qtractorMidiEventPool *sysexPool (void)
+{
+	static qtractorMidiEventPool *s_pSysexPool
+		= new qtractorMidiEventPool(64);
+	return s_pSysexPool;
+}
+
+
+// Per-thread caches; whatever comes after
+// a thread cache is gone goes straight to slabs.
+static thread_local bool g_bCachesGone = false;
+
+struct qtractorMidiEventCaches
+{
+	qtractorMidiEventCaches()
+		: events(eventPool()), sysex(sysexPool()) {}
+	~qtractorMidiEventCaches()
+		{ g_bCachesGone = true; }
+
+	qtractorMidiEventPool::Cache events;
+	qtractorMidiEventPool::Cache sysex;
+};
+
+static qtractorMidiEventCaches *eventCaches (void)
+{
+	if (g_bCachesGone)
+		return nullptr;
+
+	static thread_local qtractorMidiEventCaches s_caches;
+	return &s_caches;
+}
+
+static qtractorMidiEventPool::Cache *eventCache (void)
+{
+	qtractorMidiEventCaches *pCaches = eventCaches();
+	return (pCaches ? &pCaches->events : nullptr);
+}
+
+static qtractorMidiEventPool::Cache *sysexCache (void)
+{
+	qtractorMidiEventCaches *pCaches = eventCaches();
+	return (pCaches ? &pCaches->sysex : nullptr);
+}
+
+
+// Pooled chunk allocation helpers.
+static void *poolAlloc (
+	qtractorMidiEventPool *pPool, qtractorMidiEventPool::Cache *pCache )
+{
+	void *pv = nullptr;
+	if (pCache)
+		pv = pCache->alloc();
+	else
+		pPool->refill(&pv, 1);
+
+	if (pv == nullptr)
+		throw std::bad_alloc();
+
+	return pv;
+}
+
+static void poolFree (
+	qtractorMidiEventPool *pPool, qtractorMidiEventPool::Cache *pCache, void *pv )
+{
+	if (pCache)
+		pCache->free(pv);
+	else
+		pPool->flush(&pv, 1);
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiEvent -- Pooled allocation.
+//
+
+void *qtractorMidiEvent::operator new ( size_t iSize )
+{
+	if (iSize != sizeof(qtractorMidiEvent))
+		return ::operator new(iSize);
+
+	return poolAlloc(eventPool(), eventCache());
+}
+
+
+void qtractorMidiEvent::operator delete ( void *pEvent, size_t iSize )
+{
+	if (pEvent == nullptr)
+		return;
+
+	if (iSize != sizeof(qtractorMidiEvent))
+		::operator delete(pEvent);
+	else
+		poolFree(eventPool(), eventCache(), pEvent);
+}
+
+
+// Pooled sysex buffer allocation (small ones only).
+unsigned char *qtractorMidiEvent::allocSysex ( unsigned short iSysex )
+{
+	if (iSysex > sysexPool()->chunkSize())
+		return new unsigned char [iSysex];
+
+	return static_cast<unsigned char *> (poolAlloc(sysexPool(), sysexCache()));
+}
+
+
+void qtractorMidiEvent::freeSysex ( unsigned char *pSysex, unsigned short iSysex )
+{
+	if (iSysex > sysexPool()->chunkSize())
+		delete [] pSysex;
+	else
+		poolFree(sysexPool(), sysexCache(), pSysex);
+}
+
+
+// end of qtractorMidiEvent.cpp
@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
 
 
 //----------------------------------------------------------------------
@@ -86,7 +87,7 @@ public:
 	{
 		if (m_type == SYSEX) {
 			m_v.iSysex = e.m_v.iSysex;
-			m_u.pSysex = new unsigned char [m_v.iSysex];
+			m_u.pSysex = allocSysex(m_v.iSysex);
 			::memcpy(m_u.pSysex, e.m_u.pSysex, m_v.iSysex);
 		} else {
 			m_v.param = e.m_v.param;
@@ -97,7 +98,11 @@ public:
 
 	// Destructor.
 	~qtractorMidiEvent()
-		{ if (m_type == SYSEX && m_u.pSysex) delete [] m_u.pSysex; }
+		{ if (m_type == SYSEX && m_u.pSysex) freeSysex(m_u.pSysex, m_v.iSysex); }
+
+	// Pooled allocation (class specific).
+	static void *operator new(size_t iSize);
+	static void operator delete(void *pEvent, size_t iSize);
 
 	// Event properties accessors (getters).
 	unsigned long time()       const { return m_time; }
@@ -139,9 +144,9 @@ public:
 	// Allocate and set a new sysex buffer.
 	void setSysex(unsigned char *pSysex, unsigned short iSysex)
 	{
-		if (m_type == SYSEX && m_u.pSysex) delete [] m_u.pSysex;
+		if (m_type == SYSEX && m_u.pSysex) freeSysex(m_u.pSysex, m_v.iSysex);
 		m_v.iSysex = iSysex;
-		m_u.pSysex = new unsigned char [m_v.iSysex];
+		m_u.pSysex = allocSysex(m_v.iSysex);
 		::memcpy(m_u.pSysex, pSysex, m_v.iSysex);
 	}
 
@@ -151,6 +156,12 @@ public:
 	void setPitchBend(int iPitchBend)
 		{ m_v.value = (unsigned short) (0x2000 + iPitchBend); }
 
+protected:
+
+	// Pooled sysex buffer allocation.
+	static unsigned char *allocSysex(unsigned short iSysex);
+	static void freeSysex(unsigned char *pSysex, unsigned short iSysex);
+
 private:
 
 	// Event instance members.
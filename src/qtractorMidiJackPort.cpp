@@ -0,0 +1,437 @@
+// qtractorMidiJackPort.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorMidiJackPort.h"
+
+#include <jack/midiport.h>
+
+#include <QThread>
+
+#include <cstring>
+#include <new>
+
+
+// Maximum decoded MIDI data (eg. 14bit controllers, RPN/NRPN).
+const long c_iMaxMidiData = 16;
+
+// Open ports registry, for cycle-wide buffer clearance.
+#define QTRACTOR_MIDI_JACK_PORTS 64
+
+static QAtomicPointer<qtractorMidiJackPort> g_apJackPorts[QTRACTOR_MIDI_JACK_PORTS];
+
+// Number of (RT) clearance cycles in flight.
+static qtractorAtomic g_iClearAll;
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiJackPort -- JACK MIDI output port (in-process).
+//
+
+// Constructor.
+qtractorMidiJackPort::qtractorMidiJackPort ( unsigned int iBufferSize )
+	: m_pJackClient(nullptr), m_pJackPort(nullptr),
+		m_directBuffer(iBufferSize >> 2),
+		m_queuedBuffer(iBufferSize),
+		m_postedBuffer(iBufferSize),
+		m_pMidiDecoder(nullptr)
+{
+	if (snd_midi_event_new(c_iMaxMidiData, &m_pMidiDecoder) == 0)
+		snd_midi_event_no_status(m_pMidiDecoder, 1);
+
+	ATOMIC_SET(&m_resetPending, 0);
+
+	ATOMIC_SET(&m_iSysexHead, 0);
+	ATOMIC_SET(&m_iSysexTail, 0);
+
+	for (int i = 0; i < 8; ++i)
+		ATOMIC_SET(&m_purgeTags[i], 0);
+	ATOMIC_SET(&m_purgePending, 0);
+}
+
+
+// Destructor.
+qtractorMidiJackPort::~qtractorMidiJackPort (void)
+{
+	close();
+
+	if (m_pMidiDecoder) {
+		snd_midi_event_free(m_pMidiDecoder);
+		m_pMidiDecoder = nullptr;
+	}
+}
+
+
+// Port (un)registration (non RT-safe).
+bool qtractorMidiJackPort::open (
+	jack_client_t *pJackClient, const QString& sPortName )
+{
+	close(pJackClient);
+
+	if (pJackClient == nullptr || m_pMidiDecoder == nullptr)
+		return false;
+
+	m_pJackPort = jack_port_register(pJackClient,
+		sPortName.toUtf8().constData(),
+		JACK_DEFAULT_MIDI_TYPE,
+		JackPortIsOutput, 0);
+
+	if (m_pJackPort == nullptr)
+		return false;
+
+	m_pJackClient = pJackClient;
+
+	// Register for cycle-wide clearance...
+	for (int i = 0; i < QTRACTOR_MIDI_JACK_PORTS; ++i) {
+		if (g_apJackPorts[i].testAndSetOrdered(nullptr, this))
+			break;
+	}
+
+	m_directBuffer.clear();
+	m_queuedBuffer.clear();
+	m_postedBuffer.clear();
+
+	ATOMIC_SET(&m_iSysexHead, 0);
+	ATOMIC_SET(&m_iSysexTail, 0);
+
+	snd_midi_event_reset_decode(m_pMidiDecoder);
+
+	return true;
+}
+
+
+void qtractorMidiJackPort::close ( jack_client_t *pJackClient )
+{
+	// Unregister from cycle-wide clearance,
+	// making sure it's not in use anymore...
+	for (int i = 0; i < QTRACTOR_MIDI_JACK_PORTS; ++i) {
+		if (g_apJackPorts[i].testAndSetOrdered(this, nullptr))
+			break;
+	}
+
+	while (ATOMIC_GET(&g_iClearAll) > 0)
+		QThread::yieldCurrentThread();
+
+	// Unregister port, if we're not shutdown...
+	if (m_pJackPort && pJackClient && pJackClient == m_pJackClient)
+		jack_port_unregister(m_pJackClient, m_pJackPort);
+
+	m_pJackPort = nullptr;
+	m_pJackClient = nullptr;
+}
+
+
+// Direct (immediate) event buffering (any non-RT thread).
+bool qtractorMidiJackPort::direct ( snd_seq_event_t *pEvent )
+{
+	if (m_pJackPort == nullptr)
+		return false;
+
+	// Many producers, one consumer...
+	QMutexLocker locker(&m_mutex);
+
+	if (pEvent->type != SND_SEQ_EVENT_SYSEX)
+		return m_directBuffer.push(pEvent);
+
+	// Take a private copy of (transient) SysEx data...
+	snd_seq_event_t ev = *pEvent;
+	if (!reserve(&ev, 100))
+		return false;
+
+	if (m_directBuffer.push(&ev))
+		return true;
+
+	// Not queued, give room back...
+	SysexChunk *pChunk = ((SysexChunk *) ev.data.ext.ptr) - 1;
+	ATOMIC_SET(&pChunk->used, 0);
+	return false;
+}
+
+
+// Take a private copy of (transient) SysEx data (any non-RT
+// thread, serialized); may wait a little for data room.
+bool qtractorMidiJackPort::reserve ( snd_seq_event_t *pEv, int iRetries )
+{
+	const unsigned int iSysex = pEv->data.ext.len;
+	const unsigned int iAlign = sizeof(SysexChunk);
+	const unsigned int iSize  = iAlign + ((iSysex + iAlign - 1) & ~(iAlign - 1));
+	if (iSize >= SysexSize) {
+		qWarning("qtractorMidiJackPort[%p]::reserve(): "
+			"SysEx too large (%u bytes), dropped.", this, iSysex);
+		return false;
+	}
+
+	// Reserve contiguous room in the arena,
+	// skipping to its start when not enough...
+	const unsigned int iHead = ATOMIC_GET(&m_iSysexHead);
+	const unsigned int iPos  = iHead % SysexSize;
+	const unsigned int iPad  = (iPos + iSize > SysexSize ? SysexSize - iPos : 0);
+	const unsigned int iNeed = iPad + iSize;
+
+	// Wait a little for the consumer to make room...
+	int iRetry = 0;
+	while (SysexSize - (iHead - (unsigned int) ATOMIC_GET(&m_iSysexTail)) < iNeed) {
+		if (++iRetry > iRetries || m_pJackPort == nullptr) {
+			qWarning("qtractorMidiJackPort[%p]::reserve(): "
+				"SysEx room overflow (%u bytes), dropped.", this, iSysex);
+			return false;
+		}
+		QThread::msleep(2);
+	}
+
+	// Any padding goes as an already released chunk...
+	if (iPad > 0) {
+		SysexChunk *pPad = new (&m_sysex[iPos]) SysexChunk;
+		pPad->size = iPad;
+		ATOMIC_SET(&pPad->used, 0);
+	}
+
+	SysexChunk *pChunk = new (&m_sysex[(iPos + iPad) % SysexSize]) SysexChunk;
+	pChunk->size = iSize;
+	ATOMIC_SET(&pChunk->used, 1);
+
+	unsigned char *pSysex = (unsigned char *) (pChunk + 1);
+	::memcpy(pSysex, pEv->data.ext.ptr, iSysex);
+	pEv->data.ext.ptr = pSysex;
+
+	// Commit the room before the event gets visible...
+	ATOMIC_SET(&m_iSysexHead, int(iHead + iNeed));
+
+	return true;
+}
+
+
+// Release SysEx data room, once consumed (RT-safe).
+void qtractorMidiJackPort::release ( snd_seq_event_t *pEv )
+{
+	if (pEv->type != SND_SEQ_EVENT_SYSEX)
+		return;
+
+	SysexChunk *pChunk = ((SysexChunk *) pEv->data.ext.ptr) - 1;
+	ATOMIC_SET(&pChunk->used, 0);
+
+	// Reclaim all contiguous released room, in arena order...
+	const unsigned int iHead = ATOMIC_GET(&m_iSysexHead);
+	unsigned int iTail = ATOMIC_GET(&m_iSysexTail);
+	while (iTail != iHead) {
+		pChunk = (SysexChunk *) &m_sysex[iTail % SysexSize];
+		if (ATOMIC_GET(&pChunk->used))
+			break;
+		iTail += pChunk->size;
+	}
+
+	ATOMIC_SET(&m_iSysexTail, int(iTail));
+}
+
+
+// Queued (scheduled) event buffering, time in frames
+// (MIDI output thread only).
+bool qtractorMidiJackPort::queued (
+	snd_seq_event_t *pEvent, unsigned long iTime, unsigned long iTimeOff )
+{
+	if (m_pJackPort == nullptr)
+		return false;
+
+	if (pEvent->type == SND_SEQ_EVENT_NOTE) {
+		snd_seq_event_t ev = *pEvent;
+		ev.type = SND_SEQ_EVENT_NOTEON;
+		if (!m_queuedBuffer.insert(&ev, iTime))
+			return false;
+		// Note-off must come strictly after its note-on...
+		if (iTimeOff <= iTime)
+			iTimeOff = iTime + 1;
+		ev.type = SND_SEQ_EVENT_NOTEOFF;
+		ev.data.note.velocity = 0;
+		ev.data.note.duration = 0;
+		return m_postedBuffer.insert(&ev, iTimeOff);
+	}
+
+	if (pEvent->type == SND_SEQ_EVENT_NOTEOFF)
+		return m_postedBuffer.insert(pEvent, iTime);
+
+	if (pEvent->type != SND_SEQ_EVENT_SYSEX)
+		return m_queuedBuffer.insert(pEvent, iTime);
+
+	// Take a private copy of (transient) SysEx data,
+	// never waiting for room in here...
+	QMutexLocker locker(&m_mutex);
+
+	snd_seq_event_t ev = *pEvent;
+	if (!reserve(&ev, 0))
+		return false;
+
+	if (m_queuedBuffer.insert(&ev, iTime))
+		return true;
+
+	// Not queued, give room back...
+	SysexChunk *pChunk = ((SysexChunk *) ev.data.ext.ptr) - 1;
+	ATOMIC_SET(&pChunk->used, 0);
+	return false;
+}
+
+
+// Drop all scheduled events, on next cycle (any thread).
+void qtractorMidiJackPort::reset (void)
+{
+	ATOMIC_SET(&m_resetPending, 1);
+}
+
+
+// Drop scheduled events of a track (tag) on next cycle,
+// leaving pending note-offs alone (any thread).
+void qtractorMidiJackPort::purge ( unsigned char tag )
+{
+	qtractorAtomic *pTags = &m_purgeTags[tag >> 5];
+	const int iMask = int(1U << (tag & 0x1f));
+
+	int iOldTags;
+	do {
+		iOldTags = ATOMIC_GET(pTags);
+	} while (!ATOMIC_CAS(pTags, iOldTags, iOldTags | iMask));
+
+	ATOMIC_SET(&m_purgePending, 1);
+}
+
+
+// Process cycle executive, time in frames (RT-safe).
+void qtractorMidiJackPort::process (
+	unsigned long iTimeStart, unsigned long iTimeEnd )
+{
+	if (m_pJackPort == nullptr)
+		return;
+
+	void *pPortBuffer
+		= jack_port_get_buffer(m_pJackPort, iTimeEnd - iTimeStart);
+	if (pPortBuffer == nullptr)
+		return;
+
+	jack_midi_clear_buffer(pPortBuffer);
+
+	// Drop all scheduled events, flush pending note-offs...
+	if (ATOMIC_TAZ(&m_resetPending)) {
+		snd_seq_event_t *pEv = m_queuedBuffer.pop();
+		while (pEv) {
+			release(pEv);
+			pEv = m_queuedBuffer.pop();
+		}
+		m_postedBuffer.reset(iTimeStart);
+	}
+
+	// Void scheduled events of purged tracks (tags);
+	// note-offs are posted apart, so they still go...
+	if (ATOMIC_TAZ(&m_purgePending)) {
+		unsigned int tags[8];
+		for (int i = 0; i < 8; ++i)
+			tags[i] = (unsigned int) ATOMIC_TAZ(&m_purgeTags[i]);
+		const unsigned int iCount = m_queuedBuffer.count();
+		for (unsigned int i = 0; i < iCount; ++i) {
+			snd_seq_event_t *pEv = m_queuedBuffer.at(i);
+			if (tags[pEv->tag >> 5] & (1U << (pEv->tag & 0x1f))) {
+				release(pEv);
+				pEv->type = SND_SEQ_EVENT_NONE;
+			}
+		}
+	}
+
+	// Direct events first...
+	snd_seq_event_t *pEv0 = m_directBuffer.pop();
+	while (pEv0) {
+		write(pPortBuffer, pEv0, 0);
+		release(pEv0);
+		pEv0 = m_directBuffer.pop();
+	}
+
+	// Queued/posted events, merged in time order;
+	// note-offs go first on the very same frame...
+	snd_seq_event_t *pEv1 = m_queuedBuffer.peek();
+	snd_seq_event_t *pEv2 = m_postedBuffer.peek();
+
+	while ((pEv1 && pEv1->time.tick < iTimeEnd)
+		|| (pEv2 && pEv2->time.tick < iTimeEnd)) {
+		if (pEv1 && pEv1->time.tick < iTimeEnd
+			&& (pEv2 == nullptr || pEv2->time.tick > pEv1->time.tick)) {
+			write(pPortBuffer, pEv1, (pEv1->time.tick > iTimeStart
+				? pEv1->time.tick - iTimeStart : 0));
+			release(pEv1);
+			pEv1 = m_queuedBuffer.next();
+		} else {
+			write(pPortBuffer, pEv2, (pEv2->time.tick > iTimeStart
+				? pEv2->time.tick - iTimeStart : 0));
+			pEv2 = m_postedBuffer.next();
+		}
+	}
+}
+
+
+// Clear all open port buffers, on cycles
+// not otherwise processed at all (RT-safe).
+void qtractorMidiJackPort::clearAll ( unsigned int nframes )
+{
+	ATOMIC_INC(&g_iClearAll);
+
+	for (int i = 0; i < QTRACTOR_MIDI_JACK_PORTS; ++i) {
+		qtractorMidiJackPort *pJackPort = g_apJackPorts[i].loadAcquire();
+		if (pJackPort == nullptr || pJackPort->m_pJackPort == nullptr)
+			continue;
+		void *pPortBuffer
+			= jack_port_get_buffer(pJackPort->m_pJackPort, nframes);
+		if (pPortBuffer)
+			jack_midi_clear_buffer(pPortBuffer);
+	}
+
+	ATOMIC_DEC(&g_iClearAll);
+}
+
+
+// Write an event into the port buffer (RT-safe).
+void qtractorMidiJackPort::write (
+	void *pPortBuffer, snd_seq_event_t *pEv, unsigned int iOffset )
+{
+	// Purged events are just voided...
+	if (pEv->type == SND_SEQ_EVENT_NONE)
+		return;
+
+	// SysEx goes out verbatim...
+	if (pEv->type == SND_SEQ_EVENT_SYSEX) {
+		jack_midi_event_write(pPortBuffer, iOffset,
+			(jack_midi_data_t *) pEv->data.ext.ptr, pEv->data.ext.len);
+		return;
+	}
+
+	unsigned char midiData[c_iMaxMidiData];
+	const long iMidiData = snd_midi_event_decode(m_pMidiDecoder,
+		midiData, sizeof(midiData), pEv);
+	if (iMidiData < 1)
+		return;
+
+	// Split into one JACK event per channel message...
+	long i = 0;
+	while (i < iMidiData) {
+		long j = i + 1;
+		while (j < iMidiData && (midiData[j] & 0x80) == 0)
+			++j;
+		jack_midi_event_write(pPortBuffer, iOffset, &midiData[i], j - i);
+		i = j;
+	}
+}
+
+
+// end of qtractorMidiJackPort.cpp
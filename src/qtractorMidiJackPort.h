@@ -0,0 +1,139 @@
+// qtractorMidiJackPort.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorMidiJackPort_h
+#define __qtractorMidiJackPort_h
+
+#include "qtractorMidiBuffer.h"
+#include "qtractorAtomic.h"
+
+#include <jack/jack.h>
+
+#include <QString>
+#include <QMutex>
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiJackPort -- JACK MIDI output port (in-process).
+//
+
+class qtractorMidiJackPort
+{
+public:
+
+	// Constructor.
+	qtractorMidiJackPort(
+		unsigned int iBufferSize = qtractorMidiBuffer::MinBufferSize);
+
+	// Destructor.
+	~qtractorMidiJackPort();
+
+	// Port (un)registration (non RT-safe);
+	// won't unregister unless still on the same client.
+	bool open(jack_client_t *pJackClient, const QString& sPortName);
+	void close(jack_client_t *pJackClient = nullptr);
+
+	// JACK port accessor.
+	jack_port_t *jackPort() const
+		{ return m_pJackPort; }
+
+	// Direct (immediate) event buffering (any non-RT thread);
+	// may wait a little for SysEx data room.
+	bool direct(snd_seq_event_t *pEvent);
+
+	// Queued (scheduled) event buffering, time in frames
+	// (MIDI output thread only).
+	bool queued(snd_seq_event_t *pEvent,
+		unsigned long iTime, unsigned long iTimeOff = 0);
+
+	// Drop all scheduled events, on next cycle (any thread).
+	void reset();
+
+	// Drop scheduled events of a track (tag) on next cycle,
+	// leaving pending note-offs alone (any thread).
+	void purge(unsigned char tag);
+
+	// Process cycle executive, time in frames (RT-safe).
+	void process(unsigned long iTimeStart, unsigned long iTimeEnd);
+
+	// Clear all open port buffers, on cycles
+	// not otherwise processed at all (RT-safe).
+	static void clearAll(unsigned int nframes);
+
+protected:
+
+	// Write an event into the port buffer (RT-safe).
+	void write(void *pPortBuffer, snd_seq_event_t *pEv, unsigned int iOffset);
+
+	// Take a private copy of (transient) SysEx data (any non-RT
+	// thread, serialized); may wait a little for data room.
+	bool reserve(snd_seq_event_t *pEv, int iRetries);
+
+	// Release SysEx data room, once consumed (RT-safe).
+	void release(snd_seq_event_t *pEv);
+
+	// SysEx data arena (ring-buffer) size.
+	enum { SysexSize = 0x10000 };
+
+	// SysEx data arena chunk header: chunks may be released
+	// in any order, room is reclaimed in arena order though.
+	struct SysexChunk
+	{
+		unsigned int   size;
+		qtractorAtomic used;
+	};
+
+private:
+
+	// Instance variables.
+	jack_client_t *m_pJackClient;
+	jack_port_t   *m_pJackPort;
+
+	qtractorMidiBuffer m_directBuffer;
+	qtractorMidiBuffer m_queuedBuffer;
+	qtractorMidiBuffer m_postedBuffer;
+
+	// Sequencer event to raw MIDI decoder.
+	snd_midi_event_t *m_pMidiDecoder;
+
+	// SysEx data copies (transient sources), as chunks
+	// reserved by producers, released by the consumer;
+	// both free-running byte counters.
+	alignas(SysexChunk) unsigned char m_sysex[SysexSize];
+	qtractorAtomic m_iSysexHead;
+	qtractorAtomic m_iSysexTail;
+
+	// Event producers serialization (SysEx data room).
+	QMutex m_mutex;
+
+	// Pending reset request.
+	qtractorAtomic m_resetPending;
+
+	// Pending purge requests (tag bitmap).
+	qtractorAtomic m_purgeTags[8];
+	qtractorAtomic m_purgePending;
+};
+
+
+#endif  // __qtractorMidiJackPort_h
+
+
+// end of qtractorMidiJackPort.h
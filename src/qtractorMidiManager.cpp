@@ -23,6 +23,7 @@
 
 #include "qtractorSession.h"
 #include "qtractorSessionCursor.h"
+#include "qtractorSessionSnapshot.h"
 #include "qtractorPlugin.h"
 
 #include "qtractorMidiEngine.h"
@@ -585,6 +586,8 @@ void qtractorMidiManager::clear (void)
 void qtractorMidiManager::process (
 	unsigned long iTimeStart, unsigned long iTimeEnd )
 {
+	const unsigned long long t0 = qtractorDspLoad::start();
+
 	clear();
 
 	// Address the MIDI input buffer this way...
@@ -668,12 +671,21 @@ void qtractorMidiManager::process (
 			m_pAudioOutputBus->buffer_commit(nframes);
 		}
 	}
+
+	m_dspProbe.add(t0);
 }
 
 
 // Process buffers (in asynchronous controller thread).
 void qtractorMidiManager::processSync (void)
 {
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return;
+
+	// Plugin chain render snapshot read-side sections...
+	qtractorSessionEpoch *pEpoch = pSession->epoch();
+
 	// Check for programn change...
 	if (m_iPendingProg >= 0) {
 		m_iCurrentBank = 0;
@@ -687,11 +699,12 @@ void qtractorMidiManager::processSync (void)
 		else if (m_iPendingBankMSB >= 0)
 			m_iCurrentBank = m_iPendingBankMSB;
 		// Make the change (should be RT safe...)
-		qtractorPlugin *pPlugin = m_pPluginList->first();
-		while (pPlugin) {
-			pPlugin->selectProgram(m_iCurrentBank, m_iCurrentProg);
-			pPlugin = pPlugin->next();
-		}
+		const unsigned int iEpoch = pEpoch->enter();
+		qtractorSessionChain *pChain = m_pPluginList->chain();
+		const unsigned int iPlugins = (pChain ? pChain->plugins() : 0);
+		for (unsigned int i = 0; i < iPlugins; ++i)
+			pChain->plugin(i)->selectProgram(m_iCurrentBank, m_iCurrentProg);
+		pEpoch->leave(iEpoch);
 		// Reset pending status.
 		m_iPendingBankMSB = -1;
 		m_iPendingBankLSB = -1;
@@ -703,13 +716,15 @@ void qtractorMidiManager::processSync (void)
 	snd_seq_event_t *pEv = m_controllerBuffer.peek();
 	while (pEv) {
 		if (pEv->type == SND_SEQ_EVENT_CONTROLLER) {
-			qtractorPlugin *pPlugin = m_pPluginList->first();
-			while (pPlugin) {
-				pPlugin->setController(
+			const unsigned int iEpoch = pEpoch->enter();
+			qtractorSessionChain *pChain = m_pPluginList->chain();
+			const unsigned int iPlugins = (pChain ? pChain->plugins() : 0);
+			for (unsigned int i = 0; i < iPlugins; ++i) {
+				pChain->plugin(i)->setController(
 					pEv->data.control.param,
 					pEv->data.control.value);
-				pPlugin = pPlugin->next();
 			}
+			pEpoch->leave(iEpoch);
 		}
 		pEv = m_controllerBuffer.next();
 	}
@@ -24,6 +24,7 @@
 
 #include "qtractorAbout.h"
 #include "qtractorMidiBuffer.h"
+#include "qtractorDspLoad.h"
 
 #ifdef CONFIG_VST2
 #include "qtractorVst2Plugin.h"
@@ -320,6 +321,10 @@ public:
 	qtractorAudioOutputMonitor *audioOutputMonitor() const
 		{ return m_pAudioOutputMonitor; }
 
+	// DSP time probe (instrumentation).
+	qtractorDspProbe& dspProbe()
+		{ return m_dspProbe; }
+
 	// Current bank selection accessors.
 	void setCurrentBank(int iBank)
 		{ m_iCurrentBank = iBank; }
@@ -430,6 +435,8 @@ private:
 
 	qtractorAudioOutputMonitor *m_pAudioOutputMonitor;
 
+	qtractorDspProbe m_dspProbe;
+
 	int m_iCurrentBank;
 	int m_iCurrentProg;
 
@@ -42,6 +42,10 @@ qtractorMidiSequence::qtractorMidiSequence ( const QString& sName,
 	m_noteMax = 0;
 	m_noteMin = 0;
 
+	m_iSerial = 0;
+
+	m_pPacked = nullptr;
+
 	clear();
 }
 
@@ -49,6 +53,10 @@ qtractorMidiSequence::qtractorMidiSequence ( const QString& sName,
 // Destructor.
 qtractorMidiSequence::~qtractorMidiSequence (void)
 {
+	qtractorMidiPacked *pPacked = m_pPacked.fetchAndStoreOrdered(nullptr);
+	if (pPacked)
+		delete pPacked;
+
 	clear();
 }
 
@@ -65,9 +73,14 @@ void qtractorMidiSequence::clear (void)
 //	m_noteMin = 0;
 
 	m_duration = 0;
+	m_durationMax = 0;
 
 	m_events.clear();
 	m_notes.clear();
+
+	m_index.clear();
+
+	++m_iSerial;
 }
 
 
@@ -98,7 +111,10 @@ void qtractorMidiSequence::addEvent ( qtractorMidiEvent *pEvent )
 			} else {
 				pNoteEvent->setDuration(m_duration - t1);
 			}
+			if (m_durationMax < pNoteEvent->duration())
+				m_durationMax = pNoteEvent->duration();
 			m_notes.erase(iter_last);
+			++m_iSerial;
 		}
 		// NOTEOFF: Won't own this any longer...
 		delete pEvent;
@@ -126,9 +142,17 @@ void qtractorMidiSequence::addEvent ( qtractorMidiEvent *pEvent )
 void qtractorMidiSequence::insertEvent ( qtractorMidiEvent *pEvent )
 {
 	// Find the proper position in time sequence...
+	const unsigned long iTime0 = pEvent->time();
 	qtractorMidiEvent *pEventAfter = m_events.last();
-	while (pEventAfter && pEventAfter->time() > pEvent->time())
-		pEventAfter = pEventAfter->prev();
+	int iBlock = m_index.count() - 1;
+	if (pEventAfter && pEventAfter->time() > iTime0) {
+		// Not an append: look it up on the time index...
+		iBlock = findBlock(iTime0, false);
+		pEventAfter = (iBlock < 0 ? nullptr : m_index.at(iBlock).first);
+		while (pEventAfter && pEventAfter->next()
+			&& (pEventAfter->next())->time() <= iTime0)
+			pEventAfter = pEventAfter->next();
+	}
 
 	// Insert it...
 	if (pEventAfter)
@@ -136,6 +160,8 @@ void qtractorMidiSequence::insertEvent ( qtractorMidiEvent *pEvent )
 	else
 		m_events.prepend(pEvent);
 
+	insertIndex(pEvent, iBlock);
+
 	unsigned long iTime = pEvent->time();
 	// NOTEON: Keep note stats and make it pending on a NOTEOFF...
 	if (pEvent->type() == qtractorMidiEvent::NOTEON) {
@@ -144,24 +170,36 @@ void qtractorMidiSequence::insertEvent ( qtractorMidiEvent *pEvent )
 			m_noteMin = note;
 		if (m_noteMax < note || m_noteMax == 0)
 			m_noteMax = note;
+		if (m_durationMax < pEvent->duration())
+			m_durationMax = pEvent->duration();
 		iTime += pEvent->duration();
 	}
 	if (m_duration < iTime)
 		m_duration = iTime;
+
+	++m_iSerial;
 }
 
 
 // Unlink event from a channel sequence.
 void qtractorMidiSequence::unlinkEvent ( qtractorMidiEvent *pEvent )
 {
+	unlinkIndex(pEvent);
+
 	m_events.unlink(pEvent);
+
+	++m_iSerial;
 }
 
 
 // Remove event from a channel sequence.
 void qtractorMidiSequence::removeEvent ( qtractorMidiEvent *pEvent )
 {
+	unlinkIndex(pEvent);
+
 	m_events.remove(pEvent);
+
+	++m_iSerial;
 }
 
 
@@ -180,10 +218,14 @@ void qtractorMidiSequence::close (void)
 	for ( ; iter != iter_end; ++iter) {
 		qtractorMidiEvent *pEvent = *iter;
 		pEvent->setDuration(m_duration - pEvent->time());
+		if (m_durationMax < pEvent->duration())
+			m_durationMax = pEvent->duration();
 	}
 
 	// Reset all pending notes.
 	m_notes.clear();
+
+	++m_iSerial;
 }
 
 
@@ -237,6 +279,7 @@ void qtractorMidiSequence::copyEvents ( qtractorMidiSequence *pSeq )
 {
 	// Remove existing events.
 	m_events.clear();
+	m_index.clear();
 
 	const unsigned short iTicksPerBeat = pSeq->ticksPerBeat();
 
@@ -247,10 +290,251 @@ void qtractorMidiSequence::copyEvents ( qtractorMidiSequence *pSeq )
 		pNewEvent->setTime(timeq(pEvent->time(), iTicksPerBeat));
 		if (pEvent->type() == qtractorMidiEvent::NOTEON)
 			pNewEvent->setDuration(timeq(pEvent->duration(), iTicksPerBeat));
+		if (pEvent->type() == qtractorMidiEvent::NOTEON
+			&& m_durationMax < pNewEvent->duration())
+			m_durationMax = pNewEvent->duration();
 		m_events.append(pNewEvent);
 	}
+
+	updateIndex();
+
+	++m_iSerial;
 	// Done.
 }
 
 
+// Compact playback form (re)builder, only when stale;
+// returns the old form, if replaced (non RT-safe).
+qtractorMidiPacked *qtractorMidiSequence::updatePacked (void)
+{
+	qtractorMidiPacked *pPacked = m_pPacked.loadAcquire();
+	if (pPacked && pPacked->serial() == m_iSerial)
+		return nullptr;
+
+	return m_pPacked.fetchAndStoreOrdered(new qtractorMidiPacked(this));
+}
+
+
+// Indexed time seek: last event before given time, if any.
+qtractorMidiEvent *qtractorMidiSequence::seekEvent ( unsigned long iTime ) const
+{
+	const int iBlock = findBlock(iTime, true);
+	if (iBlock < 0)
+		return nullptr;
+
+	qtractorMidiEvent *pEvent = m_index.at(iBlock).first;
+	while (pEvent && pEvent->next() && (pEvent->next())->time() < iTime)
+		pEvent = pEvent->next();
+
+	return pEvent;
+}
+
+
+// Time index block lookup (binary search): last block whose
+// first event time is before (strict) or at the given time.
+int qtractorMidiSequence::findBlock ( unsigned long iTime, bool bStrict ) const
+{
+	int lo = 0;
+	int hi = m_index.count();
+	while (lo < hi) {
+		const int mid = (lo + hi) >> 1;
+		const unsigned long t = m_index.at(mid).first->time();
+		if (bStrict ? t < iTime : t <= iTime)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo - 1;
+}
+
+
+// Time index maintenance: account for a newly inserted event,
+// where the given block is the one it was inserted into (or before).
+void qtractorMidiSequence::insertIndex ( qtractorMidiEvent *pEvent, int iBlock )
+{
+	if (m_index.isEmpty()) {
+		Block block;
+		block.first = pEvent;
+		block.count = 1;
+		m_index.append(block);
+		return;
+	}
+
+	if (iBlock < 0) {
+		// Prepended, new head of first block...
+		iBlock = 0;
+		m_index[iBlock].first = pEvent;
+	}
+
+	if (++m_index[iBlock].count >= 2 * BlockSize)
+		splitBlock(iBlock);
+}
+
+
+// Time index maintenance: account for an event about to be unlinked.
+void qtractorMidiSequence::unlinkIndex ( qtractorMidiEvent *pEvent )
+{
+	const int iBlocks = m_index.count();
+	int iBlock = findBlock(pEvent->time(), true);
+	if (iBlock < 0)
+		iBlock = 0;
+
+	// Locate the event on its own block...
+	qtractorMidiEvent *pNext = (iBlock < iBlocks
+		? m_index.at(iBlock).first : nullptr);
+	while (pNext && pNext != pEvent) {
+		pNext = pNext->next();
+		if (iBlock + 1 < iBlocks && pNext == m_index.at(iBlock + 1).first)
+			++iBlock;
+	}
+
+	// Not found? Should never happen, but then...
+	if (pNext == nullptr) {
+		updateIndex(pEvent);
+		return;
+	}
+
+	Block& block = m_index[iBlock];
+	if (--block.count < 1)
+		m_index.remove(iBlock);
+	else
+	if (block.first == pEvent)
+		block.first = pEvent->next();
+}
+
+
+// Time index maintenance: split an overgrown block in halves.
+void qtractorMidiSequence::splitBlock ( int iBlock )
+{
+	Block block;
+	block.first = m_index.at(iBlock).first;
+	for (unsigned int i = 0; i < BlockSize && block.first; ++i)
+		block.first = block.first->next();
+	if (block.first == nullptr)
+		return;
+
+	block.count = m_index.at(iBlock).count - BlockSize;
+	m_index[iBlock].count = BlockSize;
+	m_index.insert(iBlock + 1, block);
+}
+
+
+// Time index maintenance: rebuild it all from scratch
+// (optionally leaving out an event about to be unlinked).
+void qtractorMidiSequence::updateIndex ( qtractorMidiEvent *pExclude )
+{
+	m_index.clear();
+
+	Block block;
+	block.first = nullptr;
+	block.count = 0;
+
+	qtractorMidiEvent *pEvent = m_events.first();
+	for ( ; pEvent; pEvent = pEvent->next()) {
+		if (pEvent == pExclude)
+			continue;
+		if (block.count == 0)
+			block.first = pEvent;
+		if (++block.count >= BlockSize) {
+			m_index.append(block);
+			block.count = 0;
+		}
+	}
+
+	if (block.count > 0)
+		m_index.append(block);
+}
+
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiPacked -- Compact MIDI sequence playback form.
+//
+
+// Constructor (immutable snapshot of a sequence).
+qtractorMidiPacked::qtractorMidiPacked ( qtractorMidiSequence *pSeq )
+{
+	m_iSerial = pSeq->serial();
+	m_iCount  = pSeq->events().count();
+
+	m_pTimes     = new unsigned long [m_iCount];
+	m_pTypes     = new unsigned char [m_iCount];
+	m_pParams    = new unsigned short [m_iCount];
+	m_pValues    = new unsigned short [m_iCount];
+	m_pDurations = new unsigned long [m_iCount];
+	m_ppSysex    = new qtractorMidiEvent * [m_iCount];
+
+	unsigned int i = 0;
+	qtractorMidiEvent *pEvent = pSeq->events().first();
+	for ( ; pEvent && i < m_iCount; pEvent = pEvent->next(), ++i) {
+		const qtractorMidiEvent::EventType etype = pEvent->type();
+		m_pTimes[i] = pEvent->time();
+		m_pTypes[i] = (unsigned char) etype;
+		if (etype == qtractorMidiEvent::SYSEX) {
+			m_pParams[i]    = 0;
+			m_pValues[i]    = 0;
+			m_pDurations[i] = 0;
+			// Original might be gone before we do...
+			m_ppSysex[i]    = new qtractorMidiEvent(*pEvent);
+		} else {
+			m_pParams[i]    = pEvent->param();
+			m_pValues[i]    = pEvent->value();
+			m_pDurations[i] = pEvent->duration();
+			m_ppSysex[i]    = nullptr;
+		}
+	}
+
+	m_iCount = i;
+}
+
+
+// Destructor.
+qtractorMidiPacked::~qtractorMidiPacked (void)
+{
+	for (unsigned int i = 0; i < m_iCount; ++i) {
+		if (m_ppSysex[i])
+			delete m_ppSysex[i];
+	}
+
+	delete [] m_ppSysex;
+	delete [] m_pDurations;
+	delete [] m_pValues;
+	delete [] m_pParams;
+	delete [] m_pTypes;
+	delete [] m_pTimes;
+}
+
+
+// Index of first event at or after given time,
+// searching forward from given hint, if any.
+unsigned int qtractorMidiPacked::seek (
+	unsigned long iTime, unsigned int iHint ) const
+{
+	unsigned int lo = 0;
+	unsigned int hi = m_iCount;
+
+	// Hint still good? Try a few steps forward...
+	if (iHint > 0 && iHint <= m_iCount && m_pTimes[iHint - 1] < iTime) {
+		unsigned int i = iHint;
+		for (unsigned int n = 0; n < 8 && i < m_iCount; ++n, ++i) {
+			if (m_pTimes[i] >= iTime)
+				return i;
+		}
+		lo = i;
+	}
+
+	// Binary search (lower bound)...
+	while (lo < hi) {
+		const unsigned int mid = (lo + hi) >> 1;
+		if (m_pTimes[mid] < iTime)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+
 // end of qtractorMidiSequence.cpp
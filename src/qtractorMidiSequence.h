@@ -26,11 +26,17 @@
 
 #include <QString>
 #include <QMultiHash>
+#include <QVector>
+#include <QAtomicPointer>
 
 // typedef unsigned long long uint64_t;
 #include <stdint.h>
 
 
+// Forward declarations.
+class qtractorMidiPacked;
+
+
 //----------------------------------------------------------------------
 // class qtractorMidiSequence -- The generic MIDI event sequence buffer.
 //
@@ -98,15 +104,34 @@ public:
 	unsigned char noteMin() const { return m_noteMin;  }
 	unsigned char noteMax() const { return m_noteMax;  }
 
+	// Longest note duration ever seen (an upper bound).
+	unsigned long durationMax() const { return m_durationMax; }
+
 	// Event list accessor.
 	const qtractorList<qtractorMidiEvent>& events() const { return m_events; }
 
+	// Event list change serial number.
+	unsigned int serial() const { return m_iSerial; }
+
 	// Event list management methods.
 	void addEvent    (qtractorMidiEvent *pEvent);
 	void insertEvent (qtractorMidiEvent *pEvent);
 	void unlinkEvent (qtractorMidiEvent *pEvent);
 	void removeEvent (qtractorMidiEvent *pEvent);
 
+	// Indexed time seek: last event before given time, if any.
+	qtractorMidiEvent *seekEvent(unsigned long iTime) const;
+
+	// Compact playback form accessor (RT-safe);
+	// might be null, or stale if not as of serial(),
+	// though always safe to play, being self-contained.
+	qtractorMidiPacked *packed() const
+		{ return m_pPacked.loadAcquire(); }
+
+	// Compact playback form (re)builder, only when stale;
+	// returns the old form, if replaced (non RT-safe).
+	qtractorMidiPacked *updatePacked();
+
 	// Adjust time resolutions (64bit).
 	unsigned long timep(unsigned long iTime, unsigned short p) const
 		{ return uint64_t(iTime) * p / m_iTicksPerBeat; }
@@ -126,6 +151,17 @@ public:
 	// Typed hash table to track note-ons.
 	typedef QMultiHash<unsigned char, qtractorMidiEvent *> NoteMap;
 
+protected:
+
+	// Time index block lookup (last block starting before/at time).
+	int findBlock(unsigned long iTime, bool bStrict) const;
+
+	// Time index maintenance.
+	void insertIndex(qtractorMidiEvent *pEvent, int iBlock);
+	void unlinkIndex(qtractorMidiEvent *pEvent);
+	void splitBlock(int iBlock);
+	void updateIndex(qtractorMidiEvent *pExclude = nullptr);
+
 private:
 
 	// Sequence/track properties.
@@ -146,12 +182,87 @@ private:
 	unsigned char  m_noteMin;
 	unsigned char  m_noteMax;
 	unsigned long  m_duration;
+	unsigned long  m_durationMax;
 
 	// Sequence instance event list (all same MIDI channel).
 	qtractorList<qtractorMidiEvent> m_events;
 
+	// Event list change serial number.
+	unsigned int   m_iSerial;
+
+	// Sparse time index: consecutive event list blocks,
+	// each starting on its first event, in time order.
+	struct Block
+	{
+		qtractorMidiEvent *first;
+		unsigned int       count;
+	};
+
+	enum { BlockSize = 64 };
+
+	QVector<Block> m_index;
+
 	// Local hash table to track note-ons.
 	NoteMap m_notes;
+
+	// Compact playback form.
+	QAtomicPointer<qtractorMidiPacked> m_pPacked;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiPacked -- Compact MIDI sequence playback form.
+//
+
+class qtractorMidiPacked
+{
+public:
+
+	// Constructor (immutable snapshot of a sequence).
+	qtractorMidiPacked(qtractorMidiSequence *pSeq);
+
+	// Destructor.
+	~qtractorMidiPacked();
+
+	// Sequence serial number, as of this snapshot.
+	unsigned int serial() const { return m_iSerial; }
+
+	// Number of events.
+	unsigned int count() const { return m_iCount; }
+
+	// Packed event accessors.
+	unsigned long time(unsigned int i) const
+		{ return m_pTimes[i]; }
+	qtractorMidiEvent::EventType type(unsigned int i) const
+		{ return qtractorMidiEvent::EventType(m_pTypes[i]); }
+	unsigned short param(unsigned int i) const
+		{ return m_pParams[i]; }
+	unsigned short value(unsigned int i) const
+		{ return m_pValues[i]; }
+	unsigned long duration(unsigned int i) const
+		{ return m_pDurations[i]; }
+
+	// Own copy of a SysEx event (null otherwise).
+	qtractorMidiEvent *sysex(unsigned int i) const
+		{ return m_ppSysex[i]; }
+
+	// Index of first event at or after given time,
+	// searching forward from given hint, if any.
+	unsigned int seek(unsigned long iTime, unsigned int iHint = 0) const;
+
+private:
+
+	// Instance variables.
+	unsigned int        m_iSerial;
+	unsigned int        m_iCount;
+
+	// Packed event arrays.
+	unsigned long      *m_pTimes;
+	unsigned char      *m_pTypes;
+	unsigned short     *m_pParams;
+	unsigned short     *m_pValues;
+	unsigned long      *m_pDurations;
+	qtractorMidiEvent **m_ppSysex;
 };
 
 
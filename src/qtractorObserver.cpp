@@ -22,6 +22,8 @@
 #include "qtractorAbout.h"
 #include "qtractorObserver.h"
 
+#include "qtractorAtomic.h"
+
 
 //---------------------------------------------------------------------------
 // qtractorSubjectQueue - Update/notify subject queue.
@@ -39,7 +41,7 @@ public:
 
 	qtractorSubjectQueue ( unsigned int iQueueSize = 1024 )
 		: m_iQueueIndex(0), m_iQueueSize(0), m_pQueueItems(nullptr)
-		{ resize(iQueueSize); }
+		{ ATOMIC_SET(&m_lock, 0); resize(iQueueSize); }
 
 	~qtractorSubjectQueue ()
 		{ clear(); delete [] m_pQueueItems; }
@@ -47,25 +49,34 @@ public:
 	void clear()
 		{ m_iQueueIndex = 0; }
 
+	// May be pushed from concurrent (RT) graph worker threads.
 	bool push ( qtractorSubject *pSubject, qtractorObserver *pSender, float fValue )
 	{
-		if (m_iQueueIndex >= m_iQueueSize)
+		lock();
+		if (m_iQueueIndex >= m_iQueueSize) {
+			unlock();
 			return false;
+		}
 		pSubject->setQueued(true);
 		QueueItem *pItem = &m_pQueueItems[m_iQueueIndex++];
 		pItem->subject = pSubject;
 		pItem->sender  = pSender;
 		pItem->value   = fValue;
+		unlock();
 		return true;
 	}
 
 	bool pop (bool bUpdate)
 	{
-		if (m_iQueueIndex == 0)
+		lock();
+		if (m_iQueueIndex == 0) {
+			unlock();
 			return false;
-		QueueItem *pItem = &m_pQueueItems[--m_iQueueIndex];
-		qtractorSubject *pSubject = pItem->subject;
-		pSubject->notify(pItem->sender, pItem->value, bUpdate);
+		}
+		const QueueItem item = m_pQueueItems[--m_iQueueIndex];
+		unlock();
+		qtractorSubject *pSubject = item.subject;
+		pSubject->notify(item.sender, item.value, bUpdate);
 		pSubject->setQueued(false);
 		return true;
 	}
@@ -106,9 +117,15 @@ public:
 
 private:
 
+	// Spin-lock helpers.
+	void lock()   { while (!ATOMIC_TAS(&m_lock)) /* spin */; }
+	void unlock() { ATOMIC_TAZ(&m_lock); }
+
 	unsigned int m_iQueueIndex;
 	unsigned int m_iQueueSize;
 	QueueItem   *m_pQueueItems;
+
+	qtractorAtomic m_lock;
 };
 
 
@@ -152,6 +152,7 @@ void qtractorOptions::loadOptions (void)
 	iAudioExportType     = m_settings.value("/ExportType", -1).toInt();
 	iAudioExportFormat   = m_settings.value("/ExportFormat", -1).toInt();
 	iAudioExportQuality  = m_settings.value("/ExportQuality", -1).toInt();
+	iAudioExportMode     = m_settings.value("/ExportMode", 0).toInt();
 	iAudioResampleType   = m_settings.value("/ResampleType", 2).toInt();
 	bAudioAutoTimeStretch = m_settings.value("/AutoTimeStretch", false).toBool();
 	bAudioWsolaTimeStretch = m_settings.value("/WsolaTimeStretch", true).toBool();
@@ -163,6 +164,10 @@ void qtractorOptions::loadOptions (void)
 	bAudioPlayerAutoConnect = m_settings.value("/PlayerAutoConnect", true).toBool();
 	bAudioMetroAutoConnect = m_settings.value("/MetroAutoConnect", true).toBool();
 	iAudioMetroOffset  = (unsigned long) m_settings.value("/MetroOffset", 0).toUInt();
+	iAudioProcessWorkers = m_settings.value("/ProcessWorkers", -1).toInt();
+	bAudioPreload        = m_settings.value("/Preload", false).toBool();
+	iAudioPreloadBudget  = m_settings.value("/PreloadBudget", 2048).toInt();
+	bAudioExportOffline  = m_settings.value("/ExportOffline", true).toBool();
 	m_settings.endGroup();
 
 	// MIDI rendering options group.
@@ -264,13 +269,10 @@ void qtractorOptions::loadOptions (void)
 	bOpenEditor = m_settings.value("/OpenEditor", true).toBool();
 	bQueryEditorType = m_settings.value("/QueryEditorType", false).toBool();
 	bDummyPluginScan = true;//m_settings.value("/DummyPluginScan", true).toBool();
-	iDummyLadspaHash = m_settings.value("/DummyLadspaHash", 0).toInt();
-	iDummyDssiHash = m_settings.value("/DummyDssiHash", 0).toInt();
-	iDummyVst2Hash = m_settings.value("/DummyVst2Hash", 0).toInt();
-	iDummyVst3Hash = m_settings.value("/DummyVst3Hash", 0).toInt();
-	iDummyClapHash = m_settings.value("/DummyClapHash", 0).toInt();
 	iDummyLv2Hash = m_settings.value("/DummyLv2Hash", 0).toInt();
 	bLv2DynManifest = false;//m_settings.value("/Lv2DynManifest", false).toBool();
+	bSilenceBypass = m_settings.value("/SilenceBypass", false).toBool();
+	fSilenceHold = m_settings.value("/SilenceHold", 10.0f).toFloat();
 	bSaveCurve14bit = true;//m_settings.value("/SaveCurve14bit", false).toBool();
 	m_settings.endGroup();
 
@@ -462,6 +464,7 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/ExportType", iAudioExportType);
 	m_settings.setValue("/ExportFormat", iAudioExportFormat);
 	m_settings.setValue("/ExportQuality", iAudioExportQuality);
+	m_settings.setValue("/ExportMode", iAudioExportMode);
 	m_settings.setValue("/ResampleType", iAudioResampleType);
 	m_settings.setValue("/AutoTimeStretch", bAudioAutoTimeStretch);
 	m_settings.setValue("/WsolaTimeStretch", bAudioWsolaTimeStretch);
@@ -473,6 +476,10 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/PlayerAutoConnect", bAudioPlayerAutoConnect);
 	m_settings.setValue("/MetroAutoConnect", bAudioMetroAutoConnect);
 	m_settings.setValue("/MetroOffset", uint(iAudioMetroOffset));
+	m_settings.setValue("/ProcessWorkers", iAudioProcessWorkers);
+	m_settings.setValue("/Preload", bAudioPreload);
+	m_settings.setValue("/PreloadBudget", iAudioPreloadBudget);
+	m_settings.setValue("/ExportOffline", bAudioExportOffline);
 	m_settings.endGroup();
 
 	// MIDI rendering options group.
@@ -574,13 +581,10 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/OpenEditor", bOpenEditor);
 	m_settings.setValue("/QueryEditorType", bQueryEditorType);
 	m_settings.setValue("/DummyPluginScan", bDummyPluginScan);
-	m_settings.setValue("/DummyLadspaHash", iDummyLadspaHash);
-	m_settings.setValue("/DummyDssiHash", iDummyDssiHash);
-	m_settings.setValue("/DummyVst2Hash", iDummyVst2Hash);
-	m_settings.setValue("/DummyVst3Hash", iDummyVst3Hash);
-	m_settings.setValue("/DummyClapHash", iDummyClapHash);
 	m_settings.setValue("/DummyLv2Hash", iDummyLv2Hash);
 	m_settings.setValue("/Lv2DynManifest", bLv2DynManifest);
+	m_settings.setValue("/SilenceBypass", bSilenceBypass);
+	m_settings.setValue("/SilenceHold", fSilenceHold);
 	m_settings.setValue("/SaveCurve14bit", bSaveCurve14bit);
 	m_settings.endGroup();
 
@@ -114,6 +114,7 @@ public:
 	int     iAudioExportType;
 	int     iAudioExportFormat;
 	int     iAudioExportQuality;
+	int     iAudioExportMode;
 	int     iAudioResampleType;
 	bool    bAudioAutoTimeStretch;
 	bool    bAudioWsolaTimeStretch;
@@ -126,6 +127,16 @@ public:
 	bool    bAudioPlayerAutoConnect;
 	bool    bAudioMetroAutoConnect;
 
+	// Audio track parallel process workers (-1=auto, 0=none).
+	int     iAudioProcessWorkers;
+
+	// Audio whole-file preload cache (budget in MB).
+	bool    bAudioPreload;
+	int     iAudioPreloadBudget;
+
+	// Audio export offline (non-freewheeling) mode.
+	bool    bAudioExportOffline;
+
 	// Audio metronome latency offset compensation.
 	unsigned long iAudioMetroOffset;
 
@@ -247,18 +258,18 @@ public:
 	// when more than one is available.
 	bool bQueryEditorType;
 
-	// Out-of-process plugin scanning and cache option.
+	// Out-of-process plugin scanning and cache option;
+	// file-based plugins are cached by file size and mtime.
 	bool bDummyPluginScan;
-	int  iDummyLadspaHash;
-	int  iDummyDssiHash;
-	int  iDummyVst2Hash;
-	int  iDummyVst3Hash;
-	int  iDummyClapHash;
 	int  iDummyLv2Hash;
 
 	// LV2 plugin specific options.
 	bool bLv2DynManifest;
 
+	// Plug-in chain silence auto-bypass options.
+	bool  bSilenceBypass;
+	float fSilenceHold;
+
 	// Automation preferred resolution (14bit).
 	bool bSaveCurve14bit;
 
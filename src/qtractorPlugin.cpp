@@ -27,12 +27,14 @@
 #include "qtractorPluginForm.h"
 
 #include "qtractorAudioEngine.h"
+#include "qtractorAudioGraph.h"
 #include "qtractorMidiManager.h"
 
 #include "qtractorMainForm.h"
 #include "qtractorOptions.h"
 
 #include "qtractorSession.h"
+#include "qtractorSessionSnapshot.h"
 #include "qtractorCurveFile.h"
 
 #include "qtractorMessageList.h"
@@ -251,7 +253,9 @@ qtractorPlugin::qtractorPlugin (
 		m_bActivated(false), m_bAutoDeactivated(false),
 		m_activateObserver(this),
 		m_iActivateSubjectIndex(0), m_pForm(nullptr), m_iEditorType(-1),
-		m_iDirectAccessParamIndex(-1)
+		m_iDirectAccessParamIndex(-1), m_iSilenceIn(0), m_iSilenceOut(0),
+		m_bSilenceBypass(false), m_bCanSilenceBypass(false),
+		m_iSilenceTail(TailUnknown)
 {
 	// Acquire a local unique id in chain...
 	if (m_pList && m_pType)
@@ -297,6 +301,93 @@ void qtractorPlugin::setInstances ( unsigned short iInstances )
 }
 
 
+// Whether this plugin may be skipped on silence,
+// caching its declared tail too (non RT-safe).
+void qtractorPlugin::updateSilenceBypass (void)
+{
+	m_bCanSilenceBypass = false;
+	m_iSilenceTail = TailUnknown;
+
+	resetSilence();
+
+	// Inserts and aux-sends do their own bus business,
+	// instruments and generators do play from silence...
+	const qtractorPluginType::Hint typeHint = m_pType->typeHint();
+	if (typeHint == qtractorPluginType::Insert ||
+		typeHint == qtractorPluginType::AuxSend)
+		return;
+
+	if (midiIns() > 0 || audioIns() < 1)
+		return;
+
+	const long iTail = tail();
+	if (iTail == TailInfinite)
+		return;
+
+	m_iSilenceTail = iTail;
+	m_bCanSilenceBypass = true;
+}
+
+
+// Silence auto-bypass state reset (RT-safe).
+void qtractorPlugin::resetSilence (void)
+{
+	m_iSilenceIn  = 0;
+	m_iSilenceOut = 0;
+
+	m_bSilenceBypass = false;
+}
+
+
+// Silence auto-bypass tracking, given the input
+// has been silent all along this cycle (RT-safe).
+void qtractorPlugin::updateSilence (
+	bool bSilent, unsigned int nframes, unsigned long iHold )
+{
+	if (!m_bCanSilenceBypass)
+		return;
+
+	m_iSilenceIn += nframes;
+
+	if (bSilent)
+		m_iSilenceOut += nframes;
+	else
+		m_iSilenceOut = 0;
+
+	// Output must be silent now, and for long enough:
+	// either past the declared tail or the measure hold...
+	if (m_iSilenceOut > 0) {
+		if (m_iSilenceTail > 0)
+			m_bSilenceBypass = (m_iSilenceIn >= latency() + m_iSilenceTail);
+		else
+			m_bSilenceBypass = (m_iSilenceOut >= latency() + iHold);
+	}
+}
+
+
+// Run all instances, possibly in parallel (RT-safe).
+void qtractorPlugin::process_instances ( unsigned int nframes )
+{
+	const unsigned short iInstances = instances();
+
+	qtractorAudioGraph *pAudioGraph = nullptr;
+	if (iInstances > 1) {
+		qtractorSession *pSession = qtractorSession::getInstance();
+		qtractorAudioEngine *pAudioEngine
+			= (pSession ? pSession->audioEngine() : nullptr);
+		if (pAudioEngine)
+			pAudioGraph = pAudioEngine->audioGraph();
+	}
+
+	if (pAudioGraph) {
+		pAudioGraph->process_instances(this, iInstances, nframes);
+	} else {
+		for (unsigned short i = 0; i < iInstances; ++i)
+			process_instance(i, nframes);
+	}
+}
+
+
 // Activation methods.
 
 // immediate
@@ -341,6 +432,7 @@ void qtractorPlugin::autoDeactivatePlugin ( bool bDeactivated )
 		// reactivate?
 		else if (m_bActivated) {
 			activate();
+			updateSilenceBypass();
 			if (m_pList)
 				m_pList->updateActivated(true);
 		}
@@ -367,10 +459,12 @@ void qtractorPlugin::updateActivated ( bool bActivated )
 		// without connections to other tracks (Inserts/AuxSends)
 		// otherwise user could (de)activate plugin without getting feedback
 		if (!m_bAutoDeactivated || bIsConnectedToOtherTracks) {
-			if (bActivated)
+			if (bActivated) {
 				activate();
-			else
+				updateSilenceBypass();
+			} else {
 				deactivate();
+			}
 			if (m_pList)
 				m_pList->updateActivated(bActivated);
 		}
@@ -1739,6 +1833,50 @@ void qtractorPlugin::Property::update ( float fValue, bool bUpdate )
 // qtractorPluginList -- Plugin chain list instance.
 //
 
+// Digital silence threshold (~ -160dB).
+static const float c_fSilenceThreshold = 1e-8f;
+
+// Whether the buffer frames are all digitally silent (RT-safe).
+static inline bool qtractor_plugin_silent (
+	float **ppBuffer, unsigned short iChannels, unsigned int nframes )
+{
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		const float *pFrames = ppBuffer[i];
+		for (unsigned int n = 0; n < nframes; ++n) {
+			if (::fabsf(pFrames[n]) > c_fSilenceThreshold)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+// Silence auto-bypass global options.
+static bool  g_bSilenceBypass = false;
+static float g_fSilenceHold   = 10.0f;
+
+void qtractorPluginList::setSilenceBypass ( bool bSilenceBypass )
+{
+	g_bSilenceBypass = bSilenceBypass;
+}
+
+bool qtractorPluginList::isSilenceBypass (void)
+{
+	return g_bSilenceBypass;
+}
+
+void qtractorPluginList::setSilenceHold ( float fSilenceHold )
+{
+	g_fSilenceHold = (fSilenceHold < 1.0f ? 1.0f : fSilenceHold);
+}
+
+float qtractorPluginList::silenceHold (void)
+{
+	return g_fSilenceHold;
+}
+
+
 // Constructor.
 qtractorPluginList::qtractorPluginList (
 	unsigned short iChannels, unsigned int iFlags )
@@ -1748,7 +1886,7 @@ qtractorPluginList::qtractorPluginList (
 		m_pMidiProgramSubject(nullptr),
 		m_bAutoDeactivated(false),
 		m_bAudioOutputMonitor(false),
-		m_bLatency(false), m_iLatency(0)
+		m_bLatency(false), m_iLatency(0), m_pChain(nullptr)
 {
 	setAutoDelete(true);
 
@@ -1776,6 +1914,11 @@ qtractorPluginList::~qtractorPluginList (void)
 	// Clear out all dependables...
 	m_views.clear();
 
+	// Must be out of render by now...
+	qtractorSessionChain *pChain = m_pChain.fetchAndStoreOrdered(nullptr);
+	if (pChain)
+		delete pChain;
+
 	delete m_pCurveList;
 }
 
@@ -1977,6 +2120,8 @@ void qtractorPluginList::insertPlugin (
 	else
 		append(pPlugin);
 
+	updateChain();
+
 	// Now update each observer list-view...
 	QListIterator<qtractorPluginListView *> iter(m_views);
 	while (iter.hasNext()) {
@@ -2008,6 +2153,9 @@ void qtractorPluginList::movePlugin (
 
 	// Remove and insert back again...
 	pPluginList->unlink(pPlugin);
+	// Make sure it's out of the other chain render...
+	if (pPluginList != this)
+		pPluginList->updateChain(true);
 	if (pNextPlugin) {
 		insertBefore(pPlugin, pNextPlugin);
 	} else {
@@ -2047,6 +2195,8 @@ void qtractorPluginList::movePlugin (
 		}
 	}
 
+	updateChain();
+
 	// Now update each observer list-view:
 	// - take all items...
 	QListIterator<qtractorPluginListItem *> item(pPlugin->items());
@@ -2075,8 +2225,10 @@ void qtractorPluginList::movePlugin (
 // Remove-guarded plugin method.
 void qtractorPluginList::removePlugin ( qtractorPlugin *pPlugin )
 {
-	// Just unlink the plugin from the list...
+	// Just unlink the plugin from the list,
+	// making sure it's out of the chain render...
 	unlink(pPlugin);
+	updateChain(true);
 
 	if (pPlugin->isActivated())
 		updateActivated(false);
@@ -2089,6 +2241,43 @@ void qtractorPluginList::removePlugin ( qtractorPlugin *pPlugin )
 }
 
 
+// Remove and destroy all plugins.
+void qtractorPluginList::clear (void)
+{
+	// Make sure they're all out of the chain render...
+	qtractorSessionChain *pChain = m_pChain.fetchAndStoreOrdered(nullptr);
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession) {
+		qtractorSessionEpoch *pEpoch = pSession->epoch();
+		pEpoch->retire(pChain);
+		pEpoch->synchronize();
+	}
+	else if (pChain)
+		delete pChain;
+
+	qtractorList<qtractorPlugin>::clear();
+}
+
+
+// Publish the plugin chain render snapshot anew.
+void qtractorPluginList::updateChain ( bool bSync )
+{
+	qtractorSessionChain *pChain = new qtractorSessionChain(*this);
+	pChain = m_pChain.fetchAndStoreOrdered(pChain);
+
+	// Old chain may still be in use (RT)...
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession) {
+		qtractorSessionEpoch *pEpoch = pSession->epoch();
+		pEpoch->retire(pChain);
+		if (bSync)
+			pEpoch->synchronize();
+	}
+	else if (pChain)
+		delete pChain;
+}
+
+
 // Clone/copy plugin method.
 qtractorPlugin *qtractorPluginList::copyPlugin ( qtractorPlugin *pPlugin )
 {
@@ -2166,21 +2355,64 @@ void qtractorPluginList::process ( float **ppBuffer, unsigned int nframes )
 	// Buffer binary iterator...
 	unsigned short iBuffer = 0;
 
+	// Silence tracking: whether the current chain stage
+	// is digitally silent, and for how long to measure
+	// silent output before auto-bypassing (hold time)...
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return;
+
+	const bool bSilenceBypass = g_bSilenceBypass;
+	bool bSilent = false;
+	unsigned long iSilenceHold = 0;
+	if (bSilenceBypass) {
+		bSilent = qtractor_plugin_silent(ppBuffer, m_iChannels, nframes);
+		iSilenceHold = (unsigned long) (g_fSilenceHold * pSession->sampleRate());
+	}
+
+	// Plugin chain render snapshot read-side section...
+	qtractorSessionEpoch *pEpoch = pSession->epoch();
+	const unsigned int iEpoch = pEpoch->enter();
+	qtractorSessionChain *pChain = m_pChain.loadAcquire();
+	const unsigned int iPlugins = (pChain ? pChain->plugins() : 0);
+
 	// For each plugin in chain (in order, of course...)
-	for (qtractorPlugin *pPlugin = first();
-			pPlugin; pPlugin = pPlugin->next()) {
+	for (unsigned int i = 0; i < iPlugins; ++i) {
+		qtractorPlugin *pPlugin = pChain->plugin(i);
 
 		// Must be properly activated...
 		if (!pPlugin->isActivated())
 			continue;
 
+		// Resume on first non-silent cycle, otherwise skip
+		// it altogether: the (silent) input goes through...
+		if (bSilenceBypass) {
+			if (!bSilent)
+				pPlugin->resetSilence();
+			else
+			if (pPlugin->isSilenceBypass())
+				continue;
+		}
+
 		// Set proper buffers for this plugin...
 		float **ppIBuffer = m_pppBuffers[  iBuffer & 1];
 		float **ppOBuffer = m_pppBuffers[++iBuffer & 1];
 		// Time for the real thing...
+		const unsigned long long t0 = qtractorDspLoad::start();
 		pPlugin->process(ppIBuffer, ppOBuffer, nframes);
+		pPlugin->dspProbe().add(t0);
+
+		// Track output silence, measuring tail as needed...
+		if (bSilenceBypass) {
+			const bool bSilentIn = bSilent;
+			bSilent = qtractor_plugin_silent(ppOBuffer, m_iChannels, nframes);
+			if (bSilentIn)
+				pPlugin->updateSilence(bSilent, nframes, iSilenceHold);
+		}
 	}
 
+	pEpoch->leave(iEpoch);
+
 	// Now for the output buffer commitment...
 	if (iBuffer & 1) {
 		for (unsigned short i = 0; i < m_iChannels; ++i) {
@@ -2401,6 +2633,9 @@ bool qtractorPluginList::loadElement (
 		setAudioOutputBus(m_bAudioOutputBus);
 	}
 
+	// Render the loaded plugin chain...
+	updateChain();
+
 	return true;
 }
 
@@ -2592,6 +2827,22 @@ void qtractorPluginList::resetLatency (void)
 }
 
 
+// Plugin chain current latency, as last reported (in frames);
+// regardless of compensation being enabled or not.
+unsigned long qtractorPluginList::currentLatency (void) const
+{
+	unsigned long iLatency = 0;
+
+	for (qtractorPlugin *pPlugin = first();
+			pPlugin; pPlugin = pPlugin->next()) {
+		if (pPlugin->isActivated())
+			iLatency += pPlugin->latency();
+	}
+
+	return iLatency;
+}
+
+
 // Plugin editors (GUI) visibility (auto-focus).
 void qtractorPluginList::setEditorVisibleAll ( bool bVisible )
 {
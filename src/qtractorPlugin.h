@@ -27,12 +27,14 @@
 #include "qtractorMidiControlObserver.h"
 
 #include "qtractorDocument.h"
+#include "qtractorDspLoad.h"
 
 #include <QStringList>
 #include <QPoint>
 #include <QSize>
 #include <QMap>
 #include <QVariant>
+#include <QAtomicPointer>
 
 
 // Forward declarations.
@@ -48,6 +50,8 @@ class qtractorMidiManager;
 class qtractorCurveList;
 class qtractorCurveFile;
 
+class qtractorSessionChain;
+
 
 //----------------------------------------------------------------------------
 // qtractorPluginFile -- Plugin file library instance.
@@ -260,6 +264,19 @@ public:
 	qtractorMidiControlObserver *activateObserver()
 		{ return &m_activateObserver; }
 
+	// DSP time probe (instrumentation).
+	qtractorDspProbe& dspProbe()
+		{ return m_dspProbe; }
+
+	// Silence auto-bypass state (RT-safe).
+	bool isSilenceBypass() const
+		{ return m_bSilenceBypass; }
+	bool canSilenceBypass() const
+		{ return m_bCanSilenceBypass; }
+	void resetSilence();
+	void updateSilence(bool bSilent,
+		unsigned int nframes, unsigned long iHold);
+
 	// Activate pseudo-parameter port index.
 	void setActivateSubjectIndex (unsigned long iIndex)
 		{ m_iActivateSubjectIndex = iIndex; }
@@ -334,6 +351,11 @@ public:
 	virtual void process(
 		float **ppIBuffer, float **ppOBuffer, unsigned int nframes) = 0;
 
+	// Single instance processing procedure, ports already
+	// connected (possibly called from plugin pool workers).
+	virtual void process_instance(
+		unsigned short /*iInstance*/, unsigned int /*nframes*/) {}
+
 	// Parameter update method.
 	virtual void updateParam(
 		Param */*pParam*/, float /*fValue*/, bool /*bUpdate*/) {}
@@ -384,6 +406,17 @@ public:
 	virtual unsigned long latency() const
 		{ return 0; }
 
+	// Plugin declared tail length (in frames);
+	// unknown tails are measured for silence instead.
+	enum { TailUnknown = -1, TailInfinite = -2 };
+
+	virtual long tail() const
+		{ return TailUnknown; }
+
+	// Silence auto-bypass capability and tail caching,
+	// on (re)activation or restart (non RT-safe).
+	void updateSilenceBypass();
+
 	// GUI Editor stuff.
 	virtual void openEditor(QWidget */*pParent*/= nullptr) {}
 	virtual void closeEditor() {};
@@ -575,6 +608,9 @@ protected:
 	// Instance number settler.
 	void setInstances(unsigned short iInstances);
 
+	// Run all instances, possibly in parallel (RT-safe).
+	void process_instances(unsigned int nframes);
+
 	// Internal activation methods.
 	void setChannelsActivated(unsigned short iChannels, bool bActivated);
 
@@ -673,6 +709,18 @@ private:
 	// Direct access parameter, if any.
 	long m_iDirectAccessParamIndex;
 
+	// DSP time probe.
+	qtractorDspProbe m_dspProbe;
+
+	// Silence auto-bypass state (frames).
+	unsigned long m_iSilenceIn;
+	unsigned long m_iSilenceOut;
+	bool          m_bSilenceBypass;
+
+	// Silence auto-bypass capability and tail (cached).
+	bool          m_bCanSilenceBypass;
+	long          m_iSilenceTail;
+
 	// Default preset name.
 	static QString g_sDefPreset;
 };
@@ -927,6 +975,13 @@ public:
 	void movePlugin(qtractorPlugin *pPlugin, qtractorPlugin *pNextPlugin);
 	void removePlugin(qtractorPlugin *pPlugin);
 
+	// Remove and destroy all plugins.
+	void clear();
+
+	// Plugin chain render snapshot (valid only inside read-side section).
+	qtractorSessionChain *chain() const
+		{ return m_pChain.loadAcquire(); }
+
 	// Clone/copy plugin method.
 	qtractorPlugin *copyPlugin(qtractorPlugin *pPlugin);
 
@@ -1054,15 +1109,30 @@ public:
 
 	void resetLatency();
 
+	// Plugin chain current latency, as last reported (in frames);
+	// regardless of compensation being enabled or not.
+	unsigned long currentLatency() const;
+
 	// Plugin editors (GUI) visibility (auto-focus).
 	void setEditorVisibleAll(bool bVisible);
 
+	// Silence auto-bypass global options:
+	// hold (in seconds) is for the longest echo/reverb tail.
+	static void setSilenceBypass(bool bSilenceBypass);
+	static bool isSilenceBypass();
+
+	static void setSilenceHold(float fSilenceHold);
+	static float silenceHold();
+
 protected:
 
 	// Check/sanitize plugin file-path.
 	bool checkPluginFile(QString& sFilename,
 		qtractorPluginType::Hint typeHint) const;
 
+	// Publish the plugin chain render snapshot anew.
+	void updateChain(bool bSync = false);
+
 private:
 
 	// Instance variables.
@@ -1114,6 +1184,9 @@ private:
 	// Plugin chain total latency (in frames);
 	bool          m_bLatency;
 	unsigned long m_iLatency;
+
+	// Plugin chain render snapshot.
+	QAtomicPointer<qtractorSessionChain> m_pChain;
 };
 
 
@@ -51,6 +51,7 @@
 #include <QTextStream>
 #include <QFileInfo>
 #include <QDateTime>
+#include <QThread>
 #include <QDir>
 
 #include <QRegularExpression>
@@ -427,70 +428,35 @@ bool qtractorPluginFactory::startScan ( qtractorPluginType::Hint typeHint )
 	if (pOptions == nullptr)
 		return false;
 
-	bool bDummyPluginScan = pOptions->bDummyPluginScan;
-	int  iDummyPluginHash = 0;
+	if (!pOptions->bDummyPluginScan)
+		return false;
 
-	switch (typeHint) {
-	case qtractorPluginType::Ladspa:
-		iDummyPluginHash = pOptions->iDummyLadspaHash;
-		break;
-	case qtractorPluginType::Dssi:
-		iDummyPluginHash = pOptions->iDummyDssiHash;
-		break;
-	case qtractorPluginType::Vst2:
-		iDummyPluginHash = pOptions->iDummyVst2Hash;
-		break;
-	case qtractorPluginType::Vst3:
-		iDummyPluginHash = pOptions->iDummyVst3Hash;
-		break;
-	case qtractorPluginType::Clap:
-		iDummyPluginHash = pOptions->iDummyClapHash;
-		break;
-	case qtractorPluginType::Lv2:
-		iDummyPluginHash = pOptions->iDummyLv2Hash;
-		break;
-	default:
-		break;
+	// File-based plugins are checked against the cache on a
+	// per-file basis (size and mtime); LV2 plugins are URI
+	// based and get rescanned only when their number changes...
+	const QStringList& files = m_files.value(typeHint);
+	bool bReset = false;
+	if (typeHint == qtractorPluginType::Lv2) {
+		const int iNewDummyPluginHash = files.count();
+		bReset = (pOptions->iDummyLv2Hash != iNewDummyPluginHash);
+		pOptions->iDummyLv2Hash = iNewDummyPluginHash;
 	}
 
-	if (bDummyPluginScan) {
-		const int iNewDummyPluginHash
-			= m_files.value(typeHint).count();
-		Scanner *pScanner = new Scanner(typeHint, this);
-		if (pScanner->open(iDummyPluginHash != iNewDummyPluginHash)) {
-			m_scanners.insert(typeHint, pScanner);
-			switch (typeHint) {
-			case qtractorPluginType::Ladspa:
-				pOptions->iDummyLadspaHash = iNewDummyPluginHash;
-				break;
-			case qtractorPluginType::Dssi:
-				pOptions->iDummyDssiHash = iNewDummyPluginHash;
-				break;
-			case qtractorPluginType::Vst2:
-				pOptions->iDummyVst2Hash = iNewDummyPluginHash;
-				break;
-			case qtractorPluginType::Vst3:
-				pOptions->iDummyVst3Hash = iNewDummyPluginHash;
-				break;
-			case qtractorPluginType::Clap:
-				pOptions->iDummyClapHash = iNewDummyPluginHash;
-				break;
-			case qtractorPluginType::Lv2:
-				pOptions->iDummyLv2Hash = iNewDummyPluginHash;
-				break;
-			default:
-				break;
-			}
-			// Remember to cleanup cache later, when applicable...
-			const QString& sCacheFilePath = pScanner->cacheFilePath();
-			if (!m_cacheFilePaths.contains(sCacheFilePath))
-				m_cacheFilePaths.append(sCacheFilePath);
-			// Done.
-			return true;
-		}
+	Scanner *pScanner = new Scanner(typeHint, this);
+	if (!pScanner->open(files, bReset)) {
+		delete pScanner;
+		return false;
 	}
 
-	return false;
+	m_scanners.insert(typeHint, pScanner);
+
+	// Remember to cleanup cache later, when applicable...
+	const QString& sCacheFilePath = pScanner->cacheFilePath();
+	if (!m_cacheFilePaths.contains(sCacheFilePath))
+		m_cacheFilePaths.append(sCacheFilePath);
+
+	// Done.
+	return true;
 }
 
 
@@ -925,32 +891,42 @@ bool qtractorPluginFactory::addTypes (
 
 
 //----------------------------------------------------------------------------
-// qtractorPluginFactory::Scanner -- Plugin path proxy (out-of-process client).
+// qtractorPluginFactory::Scanner -- Plugin scan proxy (out-of-process clients).
 //
 
+// Maximum number of scan workers (per plugin type).
+static const int c_iMaxScanWorkers = 8;
+
+// Per-file scan timeout (msecs).
+static const int c_iScanTimeout = 20000;
+
+// Busy scan workers poll period (msecs).
+static const int c_iScanPoll = 20;
+
+
 // Constructor.
 qtractorPluginFactory::Scanner::Scanner (
-	qtractorPluginType::Hint typeHint, QObject *pParent )
-	: QProcess(pParent), m_typeHint(typeHint), m_iExitStatus(-1)
+	qtractorPluginType::Hint typeHint, qtractorPluginFactory *pPluginFactory )
+	: m_typeHint(typeHint), m_pPluginFactory(pPluginFactory)
 {
-	QObject::connect(this,
-		SIGNAL(readyReadStandardOutput()),
-		SLOT(stdout_slot()));
-	QObject::connect(this,
-		SIGNAL(readyReadStandardError()),
-		SLOT(stderr_slot()));
-	QObject::connect(this,
-		SIGNAL(finished(int, QProcess::ExitStatus)),
-		SLOT(exit_slot(int, QProcess::ExitStatus)));
+}
+
+
+// Destructor.
+qtractorPluginFactory::Scanner::~Scanner (void)
+{
+	close();
 }
 
 
 // Open/start method.
-bool qtractorPluginFactory::Scanner::open ( bool bReset )
+bool qtractorPluginFactory::Scanner::open (
+	const QStringList& files, bool bReset )
 {
 	// Cache file setup...
 	m_file.setFileName(cacheFilePath());
 	m_list.clear();
+	m_stamps.clear();
 
 	// Open and read cache file, whether applicable...
 	if (!bReset && m_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -961,12 +937,14 @@ bool qtractorPluginFactory::Scanner::open ( bool bReset )
 			if (sText.isEmpty())
 				continue;
 			const QStringList& props = sText.split('|');
+			if (props.count() >= 3 && props.at(0) == "FILE")
+				m_stamps.insert(props.at(1), props.at(2));
+			else
 			if (props.count() >= 6) // get filename...
 				m_list[props.at(6)].append(sText);
 		}
 		// May close the file.
 		m_file.close();
-		return true;
 	}
 
 	// Make sure cache file location do exists...
@@ -974,34 +952,57 @@ bool qtractorPluginFactory::Scanner::open ( bool bReset )
 	if (!fi.dir().mkpath(fi.absolutePath()))
 		return false;
 
-	// Open cache file for writing...
+	// (Re)open cache file for writing;
+	// all up-to-date entries will be written back...
 	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
 		return false;
 
 	// LV2 plugins are dang special,
 	// need no out-of-process scanning whatsoever...
-	if (m_typeHint == qtractorPluginType::Lv2) {
-		m_iExitStatus = 0;
+	if (m_typeHint == qtractorPluginType::Lv2)
 		return true;
+
+	// Only new or changed files get scanned...
+	int iFiles = 0;
+	QStringListIterator iter(files);
+	while (iter.hasNext()) {
+		if (!isCached(iter.next()))
+			++iFiles;
 	}
 
+	// All cached in?
+	if (iFiles < 1)
+		return true;
+
+	// Scan worker pool, sized to the job...
+	int iWorkers = QThread::idealThreadCount();
+	if (iWorkers > c_iMaxScanWorkers)
+		iWorkers = c_iMaxScanWorkers;
+	if (iWorkers > iFiles)
+		iWorkers = iFiles;
+	if (iWorkers < 1)
+		iWorkers = 1;
+
+	for (int i = 0; i < iWorkers; ++i)
+		m_workers.append(new Worker(this, i));
+
 	// Go go go...
-	return start();
+	return m_workers.first()->start();
 }
 
 
 // Close/stop method.
 void qtractorPluginFactory::Scanner::close (void)
 {
-	// We're we scanning hard?...
-	if (QProcess::state() != QProcess::NotRunning || m_iExitStatus < 0) {
-		QProcess::closeWriteChannel();
-		while (QProcess::state() != QProcess::NotRunning)
-			QProcess::waitForFinished(200);
-	}
+	// Wait for all pending scans...
+	wait(true);
 
-	// Done anyway.
-	QProcess::terminate();
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext())
+		iter.next()->stop();
+
+	qDeleteAll(m_workers);
+	m_workers.clear();
 
 	// Close cache file...
 	if (m_file.isOpen())
@@ -1009,67 +1010,7 @@ void qtractorPluginFactory::Scanner::close (void)
 
 	// Cleanup cache...
 	m_list.clear();
-}
-
-
-// Scan start method.
-bool qtractorPluginFactory::Scanner::start (void)
-{
-	// Maybe we're still running, doh!
-	if (QProcess::state() != QProcess::NotRunning)
-		return false;
-
-	// Start from scratch...
-	m_iExitStatus = -1;
-
-	// Get the main scanner executable...
-	const QString sName("qtractor_plugin_scan");
-	QString sLibPath = QApplication::applicationDirPath();
-	QFileInfo fi(sLibPath, sName);
-	if (!fi.isExecutable()) {
-		sLibPath.remove(CONFIG_BINDIR);
-		sLibPath.append(CONFIG_LIBDIR);
-		sLibPath.append(QDir::separator());
-		sLibPath.append(PACKAGE_TARNAME);
-		fi = QFileInfo(sLibPath, sName);
-	}
-
-	if (!fi.isExecutable())
-		return false;
-
-	// Go go go!
-	QProcess::start(fi.filePath(), QStringList());
-	return true;
-}
-
-
-// Service slots.
-void qtractorPluginFactory::Scanner::stdout_slot (void)
-{
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return;
-
-	const QString sData(QProcess::readAllStandardOutput());
-	addTypes(sData.split('\n'));
-}
-
-
-void qtractorPluginFactory::Scanner::stderr_slot (void)
-{
-	QTextStream(stderr) << QProcess::readAllStandardError();
-}
-
-
-void qtractorPluginFactory::Scanner::exit_slot (
-	int exitCode, QProcess::ExitStatus exitStatus )
-{
-	if (m_iExitStatus < 0)
-		m_iExitStatus = 0;
-
-	if (exitCode || exitStatus != QProcess::NormalExit)
-		++m_iExitStatus;
+	m_stamps.clear();
 }
 
 
@@ -1077,8 +1018,9 @@ void qtractorPluginFactory::Scanner::exit_slot (
 bool qtractorPluginFactory::Scanner::addTypes (
 	qtractorPluginType::Hint typeHint, const QString& sFilename )
 {
-	// See if it's already cached in...
-	if (!m_list.isEmpty()) {
+	// See if it's already cached in, and still up-to-date...
+	if (isCached(sFilename)) {
+		addStamp(sFilename);
 		const QStringList& list = m_list.value(sFilename);
 		if (list.isEmpty())
 			return false;
@@ -1086,11 +1028,6 @@ bool qtractorPluginFactory::Scanner::addTypes (
 			return addTypes(list);
 	}
 
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return false;
-
 #ifdef CONFIG_LV2
 	// LV2 plugins are dang special...
 	if (typeHint == qtractorPluginType::Lv2) {
@@ -1099,7 +1036,7 @@ bool qtractorPluginFactory::Scanner::addTypes (
 		if (pType == nullptr)
 			return false;
 		if (pType->open()) {
-			pPluginFactory->addType(pType);
+			m_pPluginFactory->addType(pType);
 			pType->close();
 			// Cache out...
 			if (m_file.isOpen()) {
@@ -1120,6 +1057,7 @@ bool qtractorPluginFactory::Scanner::addTypes (
 				sout << sFilename << '|' << 0 << '|';
 				sout << "0x" << QString::number(pType->uniqueID(), 16) << endl;
 			}
+			addStamp(sFilename);
 			// Success.
 			return true;
 		} else {
@@ -1130,45 +1068,23 @@ bool qtractorPluginFactory::Scanner::addTypes (
 	}
 #endif
 
-	// Add to temporary blacklist...
-	QFile temp_file(pPluginFactory->blacklistTempFilePath());
-	if (temp_file.exists())
-		pPluginFactory->readBlacklist(temp_file);
-	pPluginFactory->writeBlacklist(temp_file, QStringList() << sFilename);
-
-	// Not cached, yet...
-	const QString& sHint = qtractorPluginType::textFromHint(typeHint);
-	const QString& sLine = sHint + ':' + sFilename + '\n';
-	const QByteArray& data = sLine.toUtf8();
-
-	bool bResult = (QProcess::write(data) == data.size());
+	// Not cached, yet: hand it over to the next idle worker...
+	if (m_workers.isEmpty())
+		return false;
 
-	// Check for hideous scan crashes...
-	if (!QProcess::waitForReadyRead(3000)) {
-		if (m_iExitStatus > 0) {
-			QProcess::waitForFinished(200);
-			start(); // Restart the crashed scan...
-			QProcess::waitForStarted(200);
-			bResult = false;
-		}
+	Worker *pWorker = idleWorker();
+	while (pWorker == nullptr) {
+		wait();
+		pWorker = idleWorker();
 	}
 
-	// If it reaches here safely, then there's
-	// no use to temporary blacklist anymore...
-	if (bResult)
-		temp_file.remove();
-
-	return bResult;
+	return pWorker->scan(typeHint, sFilename);
 }
 
 
+// Scan results feedback (from workers).
 bool qtractorPluginFactory::Scanner::addTypes ( const QStringList& list )
 {
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return false;
-
 	QStringListIterator iter(list);
 	while (iter.hasNext()) {
 		const QString& sText = iter.next().simplified();
@@ -1177,7 +1093,7 @@ bool qtractorPluginFactory::Scanner::addTypes ( const QStringList& list )
 		qtractorPluginType *pType = qtractorDummyPluginType::createType(sText);
 		if (pType) {
 			// Brand new type, add to inventory...
-			pPluginFactory->addType(pType);
+			m_pPluginFactory->addType(pType);
 			// Cache in...
 			if (m_file.isOpen())
 				QTextStream(&m_file) << sText << endl;
@@ -1192,6 +1108,82 @@ bool qtractorPluginFactory::Scanner::addTypes ( const QStringList& list )
 }
 
 
+void qtractorPluginFactory::Scanner::addStamp ( const QString& sFilename )
+{
+	if (m_file.isOpen()) {
+		QTextStream(&m_file) << "FILE|" << sFilename
+			<< '|' << fileStamp(sFilename) << endl;
+	}
+}
+
+
+// Per-file cache stamp (size and mtime) methods.
+QString qtractorPluginFactory::Scanner::fileStamp ( const QString& sFilename )
+{
+	const QFileInfo fi(sFilename);
+	if (!fi.exists())
+		return QString(); // eg. LV2 plugin URIs.
+
+	return QString::number(fi.size()) + ':'
+		+ QString::number(fi.lastModified().toMSecsSinceEpoch());
+}
+
+
+bool qtractorPluginFactory::Scanner::isCached ( const QString& sFilename ) const
+{
+	QHash<QString, QString>::ConstIterator iter = m_stamps.constFind(sFilename);
+	if (iter == m_stamps.constEnd())
+		return false;
+
+	return (iter.value() == fileStamp(sFilename));
+}
+
+
+// Worker pool helpers.
+qtractorPluginFactory::Worker *qtractorPluginFactory::Scanner::idleWorker (void) const
+{
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext()) {
+		Worker *pWorker = iter.next();
+		if (pWorker->isIdle())
+			return pWorker;
+	}
+
+	return nullptr;
+}
+
+
+// Wait for any (or all) busy workers to become idle.
+void qtractorPluginFactory::Scanner::wait ( bool bAll )
+{
+	for (;;) {
+		int iBusy = 0;
+		QListIterator<Worker *> iter(m_workers);
+		while (iter.hasNext()) {
+			Worker *pWorker = iter.next();
+			if (pWorker->isIdle())
+				continue;
+			// Hanging or crashed on the current one?
+			if (pWorker->isTimeout()
+				|| pWorker->state() == QProcess::NotRunning)
+				pWorker->abort();
+			else
+				++iBusy;
+		}
+		// Are we done yet?
+		if (iBusy < 1 || (!bAll && iBusy < m_workers.count()))
+			break;
+		// Poll on busy workers...
+		iter.toFront();
+		while (iter.hasNext()) {
+			Worker *pWorker = iter.next();
+			if (!pWorker->isIdle())
+				pWorker->waitForReadyRead(c_iScanPoll / iBusy + 1);
+		}
+	}
+}
+
+
 // Absolute cache file path.
 QString qtractorPluginFactory::Scanner::cacheFilePath (void) const
 {
@@ -1212,6 +1204,191 @@ QString qtractorPluginFactory::Scanner::cacheFilePath (void) const
 }
 
 
+//----------------------------------------------------------------------------
+// qtractorPluginFactory::Worker -- Plugin scan worker (out-of-process client).
+//
+
+// Constructor.
+qtractorPluginFactory::Worker::Worker ( Scanner *pScanner, int iWorker )
+	: QProcess(), m_pScanner(pScanner), m_iWorker(iWorker)
+{
+	QObject::connect(this,
+		SIGNAL(readyReadStandardOutput()),
+		SLOT(stdout_slot()));
+	QObject::connect(this,
+		SIGNAL(readyReadStandardError()),
+		SLOT(stderr_slot()));
+	QObject::connect(this,
+		SIGNAL(finished(int, QProcess::ExitStatus)),
+		SLOT(exit_slot(int, QProcess::ExitStatus)));
+
+	// Left-overs from a previous crash, if any...
+	readBlacklist();
+}
+
+
+// Scan start method.
+bool qtractorPluginFactory::Worker::start (void)
+{
+	// Maybe we're still running, doh!
+	if (QProcess::state() != QProcess::NotRunning)
+		return true;
+
+	// Get the main scanner executable...
+	const QString sName("qtractor_plugin_scan");
+	QString sLibPath = QApplication::applicationDirPath();
+	QFileInfo fi(sLibPath, sName);
+	if (!fi.isExecutable()) {
+		sLibPath.remove(CONFIG_BINDIR);
+		sLibPath.append(CONFIG_LIBDIR);
+		sLibPath.append(QDir::separator());
+		sLibPath.append(PACKAGE_TARNAME);
+		fi = QFileInfo(sLibPath, sName);
+	}
+
+	if (!fi.isExecutable())
+		return false;
+
+	// Go go go!
+	QProcess::start(fi.filePath(), QStringList());
+	return true;
+}
+
+
+// Scan stop method.
+void qtractorPluginFactory::Worker::stop (void)
+{
+	if (QProcess::state() != QProcess::NotRunning) {
+		QProcess::closeWriteChannel();
+		if (!QProcess::waitForFinished(c_iScanTimeout))
+			QProcess::kill();
+	}
+
+	// Done anyway.
+	QProcess::terminate();
+}
+
+
+// Scan request (asynchronous).
+bool qtractorPluginFactory::Worker::scan (
+	qtractorPluginType::Hint typeHint, const QString& sFilename )
+{
+	// Make sure we're (still) up and running...
+	if (QProcess::state() == QProcess::NotRunning) {
+		if (!start() || !QProcess::waitForStarted())
+			return false;
+	}
+
+	// Add to temporary blacklist...
+	QFile temp_file(blacklistTempFilePath());
+	m_pScanner->pluginFactory()->writeBlacklist(
+		temp_file, QStringList() << sFilename);
+
+	m_sFilename = sFilename;
+	m_timer.start();
+
+	const QString& sHint = qtractorPluginType::textFromHint(typeHint);
+	const QString& sLine = sHint + ':' + sFilename + '\n';
+	const QByteArray& data = sLine.toUtf8();
+
+	return (QProcess::write(data) == data.size());
+}
+
+
+// Current scan timeout check.
+bool qtractorPluginFactory::Worker::isTimeout (void) const
+{
+	return (!m_sFilename.isEmpty() && m_timer.elapsed() > c_iScanTimeout);
+}
+
+
+// Abort current scan, blacklisting its file.
+void qtractorPluginFactory::Worker::abort (void)
+{
+	if (m_sFilename.isEmpty())
+		return;
+
+	const QString sFilename = m_sFilename;
+	m_sFilename.clear();
+
+	// Kill any hanging scan...
+	if (QProcess::state() != QProcess::NotRunning) {
+		QProcess::kill();
+		QProcess::waitForFinished(200);
+	}
+
+	QTextStream(stderr) << "qtractor_plugin_scan: "
+		<< sFilename << ": scan failed, blacklisted." << endl;
+
+	// Have it blacklisted for good.
+	readBlacklist();
+}
+
+
+// Service slots.
+void qtractorPluginFactory::Worker::stdout_slot (void)
+{
+	QStringList list;
+
+	while (QProcess::canReadLine()) {
+		const QString sText
+			= QString::fromUtf8(QProcess::readLine()).simplified();
+		if (sText.startsWith("DONE|")) {
+			// Done with this one, flush it...
+			m_pScanner->addTypes(list);
+			list.clear();
+			if (!m_sFilename.isEmpty()) {
+				QFile::remove(blacklistTempFilePath());
+				m_pScanner->addStamp(m_sFilename);
+				m_sFilename.clear();
+			}
+		}
+		else
+		if (!sText.isEmpty())
+			list.append(sText);
+	}
+
+	if (!list.isEmpty())
+		m_pScanner->addTypes(list);
+}
+
+
+void qtractorPluginFactory::Worker::stderr_slot (void)
+{
+	QTextStream(stderr) << QProcess::readAllStandardError();
+}
+
+
+void qtractorPluginFactory::Worker::exit_slot (
+	int /*exitCode*/, QProcess::ExitStatus /*exitStatus*/ )
+{
+	// Crashed while on some scan?
+	abort();
+}
+
+
+// Temporary blacklist file path (per worker).
+QString qtractorPluginFactory::Worker::blacklistTempFilePath (void) const
+{
+	const QFileInfo fi(m_pScanner->pluginFactory()->blacklistTempFilePath());
+	return fi.absolutePath() + QDir::separator()
+		+ fi.completeBaseName() + '.'
+		+ qtractorPluginType::textFromHint(m_pScanner->typeHint()).toLower()
+		+ '.' + QString::number(m_iWorker) + '.' + fi.suffix();
+}
+
+
+// Merge temporary blacklist, if any.
+void qtractorPluginFactory::Worker::readBlacklist (void)
+{
+	QFile temp_file(blacklistTempFilePath());
+	if (temp_file.exists()) {
+		m_pScanner->pluginFactory()->readBlacklist(temp_file);
+		temp_file.remove();
+	}
+}
+
+
 //----------------------------------------------------------------------------
 // qtractorDummyPluginType -- Dummy plugin type instance.
 //
@@ -26,6 +26,7 @@
 
 #include <QProcess>
 #include <QFile>
+#include <QElapsedTimer>
 
 
 //----------------------------------------------------------------------------
@@ -134,6 +135,7 @@ private:
 
 	// Scan (out-of-process) clients.
 	class Scanner;
+	class Worker;
 
 	typedef QHash<qtractorPluginType::Hint, Scanner *> Scanners;
 
@@ -148,20 +150,22 @@ private:
 
 
 //----------------------------------------------------------------------------
-// qtractorPluginFactory::Scanner -- Plugin scan proxy (out-of-process client).
+// qtractorPluginFactory::Scanner -- Plugin scan proxy (out-of-process clients).
 //
 
-class qtractorPluginFactory::Scanner : public QProcess
+class qtractorPluginFactory::Scanner
 {
-	Q_OBJECT
-
 public:
 
 	// ctor.
-	Scanner(qtractorPluginType::Hint typeHint, QObject *pParent = nullptr);
+	Scanner(qtractorPluginType::Hint typeHint,
+		qtractorPluginFactory *pPluginFactory);
+
+	// dtor.
+	~Scanner();
 
 	// Open/close method.
-	bool open(bool bReset = false);
+	bool open(const QStringList& files, bool bReset = false);
 	void close();
 
 	// Service methods.
@@ -170,35 +174,105 @@ public:
 	// Absolute cache file path.
 	QString cacheFilePath() const;
 
-protected slots:
-
-	// Service slots.
-	void stdout_slot();
-	void stderr_slot();
+	// Accessors.
+	qtractorPluginType::Hint typeHint() const
+		{ return m_typeHint; }
+	qtractorPluginFactory *pluginFactory() const
+		{ return m_pPluginFactory; }
 
-	void exit_slot(int exitCode, QProcess::ExitStatus exitStatus);
+	// Scan results feedback (from workers).
+	bool addTypes(const QStringList& list);
+	void addStamp(const QString& sFilename);
 
 protected:
 
-	// Scan start method.
-	bool start();
+	// Per-file cache stamp (size and mtime) methods.
+	static QString fileStamp(const QString& sFilename);
+	bool isCached(const QString& sFilename) const;
 
-	// Service methods (internal)
-	bool addTypes(const QStringList& list);
+	// Worker pool helpers.
+	Worker *idleWorker() const;
+	void wait(bool bAll = false);
 
 private:
 
 	// Instance scanner name.
 	qtractorPluginType::Hint m_typeHint;
 
-	// Instance state.
-	volatile int m_iExitStatus;
+	// Owner plugin factory.
+	qtractorPluginFactory *m_pPluginFactory;
 
 	// Cache file object.
 	QFile m_file;
 
 	// Cache hash list.
 	QHash<QString, QStringList> m_list;
+
+	// Cache file stamps (size and mtime).
+	QHash<QString, QString> m_stamps;
+
+	// Scan (out-of-process) worker pool.
+	QList<Worker *> m_workers;
+};
+
+
+//----------------------------------------------------------------------------
+// qtractorPluginFactory::Worker -- Plugin scan worker (out-of-process client).
+//
+
+class qtractorPluginFactory::Worker : public QProcess
+{
+	Q_OBJECT
+
+public:
+
+	// ctor.
+	Worker(Scanner *pScanner, int iWorker);
+
+	// Start/stop methods.
+	bool start();
+	void stop();
+
+	// Scan request (asynchronous).
+	bool scan(qtractorPluginType::Hint typeHint, const QString& sFilename);
+
+	// Current scanning file (empty when idle).
+	const QString& filename() const
+		{ return m_sFilename; }
+	bool isIdle() const
+		{ return m_sFilename.isEmpty(); }
+
+	// Current scan timeout check.
+	bool isTimeout() const;
+
+	// Abort current scan, blacklisting its file.
+	void abort();
+
+protected slots:
+
+	// Service slots.
+	void stdout_slot();
+	void stderr_slot();
+
+	void exit_slot(int exitCode, QProcess::ExitStatus exitStatus);
+
+protected:
+
+	// Temporary blacklist file path (per worker).
+	QString blacklistTempFilePath() const;
+
+	// Merge temporary blacklist, if any.
+	void readBlacklist();
+
+private:
+
+	// Instance variables.
+	Scanner *m_pScanner;
+	int      m_iWorker;
+
+	// Current scanning file and elapsed time.
+	QString       m_sFilename;
+	QElapsedTimer m_timer;
 };
 
 
@@ -40,6 +40,10 @@ public:
 
 	// Constructors.
 	qtractorRingBuffer(unsigned short iChannels, unsigned int iBufferSize = 0);
+	// Shared (external) buffer constructor; takes ownership
+	// of the channel pointer array only, not of the data.
+	qtractorRingBuffer(unsigned short iChannels, unsigned int iBufferSize,
+		T **ppBuffer);
 	// Default destructor.
 	~qtractorRingBuffer();
 
@@ -79,6 +83,9 @@ private:
 	qtractorAtomic m_iWriteIndex;
 
 	T** m_ppBuffer;
+
+	// Whether the data is owned by us.
+	bool m_bOwner;
 };
 
 
@@ -107,6 +114,32 @@ qtractorRingBuffer<T>::qtractorRingBuffer ( unsigned short iChannels,
 	for (unsigned short i = 0; i < m_iChannels; ++i)
 		m_ppBuffer[i] = new T [m_iBufferSize];
 
+	m_bOwner = true;
+
+	ATOMIC_SET(&m_iReadIndex,  0);
+	ATOMIC_SET(&m_iWriteIndex, 0);
+}
+
+// Shared (external) buffer constructor.
+template<typename T>
+qtractorRingBuffer<T>::qtractorRingBuffer ( unsigned short iChannels,
+	unsigned int iBufferSize, T **ppBuffer )
+{
+	m_iChannels = iChannels;
+
+	// Adjust buffer size of nearest power-of-two, if necessary.
+	const unsigned int iMinBufferSize = 4096;
+	m_iBufferSize = iMinBufferSize;
+	while (m_iBufferSize < iBufferSize)
+		m_iBufferSize <<= 1;
+
+	// The size overflow convenience mask and tthreshold.
+	m_iBufferMask = (m_iBufferSize - 1);
+
+	// Just borrow the actual buffer stuff...
+	m_ppBuffer = ppBuffer;
+	m_bOwner = false;
+
 	ATOMIC_SET(&m_iReadIndex,  0);
 	ATOMIC_SET(&m_iWriteIndex, 0);
 }
@@ -117,8 +150,10 @@ qtractorRingBuffer<T>::~qtractorRingBuffer (void)
 {
 	// Deallocate any buffer stuff...
 	if (m_ppBuffer) {
-		for (unsigned short i = 0; i < m_iChannels; ++i)
-			delete [] m_ppBuffer[i];
+		if (m_bOwner) {
+			for (unsigned short i = 0; i < m_iChannels; ++i)
+				delete [] m_ppBuffer[i];
+		}
 		delete [] m_ppBuffer;
 	}
 }
@@ -22,11 +22,13 @@
 #include "qtractorAbout.h"
 #include "qtractorSession.h"
 #include "qtractorSessionCursor.h"
+#include "qtractorSessionSnapshot.h"
 
 #include "qtractorAudioEngine.h"
 #include "qtractorAudioPeak.h"
 #include "qtractorAudioClip.h"
 #include "qtractorAudioBuffer.h"
+#include "qtractorAudioGraph.h"
 
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiClip.h"
@@ -110,6 +112,9 @@ qtractorSession::qtractorSession (void)
 	// Initial comon client name.
 	m_sClientName = QTRACTOR_TITLE;
 
+	// Render snapshot publisher, before anything else.
+	m_pEpoch = new qtractorSessionEpoch();
+
 	// Singleton ownings.
 	m_pFiles       = new qtractorFileList();
 	m_pCommands    = new qtractorCommandList();
@@ -145,6 +150,8 @@ qtractorSession::~qtractorSession (void)
 
 	delete m_pFiles;
 
+	delete m_pEpoch;
+
 	g_pSession = nullptr;
 }
 
@@ -254,9 +261,15 @@ void qtractorSession::clear (void)
 
 	m_pCurrentTrack = nullptr;
 
+	// Withdraw render snapshot before tracks get destroyed...
+	m_pEpoch->publish(nullptr);
+	m_pEpoch->synchronize();
+
 	m_tracks.clear();
 	m_cursors.clear();
 
+	m_withdrawnClips.clear();
+
 	m_props.clear();
 
 	m_midiTags.clear();
@@ -326,6 +339,8 @@ void qtractorSession::clear (void)
 
 	m_pAudioPeakFactory->cleanup();
 
+	qtractorAudioBufferCache::getInstance()->cleanup();
+
 	qtractorMidiControl *pMidiControl = qtractorMidiControl::getInstance();
 	if (pMidiControl)
 		pMidiControl->clearControlMap();
@@ -903,11 +918,15 @@ void qtractorSession::addTrack ( qtractorTrack *pTrack )
 void qtractorSession::insertTrack ( qtractorTrack *pTrack,
 	qtractorTrack *pPrevTrack )
 {
-//	lock();
-
 	if (pTrack->trackType() == qtractorTrack::Midi)
 		acquireMidiTag(pTrack);
 
+	// Make room for one more track on the parallel process graph...
+	qtractorAudioGraph *pAudioGraph
+		= (m_pAudioEngine ? m_pAudioEngine->audioGraph() : nullptr);
+	if (pAudioGraph)
+		pAudioGraph->checkSize(m_tracks.count() + 1);
+
 	if (pPrevTrack) {
 		m_tracks.insertAfter(pTrack, pPrevTrack);
 	} else {
@@ -929,69 +948,62 @@ void qtractorSession::insertTrack ( qtractorTrack *pTrack,
 	// Associate track to its curve-list...
 	acquireTrackCurveList(pTrack);
 
+	pTrack->setLoop(m_iLoopStart, m_iLoopEnd);
+	pTrack->open();
+
+	// Make room on session cursors, then publish
+	// the new track only when it's all set...
 	qtractorSessionCursor *pSessionCursor = m_cursors.first();
 	while (pSessionCursor) {
-		pSessionCursor->addTrack(pTrack);
+		pSessionCursor->updateTracks();
 		pSessionCursor = pSessionCursor->next();
 	}
 
-	pTrack->setLoop(m_iLoopStart, m_iLoopEnd);
-	pTrack->open();
-
-//	unlock();
+	updateSnapshot();
 }
 
 
 void qtractorSession::moveTrack (
 	qtractorTrack *pTrack, qtractorTrack *pNextTrack )
 {
-//	lock();
-
 	m_tracks.unlink(pTrack);
 	if (pNextTrack)
 		m_tracks.insertBefore(pTrack, pNextTrack);
 	else
 		m_tracks.append(pTrack);
 
-	qtractorSessionCursor *pSessionCursor = m_cursors.first();
-	while (pSessionCursor) {
-		pSessionCursor->resetClips();
-		pSessionCursor = pSessionCursor->next();
-	}
-
-//	unlock();
+	// Session cursors will follow on resync...
+	updateSnapshot();
 }
 
 
 void qtractorSession::updateTrack ( qtractorTrack *pTrack )
 {
-//	lock();
-
 	pTrack->setLoop(m_iLoopStart, m_iLoopEnd);
 
-	qtractorSessionCursor *pSessionCursor = m_cursors.first();
-	while (pSessionCursor) {
-		pSessionCursor->updateTrack(pTrack);
-		pSessionCursor = pSessionCursor->next();
-	}
+	// Have session cursors relocate on this track...
+	pTrack->updateClipsRevision();
 
-//	unlock();
+	// Withdrawn clips get it all republished on restore...
+	if (m_withdrawnClips.isEmpty())
+		updateSnapshot();
 }
 
 
 void qtractorSession::unlinkTrack ( qtractorTrack *pTrack )
 {
-//	lock();
+	// Withdraw from render snapshot first,
+	// before the track gets closed...
+	m_tracks.unlink(pTrack);
+
+	updateSnapshot();
+
+	// Make sure no one is still rendering the unlinked track...
+	m_pEpoch->synchronize();
 
 	pTrack->setLoop(0, 0);
 	pTrack->close();
 
-	qtractorSessionCursor *pSessionCursor = m_cursors.first();
-	while (pSessionCursor) {
-		pSessionCursor->removeTrack(pTrack);
-		pSessionCursor = pSessionCursor->next();
-	}
-
 	if (pTrack->isRecord())
 		setRecordTracks(false);
 	if (pTrack->isMute())
@@ -1007,10 +1019,6 @@ void qtractorSession::unlinkTrack ( qtractorTrack *pTrack )
 
 	if (pTrack->trackType() == qtractorTrack::Midi)
 		releaseMidiTag(pTrack);
-
-	m_tracks.unlink(pTrack);
-
-//	unlock();
 }
 
 
@@ -1268,6 +1276,10 @@ void qtractorSession::seek ( unsigned long iFrame, bool bSync )
 
 	m_pAudioEngine->sessionCursor()->seek(iFrame, bSync);
 	m_pMidiEngine->sessionCursor()->seek(iFrame, bSync);
+
+	// Scheduled JACK MIDI output is now off the timeline...
+	if (bSync)
+		m_pMidiEngine->resetJackPorts();
 }
 
 
@@ -1312,6 +1324,58 @@ bool qtractorSession::isBusy (void) const
 }
 
 
+// Render snapshot publisher (RCU) accessor.
+qtractorSessionEpoch *qtractorSession::epoch (void) const
+{
+	return m_pEpoch;
+}
+
+
+// (Re)publish current track list render snapshot.
+void qtractorSession::updateSnapshot (void)
+{
+	m_pEpoch->publish(
+		new qtractorSessionSnapshot(m_tracks, m_withdrawnClips));
+}
+
+
+// Withdraw clips from the render snapshot, waiting for
+// all process cycles to let go of them (non RT-safe).
+void qtractorSession::withdrawClips ( const QList<qtractorClip *>& clips )
+{
+	QListIterator<qtractorClip *> iter(clips);
+	while (iter.hasNext()) {
+		qtractorClip *pClip = iter.next();
+		if (m_withdrawnClips.contains(pClip))
+			continue;
+		m_withdrawnClips.append(pClip);
+		qtractorTrack *pTrack = pClip->track();
+		if (pTrack)
+			pTrack->updateClipsRevision();
+	}
+
+	updateSnapshot();
+
+	m_pEpoch->synchronize();
+}
+
+
+// Republish all withdrawn clips back (non RT-safe).
+void qtractorSession::restoreClips (void)
+{
+	QListIterator<qtractorClip *> iter(m_withdrawnClips);
+	while (iter.hasNext()) {
+		qtractorTrack *pTrack = iter.next()->track();
+		if (pTrack)
+			pTrack->updateClipsRevision();
+	}
+
+	m_withdrawnClips.clear();
+
+	updateSnapshot();
+}
+
+
 // Playhead positioning.
 void qtractorSession::setPlayHead ( unsigned long iPlayHead )
 {
@@ -1447,6 +1511,9 @@ void qtractorSession::setLoop (
 	m_pAudioEngine->sessionCursor()->seek(iFrame, true);
 	m_pMidiEngine->sessionCursor()->seek(iFrame, true);
 
+	// Scheduled JACK MIDI output is now off the loop...
+	m_pMidiEngine->resetJackPorts();
+
 	setPlaying(bPlaying);
 	unlock();
 }
@@ -2003,10 +2070,28 @@ void qtractorSession::process (
 {
 	const qtractorTrack::TrackType syncType = pSessionCursor->syncType();
 
+	// Render snapshot read-side section...
+	const unsigned int iEpoch = m_pEpoch->enter();
+	qtractorSessionSnapshot *pSnapshot = m_pEpoch->snapshot();
+
+	// Session cursor track clips follow the snapshot...
+	pSessionCursor->resync(pSnapshot);
+
+	// Audio tracks may be processed in parallel...
+	if (syncType == qtractorTrack::Audio) {
+		qtractorAudioGraph *pAudioGraph = m_pAudioEngine->audioGraph();
+		if (pAudioGraph && pAudioGraph->workers() > 0) {
+			pAudioGraph->process(pSnapshot,
+				pSessionCursor, iFrameStart, iFrameEnd);
+			m_pEpoch->leave(iEpoch);
+			return;
+		}
+	}
+
 	// Now, for every track...
-	int iTrack = 0;
-	qtractorTrack *pTrack = m_tracks.first();
-	while (pTrack) {
+	const unsigned int iTracks = (pSnapshot ? pSnapshot->tracks() : 0);
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
 		// Track automation processing...
 		if (syncType == qtractorTrack::Audio) {
 			qtractorCurveList *pCurveList = pTrack->curveList();
@@ -2014,12 +2099,11 @@ void qtractorSession::process (
 				pCurveList->process(iFrameStart);
 		}
 		if (syncType == pTrack->trackType()) {
-			pTrack->process(pSessionCursor->clip(iTrack),
+			pTrack->process(pSessionCursor->clips(iTrack),
 				iFrameStart, iFrameEnd);
 		}
-		pTrack = pTrack->next();
-		++iTrack;
 	}
+	m_pEpoch->leave(iEpoch);
 }
 
 
@@ -2027,12 +2111,16 @@ void qtractorSession::process (
 void qtractorSession::process_record (
 	unsigned long iFrameStart, unsigned long iFrameEnd )
 {
-	// Now, for every Audio track...
-	for (qtractorTrack *pTrack = m_tracks.first();
-			pTrack; pTrack = pTrack->next()) {
+	// Now, for every Audio track (on current render snapshot)...
+	const unsigned int iEpoch = m_pEpoch->enter();
+	qtractorSessionSnapshot *pSnapshot = m_pEpoch->snapshot();
+	const unsigned int iTracks = (pSnapshot ? pSnapshot->tracks() : 0);
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
 		if (pTrack->trackType() == qtractorTrack::Audio && pTrack->isRecord())
 			pTrack->process_record(iFrameStart, iFrameEnd);
 	}
+	m_pEpoch->leave(iEpoch);
 }
 
 
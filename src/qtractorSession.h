@@ -39,6 +39,7 @@ class qtractorMidiEngine;
 class qtractorAudioEngine;
 class qtractorAudioPeakFactory;
 class qtractorSessionCursor;
+class qtractorSessionEpoch;
 class qtractorMidiManager;
 class qtractorInstrumentList;
 class qtractorCommandList;
@@ -237,6 +238,19 @@ public:
 	// Re-entrancy check.
 	bool isBusy() const;
 
+	// Render snapshot publisher (RCU) accessor.
+	qtractorSessionEpoch *epoch() const;
+
+	// (Re)publish current track list render snapshot.
+	void updateSnapshot();
+
+	// Withdraw clips from the render snapshot, waiting for
+	// all process cycles to let go of them (non RT-safe).
+	void withdrawClips(const QList<qtractorClip *>& clips);
+
+	// Republish all withdrawn clips back (non RT-safe).
+	void restoreClips();
+
 	// Consolidated session engine start status.
 	void setPlaying(bool bPlaying);
 	bool isPlaying() const;
@@ -447,6 +461,12 @@ private:
 	// Managed session cursors.
 	qtractorList<qtractorSessionCursor> m_cursors;
 
+	// Render snapshot publisher (RCU).
+	qtractorSessionEpoch *m_pEpoch;
+
+	// Clips currently withdrawn from render snapshot.
+	QList<qtractorClip *> m_withdrawnClips;
+
 	// Device engine common client name.
 	QString m_sClientName;
 
@@ -22,8 +22,11 @@
 #include "qtractorAbout.h"
 #include "qtractorSessionCursor.h"
 #include "qtractorSession.h"
+#include "qtractorSessionSnapshot.h"
 #include "qtractorClip.h"
 
+#include <QThread>
+
 
 //----------------------------------------------------------------------
 // class qtractorSessionCursor - implementation.
@@ -37,9 +40,15 @@ qtractorSessionCursor::qtractorSessionCursor ( qtractorSession *pSession,
 	m_iFrame   = iFrame;
 	m_syncType = syncType;
 
-	m_iTracks  = 0;
-	m_ppClips  = nullptr;
-	m_iSize    = 0;
+	m_pSnapshot = nullptr;
+	m_iSerial   = 0;
+
+	m_iTracks   = 0;
+	m_piItems   = nullptr;
+	m_piItemsEx = nullptr;
+	m_iSize     = 0;
+
+	ATOMIC_SET(&m_busy, 0);
 
 	resetClips();
 	reset();
@@ -51,8 +60,10 @@ qtractorSessionCursor::~qtractorSessionCursor (void)
 {
 	m_pSession->unlinkSessionCursor(this);
 
-	if (m_ppClips)
-		delete [] m_ppClips;
+	if (m_piItemsEx)
+		delete [] m_piItemsEx;
+	if (m_piItems)
+		delete [] m_piItems;
 }
 
 
@@ -80,20 +91,33 @@ void qtractorSessionCursor::seek ( unsigned long iFrame, bool bSync )
 	if (iFrame == m_iFrame)
 		return;
 
-	unsigned int iTrack = 0; 
-	qtractorTrack *pTrack = m_pSession->tracks().first();
-	while (pTrack && iTrack < m_iTracks) {
-		qtractorClip *pClip = nullptr;
-		qtractorClip *pClipLast = m_ppClips[iTrack];
+	// Render snapshot read-side section...
+	qtractorSessionEpoch *pEpoch = m_pSession->epoch();
+	const unsigned int iEpoch = pEpoch->enter();
+	qtractorSessionSnapshot *pSnapshot = pEpoch->snapshot();
+
+	lockItems();
+
+	resyncItems(pSnapshot);
+
+	for (unsigned int iTrack = 0; iTrack < m_iTracks; ++iTrack) {
+		qtractorTrack *pTrack = pSnapshot->track(iTrack);
+		qtractorClip **ppClips = pSnapshot->clips(iTrack);
+		unsigned int *piItem = m_piItems + (iTrack << 1);
+		const unsigned int iClipLast = piItem[1];
+		unsigned int iClip = 0;
 		// Optimize if seeking forward...
 		if (iFrame > m_iFrame)
-			pClip = pClipLast;
+			iClip = iClipLast;
 		// Locate first clip not past the target frame position..
-		pClip = seekClip(pTrack, pClip, iFrame);
+		iClip = seekClip(ppClips, iClip, iFrame);
 		// Update cursor track clip...
-		m_ppClips[iTrack] = pClip;
+		piItem[1] = iClip;
 		// Now something fulcral for clips around...
 		if (pTrack->trackType() == m_syncType) {
+			qtractorClip *pClipLast = ppClips[iClipLast];
+			qtractorClip **ppClip = ppClips + iClip;
+			qtractorClip *pClip = *ppClip;
 			// Tell whether play-head is after loop-start position...
 			const bool bLooping = (iFrame >= m_pSession->loopStart());
 			// Care for old/previous clip...
@@ -114,15 +138,16 @@ void qtractorSessionCursor::seek ( unsigned long iFrame, bool bSync )
 					} else {
 						pClip->reset(bLooping);
 					}
-					pClip = pClip->next();
+					pClip = *++ppClip;
 				}
 			}
 		}
-		// Next track...
-		pTrack = pTrack->next();
-		++iTrack;
 	}
 
+	unlockItems();
+
+	pEpoch->leave(iEpoch);
+
 	// Done.
 	m_iFrame = iFrame;
 }
@@ -148,124 +173,135 @@ unsigned long qtractorSessionCursor::frameTimeEx (void) const
 }
 
 
-// Current track clip accessor.
-qtractorClip *qtractorSessionCursor::clip ( unsigned int iTrack ) const
+// Current track clip accessor (non RT-safe).
+qtractorClip *qtractorSessionCursor::clip ( unsigned int iTrack )
 {
-	return (iTrack < m_iTracks ? m_ppClips[iTrack] : nullptr);
+	// The publisher side owns the current snapshot anyway...
+	resync(m_pSession->epoch()->snapshot());
+
+	qtractorClip **ppClips = clips(iTrack);
+	return (ppClips ? *ppClips : nullptr);
 }
 
 
-// Clip locate method.
-qtractorClip *qtractorSessionCursor::seekClip (
-	qtractorTrack *pTrack, qtractorClip *pClip, unsigned long iFrame ) const
+// Current track clip array position (RT-safe).
+qtractorClip **qtractorSessionCursor::clips ( unsigned int iTrack ) const
 {
-	if (pClip == nullptr)
-		pClip = pTrack->clips().first();
+	if (iTrack < m_iTracks)
+		return m_pSnapshot->clips(iTrack) + m_piItems[(iTrack << 1) + 1];
+	else
+		return nullptr;
+}
 
-	while (pClip && iFrame > pClip->clipStart() + pClip->clipLength()) {
-	//	if (pTrack->trackType() == m_syncType)
-	//		pClip->reset(m_pSession->isLooping());
-		pClip = pClip->next();
-	}
 
-	if (pClip == nullptr)
-		pClip = pTrack->clips().last();
+// Clip locate method.
+unsigned int qtractorSessionCursor::seekClip (
+	qtractorClip **ppClips, unsigned int iClip, unsigned long iFrame ) const
+{
+	qtractorClip *pClip = ppClips[iClip];
+	while (pClip && iFrame > pClip->clipStart() + pClip->clipLength())
+		pClip = ppClips[++iClip];
+
+	// Stay on the last one, if any...
+	if (pClip == nullptr && iClip > 0)
+		--iClip;
 
-	return pClip;
+	return iClip;
 }
 
 
-// Add a track to cursor.
-void qtractorSessionCursor::addTrack ( qtractorTrack *pTrack )
+// Resync to a render snapshot (RT-safe).
+void qtractorSessionCursor::resync ( qtractorSessionSnapshot *pSnapshot )
 {
-	if (pTrack == nullptr)
-		pTrack = m_pSession->tracks().last();
-
-	const unsigned int iTracks = m_iTracks + 1;
-	if (iTracks < m_iSize) {
-		updateClips(m_ppClips, iTracks);
-	} else {
-		m_iSize += iTracks;
-		qtractorClip **ppOldClips = m_ppClips;
-		qtractorClip **ppNewClips = new qtractorClip * [m_iSize];
-		updateClips(ppNewClips, iTracks);
-		m_ppClips = ppNewClips;
-		if (ppOldClips)
-			delete [] ppOldClips;
-	}
-	m_iTracks = iTracks;
+	lockItems();
+	resyncItems(pSnapshot);
+	unlockItems();
 }
 
 
-// Update track after adding/removing a clip from cursor.
-void qtractorSessionCursor::updateTrack ( qtractorTrack *pTrack )
+// Resync to a render snapshot (unguarded).
+void qtractorSessionCursor::resyncItems ( qtractorSessionSnapshot *pSnapshot )
 {
-	const int iTrack = m_pSession->tracks().find(pTrack);
-	if (iTrack >= 0) {
-		qtractorClip *pClip = seekClip(pTrack, nullptr, m_iFrame);
-		if (pClip && pTrack->trackType() == m_syncType
+	const unsigned int iSerial = (pSnapshot ? pSnapshot->serial() : 0);
+	if (m_iSerial == iSerial)
+		return;
+
+	unsigned int iTracks = (pSnapshot ? pSnapshot->tracks() : 0);
+	if (iTracks > m_iSize)
+		iTracks = m_iSize;
+
+	const unsigned int iOldTracks = m_iTracks;
+	const unsigned int *piOldItems = m_piItems;
+	unsigned int *piNewItems = m_piItemsEx;
+
+	for (unsigned int iTrack = 0; iTrack < iTracks; ++iTrack) {
+		const unsigned int iRevision = pSnapshot->revision(iTrack);
+		unsigned int *piItem = piNewItems + (iTrack << 1);
+		piItem[0] = iRevision;
+		// Same clips revision, same clip array,
+		// most probably found at the same index...
+		unsigned int iOldTrack = iTrack;
+		if (iOldTrack >= iOldTracks
+			|| piOldItems[iOldTrack << 1] != iRevision) {
+			for (iOldTrack = 0; iOldTrack < iOldTracks; ++iOldTrack) {
+				if (piOldItems[iOldTrack << 1] == iRevision)
+					break;
+			}
+		}
+		if (iOldTrack < iOldTracks) {
+			piItem[1] = piOldItems[(iOldTrack << 1) + 1];
+			continue;
+		}
+		// Changed track clips: locate and sync anew...
+		qtractorClip **ppClips = pSnapshot->clips(iTrack);
+		const unsigned int iClip = seekClip(ppClips, 0, m_iFrame);
+		piItem[1] = iClip;
+		qtractorClip *pClip = ppClips[iClip];
+		if (pClip && pSnapshot->track(iTrack)->trackType() == m_syncType
 			&& m_iFrame >= pClip->clipStart()
 			&& m_iFrame <  pClip->clipStart() + pClip->clipLength()) {
 			pClip->seek(m_iFrame - pClip->clipStart());
 		}
-		m_ppClips[iTrack] = pClip;
 	}
+
+	m_piItemsEx = m_piItems;
+	m_piItems   = piNewItems;
+	m_iTracks   = iTracks;
+	m_pSnapshot = pSnapshot;
+	m_iSerial   = iSerial;
 }
 
 
-// Remove a track from cursor.
-void qtractorSessionCursor::removeTrack ( qtractorTrack *pTrack )
+// Make room for all session tracks (non RT-safe).
+void qtractorSessionCursor::updateTracks (void)
 {
-	const int iTrack = m_pSession->tracks().find(pTrack);
-	if (iTrack >= 0)
-		removeTrack((unsigned int) iTrack);
-}
+	const unsigned int iTracks = m_pSession->tracks().count();
+	if (iTracks <= m_iSize && m_piItems)
+		return;
 
-void qtractorSessionCursor::removeTrack ( unsigned int iTrack )
-{
-	--m_iTracks;	
-	for ( ; iTrack < m_iTracks; ++iTrack)
-		m_ppClips[iTrack] = m_ppClips[iTrack + 1];
-	m_ppClips[iTrack] = nullptr;
-}
+	const unsigned int iSize = (iTracks << 1) + 1;
+	unsigned int *piNewItems   = new unsigned int [iSize << 1];
+	unsigned int *piNewItemsEx = new unsigned int [iSize << 1];
 
+	lockItems();
 
-// Update current track clip under cursor.
-void qtractorSessionCursor::updateTrackClip ( qtractorTrack *pTrack )
-{
-	const int iTrack = m_pSession->tracks().find(pTrack);
-	if (iTrack >= 0) {
-		qtractorClip *pClip = m_ppClips[iTrack];
-		if (pClip && pTrack->trackType() == m_syncType) {
-			if (m_iFrame >= pClip->clipStart() &&
-				m_iFrame <  pClip->clipStart() + pClip->clipLength()) {
-				pClip->seek(m_iFrame - pClip->clipStart());
-			} else {
-				pClip->reset(m_iFrame >= m_pSession->loopStart());
-			}
-		}
-	}
-}
+	// Keep on the currently resolved items...
+	for (unsigned int i = 0; i < (m_iTracks << 1); ++i)
+		piNewItems[i] = m_piItems[i];
 
+	unsigned int *piOldItems   = m_piItems;
+	unsigned int *piOldItemsEx = m_piItemsEx;
 
-// Update (stabilize) cursor.
-void qtractorSessionCursor::updateClips ( qtractorClip **ppClips,
-	unsigned int iTracks )
-{
-	// Reset clip positions...
-	unsigned int iTrack = 0; 
-	qtractorTrack *pTrack = m_pSession->tracks().first();
-	while (pTrack && iTrack < iTracks) {
-		qtractorClip *pClip = seekClip(pTrack, nullptr, m_iFrame);
-		if (pClip && pTrack->trackType() == m_syncType
-			&& m_iFrame >= pClip->clipStart()
-			&& m_iFrame <  pClip->clipStart() + pClip->clipLength()) {
-			pClip->seek(m_iFrame - pClip->clipStart());
-		}
-		ppClips[iTrack] = pClip;
-		pTrack = pTrack->next();
-		++iTrack;
-	}
+	m_piItems   = piNewItems;
+	m_piItemsEx = piNewItemsEx;
+	m_iSize     = iSize;
+
+	unlockItems();
+
+	// Old items may still be in use (RT)...
+	qtractorSessionEpoch *pEpoch = m_pSession->epoch();
+	pEpoch->retire(piOldItems);
+	pEpoch->retire(piOldItemsEx);
 }
 
 
@@ -288,22 +324,28 @@ void qtractorSessionCursor::resetClips (void)
 	qDebug("qtractorSessionCursor[%p,%d]::resetClips()", this, (int) m_syncType);
 #endif
 
-	// Free existing clip references.
-	if (m_ppClips) {
-		qtractorClip **ppOldClips = m_ppClips;
-		m_ppClips = nullptr;
-		delete [] ppOldClips;
-	}
+	updateTracks();
 
-	// Rebuild the whole bunch...
-	m_iTracks = m_pSession->tracks().count();
-	m_iSize   = (m_iTracks << 1);
+	// Have all tracks located and synced anew...
+	lockItems();
+	m_pSnapshot = nullptr;
+	m_iSerial   = 0;
+	m_iTracks   = 0;
+	unlockItems();
+}
 
-	if (m_iSize > 0) {
-		qtractorClip **ppNewClips = new qtractorClip * [m_iSize];
-		updateClips(ppNewClips, m_iTracks);
-		m_ppClips = ppNewClips;
-	}
+
+// Track items guard (spin-lock); only ever held for
+// a few word copies, either while resyncing or growing.
+void qtractorSessionCursor::lockItems (void)
+{
+	while (!ATOMIC_TAS(&m_busy))
+		QThread::yieldCurrentThread();
+}
+
+void qtractorSessionCursor::unlockItems (void)
+{
+	ATOMIC_SET(&m_busy, 0);
 }
 
 
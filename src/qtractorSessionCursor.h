@@ -23,9 +23,11 @@
 #define __qtractorSessionCursor_h
 
 #include "qtractorTrack.h"
+#include "qtractorAtomic.h"
 
 // Forward declarations.
 class qtractorClip;
+class qtractorSessionSnapshot;
 
 
 //----------------------------------------------------------------------
@@ -59,18 +61,18 @@ public:
 	void setSyncType(qtractorTrack::TrackType syncType);
 	qtractorTrack::TrackType syncType() const;
 
-	// Current track clip accessor.
-	qtractorClip *clip(unsigned int iTrack) const;
+	// Current track clip accessor (non RT-safe).
+	qtractorClip *clip(unsigned int iTrack);
 
-	// Add a track to cursor.
-	void addTrack    (qtractorTrack *pTrack);
-	// Update track after adding/removing a clip from cursor.
-	void updateTrack (qtractorTrack *pTrack);
-	// Remove a track from cursor.
-	void removeTrack (qtractorTrack *pTrack);
+	// Current track clip array position (RT-safe);
+	// valid only after resync, inside a read-side section.
+	qtractorClip **clips(unsigned int iTrack) const;
 
-	// Update current track clip under cursor.
-	void updateTrackClip(qtractorTrack *pTrack);
+	// Resync to a render snapshot (RT-safe).
+	void resync(qtractorSessionSnapshot *pSnapshot);
+
+	// Make room for all session tracks (non RT-safe).
+	void updateTracks();
 
 	// Reset cursor.
 	void reset();
@@ -84,14 +86,15 @@ public:
 protected:
 
 	// Clip locate method.
-	qtractorClip *seekClip(qtractorTrack *pTrack,
-		qtractorClip *pClip, unsigned long iFrame) const;
+	unsigned int seekClip(qtractorClip **ppClips,
+		unsigned int iClip, unsigned long iFrame) const;
 
-	// Update (stabilize) cursor.
-	void updateClips(qtractorClip **ppClips, unsigned int iTracks);
+	// Resync to a render snapshot (unguarded).
+	void resyncItems(qtractorSessionSnapshot *pSnapshot);
 
-	// Remove a track from cursor (by index).
-	void removeTrack (unsigned int iTrack);
+	// Track items guard (spin-lock).
+	void lockItems();
+	void unlockItems();
 
 private:
 
@@ -102,9 +105,19 @@ private:
 	unsigned long            m_iFrameDelta;
 	qtractorTrack::TrackType m_syncType;
 
+	// Resynced render snapshot.
+	qtractorSessionSnapshot *m_pSnapshot;
+	unsigned int             m_iSerial;
+
+	// Track items, as pairs of clips revision
+	// and current clip index (double-buffered).
 	unsigned int   m_iTracks;
-	qtractorClip **m_ppClips;
+	unsigned int  *m_piItems;
+	unsigned int  *m_piItemsEx;
 	unsigned int   m_iSize;
+
+	// Track items guard.
+	qtractorAtomic m_busy;
 };
 
 
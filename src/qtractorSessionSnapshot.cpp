@@ -0,0 +1,239 @@
+// qtractorSessionSnapshot.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorSessionSnapshot.h"
+
+#include "qtractorTrack.h"
+#include "qtractorClip.h"
+#include "qtractorPlugin.h"
+#include "qtractorMidiSequence.h"
+
+#include <QThread>
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionSnapshot -- Session render snapshot (immutable).
+//
+
+// Snapshot serial number generator (publisher side only).
+static unsigned int g_iSnapshotSerial = 0;
+
+// Constructor; all but the withdrawn clips get in.
+qtractorSessionSnapshot::qtractorSessionSnapshot (
+	const qtractorList<qtractorTrack>& tracks,
+	const QList<qtractorClip *>& withdrawn )
+	: m_iSerial(++g_iSnapshotSerial), m_iTracks(0),
+		m_pTracks(nullptr), m_ppClips(nullptr)
+{
+	// Zero is reserved for the unresolved cursor...
+	if (m_iSerial == 0)
+		m_iSerial = ++g_iSnapshotSerial;
+
+	// Count for all clips, plus a terminator per track...
+	unsigned int iClips = 0;
+	qtractorTrack *pTrack = tracks.first();
+	for ( ; pTrack; pTrack = pTrack->next())
+		iClips += pTrack->clips().count() + 1;
+
+	const int iTracks = tracks.count();
+	if (iTracks > 0)
+		m_pTracks = new Track [iTracks];
+
+	m_ppClips = new qtractorClip * [iClips + 1];
+
+	unsigned int iClip = 0;
+	for (pTrack = tracks.first(); pTrack; pTrack = pTrack->next()) {
+		Track& item = m_pTracks[m_iTracks++];
+		item.track    = pTrack;
+		item.revision = pTrack->clipsRevision();
+		item.clips    = iClip;
+		qtractorClip *pClip = pTrack->clips().first();
+		for ( ; pClip; pClip = pClip->next()) {
+			if (!withdrawn.contains(pClip))
+				m_ppClips[iClip++] = pClip;
+		}
+		m_ppClips[iClip++] = nullptr;
+	}
+
+	m_ppClips[iClip] = nullptr;
+}
+
+
+// Destructor.
+qtractorSessionSnapshot::~qtractorSessionSnapshot (void)
+{
+	if (m_ppClips)
+		delete [] m_ppClips;
+	if (m_pTracks)
+		delete [] m_pTracks;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionChain -- Plugin chain render snapshot (immutable).
+//
+
+// Constructor.
+qtractorSessionChain::qtractorSessionChain (
+	const qtractorList<qtractorPlugin>& plugins )
+	: m_iPlugins(0), m_ppPlugins(nullptr)
+{
+	const int iPlugins = plugins.count();
+	if (iPlugins > 0) {
+		m_ppPlugins = new qtractorPlugin * [iPlugins];
+		for (qtractorPlugin *pPlugin = plugins.first();
+				pPlugin; pPlugin = pPlugin->next()) {
+			m_ppPlugins[m_iPlugins++] = pPlugin;
+		}
+	}
+}
+
+
+// Destructor.
+qtractorSessionChain::~qtractorSessionChain (void)
+{
+	if (m_ppPlugins)
+		delete [] m_ppPlugins;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionEpoch -- Session render snapshot publisher (RCU).
+//
+
+// Constructor.
+qtractorSessionEpoch::qtractorSessionEpoch (void)
+	: m_pSnapshot(nullptr)
+{
+	ATOMIC_SET(&m_epoch, 0);
+	ATOMIC_SET(&m_readers[0], 0);
+	ATOMIC_SET(&m_readers[1], 0);
+}
+
+
+// Destructor.
+qtractorSessionEpoch::~qtractorSessionEpoch (void)
+{
+	publish(nullptr);
+	synchronize();
+}
+
+
+// Read-side critical section (RT-safe).
+unsigned int qtractorSessionEpoch::enter (void)
+{
+	const unsigned int iEpoch = (ATOMIC_GET(&m_epoch) & 1);
+	ATOMIC_INC(&m_readers[iEpoch]);
+	return iEpoch;
+}
+
+void qtractorSessionEpoch::leave ( unsigned int iEpoch )
+{
+	ATOMIC_DEC(&m_readers[iEpoch]);
+}
+
+
+// Publish a new snapshot, retiring the old one (non RT-safe).
+void qtractorSessionEpoch::publish ( qtractorSessionSnapshot *pSnapshot )
+{
+	qtractorSessionSnapshot *pOldSnapshot
+		= m_pSnapshot.fetchAndStoreOrdered(pSnapshot);
+	if (pOldSnapshot)
+		m_retiredSnapshots.append(pOldSnapshot);
+
+	reclaim(false);
+}
+
+
+// Deferred reclamation of stale cursor track items (non RT-safe).
+void qtractorSessionEpoch::retire ( unsigned int *piItems )
+{
+	if (piItems)
+		m_retiredItems.append(piItems);
+
+	reclaim(false);
+}
+
+
+// Deferred reclamation of stale plugin chains (non RT-safe).
+void qtractorSessionEpoch::retire ( qtractorSessionChain *pChain )
+{
+	if (pChain)
+		m_retiredChains.append(pChain);
+
+	reclaim(false);
+}
+
+
+// Deferred reclamation of stale MIDI playback forms (non RT-safe).
+void qtractorSessionEpoch::retire ( qtractorMidiPacked *pPacked )
+{
+	if (pPacked)
+		m_retiredPacked.append(pPacked);
+
+	reclaim(false);
+}
+
+
+// Wait for all current readers to leave,
+// then reclaim all retired items (non RT-safe).
+void qtractorSessionEpoch::synchronize (void)
+{
+	// Flip epoch parity twice, draining the old one each time,
+	// so that late readers of the previous parity are caught too.
+	for (int i = 0; i < 2; ++i) {
+		const unsigned int iEpoch = (ATOMIC_GET(&m_epoch) & 1);
+		ATOMIC_CAS(&m_epoch, iEpoch, (iEpoch ^ 1));
+		while (!ATOMIC_CAS(&m_readers[iEpoch], 0, 0))
+			QThread::yieldCurrentThread();
+	}
+
+	reclaim(true);
+}
+
+
+// Reclaim retired items, only if no readers are around.
+void qtractorSessionEpoch::reclaim ( bool bForce )
+{
+	// No readers at all, means no one may hold a retired reference...
+	// (ordered zero tests, as in compare-and-swap zero with zero)
+	if (!bForce && (!ATOMIC_CAS(&m_readers[0], 0, 0)
+		|| !ATOMIC_CAS(&m_readers[1], 0, 0)))
+		return;
+
+	qDeleteAll(m_retiredSnapshots);
+	m_retiredSnapshots.clear();
+
+	QListIterator<unsigned int *> iter(m_retiredItems);
+	while (iter.hasNext())
+		delete [] iter.next();
+	m_retiredItems.clear();
+
+	qDeleteAll(m_retiredChains);
+	m_retiredChains.clear();
+
+	qDeleteAll(m_retiredPacked);
+	m_retiredPacked.clear();
+}
+
+
+// end of qtractorSessionSnapshot.cpp
@@ -0,0 +1,181 @@
+// qtractorSessionSnapshot.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorSessionSnapshot_h
+#define __qtractorSessionSnapshot_h
+
+#include "qtractorAtomic.h"
+#include "qtractorList.h"
+
+#include <QAtomicPointer>
+#include <QList>
+
+
+// Forward declarations.
+class qtractorTrack;
+class qtractorClip;
+class qtractorMidiPacked;
+class qtractorPlugin;
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionSnapshot -- Session render snapshot (immutable).
+//
+
+class qtractorSessionSnapshot
+{
+public:
+
+	// Constructor; all but the withdrawn clips get in.
+	qtractorSessionSnapshot(const qtractorList<qtractorTrack>& tracks,
+		const QList<qtractorClip *>& withdrawn);
+
+	// Destructor.
+	~qtractorSessionSnapshot();
+
+	// Unique snapshot serial number.
+	unsigned int serial() const
+		{ return m_iSerial; }
+
+	// Track array accessors.
+	unsigned int tracks() const
+		{ return m_iTracks; }
+	qtractorTrack *track(unsigned int iTrack) const
+		{ return m_pTracks[iTrack].track; }
+
+	// Track clips revision (unique stamp) accessor.
+	unsigned int revision(unsigned int iTrack) const
+		{ return m_pTracks[iTrack].revision; }
+
+	// Track clip array (null-terminated, in clip-start order).
+	qtractorClip **clips(unsigned int iTrack) const
+		{ return m_ppClips + m_pTracks[iTrack].clips; }
+
+private:
+
+	// Track item.
+	struct Track
+	{
+		qtractorTrack *track;
+		unsigned int   revision;
+		unsigned int   clips;
+	};
+
+	// Instance variables.
+	unsigned int   m_iSerial;
+	unsigned int   m_iTracks;
+	Track         *m_pTracks;
+	qtractorClip **m_ppClips;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionChain -- Plugin chain render snapshot (immutable).
+//
+
+class qtractorSessionChain
+{
+public:
+
+	// Constructor.
+	qtractorSessionChain(const qtractorList<qtractorPlugin>& plugins);
+
+	// Destructor.
+	~qtractorSessionChain();
+
+	// Plugin array accessors.
+	unsigned int plugins() const
+		{ return m_iPlugins; }
+	qtractorPlugin *plugin(unsigned int iPlugin) const
+		{ return m_ppPlugins[iPlugin]; }
+
+private:
+
+	// Instance variables.
+	unsigned int     m_iPlugins;
+	qtractorPlugin **m_ppPlugins;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorSessionEpoch -- Session render snapshot publisher (RCU).
+//
+
+class qtractorSessionEpoch
+{
+public:
+
+	// Constructor.
+	qtractorSessionEpoch();
+
+	// Destructor.
+	~qtractorSessionEpoch();
+
+	// Read-side critical section (RT-safe).
+	unsigned int enter();
+	void leave(unsigned int iEpoch);
+
+	// Current snapshot (valid only inside read-side section).
+	qtractorSessionSnapshot *snapshot() const
+		{ return m_pSnapshot.loadAcquire(); }
+
+	// Publish a new snapshot, retiring the old one (non RT-safe).
+	void publish(qtractorSessionSnapshot *pSnapshot);
+
+	// Deferred reclamation of stale cursor track items (non RT-safe).
+	void retire(unsigned int *piItems);
+
+	// Deferred reclamation of stale plugin chains (non RT-safe).
+	void retire(qtractorSessionChain *pChain);
+
+	// Deferred reclamation of stale MIDI playback forms (non RT-safe).
+	void retire(qtractorMidiPacked *pPacked);
+
+	// Wait for all current readers to leave,
+	// then reclaim all retired items (non RT-safe).
+	void synchronize();
+
+protected:
+
+	// Reclaim retired items, only if no readers are around.
+	void reclaim(bool bForce);
+
+private:
+
+	// Reader counters, one per epoch parity.
+	qtractorAtomic m_epoch;
+	qtractorAtomic m_readers[2];
+
+	// Current published snapshot.
+	QAtomicPointer<qtractorSessionSnapshot> m_pSnapshot;
+
+	// Retired items, pending reclamation.
+	QList<qtractorSessionSnapshot *> m_retiredSnapshots;
+	QList<unsigned int *> m_retiredItems;
+	QList<qtractorSessionChain *> m_retiredChains;
+	QList<qtractorMidiPacked *> m_retiredPacked;
+};
+
+
+#endif  // __qtractorSessionSnapshot_h
+
+
+// end of qtractorSessionSnapshot.h
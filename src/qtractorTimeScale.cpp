@@ -44,6 +44,7 @@ void qtractorTimeScale::reset (void)
 	const unsigned short iBeatDivisor = (pNode ? pNode->beatDivisor : 2);
 
 	// Clear/reset tempo-map...
+	m_index.clear();
 	m_nodes.clear();
 	m_cursor.reset();
 
@@ -94,6 +95,7 @@ void qtractorTimeScale::sync ( const qtractorTimeScale& ts )
 	m_markerCursor.reset();
 
 	// Copy tempo-map nodes...
+	m_index.clear();
 	m_nodes.clear();
 	Node *pNode = ts.nodes().first();
 	while (pNode) {
@@ -262,13 +264,19 @@ qtractorTimeScale::Node *qtractorTimeScale::Cursor::seekFrame (
 	}
 
 	if (iFrame > node->frame) {
-		// Seek frame forward...
+		// Seek frame forward (far away, lookup the index)...
+		Node *pNext = node->next();
+		if (pNext && pNext->next() && iFrame >= (pNext->next())->frame)
+			return (node = ts->indexFrame(iFrame));
 		while (node && node->next() && iFrame >= (node->next())->frame)
 			node = node->next();
 	}
 	else
 	if (iFrame < node->frame) {
-		// Seek frame backward...
+		// Seek frame backward (far away, lookup the index)...
+		Node *pPrev = node->prev();
+		if (pPrev && pPrev->frame > iFrame)
+			return (node = ts->indexFrame(iFrame));
 		while (node && node->frame > iFrame)
 			node = node->prev();
 		if (node == nullptr)
@@ -346,13 +354,19 @@ qtractorTimeScale::Node *qtractorTimeScale::Cursor::seekTick (
 	}
 
 	if (iTick > node->tick) {
-		// Seek tick forward...
+		// Seek tick forward (far away, lookup the index)...
+		Node *pNext = node->next();
+		if (pNext && pNext->next() && iTick >= (pNext->next())->tick)
+			return (node = ts->indexTick(iTick));
 		while (node && node->next() && iTick >= (node->next())->tick)
 			node = node->next();
 	}
 	else
 	if (iTick < node->tick) {
-		// Seek tick backward...
+		// Seek tick backward (far away, lookup the index)...
+		Node *pPrev = node->prev();
+		if (pPrev && pPrev->tick > iTick)
+			return (node = ts->indexTick(iTick));
 		while (node && node->tick > iTick)
 			node = node->prev();
 		if (node == nullptr)
@@ -363,6 +377,28 @@ qtractorTimeScale::Node *qtractorTimeScale::Cursor::seekTick (
 }
 
 
+// Time-scale cursor batch tick/frame converters
+// (best with ascending input).
+void qtractorTimeScale::Cursor::framesFromTicks (
+	const unsigned long *pTicks, unsigned long *pFrames, unsigned int iCount )
+{
+	for (unsigned int i = 0; i < iCount; ++i) {
+		Node *pNode = seekTick(pTicks[i]);
+		pFrames[i] = (pNode ? pNode->frameFromTick(pTicks[i]) : 0);
+	}
+}
+
+
+void qtractorTimeScale::Cursor::ticksFromFrames (
+	const unsigned long *pFrames, unsigned long *pTicks, unsigned int iCount )
+{
+	for (unsigned int i = 0; i < iCount; ++i) {
+		Node *pNode = seekFrame(pFrames[i]);
+		pTicks[i] = (pNode ? pNode->tickFromFrame(pFrames[i]) : 0);
+	}
+}
+
+
 // Time-scale cursor node seeker (by pixel).
 qtractorTimeScale::Node *qtractorTimeScale::Cursor::seekPixel ( int x )
 {
@@ -373,13 +409,19 @@ qtractorTimeScale::Node *qtractorTimeScale::Cursor::seekPixel ( int x )
 	}
 
 	if (x > node->pixel) {
-		// Seek pixel forward...
+		// Seek pixel forward (far away, lookup the index)...
+		Node *pNext = node->next();
+		if (pNext && pNext->next() && x >= (pNext->next())->pixel)
+			return (node = ts->indexPixel(x));
 		while (node && node->next() && x >= (node->next())->pixel)
 			node = node->next();
 	}
 	else
 	if (x < node->pixel) {
-		// Seek tick backward...
+		// Seek pixel backward (far away, lookup the index)...
+		Node *pPrev = node->prev();
+		if (pPrev && pPrev->pixel > x)
+			return (node = ts->indexPixel(x));
 		while (node && node->pixel > x)
 			node = node->prev();
 		if (node == nullptr)
@@ -461,6 +503,9 @@ void qtractorTimeScale::updateNode ( qtractorTimeScale::Node *pNode )
 		pNext = pNext->next();
 	}
 
+	// Rebuild the node index...
+	updateIndex();
+
 	// And update marker/bar positions too...
 	updateMarkers(pNode->prev());
 }
@@ -488,6 +533,9 @@ void qtractorTimeScale::removeNode ( qtractorTimeScale::Node *pNode )
 	// Actually remove/unlink the node...
 	m_nodes.remove(pNode);
 
+	// Rebuild the node index...
+	updateIndex();
+
 	// Then update marker/bar positions too...
 	updateMarkers(pNodePrev);
 }
@@ -510,11 +558,87 @@ void qtractorTimeScale::updateScale (void)
 		pNext = pNext->next();
 	}
 
+	// Rebuild the node index...
+	updateIndex();
+
 	// Also update all marker/bar positions too...
 	updateMarkers(m_nodes.first());
 }
 
 
+// Tempo-map node index (re)builder.
+void qtractorTimeScale::updateIndex (void)
+{
+	m_index.resize(m_nodes.count());
+
+	int i = 0;
+	for (Node *pNode = m_nodes.first(); pNode; pNode = pNode->next())
+		m_index[i++] = pNode;
+}
+
+
+// Tempo-map node index lookup (by frame).
+qtractorTimeScale::Node *qtractorTimeScale::indexFrame (
+	unsigned long iFrame ) const
+{
+	int lo = 0;
+	int hi = m_index.count();
+	if (hi < 1)
+		return m_nodes.first();
+
+	while (hi - lo > 1) {
+		const int mid = ((lo + hi) >> 1);
+		if (m_index.at(mid)->frame > iFrame)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	return m_index.at(lo);
+}
+
+
+// Tempo-map node index lookup (by tick).
+qtractorTimeScale::Node *qtractorTimeScale::indexTick (
+	unsigned long iTick ) const
+{
+	int lo = 0;
+	int hi = m_index.count();
+	if (hi < 1)
+		return m_nodes.first();
+
+	while (hi - lo > 1) {
+		const int mid = ((lo + hi) >> 1);
+		if (m_index.at(mid)->tick > iTick)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	return m_index.at(lo);
+}
+
+
+// Tempo-map node index lookup (by pixel).
+qtractorTimeScale::Node *qtractorTimeScale::indexPixel ( int x ) const
+{
+	int lo = 0;
+	int hi = m_index.count();
+	if (hi < 1)
+		return m_nodes.first();
+
+	while (hi - lo > 1) {
+		const int mid = ((lo + hi) >> 1);
+		if (m_index.at(mid)->pixel > x)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	return m_index.at(lo);
+}
+
+
 // Convert frames to time string and vice-versa.
 unsigned long qtractorTimeScale::frameFromTextEx (
 	DisplayFormat displayFormat,
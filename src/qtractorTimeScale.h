@@ -25,6 +25,7 @@
 #include "qtractorList.h"
 
 #include <QStringList>
+#include <QVector>
 #include <QColor>
 
 // Needed for the translation functions.
@@ -284,6 +285,12 @@ public:
 		Node *seekTick(unsigned long iTick);
 		Node *seekPixel(int x);
 
+		// Batch tick/frame converters (best with ascending input).
+		void framesFromTicks(const unsigned long *pTicks,
+			unsigned long *pFrames, unsigned int iCount);
+		void ticksFromFrames(const unsigned long *pFrames,
+			unsigned long *pTicks, unsigned int iCount);
+
 	protected:
 
 		// Member variables.
@@ -624,6 +631,14 @@ protected:
 	unsigned long timeq ( unsigned long time ) const
 		{ return uint64_t(time) * m_iTicksPerBeat / TICKS_PER_BEAT_HRQ; }
 
+	// Tempo-map node index (re)builder.
+	void updateIndex();
+
+	// Tempo-map node index lookup (by frame, tick or pixel).
+	Node *indexFrame(unsigned long iFrame) const;
+	Node *indexTick(unsigned long iTick) const;
+	Node *indexPixel(int x) const;
+
 private:
 
 	unsigned short m_iSnapPerBeat;      // Snap per beat (divisor).
@@ -639,6 +654,9 @@ private:
 	// Tempo-map node list.
 	qtractorList<Node> m_nodes;
 
+	// Tempo-map node index (binary searchable).
+	QVector<Node *> m_index;
+
 	// Internal node cursor.
 	Cursor m_cursor;
 
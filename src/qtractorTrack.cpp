@@ -57,6 +57,10 @@
 #define MIDI_CHANNEL_VOLUME		0x07
 #define MIDI_CHANNEL_PANNING	0x0a
 
+
+// Clip list revision stamp generator (non RT-safe).
+static unsigned int g_iClipsRevision = 0;
+
 //------------------------------------------------------------------------
 // qtractorTrack::StateObserver -- Local track state observer.
 
@@ -310,9 +314,17 @@ qtractorTrack::qtractorTrack ( qtractorSession *pSession, TrackType trackType )
 	m_bClipRecordEx = false;
 
 	m_clips.setAutoDelete(true);
+	updateClipsRevision();
+
+	m_iLatencyComp = 0;
 
 	m_pSyncThread = nullptr;
 
+	m_iAudioChannels   = 0;
+	m_iAudioBufferSize = 0;
+	m_ppXBuffer = nullptr;
+	m_ppYBuffer = nullptr;
+
 	m_pMidiVolumeObserver  = nullptr;
 	m_pMidiPanningObserver = nullptr;
 
@@ -381,6 +393,8 @@ qtractorTrack::~qtractorTrack (void)
 		delete m_pPluginList;
 	if (m_pMonitor)
 		delete m_pMonitor;
+
+	deleteAudioBuffer();
 }
 
 
@@ -391,6 +405,7 @@ void qtractorTrack::clear (void)
 
 	clearTakeInfo();
 	m_clips.clear();
+	updateClipsRevision();
 
 	m_pPluginList->clear();
 	m_pCurveFile->clear();
@@ -505,6 +520,7 @@ bool qtractorTrack::open (void)
 				pAudioBus->channels(), m_props.gain, m_props.panning);
 			m_pPluginList->setChannels(pAudioBus->channels(),
 				qtractorPluginList::AudioTrack);
+			createAudioBuffer(pAudioBus->channels());
 		}
 		break;
 	}
@@ -1147,6 +1163,45 @@ bool qtractorTrack::isPluginListLatency (void) const
 }
 
 
+// Session-wide delay compensation accessors (non RT-safe).
+bool qtractorTrack::setLatencyComp (
+	unsigned long iLatency, unsigned long iDelay )
+{
+	unsigned short iChannels = 0;
+	if (m_props.trackType == qtractorTrack::Audio && m_pOutputBus) {
+		qtractorAudioBus *pAudioBus
+			= static_cast<qtractorAudioBus *> (m_pOutputBus);
+		iChannels = pAudioBus->channels();
+	}
+
+	const bool bDelay = m_latencyDelay.setDelay(iChannels, iDelay);
+	if (iLatency == m_iLatencyComp && !bDelay)
+		return false;
+
+	m_iLatencyComp = iLatency;
+	return true;
+}
+
+
+// Reset main output path delay line contents.
+void qtractorTrack::resetLatencyDelay (void)
+{
+	m_latencyDelay.reset();
+}
+
+
+// Main output path delay processing (RT-safe).
+void qtractorTrack::processLatencyDelay (
+	float **ppBuffer, unsigned int nframes )
+{
+	if (m_props.trackType == qtractorTrack::Audio && m_pOutputBus) {
+		qtractorAudioBus *pAudioBus
+			= static_cast<qtractorAudioBus *> (m_pOutputBus);
+		m_latencyDelay.process(ppBuffer, nframes, pAudioBus->channels());
+	}
+}
+
+
 // Normalized view height accessors.
 int qtractorTrack::height (void) const
 {
@@ -1250,12 +1305,16 @@ void qtractorTrack::insertClip ( qtractorClip *pClip )
 		m_clips.insertBefore(pClip, pNextClip);
 	else
 		m_clips.append(pClip);
+
+	updateClipsRevision();
 }
 
 
 void qtractorTrack::unlinkClip ( qtractorClip *pClip )
 {
 	m_clips.unlink(pClip);
+
+	updateClipsRevision();
 }
 
 void qtractorTrack::removeClip ( qtractorClip *pClip )
@@ -1267,6 +1326,17 @@ void qtractorTrack::removeClip ( qtractorClip *pClip )
 }
 
 
+// Clip list revision (unique stamp, render snapshot hint).
+void qtractorTrack::updateClipsRevision (void)
+{
+	// Zero is reserved for the unresolved cursor...
+	if (++g_iClipsRevision == 0)
+		++g_iClipsRevision;
+
+	m_iClipsRevision = g_iClipsRevision;
+}
+
+
 // Current clip on record (capture).
 void qtractorTrack::setClipRecord ( qtractorClip *pClipRecord )
 {
@@ -1447,11 +1517,27 @@ void qtractorTrack::resetProperties (void)
 
 
 // Track special process cycle executive.
-void qtractorTrack::process ( qtractorClip *pClip,
+void qtractorTrack::process ( qtractorClip **ppClips,
 	unsigned long iFrameStart, unsigned long iFrameEnd )
 {
-	// Audio-buffers needs some preparation...
+	process_buffer(ppClips, iFrameStart, iFrameEnd);
+	process_commit(iFrameEnd - iFrameStart);
+}
+
+
+// Track special process cycle executive (private buffer stage).
+void qtractorTrack::process_buffer ( qtractorClip **ppClips,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	// Audio-buffers must fit the whole cycle...
 	const unsigned int nframes = iFrameEnd - iFrameStart;
+	if (m_props.trackType == qtractorTrack::Audio
+		&& nframes > m_iAudioBufferSize)
+		return;
+
+	const unsigned long long t0 = qtractorDspLoad::start();
+
+	// Audio-buffers needs some preparation...
 	qtractorAudioMonitor *pAudioMonitor = nullptr;
 	qtractorAudioBus *pOutputBus = nullptr;
 	if (m_props.trackType == qtractorTrack::Audio) {
@@ -1461,37 +1547,59 @@ void qtractorTrack::process ( qtractorClip *pClip,
 		if (pOutputBus) {
 			qtractorAudioBus *pInputBus = (m_pSession->isTrackMonitor(this)
 				? static_cast<qtractorAudioBus *> (m_pInputBus) : nullptr);
-			pOutputBus->buffer_prepare(nframes, pInputBus);
+			pOutputBus->buffer_prepare(nframes, pInputBus,
+				m_ppXBuffer, m_ppYBuffer);
 		}
 	}
 
 	// Playback...
 	if (!isMute() && (!m_pSession->soloTracks() || isSolo())) {
-		const unsigned long iLatency = m_pPluginList->latency();
+		const unsigned long iLatency = m_iLatencyComp;
 		const unsigned long iFrameStart2 = iFrameStart + iLatency;
 		const unsigned long iFrameEnd2 = iFrameEnd + iLatency;
-		// Now, for every clip...
+		// Now, for every clip (null-terminated)...
+		qtractorClip *pClip = (ppClips ? *ppClips : nullptr);
 		while (pClip && pClip->clipStart() < iFrameEnd2) {
 			if (iFrameStart2 < pClip->clipStart() + pClip->clipLength())
 				pClip->process(iFrameStart2, iFrameEnd2);
-			pClip = pClip->next();
+			pClip = *++ppClips;
 		}
 	}
 
-	// Audio buffers needs monitoring and commitment...
+	// Audio buffers needs monitoring...
 	if (pAudioMonitor && pOutputBus) {
 		// Plugin chain post-processing...
-		m_pPluginList->process(pOutputBus->buffer(), nframes);
+		m_pPluginList->process(m_ppYBuffer, nframes);
+		// Delay compensation (main output path)...
+		m_latencyDelay.process(m_ppYBuffer, nframes, pOutputBus->channels());
 		// Monitor passthru...
-		pAudioMonitor->process(pOutputBus->buffer(), nframes);
-		// Actually render it...
-		pOutputBus->buffer_commit(nframes);
+		pAudioMonitor->process(m_ppYBuffer, nframes);
+	}
+
+	m_dspProbe.add(t0);
+}
+
+
+// Track special process cycle executive (bus commit stage).
+void qtractorTrack::process_commit ( unsigned int nframes )
+{
+	if (m_props.trackType != qtractorTrack::Audio
+		|| nframes > m_iAudioBufferSize)
+		return;
+
+	// Actually render it...
+	qtractorAudioBus *pOutputBus
+		= static_cast<qtractorAudioBus *> (m_pOutputBus);
+	if (pOutputBus && m_pMonitor) {
+		const unsigned long long t0 = qtractorDspLoad::start();
+		pOutputBus->buffer_commit(nframes, m_ppXBuffer);
+		m_dspProbe.add(t0);
 	}
 }
 
 
 // Freewheeling process cycle executive (needed for export).
-void qtractorTrack::process_export ( qtractorClip *pClip,
+void qtractorTrack::process_export ( qtractorClip **ppClips,
 	unsigned long iFrameStart, unsigned long iFrameEnd )
 {
 	// Track automation processing...
@@ -1499,38 +1607,55 @@ void qtractorTrack::process_export ( qtractorClip *pClip,
 	if (pCurveList && pCurveList->isProcess())
 		pCurveList->process(iFrameStart);
 
-	// Audio-buffers needs some preparation...
+	process_export_buffer(ppClips, iFrameStart, iFrameEnd);
+	process_commit(iFrameEnd - iFrameStart);
+}
+
+
+// Freewheeling process cycle executive (private buffer stage).
+void qtractorTrack::process_export_buffer ( qtractorClip **ppClips,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	// Audio-buffers must fit the whole cycle...
 	const unsigned int nframes = iFrameEnd - iFrameStart;
+	if (m_props.trackType == qtractorTrack::Audio
+		&& nframes > m_iAudioBufferSize)
+		return;
+
+	// Audio-buffers needs some preparation...
 	qtractorAudioMonitor *pAudioMonitor = nullptr;
 	qtractorAudioBus *pOutputBus = nullptr;
 	if (m_props.trackType == qtractorTrack::Audio) {
 		pAudioMonitor = static_cast<qtractorAudioMonitor *> (m_pMonitor);
 		pOutputBus = static_cast<qtractorAudioBus *> (m_pOutputBus);
-		if (pOutputBus)
-			pOutputBus->buffer_prepare(nframes);
+		if (pOutputBus) {
+			pOutputBus->buffer_prepare(nframes, nullptr,
+				m_ppXBuffer, m_ppYBuffer);
+		}
 	}
 
 	// Playback...
 	if (!isMute() && (!m_pSession->soloTracks() || isSolo())) {
-		const unsigned long iLatency = m_pPluginList->latency();
+		const unsigned long iLatency = m_iLatencyComp;
 		const unsigned long iFrameStart2 = iFrameStart + iLatency;
 		const unsigned long iFrameEnd2 = iFrameEnd + iLatency;
-		// Now, for every clip...
+		// Now, for every clip (null-terminated)...
+		qtractorClip *pClip = (ppClips ? *ppClips : nullptr);
 		while (pClip && pClip->clipStart() < iFrameEnd2) {
 			if (iFrameStart2 < pClip->clipStart() + pClip->clipLength())
 				pClip->process_export(iFrameStart2, iFrameEnd2);
-			pClip = pClip->next();
+			pClip = *++ppClips;
 		}
 	}
 
-	// Audio buffers needs monitoring and commitment...
+	// Audio buffers needs monitoring...
 	if (pAudioMonitor && pOutputBus) {
 		// Plugin chain post-processing...
-		m_pPluginList->process(pOutputBus->buffer(), nframes);
+		m_pPluginList->process(m_ppYBuffer, nframes);
+		// Delay compensation (main output path)...
+		m_latencyDelay.process(m_ppYBuffer, nframes, pOutputBus->channels());
 		// Monitor passthru...
-		pAudioMonitor->process(pOutputBus->buffer(), nframes);
-		// Actually render it...
-		pOutputBus->buffer_commit(nframes);
+		pAudioMonitor->process(m_ppYBuffer, nframes);
 	}
 }
 
@@ -1726,6 +1851,102 @@ qtractorAudioBufferThread *qtractorTrack::syncThread (void)
 }
 
 
+// Audio track (private) mix-down buffer accessor.
+float **qtractorTrack::audioBuffer (void) const
+{
+	return m_ppYBuffer;
+}
+
+
+// Audio track (private) whole-cycle buffer accessors (export).
+float **qtractorTrack::audioBufferEx (void) const
+{
+	return m_ppXBuffer;
+}
+
+unsigned short qtractorTrack::audioChannels (void) const
+{
+	return m_iAudioChannels;
+}
+
+
+// Audio track (private) mix-down buffer (re)allocation.
+void qtractorTrack::createAudioBuffer ( unsigned short iChannels )
+{
+	qtractorAudioEngine *pAudioEngine = m_pSession->audioEngine();
+	if (pAudioEngine == nullptr)
+		return;
+
+	unsigned int iBufferSize = pAudioEngine->bufferSizeEx();
+	if (m_ppXBuffer
+		&& m_iAudioChannels == iChannels
+		&& m_iAudioBufferSize == iBufferSize)
+		return;
+
+	float **ppNewXBuffer = nullptr;
+	float **ppNewYBuffer = nullptr;
+
+	if (iChannels > 0 && iBufferSize > 0) {
+		ppNewXBuffer = new float * [iChannels];
+		ppNewYBuffer = new float * [iChannels];
+		for (unsigned short i = 0; i < iChannels; ++i) {
+			ppNewXBuffer[i] = new float [iBufferSize];
+			ppNewYBuffer[i] = ppNewXBuffer[i];
+			::memset(ppNewXBuffer[i], 0, iBufferSize * sizeof(float));
+		}
+	} else {
+		iChannels = 0;
+		iBufferSize = 0;
+	}
+
+	// Make it sure we're not in the middle of a cycle,
+	// as this gets called on any track (re)open...
+	m_pSession->lock();
+
+	float **ppOldXBuffer = m_ppXBuffer;
+	float **ppOldYBuffer = m_ppYBuffer;
+	const unsigned short iOldChannels = m_iAudioChannels;
+
+	m_iAudioChannels   = iChannels;
+	m_iAudioBufferSize = iBufferSize;
+	m_ppYBuffer = ppNewYBuffer;
+	m_ppXBuffer = ppNewXBuffer;
+
+	m_pSession->unlock();
+
+	if (ppOldXBuffer) {
+		for (unsigned short i = 0; i < iOldChannels; ++i)
+			delete [] ppOldXBuffer[i];
+		delete [] ppOldXBuffer;
+	}
+
+	if (ppOldYBuffer)
+		delete [] ppOldYBuffer;
+}
+
+
+void qtractorTrack::deleteAudioBuffer (void)
+{
+	float **ppXBuffer = m_ppXBuffer;
+	float **ppYBuffer = m_ppYBuffer;
+
+	m_ppXBuffer = nullptr;
+	m_ppYBuffer = nullptr;
+
+	if (ppXBuffer) {
+		for (unsigned short i = 0; i < m_iAudioChannels; ++i)
+			delete [] ppXBuffer[i];
+		delete [] ppXBuffer;
+	}
+
+	if (ppYBuffer)
+		delete [] ppYBuffer;
+
+	m_iAudioChannels   = 0;
+	m_iAudioBufferSize = 0;
+}
+
+
 // Track state (monitor record, mute, solo) button setup.
 qtractorSubject *qtractorTrack::monitorSubject (void) const
 {
@@ -25,6 +25,8 @@
 #include "qtractorList.h"
 
 #include "qtractorMidiControl.h"
+#include "qtractorDspLoad.h"
+#include "qtractorAudioDelay.h"
 
 #include <QColor>
 
@@ -177,10 +179,28 @@ public:
 	// Track plugin-chain accessor.
 	qtractorPluginList *pluginList() const;
 
+	// DSP time probe (instrumentation).
+	qtractorDspProbe& dspProbe()
+		{ return m_dspProbe; }
+
 	// Plugin latency compensation accessors.
 	void setPluginListLatency(bool bPluginListLatency);
 	bool isPluginListLatency() const;
 
+	// Session-wide delay compensation accessors (non RT-safe):
+	// clip read-ahead and main output path delay (in frames).
+	bool setLatencyComp(unsigned long iLatency, unsigned long iDelay);
+	unsigned long latencyComp() const
+		{ return m_iLatencyComp; }
+	unsigned long latencyDelay() const
+		{ return m_latencyDelay.delay(); }
+
+	// Reset main output path delay line contents.
+	void resetLatencyDelay();
+
+	// Main output path delay processing (RT-safe).
+	void processLatencyDelay(float **ppBuffer, unsigned int nframes);
+
 	// Base height (in pixels).
 	enum { HeightMin = 24, HeightBase = 96 };
 
@@ -203,6 +223,11 @@ public:
 	void unlinkClip(qtractorClip *pClip);
 	void removeClip(qtractorClip *pClip);
 
+	// Clip list revision (unique stamp, render snapshot hint).
+	unsigned int clipsRevision() const
+		{ return m_iClipsRevision; }
+	void updateClipsRevision();
+
 	// Current clip on record (capture).
 	void setClipRecord(qtractorClip *pClipRecord);
 	qtractorClip *clipRecord() const;
@@ -227,11 +252,20 @@ public:
 	static QColor trackColor(int iTrack);
 
 	// Track special process cycle executive.
-	void process(qtractorClip *pClip,
+	void process(qtractorClip **ppClips,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Track special process cycle executive (split stages).
+	void process_buffer(qtractorClip **ppClips,
 		unsigned long iFrameStart, unsigned long iFrameEnd);
+	void process_commit(unsigned int nframes);
 
 	// Track freewheeling process cycle executive (needed for export).
-	void process_export(qtractorClip *pClip,
+	void process_export(qtractorClip **ppClips,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Track freewheeling process cycle executive (private buffer stage).
+	void process_export_buffer(qtractorClip **ppClips,
 		unsigned long iFrameStart, unsigned long iFrameEnd);
 
 	// Track special process record executive (audio recording only).
@@ -258,6 +292,13 @@ public:
 	// Audio buffer ring-cache (playlist) methods.
 	qtractorAudioBufferThread *syncThread();
 
+	// Audio track (private) mix-down buffer accessor.
+	float **audioBuffer() const;
+
+	// Audio track (private) whole-cycle buffer accessors (export).
+	float **audioBufferEx() const;
+	unsigned short audioChannels() const;
+
 	// Track state (monitor, record, mute, solo) button setup.
 	qtractorSubject *monitorSubject() const;
 	qtractorSubject *recordSubject() const;
@@ -376,6 +417,12 @@ public:
 	static void setTrackColorSaturation(int iTrackColorSaturation);
 	static int trackColorSaturation();
 
+protected:
+
+	// Audio track (private) mix-down buffer (re)allocation.
+	void createAudioBuffer(unsigned short iChannels);
+	void deleteAudioBuffer();
+
 private:
 
 	qtractorSession *m_pSession;    // Session reference.
@@ -400,6 +447,7 @@ private:
 	int              m_iZoomHeight; // View height (zoomed).
 
 	qtractorList<qtractorClip> m_clips; // List of clips.
+	unsigned int m_iClipsRevision;      // Clip list revision stamp.
 
 	qtractorClip *m_pClipRecord;        // Current clip on record (capture).
 	unsigned long m_iClipRecordStart;   // Current clip on record start frame.
@@ -408,9 +456,20 @@ private:
 
 	qtractorPluginList *m_pPluginList;	// Plugin chain (audio).
 
+	qtractorDspProbe m_dspProbe;        // DSP time probe.
+
+	unsigned long      m_iLatencyComp;  // Delay compensation read-ahead.
+	qtractorAudioDelay m_latencyDelay;  // Delay compensation output line.
+
 	// Audio buffer ring-cache (playlist).
 	qtractorAudioBufferThread *m_pSyncThread;
 
+	// Audio track (private) mix-down buffer.
+	unsigned short m_iAudioChannels;
+	unsigned int   m_iAudioBufferSize;
+	float        **m_ppXBuffer;
+	float        **m_ppYBuffer;
+
 	// MIDI track/channel (volume, panning) observers.
 	class MidiVolumeObserver;
 	class MidiPanningObserver;
@@ -82,6 +82,13 @@
 // Follow-playhead: maximum iterations on hold.
 #define QTRACTOR_SYNC_VIEW_HOLD 46
 
+// Track lane tile width and rendering margin (in pixels).
+#define QTRACTOR_TILE_WIDTH  256
+#define QTRACTOR_TILE_MARGIN 8
+
+// Track lane tiles cache maximum cost (in KB).
+#define QTRACTOR_TILES_MAX_COST (64 * 1024)
+
 
 //----------------------------------------------------------------------------
 // qtractorTrackView::ClipBoard - Local clipaboard singleton.
@@ -123,6 +130,13 @@ qtractorTrackView::qtractorTrackView ( qtractorTracks *pTracks,
 	m_pEditCurveNodeSpinBox = nullptr;
 	m_iEditCurveNodeDirty = 0;
 
+	m_tiles.setMaxCost(QTRACTOR_TILES_MAX_COST);
+
+	m_iTilesStamp   = 0;
+	m_iTilesKeep    = 0;
+	m_bTilesPartial = false;
+	m_bTilesAhead   = false;
+
 	clear();
 
 	// Zoom tool widgets
@@ -253,6 +267,9 @@ void qtractorTrackView::clear (void)
 	m_pDragCurveNode = nullptr;
 	m_iDragCurveX = 0;
 
+	m_tiles.clear();
+	m_bTilesPartial = false;
+
 	qtractorScrollView::setContentsPos(0, 0);
 }
 
@@ -306,10 +323,11 @@ void qtractorTrackView::updateContentsWidth ( int iContentsWidth )
 		qtractorAudioPeakFactory *pPeakFactory = pSession->audioPeakFactory();
 		if (pPeakFactory) {
 			const unsigned short iPeakPeriod = pPeakFactory->peakPeriod();
-			// Should we change resolution?
+			// Should we change resolution? Only ever finer,
+			// as coarser ones are already there (mipmap levels)...
 			const int p2 = ((iSessionLength / iPeakPeriod) >> 1) + 1;
-			int q2 = (iSessionWidth / p2);
-			if (q2 > 4) {
+			const int q2 = (iSessionWidth / p2);
+			if (q2 > 4 && (iPeakPeriod >> 3) > 0) {
 				pPeakFactory->setPeakPeriod(iPeakPeriod >> 3);
 			#ifdef CONFIG_DEBUG
 				qDebug("qtractorTrackView::updateContentsWidth() "
@@ -319,20 +337,6 @@ void qtractorTrackView::updateContentsWidth ( int iContentsWidth )
 					pPeakFactory->peakPeriod(), iPeakPeriod, p2, q2);
 			#endif
 			}
-			else
-			if (q2 < 2 && iSessionWidth > 1) {
-				q2 = (p2 / iSessionWidth);
-				if (q2 > 4) {
-					pPeakFactory->setPeakPeriod(iPeakPeriod << 3);
-				#ifdef CONFIG_DEBUG
-					qDebug("qtractorTrackView::updateContentsWidth() "
-						"iSessionLength=%lu iSessionWidth=%d "
-						"-- peakPeriod=%u (%u) p2=%d q2=%d.",
-						iSessionLength, iSessionWidth,
-						pPeakFactory->peakPeriod(), iPeakPeriod, p2, q2);
-				#endif
-				}
-			}
 		}
 	#if 0
 		m_iPlayHeadX = pSession->pixelFromFrame(pSession->playHead());
@@ -359,6 +363,11 @@ void qtractorTrackView::updateContentsWidth ( int iContentsWidth )
 // Local rectangular contents update.
 void qtractorTrackView::updateContents ( const QRect& rect )
 {
+	if (m_iTilesKeep < 1 && !m_bTilesPartial)
+		m_tiles.clear();
+
+	m_bTilesPartial = false;
+
 	updatePixmap(
 		qtractorScrollView::contentsX(), qtractorScrollView::contentsY());
 
@@ -369,6 +378,11 @@ void qtractorTrackView::updateContents ( const QRect& rect )
 // Overall contents update.
 void qtractorTrackView::updateContents (void)
 {
+	if (m_iTilesKeep < 1 && !m_bTilesPartial)
+		m_tiles.clear();
+
+	m_bTilesPartial = false;
+
 	updatePixmap(
 		qtractorScrollView::contentsX(), qtractorScrollView::contentsY());
 
@@ -376,6 +390,21 @@ void qtractorTrackView::updateContents (void)
 }
 
 
+// Invalidate cached tiles of a given track lane only,
+// instead of all, on the very next contents update.
+void qtractorTrackView::invalidateTrack ( qtractorTrack *pTrack )
+{
+	QListIterator<TileKey> iter(m_tiles.keys());
+	while (iter.hasNext()) {
+		const TileKey& key = iter.next();
+		if (key.first == pTrack)
+			m_tiles.remove(key);
+	}
+
+	m_bTilesPartial = true;
+}
+
+
 // Special recording visual feedback.
 void qtractorTrackView::updateContentsRecord (void)
 {
@@ -876,7 +905,10 @@ void qtractorTrackView::resizeEvent ( QResizeEvent *pResizeEvent )
 		m_pXzoomReset->setGeometry(x, h - w - 2, w, w);
 	}
 
+	// Cached tiles are still good...
+	++m_iTilesKeep;
 	updateContents();
+	--m_iTilesKeep;
 
 	// HACK: let our (single) thumb view get notified...
 	qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
@@ -885,6 +917,15 @@ void qtractorTrackView::resizeEvent ( QResizeEvent *pResizeEvent )
 }
 
 
+// Scroll area updater (keeps cached tiles).
+void qtractorTrackView::scrollContentsBy ( int dx, int dy )
+{
+	++m_iTilesKeep;
+	qtractorScrollView::scrollContentsBy(dx, dy);
+	--m_iTilesKeep;
+}
+
+
 // (Re)create the complete track view pixmap.
 void qtractorTrackView::updatePixmap ( int cx, int cy )
 {
@@ -917,7 +958,6 @@ void qtractorTrackView::updatePixmap ( int cx, int cy )
 	// Update view session cursor location,
 	// so that we'll start drawing clips from there...
 	const unsigned long iTrackStart = pTimeScale->frameFromPixel(cx);
-	const unsigned long iTrackEnd   = iTrackStart + pTimeScale->frameFromPixel(w);
 	// Create cursor now if applicable...
 	if (m_pSessionCursor == nullptr) {
 		m_pSessionCursor = pSession->createSessionCursor(iTrackStart);
@@ -925,67 +965,48 @@ void qtractorTrackView::updatePixmap ( int cx, int cy )
 		m_pSessionCursor->seek(iTrackStart);
 	}
 
-	const QColor& rgbLight = pal.midlight().color();
-	const QColor& rgbDark  = rgbMid.darker(120);
+	// Whole view layout has changed?
+	const unsigned int iTilesStamp = tilesStamp();
+	if (m_iTilesStamp != iTilesStamp) {
+		m_iTilesStamp = iTilesStamp;
+		m_tiles.clear();
+	}
 
-	// Draw vertical grid lines...
-	if (m_bSnapGrid || m_bSnapZebra) {
-		const QBrush zebra(QColor(0, 0, 0, 20));
-		qtractorTimeScale::Cursor cursor(pTimeScale);
-		qtractorTimeScale::Node *pNode = cursor.seekPixel(cx);
-		unsigned short iPixelsPerBeat = pNode->pixelsPerBeat();
-		unsigned int iBeat = pNode->beatFromPixel(cx);
-		if (iBeat > 0) pNode = cursor.seekBeat(--iBeat);
-		unsigned short iBar = pNode->barFromBeat(iBeat);
-		int x = pNode->pixelFromBeat(iBeat) - cx;
-		int x2 = x;
-		while (x < w) {
-			bool bBeatIsBar = pNode->beatIsBar(iBeat);
-			if (bBeatIsBar) {
-				if (m_bSnapGrid) {
-					painter.setPen(rgbLight);
-					painter.drawLine(x, 0, x, h);
-				}
-				if (m_bSnapZebra && (x > x2) && (++iBar & 1))
-					painter.fillRect(QRect(x2, 0, x - x2 + 1, h), zebra);
-				x2 = x;
-				if (iBeat == pNode->beat)
-					iPixelsPerBeat = pNode->pixelsPerBeat();
-			}
-			if (m_bSnapGrid && (bBeatIsBar || iPixelsPerBeat > 16)) {
-				painter.setPen(rgbDark);
-				painter.drawLine(x - 1, 0, x - 1, h);
+	// Draw track lanes, tile by tile...
+	const int tw = QTRACTOR_TILE_WIDTH;
+	const int t1 = cx / tw;
+	const int t2 = (cx + w - 1) / tw;
+	int y1, y2;
+	for (int t = t1; t <= t2; ++t) {
+		// Seek the session cursor for this tile clip hints...
+		const int x0 = t * tw - QTRACTOR_TILE_MARGIN;
+		m_pSessionCursor->seek(pTimeScale->frameFromPixel(x0 > 0 ? x0 : 0));
+		y1 = y2 = 0;
+		int iTrack = 0;
+		qtractorTrack *pTrack = pSession->tracks().first();
+		while (pTrack && y2 < cy + h) {
+			y1  = y2;
+			y2 += pTrack->zoomHeight();
+			if (y2 > cy) {
+				QPixmap *pTile = trackTile(pTrack, t, y2 - y1,
+					m_pSessionCursor->clip(iTrack));
+				if (pTile)
+					painter.drawPixmap(t * tw - cx, y1 - cy, *pTile);
 			}
-			pNode = cursor.seekBeat(++iBeat);
-			x = pNode->pixelFromBeat(iBeat) - cx;
+			pTrack = pTrack->next();
+			++iTrack;
 		}
-		if (m_bSnapZebra && (x > x2) && (++iBar & 1))
-			painter.fillRect(QRect(x2, 0, x - x2 + 1, h), zebra);
 	}
 
-	// Draw track and horizontal lines...
-	int y1, y2;
-	y1 = y2 = 0;
-	int iTrack = 0;
+	// Restore view session cursor location...
+	m_pSessionCursor->seek(iTrackStart);
+
+	// Empty or beyond the last track lane?
+	y2 = 0;
 	qtractorTrack *pTrack = pSession->tracks().first();
 	while (pTrack && y2 < cy + h) {
-		y1  = y2;
 		y2 += pTrack->zoomHeight();
-		if (y2 > cy) {
-			// Dispatch to paint this track...
-			if (y1 > cy) {
-				painter.setPen(rgbLight);
-				painter.drawLine(0, y1 - cy, w, y1 - cy);
-			}
-			const QRect trackRect(0, y1 - cy + 1, w, y2 - y1 - 2);
-		//	painter.fillRect(trackRect, rgbMid);
-			pTrack->drawTrack(&painter, trackRect, iTrackStart, iTrackEnd,
-				m_pSessionCursor->clip(iTrack));
-			painter.setPen(rgbDark);
-			painter.drawLine(0, y2 - cy - 1, w, y2 - cy - 1);
-		}
 		pTrack = pTrack->next();
-		++iTrack;
 	}
 
 	// Fill the empty area...
@@ -1049,6 +1070,218 @@ void qtractorTrackView::updatePixmap ( int cx, int cy )
 			painter.drawLine(x, 0, x, h);
 		}
 	}
+
+	// Render neighbouring tiles ahead, when idle...
+	if (!m_bTilesAhead) {
+		m_bTilesAhead = true;
+		QTimer::singleShot(0, this, SLOT(updateTilesSlot()));
+	}
+}
+
+
+// Render neighbouring tiles ahead (idle time).
+void qtractorTrackView::updateTilesSlot (void)
+{
+	m_bTilesAhead = false;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr || m_pSessionCursor == nullptr)
+		return;
+
+	qtractorTimeScale *pTimeScale = pSession->timeScale();
+	if (pTimeScale == nullptr)
+		return;
+
+	if (m_iTilesStamp != tilesStamp())
+		return;
+
+	QWidget *pViewport = qtractorScrollView::viewport();
+	const int w = pViewport->width();
+	const int h = pViewport->height();
+
+	const int cx = qtractorScrollView::contentsX();
+	const int cy = qtractorScrollView::contentsY();
+
+	const int tw = QTRACTOR_TILE_WIDTH;
+	const int t1 = cx / tw;
+	const int t2 = (cx + w - 1) / tw;
+
+	const unsigned long iTrackStart = m_pSessionCursor->frame();
+
+	for (int t = t1 - 1; t <= t2 + 1; t += (t2 - t1 + 2)) {
+		if (t < 0)
+			continue;
+		const int x0 = t * tw - QTRACTOR_TILE_MARGIN;
+		m_pSessionCursor->seek(pTimeScale->frameFromPixel(x0 > 0 ? x0 : 0));
+		int y1, y2;
+		y1 = y2 = 0;
+		int iTrack = 0;
+		qtractorTrack *pTrack = pSession->tracks().first();
+		while (pTrack && y2 < cy + h) {
+			y1  = y2;
+			y2 += pTrack->zoomHeight();
+			if (y2 > cy)
+				trackTile(pTrack, t, y2 - y1, m_pSessionCursor->clip(iTrack));
+			pTrack = pTrack->next();
+			++iTrack;
+		}
+	}
+
+	m_pSessionCursor->seek(iTrackStart);
+}
+
+
+// Get (or render) a cached track lane tile.
+QPixmap *qtractorTrackView::trackTile (
+	qtractorTrack *pTrack, int iTile, int h, qtractorClip *pClip )
+{
+	const TileKey key(pTrack, iTile);
+	QPixmap *pTile = m_tiles.object(key);
+	if (pTile && pTile->height() == h)
+		return pTile;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return nullptr;
+
+	qtractorTimeScale *pTimeScale = pSession->timeScale();
+	if (pTimeScale == nullptr)
+		return nullptr;
+
+	const int tw = QTRACTOR_TILE_WIDTH;
+	if (h < 1)
+		return nullptr;
+
+	const QPalette& pal = qtractorScrollView::palette();
+	const QColor& rgbMid   = pal.mid().color();
+	const QColor& rgbLight = pal.midlight().color();
+	const QColor& rgbDark  = rgbMid.darker(120);
+
+	pTile = new QPixmap(tw, h);
+	pTile->fill(rgbMid);
+
+	QPainter painter(pTile);
+	painter.setFont(qtractorScrollView::font());
+
+	const int x0 = iTile * tw;
+	drawGrid(&painter, x0, tw, h);
+
+	if (pTrack->prev()) {
+		painter.setPen(rgbLight);
+		painter.drawLine(0, 0, tw, 0);
+	}
+
+	// Render a little beyond the tile edges,
+	// so that clip borders and labels get seamless...
+	int x1 = x0 - QTRACTOR_TILE_MARGIN;
+	if (x1 < 0)
+		x1 = 0;
+	const int x2 = x0 + tw + QTRACTOR_TILE_MARGIN;
+	const unsigned long iTrackStart = pTimeScale->frameFromPixel(x1);
+	const unsigned long iTrackEnd   = pTimeScale->frameFromPixel(x2);
+	const QRect trackRect(0, 1, x2 - x1, h - 2);
+	painter.setClipRect(0, 0, tw, h);
+	painter.translate(x1 - x0, 0);
+	pTrack->drawTrack(&painter, trackRect, iTrackStart, iTrackEnd, pClip);
+	painter.resetTransform();
+
+	painter.setPen(rgbDark);
+	painter.drawLine(0, h - 1, tw, h - 1);
+	painter.end();
+
+	// Cost is in KB...
+	const int iCost = (tw * h * pTile->depth()) >> 13;
+	if (!m_tiles.insert(key, pTile, iCost > 0 ? iCost : 1))
+		return nullptr;
+
+	return m_tiles.object(key);
+}
+
+
+// Draw vertical grid lines (snap-grid and zebra).
+void qtractorTrackView::drawGrid (
+	QPainter *pPainter, int cx, int w, int h ) const
+{
+	if (!m_bSnapGrid && !m_bSnapZebra)
+		return;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return;
+
+	qtractorTimeScale *pTimeScale = pSession->timeScale();
+	if (pTimeScale == nullptr)
+		return;
+
+	const QPalette& pal = qtractorScrollView::palette();
+	const QColor& rgbLight = pal.midlight().color();
+	const QColor& rgbDark  = pal.mid().color().darker(120);
+
+	const QBrush zebra(QColor(0, 0, 0, 20));
+	qtractorTimeScale::Cursor cursor(pTimeScale);
+	qtractorTimeScale::Node *pNode = cursor.seekPixel(cx);
+	unsigned short iPixelsPerBeat = pNode->pixelsPerBeat();
+	unsigned int iBeat = pNode->beatFromPixel(cx);
+	if (iBeat > 0) pNode = cursor.seekBeat(--iBeat);
+	unsigned short iBar = pNode->barFromBeat(iBeat);
+	int x = pNode->pixelFromBeat(iBeat) - cx;
+	int x2 = x;
+	while (x < w + 1) {
+		bool bBeatIsBar = pNode->beatIsBar(iBeat);
+		if (bBeatIsBar) {
+			if (m_bSnapGrid) {
+				pPainter->setPen(rgbLight);
+				pPainter->drawLine(x, 0, x, h);
+			}
+			if (m_bSnapZebra && (x > x2) && (++iBar & 1))
+				pPainter->fillRect(QRect(x2, 0, x - x2 + 1, h), zebra);
+			x2 = x;
+			if (iBeat == pNode->beat)
+				iPixelsPerBeat = pNode->pixelsPerBeat();
+		}
+		if (m_bSnapGrid && (bBeatIsBar || iPixelsPerBeat > 16)) {
+			pPainter->setPen(rgbDark);
+			pPainter->drawLine(x - 1, 0, x - 1, h);
+		}
+		pNode = cursor.seekBeat(++iBeat);
+		x = pNode->pixelFromBeat(iBeat) - cx;
+	}
+	if (m_bSnapZebra && (x > x2) && (++iBar & 1))
+		pPainter->fillRect(QRect(x2, 0, x - x2 + 1, h), zebra);
+}
+
+
+// Whole view layout stamp (any change invalidates all tiles).
+unsigned int qtractorTrackView::tilesStamp (void) const
+{
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return 0;
+
+	qtractorTimeScale *pTimeScale = pSession->timeScale();
+	if (pTimeScale == nullptr)
+		return 0;
+
+	unsigned int h = pTimeScale->horizontalZoom();
+	h = (h << 5) ^ (h >> 27)
+		^ (unsigned int) (1000.0f * pTimeScale->pixelRate());
+	h = (h << 5) ^ (h >> 27) ^ pTimeScale->sampleRate();
+
+	qtractorTimeScale::Node *pNode = pTimeScale->nodes().first();
+	for ( ; pNode; pNode = pNode->next()) {
+		h = (h << 5) ^ (h >> 27) ^ (unsigned int) pNode->frame;
+		h = (h << 5) ^ (h >> 27) ^ (unsigned int) (100.0f * pNode->tempo);
+		h = (h << 5) ^ (h >> 27) ^ pNode->beatsPerBar;
+		h = (h << 5) ^ (h >> 27) ^ pNode->beatDivisor;
+	}
+
+	const QPalette& pal = qtractorScrollView::palette();
+	h = (h << 5) ^ (h >> 27) ^ pal.mid().color().rgb();
+	h = (h << 5) ^ (h >> 27) ^ pal.midlight().color().rgb();
+	h = (h << 5) ^ (h >> 27) ^ (m_bSnapGrid  ? 1 : 0);
+	h = (h << 5) ^ (h >> 27) ^ (m_bSnapZebra ? 2 : 0);
+
+	return h;
 }
 
 
@@ -30,6 +30,8 @@
 
 #include <QPixmap>
 #include <QBrush>
+#include <QCache>
+#include <QPair>
 
 
 // Forward declarations.
@@ -86,6 +88,10 @@ public:
 	// Special recording visual feedback.
 	void updateContentsRecord();
 
+	// Invalidate cached tiles of a given track lane only,
+	// instead of all, on the very next contents update.
+	void invalidateTrack(qtractorTrack *pTrack);
+
 	// The current clip selection mode.
 	enum SelectMode { SelectClip, SelectRange, SelectRect };
 	enum SelectEdit { EditNone = 0, EditHead = 1, EditTail = 2, EditBoth = 3 };
@@ -264,6 +270,9 @@ protected:
 	// Resize event handler.
 	void resizeEvent(QResizeEvent *pResizeEvent);
 
+	// Scroll area updater (keeps cached tiles).
+	void scrollContentsBy(int dx, int dy);
+
 	// Draw the track view
 	void drawContents(QPainter *pPainter, const QRect& rect);
 
@@ -409,6 +418,16 @@ protected:
 	void openEditCurveNode(qtractorCurve *pCurve, qtractorCurve::Node *pNode);
 	void closeEditCurveNode();
 
+	// Draw vertical grid lines (snap-grid and zebra).
+	void drawGrid(QPainter *pPainter, int cx, int w, int h) const;
+
+	// Get (or render) a cached track lane tile.
+	QPixmap *trackTile(qtractorTrack *pTrack, int iTile, int h,
+		qtractorClip *pClip = nullptr);
+
+	// Whole view layout stamp (any change invalidates all tiles).
+	unsigned int tilesStamp() const;
+
 protected slots:
 
 	// To have track view in v-sync with track list.
@@ -417,6 +436,9 @@ protected slots:
 	// (Re)create the complete track view pixmap.
 	void updatePixmap(int cx, int cy);
 
+	// Render neighbouring tiles ahead (idle time).
+	void updateTilesSlot();
+
 	// Drag-reset timer slot.
 	void dragTimeout();
 
@@ -439,6 +461,16 @@ private:
 	// Local double-buffering pixmap.
 	QPixmap m_pixmap;
 
+	// Cached track lane tiles (per track and time range).
+	typedef QPair<qtractorTrack *, int> TileKey;
+
+	QCache<TileKey, QPixmap> m_tiles;
+
+	unsigned int m_iTilesStamp;
+	int          m_iTilesKeep;
+	bool         m_bTilesPartial;
+	bool         m_bTilesAhead;
+
 	// To maintain the current track/clip positioning.
 	qtractorSessionCursor *m_pSessionCursor;
 
@@ -1707,6 +1707,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency () const;
 
+	// Plugin declared tail length (in frames);
+	long tail () const;
+
 	// Set/add a parameter value/point.
 	void setParameter (
 		Vst::ParamID id, Vst::ParamValue value, uint32 offset);
@@ -1867,6 +1870,8 @@ public:
 			m_pPlugin->impl()->deactivate();
 			m_pPlugin->impl()->activate();
 		}
+		if (flags & (Vst::kReloadComponent | Vst::kLatencyChanged))
+			m_pPlugin->updateSilenceBypass();
 		return kResultOk;
 	}
 
@@ -2620,6 +2625,23 @@ unsigned long qtractorVst3Plugin::Impl::latency (void) const
 }
 
 
+// Plugin declared tail length (in frames);
+long qtractorVst3Plugin::Impl::tail (void) const
+{
+	if (m_processor == nullptr)
+		return qtractorPlugin::TailUnknown;
+
+	// Zero is the SDK default (kNoTail), so it can't be trusted...
+	const uint32 iTail = m_processor->getTailSamples();
+	if (iTail == Vst::kInfiniteTail)
+		return qtractorPlugin::TailInfinite;
+	if (iTail == Vst::kNoTail)
+		return qtractorPlugin::TailUnknown;
+
+	return long(iTail);
+}
+
+
 // Set/add a parameter value/point.
 void qtractorVst3Plugin::Impl::setParameter (
 	Vst::ParamID id, Vst::ParamValue value, uint32 offset )
@@ -3532,6 +3554,13 @@ unsigned long qtractorVst3Plugin::latency (void) const
 }
 
 
+// Plugin declared tail length (in frames);
+long qtractorVst3Plugin::tail (void) const
+{
+	return m_pImpl->tail();
+}
+
+
 // Provisional program/patch accessor.
 bool qtractorVst3Plugin::getProgram ( int iIndex, Program& program ) const
 {
@@ -141,6 +141,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency() const;
 
+	// Plugin declared tail length (in frames);
+	long tail() const;
+
 	// Provisional program/patch accessor.
 	bool getProgram(int iIndex, Program& program) const;
 
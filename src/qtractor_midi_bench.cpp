@@ -0,0 +1,145 @@
+// qtractor_midi_bench.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2022, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorMidiFile.h"
+#include "qtractorTimeScale.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTextStream>
+
+// Deprecated QTextStreamFunctions/Qt namespaces workaround.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+#define endl	Qt::endl
+#endif
+
+
+//-------------------------------------------------------------------------
+// SMF load benchmark -- reads and frees whole MIDI files, repeatedly.
+//
+// usage: qtractor_midi_bench [-n <rounds>] <file.mid> [<file.mid> ...]
+//
+
+static bool qtractor_midi_bench ( const QString& sFilename,
+	int iRounds, QTextStream& out )
+{
+	qint64 iLoadNsecs = 0;
+	qint64 iFreeNsecs = 0;
+	int iEvents = 0;
+
+	for (int iRound = 0; iRound < iRounds; ++iRound) {
+
+		qtractorMidiFile file;
+		if (!file.open(sFilename)) {
+			out << sFilename << ": cannot open." << endl;
+			return false;
+		}
+
+		const unsigned short iSeqs
+			= (file.format() == 1 ? file.tracks() : 16);
+		qtractorMidiSequence **ppSeqs
+			= new qtractorMidiSequence * [iSeqs];
+		for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
+			ppSeqs[iSeq] = new qtractorMidiSequence(QString(), iSeq,
+				qtractorTimeScale::TICKS_PER_BEAT_HRQ);
+		}
+
+		QElapsedTimer timer;
+		timer.start();
+
+		const bool bRead = file.readTracks(ppSeqs, iSeqs);
+
+		iLoadNsecs += timer.nsecsElapsed();
+
+		file.close();
+
+		iEvents = 0;
+		for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq)
+			iEvents += ppSeqs[iSeq]->events().count();
+
+		timer.restart();
+
+		for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq)
+			delete ppSeqs[iSeq];
+		delete [] ppSeqs;
+
+		iFreeNsecs += timer.nsecsElapsed();
+
+		if (!bRead) {
+			out << sFilename << ": cannot read." << endl;
+			return false;
+		}
+	}
+
+	out << sFilename
+		<< ": events=" << iEvents
+		<< " rounds=" << iRounds
+		<< " load=" << (1e-6 * double(iLoadNsecs) / double(iRounds)) << " ms"
+		<< " free=" << (1e-6 * double(iFreeNsecs) / double(iRounds)) << " ms"
+		<< endl;
+
+	return true;
+}
+
+
+//-------------------------------------------------------------------------
+// main - The main program trunk.
+//
+
+int main ( int argc, char **argv )
+{
+	QCoreApplication app(argc, argv);
+
+	QTextStream out(stdout);
+
+	int iRounds = 10;
+	QStringList files;
+
+	const QStringList& args = app.arguments();
+	for (int i = 1; i < args.count(); ++i) {
+		const QString& sArg = args.at(i);
+		if (sArg == "-n" && i + 1 < args.count())
+			iRounds = args.at(++i).toInt();
+		else
+			files.append(sArg);
+	}
+
+	if (files.isEmpty() || iRounds < 1) {
+		out << "usage: " << args.at(0)
+			<< " [-n <rounds>] <file.mid> [<file.mid> ...]" << endl;
+		return 1;
+	}
+
+	int iRet = 0;
+
+	QStringListIterator iter(files);
+	while (iter.hasNext()) {
+		if (!qtractor_midi_bench(iter.next(), iRounds, out))
+			iRet = 2;
+	}
+
+	return iRet;
+}
+
+
+// end of qtractor_midi_bench.cpp
@@ -1864,6 +1864,8 @@ int main ( int argc, char **argv )
 			else
 		#endif
 			break;
+			// Always tell when done with this one...
+			QTextStream(stdout) << "DONE|" << sFilename << '\n';
 		}
 	}
 #ifdef CONFIG_DEBUG